@@ -9,8 +9,8 @@
  * @param nodes A vector of Node objects.
  * @throws std::invalid_argument if the nodes vector is empty for data messages.
  */
-DataMessage::DataMessage(const MessageHeader& header, const std::vector<Node>& nodes)
-    : header_(header), nodes_(nodes) {
+DataMessage::DataMessage(MessageHeader header, std::vector<Node> nodes)
+    : header_(std::move(header)), nodes_(std::move(nodes)) {
     if (nodes_.empty()) {
         throw std::invalid_argument("Nodes vector cannot be empty");
     }
@@ -28,7 +28,7 @@ DataMessage::DataMessage(const MessageHeader& header, const std::vector<Node>& n
  *
  * @return MessageHeader The header of the data message.
  */
-MessageHeader DataMessage::getHeader() const { return header_; }
+const MessageHeader& DataMessage::getHeader() const { return header_; }
 
 /**
  * @brief Retrieves the list of nodes.
@@ -37,7 +37,14 @@ MessageHeader DataMessage::getHeader() const { return header_; }
  *
  * @return std::vector<Node> A vector of Node objects.
  */
-std::vector<Node> DataMessage::getNodes() const { return nodes_; }
+const std::vector<Node>& DataMessage::getNodes() const& { return nodes_; }
+
+/**
+ * @brief Releases the list of nodes of an expiring DataMessage.
+ *
+ * @return The nodes, moved out of the message.
+ */
+std::vector<Node> DataMessage::getNodes() && { return std::move(nodes_); }
 
 /**
  * @brief Overloads the << operator to print the DataMessage object.
@@ -57,7 +64,9 @@ std::ostream& operator<<(std::ostream& os, const DataMessage& message) {
     for (const auto& node : message.getNodes()) {
         os << "    Node {\n";
         os << "      Name: " << node.getName() << "\n";
-        os << "      Value: " << (node.getValue().has_value() ? node.getValue().value() : "null")
+        os << "      Value: "
+           << (node.getValue().has_value() ? NodeValueFormatter::toString(node.getValue().value())
+                                           : "null")
            << "\n";
         if (node.getMetadata().getGenerated()) {
             auto generated = node.getMetadata().getGenerated().value().time_since_epoch();
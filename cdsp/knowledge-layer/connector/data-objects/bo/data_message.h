@@ -9,9 +9,10 @@
 
 class DataMessage {
    public:
-    DataMessage(const MessageHeader& header, const std::vector<Node>& nodes);
-    MessageHeader getHeader() const;
-    std::vector<Node> getNodes() const;
+    DataMessage(MessageHeader header, std::vector<Node> nodes);
+    [[nodiscard]] const MessageHeader& getHeader() const;
+    [[nodiscard]] const std::vector<Node>& getNodes() const&;
+    [[nodiscard]] std::vector<Node> getNodes() &&;
     friend std::ostream& operator<<(std::ostream& os, const DataMessage& message);
 
    private:
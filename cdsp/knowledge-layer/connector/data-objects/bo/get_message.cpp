@@ -8,8 +8,8 @@
  *
  * @throws std::invalid_argument if the nodes vector is empty for get messages.
  */
-GetMessage::GetMessage(const MessageHeader& header, const std::vector<Node>& nodes)
-    : header_(header), nodes_(nodes) {}
+GetMessage::GetMessage(MessageHeader header, std::vector<Node> nodes)
+    : header_(std::move(header)), nodes_(std::move(nodes)) {}
 
 /**
  * @brief Retrieves the header of the GetMessage.
@@ -20,7 +20,7 @@ GetMessage::GetMessage(const MessageHeader& header, const std::vector<Node>& nod
  *
  * @return MessageHeader The header of the GetMessage.
  */
-MessageHeader GetMessage::getHeader() const { return header_; }
+const MessageHeader& GetMessage::getHeader() const { return header_; }
 
 /**
  * @brief Retrieves the list of nodes.
@@ -30,7 +30,14 @@ MessageHeader GetMessage::getHeader() const { return header_; }
  *
  * @return std::vector<Node> A vector of Node objects.
  */
-std::vector<Node> GetMessage::getNodes() const { return nodes_; }
+const std::vector<Node>& GetMessage::getNodes() const& { return nodes_; }
+
+/**
+ * @brief Releases the list of nodes of an expiring GetMessage.
+ *
+ * @return The nodes, moved out of the message.
+ */
+std::vector<Node> GetMessage::getNodes() && { return std::move(nodes_); }
 
 /**
  * @brief Overloads the << operator to print the GetMessage object.
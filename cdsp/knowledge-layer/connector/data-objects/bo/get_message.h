@@ -6,10 +6,11 @@
 
 class GetMessage {
    public:
-    GetMessage(const MessageHeader& header, const std::vector<Node>& nodes);
+    GetMessage(MessageHeader header, std::vector<Node> nodes);
 
-    MessageHeader getHeader() const;
-    std::vector<Node> getNodes() const;
+    [[nodiscard]] const MessageHeader& getHeader() const;
+    [[nodiscard]] const std::vector<Node>& getNodes() const&;
+    [[nodiscard]] std::vector<Node> getNodes() &&;
     friend std::ostream& operator<<(std::ostream& os, const GetMessage& message);
 
    private:
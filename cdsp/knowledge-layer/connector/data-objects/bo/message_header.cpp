@@ -9,9 +9,9 @@
  *
  * @throws std::invalid_argument if the instance is empty.
  */
-MessageHeader::MessageHeader(const std::string& instance, const SchemaType& schema_type)
-    : instance_(instance), schema_type_(schema_type) {
-    if (instance.empty()) {
+MessageHeader::MessageHeader(std::string instance, SchemaType schema_type)
+    : instance_(std::move(instance)), schema_type_(schema_type) {
+    if (instance_.empty()) {
         throw std::invalid_argument("MessageHeader instance cannot be empty");
     }
 }
@@ -21,7 +21,7 @@ MessageHeader::MessageHeader(const std::string& instance, const SchemaType& sche
  *
  * @return A string representing the instance of the message header.
  */
-std::string MessageHeader::getInstance() const { return instance_; }
+const std::string& MessageHeader::getInstance() const { return instance_; }
 /**
  * @brief Retrieves the schema type associated with the message header.
  *
@@ -7,9 +7,9 @@
 
 class MessageHeader {
    public:
-    MessageHeader(const std::string &instance, const SchemaType &schema_type);
+    MessageHeader(std::string instance, SchemaType schema_type);
 
-    [[nodiscard]] std::string getInstance() const;
+    [[nodiscard]] const std::string &getInstance() const;
     [[nodiscard]] SchemaType getSchemaType() const;
 
    private:
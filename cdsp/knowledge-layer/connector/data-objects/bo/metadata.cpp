@@ -10,9 +10,11 @@
  * generated.
  * @param confidence An optional confidence value associated with the metadata.
  */
-Metadata::Metadata(const Timestamps &timestamps, const std::optional<OriginType> &origin,
-                   const std::optional<std::pair<ConfidenceType, std::string>> &confidence)
-    : generated_(timestamps.generated), origin_(origin), confidence_(confidence) {
+Metadata::Metadata(const Timestamps &timestamps, std::optional<OriginType> origin,
+                   std::optional<std::pair<ConfidenceType, std::string>> confidence)
+    : generated_(timestamps.generated),
+      origin_(std::move(origin)),
+      confidence_(std::move(confidence)) {
     if (timestamps.received.has_value()) {
         received_ = timestamps.received.value();
     } else {
@@ -26,7 +28,7 @@ Metadata::Metadata(const Timestamps &timestamps, const std::optional<OriginType>
  * @return An optional containing the time point when the metadata was
  * generated. If the time point is not set, the optional will be empty.
  */
-std::optional<std::chrono::system_clock::time_point> Metadata::getGenerated() const {
+const std::optional<std::chrono::system_clock::time_point> &Metadata::getGenerated() const {
     return generated_;
 }
 
@@ -43,7 +45,7 @@ std::chrono::system_clock::time_point Metadata::getReceived() const { return rec
  * @return An optional containing the origin information. If the origin is not
  *         set, the optional will be empty.
  */
-std::optional<Metadata::OriginType> Metadata::getOriginType() const { return origin_; }
+const std::optional<Metadata::OriginType> &Metadata::getOriginType() const { return origin_; }
 
 /**
  * @brief Retrieves the confidence value associated with the metadata.
@@ -51,6 +53,6 @@ std::optional<Metadata::OriginType> Metadata::getOriginType() const { return ori
  * @return An optional containing a pair of confidence type and value.
  *         If the confidence is not set, the optional will be empty.
  */
-std::optional<std::pair<ConfidenceType, std::string>> Metadata::getConfidence() const {
+const std::optional<std::pair<ConfidenceType, std::string>> &Metadata::getConfidence() const {
     return confidence_;
 }
\ No newline at end of file
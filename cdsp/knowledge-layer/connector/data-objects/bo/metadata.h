@@ -19,13 +19,14 @@ class Metadata {
     };
     explicit Metadata(
         const Timestamps &timestamps = {std::nullopt, std::nullopt},
-        const std::optional<OriginType> &origin = std::nullopt,
-        const std::optional<std::pair<ConfidenceType, std::string>> &confidence = std::nullopt);
+        std::optional<OriginType> origin = std::nullopt,
+        std::optional<std::pair<ConfidenceType, std::string>> confidence = std::nullopt);
 
-    [[nodiscard]] std::optional<std::chrono::system_clock::time_point> getGenerated() const;
+    [[nodiscard]] const std::optional<std::chrono::system_clock::time_point> &getGenerated() const;
     [[nodiscard]] std::chrono::system_clock::time_point getReceived() const;
-    [[nodiscard]] std::optional<OriginType> getOriginType() const;
-    [[nodiscard]] std::optional<std::pair<ConfidenceType, std::string>> getConfidence() const;
+    [[nodiscard]] const std::optional<OriginType> &getOriginType() const;
+    [[nodiscard]] const std::optional<std::pair<ConfidenceType, std::string>> &getConfidence()
+        const;
 
    private:
     std::optional<std::chrono::system_clock::time_point> generated_;
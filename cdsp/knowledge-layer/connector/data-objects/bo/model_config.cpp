@@ -52,7 +52,8 @@ ModelConfig::ModelConfig(
       validation_shapes_(validation_shapes),
       triple_assembler_helper_(triple_assembler_helper),
       reasoning_output_queries_(reasoning_output_queries),
-      reasoner_settings_(reasoner_settings) {
+      reasoner_settings_(reasoner_settings),
+      reasoning_output_path_(output_path + "/reasoning_output/") {
     if (inputs_.empty()) {
         throw std::invalid_argument("Inputs map cannot be empty");
     }
@@ -81,15 +82,17 @@ ModelConfig::ModelConfig(
                 throw std::invalid_argument(
                     "Inputs map must contain all supported schema collections");
             }
-            if (triple_assembler_helper.getQueries().find(schema) ==
-                triple_assembler_helper.getQueries().end()) {
-                if (triple_assembler_helper.getQueries().find(SchemaType::DEFAULT) ==
-                    triple_assembler_helper.getQueries().end()) {
+            const auto& queries = triple_assembler_helper.getQueries();
+            auto query_pair = queries.find(schema);
+            if (query_pair == queries.end()) {
+                query_pair = queries.find(SchemaType::DEFAULT);
+                if (query_pair == queries.end()) {
                     throw std::invalid_argument(
                         "All supported schema collections must be in the queries map or there must "
                         "be a default query");
                 }
             }
+            query_pairs_.emplace(schema, query_pair->second);
 
             // Add Object ID for each schema type
             std::string uppercase_schema_type = Helper::toUppercase(schemaTypeToString(schema));
@@ -100,6 +103,10 @@ ModelConfig::ModelConfig(
             }
         }
     }
+
+    buildSignalCatalog();
+    query_dependencies_ =
+        QueryDependencyGraph(reasoner_rules_, reasoning_output_queries_, signal_catalog_);
 }
 
 /**
@@ -110,7 +117,18 @@ ModelConfig::ModelConfig(
  *
  * @return A map of SchemaType to a string representing the object ID.
  */
-std::map<SchemaType, std::string> ModelConfig::getObjectId() const { return object_ids_; }
+const std::map<SchemaType, std::string>& ModelConfig::getObjectId() const { return object_ids_; }
+
+/**
+ * @brief Retrieves the object ID of a supported schema type.
+ *
+ * @param schema_type The schema type to get the object ID for.
+ * @return The object ID associated with the schema type.
+ * @throws std::out_of_range if the schema type is not supported.
+ */
+const std::string& ModelConfig::getObjectId(SchemaType schema_type) const {
+    return object_ids_.at(schema_type);
+}
 
 /**
  * @brief Retrieves the input configurations for the model.
@@ -122,7 +140,18 @@ std::map<SchemaType, std::string> ModelConfig::getObjectId() const { return obje
  * @return A map of SchemaType to a SchemaInput object representing the
  * inputs.
  */
-std::map<SchemaType, SchemaInputList> ModelConfig::getInputs() const { return inputs_; }
+const std::map<SchemaType, SchemaInputList>& ModelConfig::getInputs() const { return inputs_; }
+
+/**
+ * @brief Retrieves the input configuration of a schema type.
+ *
+ * @param schema_type The schema type to get the inputs for.
+ * @return The SchemaInputList associated with the schema type.
+ * @throws std::out_of_range if there are no inputs for the schema type.
+ */
+const SchemaInputList& ModelConfig::getInputs(SchemaType schema_type) const {
+    return inputs_.at(schema_type);
+}
 
 /**
  * @brief Retrieves the list of ontologies.
@@ -133,7 +162,7 @@ std::map<SchemaType, SchemaInputList> ModelConfig::getInputs() const { return in
  *
  * @return A vector of pairs containing ReasonerSyntaxType and std::string.
  */
-std::vector<std::pair<ReasonerSyntaxType, std::string>> ModelConfig::getOntologies() const {
+const std::vector<std::pair<ReasonerSyntaxType, std::string>>& ModelConfig::getOntologies() const {
     return ontologies_;
 }
 
@@ -142,7 +171,14 @@ std::vector<std::pair<ReasonerSyntaxType, std::string>> ModelConfig::getOntologi
  *
  * @return A string representing the output path.
  */
-std::string ModelConfig::getOutput() const { return output_path_; }
+const std::string& ModelConfig::getOutput() const { return output_path_; }
+
+/**
+ * @brief Retrieves the directory where the reasoning query results are stored.
+ *
+ * @return The output path followed by "/reasoning_output/".
+ */
+const std::string& ModelConfig::getReasoningOutputPath() const { return reasoning_output_path_; }
 
 /**
  * @brief Retrieves the reasoner rules associated with the model configuration.
@@ -151,7 +187,8 @@ std::string ModelConfig::getOutput() const { return output_path_; }
  *         The RuleLanguageType represents the type of rule language, and the string
  *         represents the rule itself.
  */
-std::vector<std::pair<RuleLanguageType, std::string>> ModelConfig::getReasonerRules() const {
+const std::vector<std::pair<RuleLanguageType, std::string>>& ModelConfig::getReasonerRules()
+    const {
     return reasoner_rules_;
 }
 
@@ -165,7 +202,8 @@ std::vector<std::pair<RuleLanguageType, std::string>> ModelConfig::getReasonerRu
  * @return A vector of pairs containing ReasonerSyntaxType and string,
  * representing the validation shapes.
  */
-std::vector<std::pair<ReasonerSyntaxType, std::string>> ModelConfig::getValidationShapes() const {
+const std::vector<std::pair<ReasonerSyntaxType, std::string>>& ModelConfig::getValidationShapes()
+    const {
     return validation_shapes_;
 }
 
@@ -177,10 +215,33 @@ std::vector<std::pair<ReasonerSyntaxType, std::string>> ModelConfig::getValidati
  *
  * @return TripleAssemblerHelper The TripleAssemblerHelper object containing the queries.
  */
-TripleAssemblerHelper ModelConfig::getQueriesTripleAssemblerHelper() const {
+const TripleAssemblerHelper& ModelConfig::getQueriesTripleAssemblerHelper() const {
     return triple_assembler_helper_;
 }
 
+/**
+ * @brief Retrieves the triple assembler queries to use for a schema type.
+ *
+ * Supported schema types are resolved to their own queries or to the default queries when the
+ * configuration is built. Other schema types fall back to the default queries.
+ *
+ * @param schema_type The schema type of the message the triples are created for.
+ * @return The QueryPair for the schema type.
+ * @throws std::out_of_range if there are neither queries for the schema type nor default queries.
+ */
+const TripleAssemblerHelper::QueryPair& ModelConfig::getQueryPair(SchemaType schema_type) const {
+    const auto query_pair = query_pairs_.find(schema_type);
+    if (query_pair != query_pairs_.end()) {
+        return query_pair->second;
+    }
+    const auto& queries = triple_assembler_helper_.getQueries();
+    const auto schema_query_pair = queries.find(schema_type);
+    if (schema_query_pair != queries.end()) {
+        return schema_query_pair->second;
+    }
+    return queries.at(SchemaType::DEFAULT);
+}
+
 /**
  * @brief Retrieves the reasoning output queries stored in the model
  * configuration.
@@ -190,7 +251,7 @@ TripleAssemblerHelper ModelConfig::getQueriesTripleAssemblerHelper() const {
  *
  * @return A vector of ReasoningOutputQuery objects.
  */
-std::vector<ReasoningOutputQuery> ModelConfig::getReasoningOutputQueries() const {
+const std::vector<ReasoningOutputQuery>& ModelConfig::getReasoningOutputQueries() const {
     return reasoning_output_queries_;
 }
 
@@ -201,7 +262,54 @@ std::vector<ReasoningOutputQuery> ModelConfig::getReasoningOutputQueries() const
  *
  * @return ReasonerSettings The current reasoner settings.
  */
-ReasonerSettings ModelConfig::getReasonerSettings() const { return reasoner_settings_; }
+const ReasonerSettings& ModelConfig::getReasonerSettings() const { return reasoner_settings_; }
+
+/**
+ * @brief Retrieves the catalog of the signals known by the model configuration.
+ *
+ * The catalog contains the input data points of every schema and the signals described by the
+ * Turtle validation shapes.
+ *
+ * @return The SignalCatalog of the model configuration.
+ */
+const SignalCatalog& ModelConfig::getSignalCatalog() const { return signal_catalog_; }
+
+/**
+ * @brief Retrieves the input signals of the reasoning output queries.
+ *
+ * The dependencies are analyzed from the reasoner rules, the output queries and the predicates of
+ * the signal catalog, with the queries indexed as in getReasoningOutputQueries().
+ *
+ * @return The QueryDependencyGraph of the model configuration.
+ */
+const QueryDependencyGraph& ModelConfig::getQueryDependencies() const {
+    return query_dependencies_;
+}
+
+/**
+ * @brief Builds the signal catalog from the input data points and the validation shapes.
+ *
+ * The input data points are added first, in the order of the input files, followed by the
+ * signals of the Turtle validation shapes whose root shape is named after one of the schemas.
+ */
+void ModelConfig::buildSignalCatalog() {
+    std::vector<std::string> root_names;
+    for (const auto& [schema, input_list] : inputs_) {
+        root_names.push_back(schemaTypeToString(schema, true));
+        const std::string prefix = root_names.back() + ".";
+        for (const auto& data_point : input_list.subscribe) {
+            if (!data_point.empty()) {
+                signal_catalog_.addSignal(prefix + data_point);
+            }
+        }
+    }
+
+    for (const auto& [syntax, shapes] : validation_shapes_) {
+        if (syntax == ReasonerSyntaxType::TURTLE) {
+            signal_catalog_.addSignalsFromShapes(shapes, root_names);
+        }
+    }
+}
 
 /**
  * @brief Overloads the << operator to print the ModelConfig object.
@@ -276,11 +384,24 @@ std::ostream& operator<<(std::ostream& os, const ModelConfig& config) {
         os << "    }\n";
     }
     os << "  Queries Rules Output: [\n";
-    for (const auto& query : config.getReasoningOutputQueries()) {
+    const auto& queries = config.getReasoningOutputQueries();
+    for (std::size_t index = 0; index < queries.size(); ++index) {
+        const auto& query = queries[index];
         os << "    {\n";
         os << "      Query Language: " << queryLanguageTypeToContentType(query.query_language)
            << ",\n";
         os << "      Query: " << query.query << "\n";
+        os << "      Input Signals: [";
+        if (config.getQueryDependencies().dependsOnAllSignals(index)) {
+            os << "all";
+        } else {
+            const char* separator = "";
+            for (const SignalId signal : config.getQueryDependencies().getInputSignals(index)) {
+                os << separator << config.getSignalCatalog().getPath(signal);
+                separator = ", ";
+            }
+        }
+        os << "]\n";
         os << "    }\n";
     }
     os << "  ]\n";
@@ -2,11 +2,14 @@
 #define MODEL_CONFIG_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "data_types.h"
+#include "query_dependency_graph.h"
 #include "reasoner_settings.h"
+#include "signal_catalog.h"
 #include "triple_assembler_helper.h"
 
 struct SchemaInputList {
@@ -15,6 +18,14 @@ struct SchemaInputList {
     bool operator==(const SchemaInputList& other) const { return subscribe == other.subscribe; }
 };
 
+/**
+ * @brief Reasoning model configuration.
+ *
+ * A ModelConfig is immutable once constructed. It is shared between the components on the message
+ * path as a ModelConfigSnapshot, and its getters return references into the snapshot, so reading
+ * the configuration does not allocate. Lookups that are needed per message or per node are
+ * resolved for every supported schema when the configuration is built.
+ */
 class ModelConfig {
    public:
     ModelConfig(const std::map<SchemaType, SchemaInputList>& supported_data_points,
@@ -26,15 +37,24 @@ class ModelConfig {
                 const std::vector<ReasoningOutputQuery>& reasoning_output_queries,
                 const ReasonerSettings& reasoner_settings);
 
-    virtual std::map<SchemaType, std::string> getObjectId() const;
-    virtual std::map<SchemaType, SchemaInputList> getInputs() const;
-    virtual std::vector<std::pair<ReasonerSyntaxType, std::string>> getOntologies() const;
-    virtual std::string getOutput() const;
-    virtual std::vector<std::pair<RuleLanguageType, std::string>> getReasonerRules() const;
-    virtual std::vector<std::pair<ReasonerSyntaxType, std::string>> getValidationShapes() const;
-    virtual TripleAssemblerHelper getQueriesTripleAssemblerHelper() const;
-    virtual std::vector<ReasoningOutputQuery> getReasoningOutputQueries() const;
-    virtual ReasonerSettings getReasonerSettings() const;
+    virtual ~ModelConfig() = default;
+
+    virtual const std::map<SchemaType, std::string>& getObjectId() const;
+    virtual const std::string& getObjectId(SchemaType schema_type) const;
+    virtual const std::map<SchemaType, SchemaInputList>& getInputs() const;
+    virtual const SchemaInputList& getInputs(SchemaType schema_type) const;
+    virtual const std::vector<std::pair<ReasonerSyntaxType, std::string>>& getOntologies() const;
+    virtual const std::string& getOutput() const;
+    virtual const std::string& getReasoningOutputPath() const;
+    virtual const std::vector<std::pair<RuleLanguageType, std::string>>& getReasonerRules() const;
+    virtual const std::vector<std::pair<ReasonerSyntaxType, std::string>>& getValidationShapes()
+        const;
+    virtual const TripleAssemblerHelper& getQueriesTripleAssemblerHelper() const;
+    virtual const TripleAssemblerHelper::QueryPair& getQueryPair(SchemaType schema_type) const;
+    virtual const std::vector<ReasoningOutputQuery>& getReasoningOutputQueries() const;
+    virtual const ReasonerSettings& getReasonerSettings() const;
+    virtual const SignalCatalog& getSignalCatalog() const;
+    virtual const QueryDependencyGraph& getQueryDependencies() const;
     friend std::ostream& operator<<(std::ostream& os, const ModelConfig& config);
 
    private:
@@ -47,6 +67,18 @@ class ModelConfig {
     TripleAssemblerHelper triple_assembler_helper_;
     std::vector<ReasoningOutputQuery> reasoning_output_queries_;
     std::map<SchemaType, std::string> object_ids_;
+    // Precomputed lookups
+    std::string reasoning_output_path_;
+    std::map<SchemaType, TripleAssemblerHelper::QueryPair> query_pairs_;
+    SignalCatalog signal_catalog_;
+    QueryDependencyGraph query_dependencies_;
+
+    void buildSignalCatalog();
 };
 
+/**
+ * @brief Shared, read-only view of a ModelConfig.
+ */
+using ModelConfigSnapshot = std::shared_ptr<const ModelConfig>;
+
 #endif  // MODEL_CONFIG_H
\ No newline at end of file
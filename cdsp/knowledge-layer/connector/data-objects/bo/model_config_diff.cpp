@@ -0,0 +1,125 @@
+#include "model_config_diff.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace {
+/**
+ * @brief Collects the entries of `from` that are not in `other`, keeping their order.
+ */
+template <typename T>
+std::vector<T> difference(const std::vector<T>& from, const std::vector<T>& other) {
+    std::vector<T> result;
+    for (const auto& entry : from) {
+        if (std::find(other.begin(), other.end(), entry) == other.end()) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Fills the added and removed entries between two versions of a list of artifacts.
+ */
+template <typename T>
+void diffArtifacts(const std::vector<T>& previous, const std::vector<T>& current,
+                   std::vector<T>& added, std::vector<T>& removed) {
+    added = difference(current, previous);
+    removed = difference(previous, current);
+}
+}  // namespace
+
+/**
+ * @brief Computes the differences from a previous to a current model configuration.
+ *
+ * @param previous The configuration in use.
+ * @param current The newly loaded configuration.
+ * @return The differences between the configurations.
+ */
+ModelConfigDiff ModelConfigDiff::compute(const ModelConfig& previous, const ModelConfig& current) {
+    ModelConfigDiff diff;
+    diffArtifacts(previous.getReasonerRules(), current.getReasonerRules(), diff.added_rules,
+                  diff.removed_rules);
+    diffArtifacts(previous.getOntologies(), current.getOntologies(), diff.added_ontologies,
+                  diff.removed_ontologies);
+    diffArtifacts(previous.getValidationShapes(), current.getValidationShapes(),
+                  diff.added_validation_shapes, diff.removed_validation_shapes);
+
+    diff.triple_assembler_queries_changed =
+        previous.getQueriesTripleAssemblerHelper().getQueries() !=
+        current.getQueriesTripleAssemblerHelper().getQueries();
+    diff.output_queries_changed =
+        previous.getReasoningOutputQueries() != current.getReasoningOutputQueries();
+
+    const ReasonerSettings& previous_settings = previous.getReasonerSettings();
+    const ReasonerSettings& current_settings = current.getReasonerSettings();
+    diff.output_settings_changed =
+        previous.getOutput() != current.getOutput() ||
+        previous_settings.getOutputFormat() != current_settings.getOutputFormat() ||
+        previous_settings.isIsAiReasonerInferenceResults() !=
+            current_settings.isIsAiReasonerInferenceResults();
+    diff.signal_catalog_changed = previous.getInputs() != current.getInputs() ||
+                                  !diff.added_validation_shapes.empty() ||
+                                  !diff.removed_validation_shapes.empty();
+
+    // The subscriptions and the reasoner connection are set up once at startup
+    if (previous.getInputs() != current.getInputs()) {
+        diff.restart_required.emplace_back("inputs");
+    }
+    if (previous_settings.getSupportedSchemaCollections() !=
+        current_settings.getSupportedSchemaCollections()) {
+        diff.restart_required.emplace_back("supported_schema_collections");
+    }
+    if (previous_settings.getInferenceEngine() != current_settings.getInferenceEngine()) {
+        diff.restart_required.emplace_back("inference_engine");
+    }
+    return diff;
+}
+
+/**
+ * @brief Checks whether the configurations are equivalent.
+ *
+ * @return true if nothing changed.
+ */
+bool ModelConfigDiff::empty() const {
+    return !hasReasonerChanges() && !triple_assembler_queries_changed && !output_queries_changed &&
+           !output_settings_changed && !signal_catalog_changed && restart_required.empty();
+}
+
+/**
+ * @brief Checks whether rules, ontologies or validation shapes have to be added or removed.
+ *
+ * @return true if the content of the reasoner changes.
+ */
+bool ModelConfigDiff::hasReasonerChanges() const {
+    return !added_rules.empty() || !removed_rules.empty() || !added_ontologies.empty() ||
+           !removed_ontologies.empty() || !added_validation_shapes.empty() ||
+           !removed_validation_shapes.empty();
+}
+
+/**
+ * @brief Prints a one-line summary of the differences.
+ *
+ * @param os The output stream to write to.
+ * @param diff The differences to print.
+ * @return The output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const ModelConfigDiff& diff) {
+    os << "rules +" << diff.added_rules.size() << "/-" << diff.removed_rules.size()
+       << ", ontologies +" << diff.added_ontologies.size() << "/-"
+       << diff.removed_ontologies.size() << ", validation shapes +"
+       << diff.added_validation_shapes.size() << "/-" << diff.removed_validation_shapes.size();
+    if (diff.triple_assembler_queries_changed) {
+        os << ", triple assembler queries";
+    }
+    if (diff.output_queries_changed) {
+        os << ", output queries";
+    }
+    if (diff.output_settings_changed) {
+        os << ", output settings";
+    }
+    for (const auto& setting : diff.restart_required) {
+        os << ", " << setting << " (restart required)";
+    }
+    return os;
+}
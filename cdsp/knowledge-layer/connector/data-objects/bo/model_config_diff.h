@@ -0,0 +1,43 @@
+#ifndef MODEL_CONFIG_DIFF_H
+#define MODEL_CONFIG_DIFF_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data_types.h"
+#include "model_config.h"
+
+/**
+ * @brief Differences between two versions of the model configuration.
+ *
+ * Rules, ontologies and validation shapes are compared by content, so a diff lists exactly the
+ * artifacts to add to and remove from the reasoner. Queries and output settings are read from
+ * the configuration snapshot for every message and only need a flag. Settings that are applied
+ * once at startup, like the subscribed inputs, are listed in `restart_required`.
+ */
+struct ModelConfigDiff {
+    std::vector<std::pair<RuleLanguageType, std::string>> added_rules;
+    std::vector<std::pair<RuleLanguageType, std::string>> removed_rules;
+    std::vector<std::pair<ReasonerSyntaxType, std::string>> added_ontologies;
+    std::vector<std::pair<ReasonerSyntaxType, std::string>> removed_ontologies;
+    std::vector<std::pair<ReasonerSyntaxType, std::string>> added_validation_shapes;
+    std::vector<std::pair<ReasonerSyntaxType, std::string>> removed_validation_shapes;
+    // The queries are read from the snapshot, so the change only needs the snapshot to be swapped
+    bool triple_assembler_queries_changed = false;
+    bool output_queries_changed = false;
+    bool output_settings_changed = false;
+    // The signal IDs of the catalog may have changed
+    bool signal_catalog_changed = false;
+    // Names of the changed settings that cannot be applied without a restart
+    std::vector<std::string> restart_required;
+
+    static ModelConfigDiff compute(const ModelConfig& previous, const ModelConfig& current);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] bool hasReasonerChanges() const;
+};
+
+std::ostream& operator<<(std::ostream& os, const ModelConfigDiff& diff);
+
+#endif  // MODEL_CONFIG_DIFF_H
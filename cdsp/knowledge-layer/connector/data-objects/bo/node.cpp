@@ -5,13 +5,18 @@
  * @brief Constructs a new Node object.
  *
  * @param name The name of the node. Must not be empty.
- * @param value The optional value associated with the node.
+ * @param value The optional typed value associated with the node.
  * @param metadata The metadata associated with the node.
+ * @param signal_id The ID of the signal in the signal catalog, or UNKNOWN_SIGNAL.
  *
  * @throws std::invalid_argument if the name is empty.
  */
-Node::Node(std::string name, std::optional<std::string> value, Metadata metadata)
-    : name_(std::move(name)), value_(std::move(value)), metadata_(std::move(metadata)) {
+Node::Node(std::string name, std::optional<NodeValue> value, Metadata metadata,
+           SignalId signal_id)
+    : name_(std::move(name)),
+      value_(std::move(value)),
+      metadata_(std::move(metadata)),
+      signal_id_(signal_id) {
     if (name_.empty()) {
         throw std::invalid_argument("Node name cannot be empty");
     }
@@ -22,19 +27,47 @@ Node::Node(std::string name, std::optional<std::string> value, Metadata metadata
  *
  * @return A string representing the name of the node.
  */
-std::string Node::getName() const { return name_; }
+const std::string &Node::getName() const & { return name_; }
+
+/**
+ * @brief Releases the name of an expiring node.
+ *
+ * @return The name, moved out of the node.
+ */
+std::string Node::getName() && { return std::move(name_); }
 
 /**
  * @brief Retrieves the value stored in the node.
  *
- * @return std::optional<std::string> An optional containing the value if it
+ * @return std::optional<NodeValue> An optional containing the typed value if it
  * exists,
  */
-std::optional<std::string> Node::getValue() const { return value_; }
+const std::optional<NodeValue> &Node::getValue() const & { return value_; }
+
+/**
+ * @brief Releases the value of an expiring node.
+ *
+ * @return The value, moved out of the node.
+ */
+std::optional<NodeValue> Node::getValue() && { return std::move(value_); }
 
 /**
  * @brief Retrieves the metadata associated with the node.
  *
  * @return Metadata The metadata object associated with the node.
  */
-Metadata Node::getMetadata() const { return metadata_; }
+const Metadata &Node::getMetadata() const & { return metadata_; }
+
+/**
+ * @brief Releases the metadata of an expiring node.
+ *
+ * @return The metadata, moved out of the node.
+ */
+Metadata Node::getMetadata() && { return std::move(metadata_); }
+
+/**
+ * @brief Retrieves the catalog ID of the signal the node belongs to.
+ *
+ * @return The signal ID, or SignalCatalog::UNKNOWN_SIGNAL if the node name is not in the catalog.
+ */
+SignalId Node::getSignalId() const { return signal_id_; }
@@ -5,19 +5,27 @@
 #include <string>
 
 #include "metadata.h"
+#include "node_value.h"
+#include "signal_catalog.h"
 
 class Node {
    public:
-    Node(std::string name, std::optional<std::string> value, Metadata metadata);
+    Node(std::string name, std::optional<NodeValue> value, Metadata metadata,
+         SignalId signal_id = SignalCatalog::UNKNOWN_SIGNAL);
 
-    [[nodiscard]] std::string getName() const;
-    [[nodiscard]] std::optional<std::string> getValue() const;
-    [[nodiscard]] Metadata getMetadata() const;
+    [[nodiscard]] const std::string &getName() const &;
+    [[nodiscard]] std::string getName() &&;
+    [[nodiscard]] const std::optional<NodeValue> &getValue() const &;
+    [[nodiscard]] std::optional<NodeValue> getValue() &&;
+    [[nodiscard]] const Metadata &getMetadata() const &;
+    [[nodiscard]] Metadata getMetadata() &&;
+    [[nodiscard]] SignalId getSignalId() const;
 
    private:
     std::string name_;
-    std::optional<std::string> value_;
+    std::optional<NodeValue> value_;
     Metadata metadata_;
+    SignalId signal_id_;
 };
 
 #endif  // NODE_H
\ No newline at end of file
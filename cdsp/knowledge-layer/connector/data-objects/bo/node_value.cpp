@@ -0,0 +1,160 @@
+#include "node_value.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "xsd_datatype.h"
+
+namespace {
+
+std::string formatInteger(std::int64_t value) {
+    std::array<char, std::numeric_limits<std::int64_t>::digits10 + 3> buffer{};
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    return std::string(buffer.data(), result.ptr);
+}
+
+/**
+ * @brief Formats a double in fixed notation, as needed by xsd:decimal.
+ *
+ * @return The formatted value, or std::nullopt if it is not finite or too small for the buffer.
+ */
+std::optional<std::string> formatFixed(double value) {
+    if (!std::isfinite(value)) {
+        return std::nullopt;
+    }
+    // Fixed notation of the largest doubles needs more than 300 digits
+    std::array<char, std::numeric_limits<double>::max_exponent10 + 32> buffer{};
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value,
+                                      std::chars_format::fixed);
+    if (result.ec != std::errc()) {
+        return std::nullopt;
+    }
+    return std::string(buffer.data(), result.ptr);
+}
+
+bool isInt64(double value) {
+    constexpr double LIMIT = 9223372036854775808.0;  // 2^63
+    return std::trunc(value) == value && value >= -LIMIT && value < LIMIT;
+}
+
+}  // namespace
+
+/**
+ * @brief Formats a node value without datatype information.
+ *
+ * Booleans become "true" or "false", numbers use the shortest representation that reads back to
+ * the same value, and strings are returned as they are.
+ *
+ * @param value The value to format.
+ * @return The string representation of the value.
+ */
+std::string NodeValueFormatter::toString(const NodeValue& value) {
+    if (const auto* boolean = std::get_if<bool>(&value)) {
+        return *boolean ? "true" : "false";
+    }
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        return formatInteger(*integer);
+    }
+    if (const auto* floating = std::get_if<double>(&value)) {
+        return formatDouble(*floating);
+    }
+    return std::get<std::string>(value);
+}
+
+/**
+ * @brief Formats a node value as the lexical form of an RDF literal of the given datatype.
+ *
+ * The datatype is the XSD datatype from the SHACL shapes, as local name ("float"), prefixed name
+ * ("xsd:float") or full IRI. Numbers are written in the form the datatype allows, e.g. integral
+ * doubles of an xsd:int without fraction, and doubles of an xsd:decimal without exponent.
+ * Booleans of numeric datatypes become 1 or 0, numbers of xsd:boolean become true unless they are
+ * zero. String values and unknown datatypes are formatted with toString.
+ *
+ * @param value The value to format.
+ * @param datatype The datatype of the literal.
+ * @return The lexical form of the literal.
+ */
+std::string NodeValueFormatter::toLiteral(const NodeValue& value, std::string_view datatype) {
+    const XsdDatatypeKind kind = XsdDatatype::getKind(datatype);
+    if (kind == XsdDatatypeKind::OTHER || std::holds_alternative<std::string>(value)) {
+        return toString(value);
+    }
+
+    if (const auto* boolean = std::get_if<bool>(&value)) {
+        if (kind == XsdDatatypeKind::BOOLEAN) {
+            return *boolean ? "true" : "false";
+        }
+        return *boolean ? "1" : "0";
+    }
+
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        if (kind == XsdDatatypeKind::BOOLEAN) {
+            return *integer != 0 ? "true" : "false";
+        }
+        return formatInteger(*integer);
+    }
+
+    const double floating = std::get<double>(value);
+    switch (kind) {
+        case XsdDatatypeKind::BOOLEAN:
+            return floating != 0.0 ? "true" : "false";
+        case XsdDatatypeKind::INTEGER:
+            // Keep fractions rather than truncating, the reasoner reports the invalid literal
+            return isInt64(floating) ? formatInteger(static_cast<std::int64_t>(floating))
+                                     : formatDouble(floating);
+        case XsdDatatypeKind::DECIMAL:
+            if (auto fixed = formatFixed(floating)) {
+                return *std::move(fixed);
+            }
+            return formatDouble(floating);
+        default:
+            return formatDouble(floating);
+    }
+}
+
+/**
+ * @brief Formats a double with the shortest representation that reads back to the same value.
+ *
+ * Infinity and NaN are written as in XSD ("INF", "-INF", "NaN").
+ *
+ * @param value The value to format.
+ * @return The string representation of the value.
+ */
+std::string NodeValueFormatter::formatDouble(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "INF" : "-INF";
+    }
+    std::array<char, 32> buffer{};
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    return std::string(buffer.data(), result.ptr);
+}
+
+/**
+ * @brief Reads a node value as a number.
+ *
+ * @param value The value to read. Strings are parsed and must contain only the number.
+ * @return The numeric value, or std::nullopt if the value is a boolean or not a number.
+ */
+std::optional<double> NodeValueFormatter::toDouble(const NodeValue& value) {
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        return static_cast<double>(*integer);
+    }
+    if (const auto* floating = std::get_if<double>(&value)) {
+        return *floating;
+    }
+    if (const auto* text = std::get_if<std::string>(&value)) {
+        double number = 0.0;
+        const char* end = text->data() + text->size();
+        const auto result = std::from_chars(text->data(), end, number);
+        if (!text->empty() && result.ec == std::errc() && result.ptr == end) {
+            return number;
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,26 @@
+#ifndef NODE_VALUE_H
+#define NODE_VALUE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+
+/**
+ * @brief Typed value of a node, as parsed from the incoming message.
+ *
+ * Values keep their type until they are serialized, so numbers are not formatted and parsed
+ * again on their way through the pipeline.
+ */
+using NodeValue = std::variant<bool, std::int64_t, double, std::string>;
+
+class NodeValueFormatter {
+   public:
+    static std::string toString(const NodeValue& value);
+    static std::string toLiteral(const NodeValue& value, std::string_view datatype);
+    static std::string formatDouble(double value);
+    static std::optional<double> toDouble(const NodeValue& value);
+};
+
+#endif  // NODE_VALUE_H
@@ -0,0 +1,494 @@
+#include "query_dependency_graph.h"
+
+#include <cctype>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+enum class TokenKind {
+    TERM,       // IRI, prefixed name or keyword
+    VARIABLE,   // ?name or $name
+    IMPLIES,    // :- between the head and the body of a rule
+    END,        // . at the end of a statement
+    OPEN,       // { ( or [ on its own, e.g. a triple atom [?s, ?p, ?o]
+    ARGUMENTS,  // [ right after a name, opening the arguments of an atom like car:speed[?x, ?v]
+    CLOSE,      // } ) or ]
+    COMMA,
+    SEMICOLON,
+};
+
+struct Token {
+    TokenKind kind;
+    std::string_view text;
+};
+
+bool isNameCharacter(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_' || c == '-' || c == ':' ||
+           c == '.' || c == '@' || c == '%';
+}
+
+/**
+ * @brief Splits Datalog rules or a SPARQL query into the tokens that matter for the dependencies:
+ * IRIs, prefixed names and keywords, variables, `:-`, the `.` ending a statement and the
+ * brackets and separators of atoms and graph patterns. Literals, comments and operators are
+ * dropped.
+ */
+std::vector<Token> tokenize(std::string_view text) {
+    std::vector<Token> tokens;
+    std::size_t position = 0;
+    while (position < text.size()) {
+        const char c = text[position];
+        if (c == '#') {
+            position = text.find('\n', position);
+        } else if (c == '<') {
+            // An IRI has no spaces, otherwise it is a comparison
+            const std::size_t end = text.find_first_of("> \t\r\n<", position + 1);
+            if (end != std::string_view::npos && text[end] == '>') {
+                tokens.push_back({TokenKind::TERM, text.substr(position, end - position + 1)});
+                position = end + 1;
+            } else {
+                position++;
+            }
+        } else if (c == '"' || c == '\'') {
+            std::size_t end = position + 1;
+            while (end < text.size() && text[end] != c) {
+                end += text[end] == '\\' ? 2 : 1;
+            }
+            position = end + 1;
+        } else if (c == '?' || c == '$') {
+            std::size_t end = position + 1;
+            while (end < text.size() && (std::isalnum(static_cast<unsigned char>(text[end])) != 0 ||
+                                         text[end] == '_')) {
+                end++;
+            }
+            // A lone ? is a property path modifier
+            if (end > position + 1) {
+                tokens.push_back({TokenKind::VARIABLE, text.substr(position, end - position)});
+            }
+            position = end;
+        } else if (c == '[' && position > 0 &&
+                   (isNameCharacter(text[position - 1]) || text[position - 1] == '>')) {
+            tokens.push_back({TokenKind::ARGUMENTS, text.substr(position, 1)});
+            position++;
+        } else if (c == '{' || c == '(' || c == '[') {
+            tokens.push_back({TokenKind::OPEN, text.substr(position, 1)});
+            position++;
+        } else if (c == '}' || c == ')' || c == ']') {
+            tokens.push_back({TokenKind::CLOSE, text.substr(position, 1)});
+            position++;
+        } else if (c == ',' || c == ';') {
+            tokens.push_back(
+                {c == ',' ? TokenKind::COMMA : TokenKind::SEMICOLON, text.substr(position, 1)});
+            position++;
+        } else if (c == ':' && position + 1 < text.size() && text[position + 1] == '-') {
+            tokens.push_back({TokenKind::IMPLIES, text.substr(position, 2)});
+            position += 2;
+        } else if (c == '.' && (position + 1 == text.size() ||
+                                std::isdigit(static_cast<unsigned char>(text[position + 1])) ==
+                                    0)) {
+            tokens.push_back({TokenKind::END, text.substr(position, 1)});
+            position++;
+        } else if (isNameCharacter(c)) {
+            std::size_t end = position;
+            while (end < text.size() && isNameCharacter(text[end])) {
+                end++;
+            }
+            // A trailing dot ends the statement
+            while (end > position + 1 && text[end - 1] == '.') {
+                end--;
+            }
+            tokens.push_back({TokenKind::TERM, text.substr(position, end - position)});
+            position = end;
+        } else {
+            position++;
+        }
+    }
+    return tokens;
+}
+
+bool isPrefixKeyword(std::string_view token) {
+    if (token == "@prefix") {
+        return true;
+    }
+    constexpr std::string_view PREFIX = "prefix";
+    if (token.size() != PREFIX.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < PREFIX.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(token[i])) != PREFIX[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The terms of a document with its prefixed names expanded to full IRIs.
+ */
+class TermReader {
+   public:
+    explicit TermReader(std::string_view text) : tokens_(tokenize(text)) {}
+
+    /**
+     * Calls `on_token` with every token and its text, the terms expanded. Prefix declarations are
+     * consumed.
+     */
+    template <typename Callback>
+    void read(Callback on_token) {
+        for (std::size_t i = 0; i < tokens_.size(); ++i) {
+            const Token& token = tokens_[i];
+            if (token.kind == TokenKind::TERM && isPrefixKeyword(token.text) &&
+                i + 2 < tokens_.size()) {
+                // prefix car: <http://example.ontology.com/car#>
+                const std::string_view prefix = tokens_[i + 1].text;
+                const std::string_view iri = tokens_[i + 2].text;
+                if (!prefix.empty() && prefix.back() == ':' && iri.size() >= 2 &&
+                    iri.front() == '<') {
+                    prefixes_[std::string(prefix.substr(0, prefix.size() - 1))] =
+                        std::string(iri.substr(1, iri.size() - 2));
+                }
+                i += 2;
+                if (i + 1 < tokens_.size() && tokens_[i + 1].kind == TokenKind::END) {
+                    i++;
+                }
+                continue;
+            }
+            on_token(token.kind,
+                     token.kind == TokenKind::TERM ? expand(token.text) : std::string(token.text));
+        }
+    }
+
+   private:
+    std::vector<Token> tokens_;
+    std::unordered_map<std::string, std::string> prefixes_;
+
+    [[nodiscard]] std::string expand(std::string_view term) const {
+        if (term.size() >= 2 && term.front() == '<') {
+            return std::string(term.substr(1, term.size() - 2));
+        }
+        const std::size_t colon = term.find(':');
+        if (colon != std::string_view::npos) {
+            const auto prefix = prefixes_.find(std::string(term.substr(0, colon)));
+            if (prefix != prefixes_.end()) {
+                return prefix->second + std::string(term.substr(colon + 1));
+            }
+        }
+        return std::string(term);
+    }
+};
+
+struct Rule {
+    std::vector<std::string> head;
+    std::vector<std::string> body;
+    // A triple atom like [?s, ?p, ?o] whose predicate is a variable
+    bool variable_head_predicate = false;
+    bool variable_body_predicate = false;
+};
+
+/**
+ * @brief Reads the rules of a Datalog document. Facts, i.e. statements without a body, are
+ * skipped.
+ */
+void readDatalogRules(std::string_view text, std::vector<Rule>& rules) {
+    Rule rule;
+    bool in_body = false;
+    // Index of the current argument of a triple atom [subject, predicate, object], -1 outside
+    int triple_argument = -1;
+    TermReader(text).read([&](TokenKind kind, const std::string& term) {
+        switch (kind) {
+            case TokenKind::IMPLIES:
+                in_body = true;
+                break;
+            case TokenKind::END:
+                if (in_body) {
+                    rules.push_back(std::move(rule));
+                }
+                rule = Rule();
+                in_body = false;
+                triple_argument = -1;
+                break;
+            case TokenKind::OPEN:
+                triple_argument = term == "[" ? 0 : triple_argument;
+                break;
+            case TokenKind::CLOSE:
+                triple_argument = term == "]" ? -1 : triple_argument;
+                break;
+            case TokenKind::COMMA:
+                triple_argument += triple_argument >= 0 ? 1 : 0;
+                break;
+            case TokenKind::VARIABLE:
+                if (triple_argument == 1) {
+                    (in_body ? rule.variable_body_predicate : rule.variable_head_predicate) = true;
+                }
+                break;
+            case TokenKind::TERM:
+                (in_body ? rule.body : rule.head).push_back(term);
+                break;
+            default:
+                break;
+        }
+    });
+}
+
+/**
+ * @brief Bare words in a SPARQL query that start something else than a triple pattern, e.g.
+ * FILTER or OPTIONAL. Prefixed names, numbers and `a` are not keywords.
+ */
+bool isKeyword(const std::string& term) {
+    return !term.empty() && std::isalpha(static_cast<unsigned char>(term.front())) != 0 &&
+           term.find(':') == std::string::npos && term != "a" && term != "true" &&
+           term != "false";
+}
+
+/**
+ * @brief Finds triple patterns with a variable predicate, e.g. `?s ?p ?o`, in a SPARQL query.
+ *
+ * Follows the position within the triple patterns of the group graph patterns, including the
+ * `;` and `[ ... ]` abbreviations. Expressions in parentheses are skipped. A variable that might
+ * be a predicate counts as one.
+ */
+class VariablePredicateFinder {
+   public:
+    void read(TokenKind kind, const std::string& text) {
+        if (position_ == Position::EXPRESSION && kind != TokenKind::OPEN &&
+            kind != TokenKind::CLOSE) {
+            return;
+        }
+        switch (kind) {
+            case TokenKind::OPEN:
+            case TokenKind::ARGUMENTS:
+                groups_.push_back({text, position_});
+                if (text == "{") {
+                    graph_patterns_++;
+                    position_ = Position::SUBJECT;
+                } else if (text == "(") {
+                    position_ = Position::EXPRESSION;
+                } else if (position_ != Position::EXPRESSION) {
+                    // Blank node property list
+                    position_ = Position::PREDICATE;
+                }
+                break;
+            case TokenKind::CLOSE:
+                close();
+                break;
+            case TokenKind::END:
+                position_ = graph_patterns_ > 0 ? Position::SUBJECT : Position::OTHER;
+                break;
+            case TokenKind::SEMICOLON:
+                if (position_ == Position::PREDICATE || position_ == Position::OBJECT) {
+                    position_ = Position::PREDICATE;
+                }
+                break;
+            case TokenKind::VARIABLE:
+                found_ = found_ || position_ == Position::PREDICATE;
+                position_ = afterTerm(position_);
+                break;
+            case TokenKind::TERM:
+                if (isKeyword(text) &&
+                    (position_ == Position::SUBJECT || position_ == Position::OBJECT)) {
+                    position_ = Position::OTHER;
+                } else {
+                    position_ = afterTerm(position_);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    [[nodiscard]] bool found() const { return found_; }
+
+   private:
+    enum class Position {
+        OTHER,       // Outside of a triple pattern, e.g. after FILTER or SELECT
+        SUBJECT,     // At the start of a triple pattern
+        PREDICATE,   // After the subject or a ;
+        OBJECT,      // After the predicate
+        EXPRESSION,  // In parentheses
+    };
+
+    struct Group {
+        std::string open;
+        Position outer;
+    };
+
+    Position position_ = Position::OTHER;
+    std::vector<Group> groups_;
+    // Open { brackets
+    std::size_t graph_patterns_ = 0;
+    bool found_ = false;
+
+    static Position afterTerm(Position position) {
+        if (position == Position::SUBJECT) {
+            return Position::PREDICATE;
+        }
+        return position == Position::PREDICATE ? Position::OBJECT : position;
+    }
+
+    void close() {
+        if (groups_.empty()) {
+            return;
+        }
+        const Group group = groups_.back();
+        groups_.pop_back();
+        if (group.open == "{") {
+            graph_patterns_--;
+        }
+        if (group.outer == Position::EXPRESSION) {
+            position_ = Position::EXPRESSION;
+        } else if (group.open == "{" || group.outer == Position::OTHER) {
+            // e.g. after OPTIONAL { ... } or FILTER(...)
+            position_ = graph_patterns_ > 0 ? Position::SUBJECT : Position::OTHER;
+        } else {
+            // A collection, path or blank node in place of a term
+            position_ = afterTerm(group.outer);
+        }
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief Analyzes which signals the output queries depend on.
+ *
+ * @param rules The reasoner rules.
+ * @param queries The reasoning output queries, in the order their index refers to.
+ * @param signal_catalog The signals, with the predicates the SHACL shapes map them to.
+ */
+QueryDependencyGraph::QueryDependencyGraph(
+    const std::vector<std::pair<RuleLanguageType, std::string>>& rules,
+    const std::vector<ReasoningOutputQuery>& queries, const SignalCatalog& signal_catalog) {
+    std::vector<Rule> datalog_rules;
+    for (const auto& [language, content] : rules) {
+        if (language == RuleLanguageType::DATALOG) {
+            readDatalogRules(content, datalog_rules);
+        }
+    }
+
+    std::unordered_map<std::string, std::vector<const Rule*>> rules_by_head;
+    // Rules that can derive any term, followed from every query
+    std::vector<const Rule*> generic_rules;
+    for (const auto& rule : datalog_rules) {
+        if (rule.variable_head_predicate) {
+            generic_rules.push_back(&rule);
+        }
+        for (const auto& term : rule.head) {
+            rules_by_head[term].push_back(&rule);
+        }
+    }
+
+    std::unordered_map<std::string, std::vector<SignalId>> signals_by_predicate;
+    std::vector<SignalId> unmapped_signals;
+    for (SignalId id = 0; id < signal_catalog.size(); ++id) {
+        if (signal_catalog.getPredicate(id).empty()) {
+            unmapped_signals.push_back(id);
+        } else {
+            signals_by_predicate[signal_catalog.getPredicate(id)].push_back(id);
+        }
+    }
+
+    queries_.reserve(queries.size());
+    for (const auto& query : queries) {
+        std::unordered_set<std::string> reached;
+        std::deque<std::string> pending;
+        VariablePredicateFinder finder;
+        TermReader(query.query).read([&](TokenKind kind, const std::string& term) {
+            finder.read(kind, term);
+            if (kind == TokenKind::TERM && reached.insert(term).second) {
+                pending.push_back(term);
+            }
+        });
+        // A variable predicate matches every signal predicate
+        bool variable_predicate = finder.found();
+
+        const auto follow = [&](const Rule& rule) {
+            variable_predicate = variable_predicate || rule.variable_body_predicate;
+            for (const auto& term : rule.body) {
+                if (reached.insert(term).second) {
+                    pending.push_back(term);
+                }
+            }
+        };
+        for (const Rule* rule : generic_rules) {
+            follow(*rule);
+        }
+
+        // Follow the rules that derive the terms reached so far
+        while (!pending.empty() && !variable_predicate) {
+            const auto deriving_rules = rules_by_head.find(pending.front());
+            pending.pop_front();
+            if (deriving_rules == rules_by_head.end()) {
+                continue;
+            }
+            for (const Rule* rule : deriving_rules->second) {
+                follow(*rule);
+            }
+        }
+
+        QueryInputs inputs;
+        if (variable_predicate) {
+            queries_.push_back(std::move(inputs));
+            continue;
+        }
+        inputs.is_input.assign(signal_catalog.size(), 0);
+        for (const auto& term : reached) {
+            const auto signals = signals_by_predicate.find(term);
+            if (signals == signals_by_predicate.end()) {
+                continue;
+            }
+            for (const SignalId id : signals->second) {
+                inputs.is_input[id] = 1;
+                inputs.all_signals = false;
+            }
+        }
+        if (!inputs.all_signals) {
+            // Nothing tells which queries read the signals that no shape maps to a predicate
+            for (const SignalId id : unmapped_signals) {
+                inputs.is_input[id] = 1;
+            }
+            for (SignalId id = 0; id < inputs.is_input.size(); ++id) {
+                if (inputs.is_input[id] != 0) {
+                    inputs.signals.push_back(id);
+                }
+            }
+        }
+        queries_.push_back(std::move(inputs));
+    }
+}
+
+/**
+ * @brief Checks whether a change of a signal can change the result of an output query.
+ *
+ * @param query_index The index of the query in the reasoning output queries.
+ * @param signal The ID of the signal. Signals that are not in the catalog, or that no shape maps
+ * to a predicate, are inputs of every query.
+ * @return true if the query has to run again.
+ */
+bool QueryDependencyGraph::dependsOn(std::size_t query_index, SignalId signal) const {
+    if (query_index >= queries_.size() || queries_[query_index].all_signals) {
+        return true;
+    }
+    const auto& is_input = queries_[query_index].is_input;
+    return signal >= is_input.size() || is_input[signal] != 0;
+}
+
+/**
+ * @brief Checks whether the analysis found no input signals for a query, so every signal is one.
+ */
+bool QueryDependencyGraph::dependsOnAllSignals(std::size_t query_index) const {
+    return query_index >= queries_.size() || queries_[query_index].all_signals;
+}
+
+/**
+ * @brief Retrieves the input signals of a query, empty if it depends on all signals.
+ *
+ * @throws std::out_of_range if the query index is out of range.
+ */
+const std::vector<SignalId>& QueryDependencyGraph::getInputSignals(std::size_t query_index) const {
+    return queries_.at(query_index).signals;
+}
+
+std::size_t QueryDependencyGraph::size() const { return queries_.size(); }
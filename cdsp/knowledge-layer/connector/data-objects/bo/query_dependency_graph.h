@@ -0,0 +1,51 @@
+#ifndef QUERY_DEPENDENCY_GRAPH_H
+#define QUERY_DEPENDENCY_GRAPH_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data_types.h"
+#include "signal_catalog.h"
+
+/**
+ * @brief Input signals of the reasoning output queries, found by static analysis of the rules and
+ * the queries.
+ *
+ * The Datalog rules are read as a graph from the terms (IRIs and prefixed names) of their heads to
+ * the terms of their bodies. Starting from the terms of an output query, the graph is followed
+ * through every rule that derives one of the terms. A signal is an input of the query if the
+ * predicate that the SHACL shapes map it to (see SignalCatalog::getPredicate) is one of the terms
+ * reached, e.g. `car:angle` in `sosa:observedProperty[?obs, car:angle]`.
+ *
+ * The analysis is conservative where it cannot tell: a query that reaches no signal predicate
+ * (e.g. one that only uses generic rules) or a variable predicate (e.g. `?s ?p ?o` in the query or
+ * `[?s, ?p, ?o]` in the body of a rule) depends on all signals. Rules with a variable predicate in
+ * their head can derive any term, so they are followed from every query. Signals that are not in
+ * the catalog, or that no shape maps to a predicate, are inputs of every query.
+ */
+class QueryDependencyGraph {
+   public:
+    QueryDependencyGraph() = default;
+    QueryDependencyGraph(const std::vector<std::pair<RuleLanguageType, std::string>>& rules,
+                         const std::vector<ReasoningOutputQuery>& queries,
+                         const SignalCatalog& signal_catalog);
+
+    [[nodiscard]] bool dependsOn(std::size_t query_index, SignalId signal) const;
+    [[nodiscard]] bool dependsOnAllSignals(std::size_t query_index) const;
+    [[nodiscard]] const std::vector<SignalId>& getInputSignals(std::size_t query_index) const;
+    [[nodiscard]] std::size_t size() const;
+
+   private:
+    struct QueryInputs {
+        bool all_signals = true;
+        // Indexed by signal ID
+        std::vector<char> is_input;
+        std::vector<SignalId> signals;
+    };
+
+    std::vector<QueryInputs> queries_;
+};
+
+#endif  // QUERY_DEPENDENCY_GRAPH_H
@@ -54,7 +54,7 @@ ReasonerSyntaxType ReasonerSettings::getOutputFormat() const { return output_for
  *
  * @return A vector of SchemaType representing the supported schema collections.
  */
-std::vector<SchemaType> ReasonerSettings::getSupportedSchemaCollections() const {
+const std::vector<SchemaType>& ReasonerSettings::getSupportedSchemaCollections() const {
     return supported_schema_collections_;
 }
 
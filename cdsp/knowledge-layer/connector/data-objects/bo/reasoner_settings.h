@@ -14,7 +14,7 @@ class ReasonerSettings {
                      const bool is_ai_reasoner_inference_results);
     InferenceEngineType getInferenceEngine() const;
     ReasonerSyntaxType getOutputFormat() const;
-    std::vector<SchemaType> getSupportedSchemaCollections() const;
+    const std::vector<SchemaType>& getSupportedSchemaCollections() const;
     bool isIsAiReasonerInferenceResults() const;
 
    private:
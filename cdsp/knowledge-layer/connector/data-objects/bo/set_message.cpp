@@ -6,8 +6,8 @@
  * @param header The MessageHeader object that contains the header information for the message.
  * @param nodes A vector of Node objects that represent the nodes associated with the message.
  */
-SetMessage::SetMessage(const MessageHeader& header, const std::vector<Node>& nodes)
-    : header_(header), nodes_(nodes) {}
+SetMessage::SetMessage(MessageHeader header, std::vector<Node> nodes)
+    : header_(std::move(header)), nodes_(std::move(nodes)) {}
 
 /**
  * @brief Retrieves the header of the SetMessage.
@@ -17,7 +17,7 @@ SetMessage::SetMessage(const MessageHeader& header, const std::vector<Node>& nod
  *
  * @return MessageHeader The header of the SetMessage.
  */
-MessageHeader SetMessage::getHeader() const { return header_; }
+const MessageHeader& SetMessage::getHeader() const { return header_; }
 
 /**
  * @brief Retrieves the list of nodes.
@@ -27,7 +27,14 @@ MessageHeader SetMessage::getHeader() const { return header_; }
  *
  * @return std::vector<Node> A vector of Node objects.
  */
-std::vector<Node> SetMessage::getNodes() const { return nodes_; }
+const std::vector<Node>& SetMessage::getNodes() const& { return nodes_; }
+
+/**
+ * @brief Releases the list of nodes of an expiring SetMessage.
+ *
+ * @return The nodes, moved out of the message.
+ */
+std::vector<Node> SetMessage::getNodes() && { return std::move(nodes_); }
 
 /**
  * @brief Overloads the << operator to print the SetMessage object.
@@ -49,7 +56,8 @@ std::ostream& operator<<(std::ostream& os, const SetMessage& message) {
     } else {
         os << "  Nodes: " << "\n";
         for (const auto& node : message.getNodes()) {
-            os << "    " << node.getName() << ": " << node.getValue().value_or("") << "\n";
+            os << "    " << node.getName() << ": "
+               << (node.getValue() ? NodeValueFormatter::toString(*node.getValue()) : "") << "\n";
         }
     }
     if (message.getNodes().empty()) {
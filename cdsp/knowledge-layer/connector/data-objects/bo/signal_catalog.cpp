@@ -0,0 +1,310 @@
+#include "signal_catalog.h"
+
+#include <serd/serd.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include "logger.h"
+
+namespace {
+constexpr char RDF_TYPE[] = "http://www.w3.org/1999/02/22-rdf-syntax-ns#type";
+constexpr char SH_NODE_SHAPE[] = "http://www.w3.org/ns/shacl#NodeShape";
+constexpr char SH_NAME[] = "http://www.w3.org/ns/shacl#name";
+constexpr char SH_NODE[] = "http://www.w3.org/ns/shacl#node";
+constexpr char SH_PATH[] = "http://www.w3.org/ns/shacl#path";
+constexpr char SH_PROPERTY[] = "http://www.w3.org/ns/shacl#property";
+
+struct ShapeProperty {
+    std::string name;
+    std::string node;
+    // Full IRI of the `sh:path`, empty if the path is not a single predicate
+    std::string path;
+};
+
+struct NodeShape {
+    std::string name;
+    std::vector<ShapeProperty> properties;
+};
+
+/**
+ * @brief Reads the statements of a Turtle document with serd and collects the names and the
+ * properties of its SHACL node shapes.
+ *
+ * Prefixed names, including the `a` shorthand, are expanded to full IRIs, so the shapes may use
+ * any prefix. Blank nodes are keyed as `_:<label>` and literals by their lexical form.
+ */
+class ShapeReader {
+   public:
+    ShapeReader() : env_(serd_env_new(nullptr)) {}
+    ShapeReader(const ShapeReader &) = delete;
+    ShapeReader &operator=(const ShapeReader &) = delete;
+    ~ShapeReader() { serd_env_free(env_); }
+
+    /**
+     * Reads the document. Statements after a syntax error are not read.
+     *
+     * @return The node shapes with a `sh:name`, by their subject.
+     */
+    std::map<std::string, NodeShape> read(std::string_view text) {
+        SerdReader *reader =
+            serd_reader_new(SERD_TURTLE, this, nullptr, onBase, onPrefix, onStatement, nullptr);
+        serd_reader_set_error_sink(reader, onError, this);
+        const std::string document(text);
+        const SerdStatus status =
+            serd_reader_read_string(reader, reinterpret_cast<const uint8_t *>(document.c_str()));
+        serd_reader_free(reader);
+        if (status != SERD_SUCCESS) {
+            LOG_WARN("The SHACL shapes could not be read completely, syntax error at line "
+                     << error_line_ << ". Signals of the remaining shapes are not cataloged.");
+        }
+
+        std::map<std::string, NodeShape> shapes;
+        for (const auto &[subject, objects] : statements_) {
+            if (!hasObject(objects, RDF_TYPE, SH_NODE_SHAPE)) {
+                continue;
+            }
+            NodeShape shape;
+            shape.name = getObject(objects, SH_NAME);
+            if (shape.name.empty()) {
+                continue;
+            }
+            for (const auto &[predicate, property_node] : objects) {
+                const auto property_objects = statements_.find(property_node);
+                if (predicate != SH_PROPERTY || property_objects == statements_.end()) {
+                    continue;
+                }
+                ShapeProperty property{getObject(property_objects->second, SH_NAME),
+                                       getObject(property_objects->second, SH_NODE),
+                                       getObject(property_objects->second, SH_PATH)};
+                if (!property.name.empty()) {
+                    if (property.path.rfind("_:", 0) == 0) {
+                        property.path.clear();  // A property path, e.g. a sequence
+                    }
+                    shape.properties.push_back(std::move(property));
+                }
+            }
+            shapes.emplace(subject, std::move(shape));
+        }
+        return shapes;
+    }
+
+   private:
+    using Objects = std::vector<std::pair<std::string, std::string>>;
+
+    SerdEnv *env_;
+    // Predicates and objects of each subject, in document order
+    std::map<std::string, Objects> statements_;
+    unsigned error_line_ = 0;
+
+    static bool hasObject(const Objects &objects, std::string_view predicate,
+                          std::string_view object) {
+        return std::find(objects.begin(), objects.end(),
+                         std::make_pair(std::string(predicate), std::string(object))) !=
+               objects.end();
+    }
+
+    static std::string getObject(const Objects &objects, std::string_view predicate) {
+        for (const auto &[object_predicate, object] : objects) {
+            if (object_predicate == predicate) {
+                return object;
+            }
+        }
+        return "";
+    }
+
+    /**
+     * Converts a node read by serd to the string it is keyed by: IRIs are expanded and blank
+     * nodes get the `_:` prefix.
+     */
+    [[nodiscard]] std::string toString(const SerdNode *node) const {
+        const std::string text(reinterpret_cast<const char *>(node->buf), node->n_bytes);
+        switch (node->type) {
+            case SERD_URI:
+            case SERD_CURIE: {
+                SerdNode expanded = serd_env_expand_node(env_, node);
+                if (expanded.buf == nullptr) {
+                    return text;  // A prefix that is not declared
+                }
+                std::string iri(reinterpret_cast<const char *>(expanded.buf), expanded.n_bytes);
+                serd_node_free(&expanded);
+                return iri;
+            }
+            case SERD_BLANK:
+                return "_:" + text;
+            default:
+                return text;
+        }
+    }
+
+    static SerdStatus onBase(void *handle, const SerdNode *uri) {
+        return serd_env_set_base_uri(static_cast<ShapeReader *>(handle)->env_, uri);
+    }
+
+    static SerdStatus onPrefix(void *handle, const SerdNode *name, const SerdNode *uri) {
+        return serd_env_set_prefix(static_cast<ShapeReader *>(handle)->env_, name, uri);
+    }
+
+    static SerdStatus onStatement(void *handle, SerdStatementFlags /*flags*/,
+                                  const SerdNode * /*graph*/, const SerdNode *subject,
+                                  const SerdNode *predicate, const SerdNode *object,
+                                  const SerdNode * /*object_datatype*/,
+                                  const SerdNode * /*object_lang*/) {
+        auto *reader = static_cast<ShapeReader *>(handle);
+        reader->statements_[reader->toString(subject)].emplace_back(reader->toString(predicate),
+                                                                    reader->toString(object));
+        return SERD_SUCCESS;
+    }
+
+    static SerdStatus onError(void *handle, const SerdError *error) {
+        static_cast<ShapeReader *>(handle)->error_line_ = error->line;
+        return SERD_SUCCESS;
+    }
+};
+
+std::vector<std::string> splitPath(std::string_view path) {
+    std::vector<std::string> segments;
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t end = path.find('.', start);
+        segments.emplace_back(path.substr(start, end - start));
+        if (end == std::string_view::npos) {
+            return segments;
+        }
+        start = end + 1;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Copies a catalog, rebuilding the index on the paths of the copy.
+ */
+SignalCatalog::SignalCatalog(const SignalCatalog &other) : signals_(other.signals_) {
+    ids_.reserve(signals_.size());
+    for (SignalId id = 0; id < signals_.size(); ++id) {
+        ids_.emplace(signals_[id].path, id);
+    }
+}
+
+SignalCatalog &SignalCatalog::operator=(SignalCatalog other) noexcept {
+    std::swap(signals_, other.signals_);
+    std::swap(ids_, other.ids_);
+    return *this;
+}
+
+/**
+ * @brief Adds a signal to the catalog.
+ *
+ * @param path The full VSS path of the signal, including the schema (e.g. "Vehicle.Speed").
+ * @return The ID of the signal. If the path is already in the catalog, its existing ID.
+ * @throws std::invalid_argument if the path is empty.
+ */
+SignalId SignalCatalog::addSignal(std::string_view path) {
+    if (path.empty()) {
+        throw std::invalid_argument("Signal path cannot be empty");
+    }
+    if (const auto found = ids_.find(path); found != ids_.end()) {
+        return found->second;
+    }
+    const auto id = static_cast<SignalId>(signals_.size());
+    signals_.push_back({std::string(path), splitPath(path), std::string()});
+    ids_.emplace(signals_.back().path, id);
+    return id;
+}
+
+/**
+ * @brief Adds the leaf signals described by SHACL node shapes in Turtle syntax.
+ *
+ * Starting from the node shapes whose `sh:name` is one of the root names (e.g. "Vehicle"), the
+ * `sh:property` entries are followed through their `sh:node` shapes. Every property without
+ * `sh:node` is a signal, whose path is made of the `sh:name` of the shapes and properties on the
+ * way, e.g. "Vehicle.CurrentLocation.Latitude". The `sh:path` of the property becomes the predicate
+ * of the signal.
+ *
+ * @param shapes The SHACL shapes in Turtle syntax.
+ * @param root_names The names of the root shapes, one per schema.
+ * @return The number of signals that were not already in the catalog.
+ */
+std::size_t SignalCatalog::addSignalsFromShapes(std::string_view shapes,
+                                                const std::vector<std::string> &root_names) {
+    ShapeReader reader;
+    const auto node_shapes = reader.read(shapes);
+    const std::size_t size_before = signals_.size();
+
+    std::unordered_set<std::string> visiting;
+    std::function<void(const NodeShape &, const std::string &)> add_shape =
+        [&](const NodeShape &shape, const std::string &prefix) {
+            for (const auto &property : shape.properties) {
+                const std::string path = prefix + "." + property.name;
+                if (property.node.empty()) {
+                    const SignalId id = addSignal(path);
+                    if (!property.path.empty()) {
+                        signals_[id].predicate = property.path;
+                    }
+                    continue;
+                }
+                const auto child = node_shapes.find(property.node);
+                // Nested shapes that are missing or recursive do not describe signals
+                if (child != node_shapes.end() && visiting.insert(property.node).second) {
+                    add_shape(child->second, path);
+                    visiting.erase(property.node);
+                }
+            }
+        };
+
+    for (const auto &[subject, shape] : node_shapes) {
+        for (const auto &root_name : root_names) {
+            if (shape.name == root_name) {
+                visiting.insert(subject);
+                add_shape(shape, root_name);
+                visiting.erase(subject);
+            }
+        }
+    }
+    return signals_.size() - size_before;
+}
+
+/**
+ * @brief Looks up the ID of a signal.
+ *
+ * @param path The full VSS path of the signal.
+ * @return The ID of the signal, or UNKNOWN_SIGNAL if it is not in the catalog.
+ */
+SignalId SignalCatalog::find(std::string_view path) const {
+    const auto found = ids_.find(path);
+    return found != ids_.end() ? found->second : UNKNOWN_SIGNAL;
+}
+
+/**
+ * @brief Retrieves the full VSS path of a signal.
+ *
+ * @throws std::out_of_range if the ID is not in the catalog.
+ */
+const std::string &SignalCatalog::getPath(SignalId id) const { return signals_.at(id).path; }
+
+/**
+ * @brief Retrieves the dot-separated segments of the path of a signal.
+ *
+ * @throws std::out_of_range if the ID is not in the catalog.
+ */
+const std::vector<std::string> &SignalCatalog::getSegments(SignalId id) const {
+    return signals_.at(id).segments;
+}
+
+/**
+ * @brief Retrieves the predicate that the SHACL shapes map a signal to, e.g.
+ * "http://example.ontology.com/car#speed" for "Vehicle.Speed".
+ *
+ * @return The full IRI of the predicate, empty if no shape describes the signal.
+ * @throws std::out_of_range if the ID is not in the catalog.
+ */
+const std::string &SignalCatalog::getPredicate(SignalId id) const {
+    return signals_.at(id).predicate;
+}
+
+std::size_t SignalCatalog::size() const { return signals_.size(); }
@@ -0,0 +1,56 @@
+#ifndef SIGNAL_CATALOG_H
+#define SIGNAL_CATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using SignalId = std::uint32_t;
+
+/**
+ * @brief Catalog of the known VSS signals (e.g. "Vehicle.CurrentLocation.Latitude").
+ *
+ * Each signal gets a dense integer ID, assigned in insertion order, so per-signal state can be
+ * kept in arrays indexed by ID. The catalog also keeps the dot-separated segments of every path,
+ * so they do not have to be split again for every node. It is filled once when the model
+ * configuration is built and only read afterwards.
+ */
+class SignalCatalog {
+   public:
+    static constexpr SignalId UNKNOWN_SIGNAL = std::numeric_limits<SignalId>::max();
+
+    SignalCatalog() = default;
+    SignalCatalog(const SignalCatalog &other);
+    SignalCatalog(SignalCatalog &&other) noexcept = default;
+    SignalCatalog &operator=(SignalCatalog other) noexcept;
+    ~SignalCatalog() = default;
+
+    SignalId addSignal(std::string_view path);
+    std::size_t addSignalsFromShapes(std::string_view shapes,
+                                     const std::vector<std::string> &root_names);
+
+    [[nodiscard]] SignalId find(std::string_view path) const;
+    [[nodiscard]] const std::string &getPath(SignalId id) const;
+    [[nodiscard]] const std::vector<std::string> &getSegments(SignalId id) const;
+    [[nodiscard]] const std::string &getPredicate(SignalId id) const;
+    [[nodiscard]] std::size_t size() const;
+
+   private:
+    struct Signal {
+        std::string path;
+        std::vector<std::string> segments;
+        // Full IRI of the `sh:path` of the signal's property shape, if any
+        std::string predicate;
+    };
+
+    // A deque keeps the paths in place, so the index can view them
+    std::deque<Signal> signals_;
+    std::unordered_map<std::string_view, SignalId> ids_;
+};
+
+#endif  // SIGNAL_CATALOG_H
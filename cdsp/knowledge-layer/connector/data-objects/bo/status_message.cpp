@@ -26,7 +26,7 @@ int StatusMessage::getIdentifier() const { return id_; }
  *
  * @return An optional Error object.
  */
-std::optional<Error> StatusMessage::getError() const { return error_; }
+const std::optional<Error>& StatusMessage::getError() const { return error_; }
 
 /**
  * @brief Overloads the << operator to print the StatusMessage object.
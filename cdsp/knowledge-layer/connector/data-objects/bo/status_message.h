@@ -11,7 +11,7 @@ class StatusMessage {
     StatusMessage(int identifier, std::optional<Error> error);
 
     [[nodiscard]] int getIdentifier() const;
-    [[nodiscard]] std::optional<Error> getError() const;
+    [[nodiscard]] const std::optional<Error>& getError() const;
     friend std::ostream& operator<<(std::ostream& os, const StatusMessage& message);
 
    private:
@@ -8,8 +8,8 @@
  *
  * @throws std::invalid_argument if the nodes vector is empty for subscribe messages.
  */
-SubscribeMessage::SubscribeMessage(const MessageHeader& header, const std::vector<Node>& nodes)
-    : header_(header), nodes_(nodes) {}
+SubscribeMessage::SubscribeMessage(MessageHeader header, std::vector<Node> nodes)
+    : header_(std::move(header)), nodes_(std::move(nodes)) {}
 /**
  * @brief Retrieves the header of the SubscribeMessage.
  *
@@ -19,7 +19,7 @@ SubscribeMessage::SubscribeMessage(const MessageHeader& header, const std::vecto
  *
  * @return MessageHeader The header of the SubscribeMessage.
  */
-MessageHeader SubscribeMessage::getHeader() const { return header_; }
+const MessageHeader& SubscribeMessage::getHeader() const { return header_; }
 
 /**
  * @brief Retrieves the list of nodes.
@@ -29,7 +29,14 @@ MessageHeader SubscribeMessage::getHeader() const { return header_; }
  *
  * @return std::vector<Node> A vector of Node objects.
  */
-std::vector<Node> SubscribeMessage::getNodes() const { return nodes_; }
+const std::vector<Node>& SubscribeMessage::getNodes() const& { return nodes_; }
+
+/**
+ * @brief Releases the list of nodes of an expiring SubscribeMessage.
+ *
+ * @return The nodes, moved out of the message.
+ */
+std::vector<Node> SubscribeMessage::getNodes() && { return std::move(nodes_); }
 
 /**
  * @brief Overloads the << operator to print the SubscribeMessage object.
@@ -6,10 +6,11 @@
 
 class SubscribeMessage {
    public:
-    SubscribeMessage(const MessageHeader& header, const std::vector<Node>& nodes);
+    SubscribeMessage(MessageHeader header, std::vector<Node> nodes);
 
-    MessageHeader getHeader() const;
-    std::vector<Node> getNodes() const;
+    [[nodiscard]] const MessageHeader& getHeader() const;
+    [[nodiscard]] const std::vector<Node>& getNodes() const&;
+    [[nodiscard]] std::vector<Node> getNodes() &&;
     friend std::ostream& operator<<(std::ostream& os, const SubscribeMessage& message);
 
    private:
@@ -34,19 +34,26 @@ class MockModelConfig : public ModelConfig {
               ReasonerSettings(InferenceEngineType::RDFOX, ReasonerSyntaxType::TURTLE,
                                {SchemaType::VEHICLE}, true)) {}
 
-    MOCK_METHOD((std::map<SchemaType, std::string>), getObjectId, (), (const, override));
-    MOCK_METHOD((std::map<SchemaType, SchemaInputList>), getInputs, (), (const, override));
-    MOCK_METHOD((std::vector<std::pair<ReasonerSyntaxType, std::string>>), getOntologies, (),
+    MOCK_METHOD((const std::map<SchemaType, std::string>&), getObjectId, (), (const, override));
+    MOCK_METHOD((const std::string&), getObjectId, (SchemaType), (const, override));
+    MOCK_METHOD((const std::map<SchemaType, SchemaInputList>&), getInputs, (),
                 (const, override));
-    MOCK_METHOD((std::string), getOutput, (), (const, override));
-    MOCK_METHOD((std::vector<std::pair<RuleLanguageType, std::string>>), getReasonerRules, (),
+    MOCK_METHOD((const SchemaInputList&), getInputs, (SchemaType), (const, override));
+    MOCK_METHOD((const std::vector<std::pair<ReasonerSyntaxType, std::string>>&), getOntologies,
+                (), (const, override));
+    MOCK_METHOD((const std::string&), getOutput, (), (const, override));
+    MOCK_METHOD((const std::string&), getReasoningOutputPath, (), (const, override));
+    MOCK_METHOD((const std::vector<std::pair<RuleLanguageType, std::string>>&), getReasonerRules,
+                (), (const, override));
+    MOCK_METHOD((const std::vector<std::pair<ReasonerSyntaxType, std::string>>&),
+                getValidationShapes, (), (const, override));
+    MOCK_METHOD((const TripleAssemblerHelper&), getQueriesTripleAssemblerHelper, (),
                 (const, override));
-    MOCK_METHOD((std::vector<std::pair<ReasonerSyntaxType, std::string>>), getValidationShapes, (),
+    MOCK_METHOD((const TripleAssemblerHelper::QueryPair&), getQueryPair, (SchemaType),
                 (const, override));
-    MOCK_METHOD((TripleAssemblerHelper), getQueriesTripleAssemblerHelper, (), (const, override));
-    MOCK_METHOD((std::vector<ReasoningOutputQuery>), getReasoningOutputQueries, (),
+    MOCK_METHOD((const std::vector<ReasoningOutputQuery>&), getReasoningOutputQueries, (),
                 (const, override));
-    MOCK_METHOD((ReasonerSettings), getReasonerSettings, (), (const, override));
+    MOCK_METHOD((const ReasonerSettings&), getReasonerSettings, (), (const, override));
 };
 
 #endif  // MOCK_MODEL_CONFIG_H
\ No newline at end of file
@@ -29,6 +29,7 @@ TripleAssemblerHelper::TripleAssemblerHelper(const std::map<SchemaType, QueryPai
  * @return A map of SchemaType to QueryPair objects. Each QueryPair object contains
  *                a data property and an object property to construct the triples.
  */
-std::map<SchemaType, TripleAssemblerHelper::QueryPair> TripleAssemblerHelper::getQueries() const {
+const std::map<SchemaType, TripleAssemblerHelper::QueryPair>& TripleAssemblerHelper::getQueries()
+    const {
     return queries_;
 }
\ No newline at end of file
@@ -12,9 +12,14 @@ class TripleAssemblerHelper {
     struct QueryPair {
         std::pair<QueryLanguageType, std::string> data_property;
         std::pair<QueryLanguageType, std::string> object_property;
+
+        bool operator==(const QueryPair& other) const {
+            return data_property == other.data_property &&
+                   object_property == other.object_property;
+        }
     };
     TripleAssemblerHelper(const std::map<SchemaType, QueryPair>& queries);
-    std::map<SchemaType, QueryPair> getQueries() const;
+    const std::map<SchemaType, QueryPair>& getQueries() const;
 
    private:
     std::map<SchemaType, QueryPair> queries_;
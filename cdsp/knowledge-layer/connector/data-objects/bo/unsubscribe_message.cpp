@@ -12,14 +12,21 @@ UnsubscribeMessage::UnsubscribeMessage(MessageHeader header, std::vector<Node> n
  *
  * @return MessageHeader The header of the unsubscribe message.
  */
-MessageHeader UnsubscribeMessage::getHeader() const { return header_; }
+const MessageHeader &UnsubscribeMessage::getHeader() const { return header_; }
 
 /**
  * @brief Retrieves the list of nodes associated with the UnsubscribeMessage.
  *
  * @return A vector containing Node objects.
  */
-std::vector<Node> UnsubscribeMessage::getNodes() const { return nodes_; }
+const std::vector<Node> &UnsubscribeMessage::getNodes() const & { return nodes_; }
+
+/**
+ * @brief Releases the list of nodes of an expiring UnsubscribeMessage.
+ *
+ * @return The nodes, moved out of the message.
+ */
+std::vector<Node> UnsubscribeMessage::getNodes() && { return std::move(nodes_); }
 
 /**
  * Overloads the insertion (<<) operator for the UnsubscribeMessage class.
@@ -8,8 +8,9 @@ class UnsubscribeMessage {
    public:
     UnsubscribeMessage(MessageHeader header, std::vector<Node> nodes);
 
-    [[nodiscard]] MessageHeader getHeader() const;
-    [[nodiscard]] std::vector<Node> getNodes() const;
+    [[nodiscard]] const MessageHeader &getHeader() const;
+    [[nodiscard]] const std::vector<Node> &getNodes() const &;
+    [[nodiscard]] std::vector<Node> getNodes() &&;
     friend std::ostream &operator<<(std::ostream &out_stream, const UnsubscribeMessage &message);
 
    private:
@@ -1,11 +1,14 @@
 #include "json_writer.h"
 
-#include <iostream>
-#include <sstream>
+#include <algorithm>
+#include <string_view>
 
-#include "file_handler_impl.h"
 #include "helper.h"
+#include "logger.h"
 #include "pugixml.hpp"
+#include "sparql_json_result_parser.h"
+#include "sparql_term_converter.h"
+#include "tabular_result_reader.h"
 
 /**
  * Writes the query result to a JSON object and optionally stores it in a file.
@@ -20,29 +23,77 @@
  * @param result_format_type The format of the query result.
  * @param is_ai_reasoner_inference_results A boolean indicating whether the
  * reasoning results are inferred.
- * @param output_file_path An optional file path to store the JSON object.
- * @param file_handler An optional file handler to use for writing the JSON
- * object to a file.
+ * @param output_file_path An optional directory to store the JSON object in.
+ * @param output_sink The output sink writing the JSON object to the files of
+ * the output directory. Nothing is stored if it is not provided.
+ * @param resource The memory resource for the scratch data of the parsing, e.g.
+ * the arena of the message being processed.
  * @return A JSON object containing the query result data and metadata.
  * @throws std::runtime_error If the query result format is not supported.
+ *
+ * @note SPARQL JSON results are grouped while they are parsed, the other formats are parsed
+ * into flat rows first.
  */
 nlohmann::json JSONWriter::writeToJson(const std::string &query_result,
                                        const DataQueryAcceptType &result_format_type,
                                        bool is_ai_reasoner_inference_results,
                                        std::optional<std::string> output_file_path,
-                                       const std::shared_ptr<IFileHandler> &file_handler) {
-    nlohmann::json flat_result = parseQueryResult(query_result, result_format_type);
-    nlohmann::json grouped_result = groupResult(flat_result, is_ai_reasoner_inference_results);
+                                       const std::shared_ptr<IOutputSink> &output_sink,
+                                       std::pmr::memory_resource *resource) {
+    nlohmann::json grouped_result;
+    if (result_format_type == DataQueryAcceptType::SPARQL_JSON) {
+        grouped_result = SparqlJsonResultParser::parse(query_result,
+                                                       is_ai_reasoner_inference_results, resource);
+    } else {
+        nlohmann::json flat_result = parseQueryResult(query_result, result_format_type, resource);
+        grouped_result = groupResult(flat_result, is_ai_reasoner_inference_results);
+    }
 
     if (!grouped_result.empty()) {
-        if (output_file_path.has_value() && !output_file_path->empty()) {
-            storeJsonToFile(grouped_result, *output_file_path, file_handler);
+        if (output_sink && output_file_path.has_value() && !output_file_path->empty()) {
+            storeJsonToFile(grouped_result, *output_file_path, *output_sink);
         }
         return grouped_result;
     }
     return nlohmann::json::object();  // Return an empty JSON object if no results
 }
 
+/**
+ * @brief Writes a SPARQL JSON query result to JSON objects, one per value of a variable.
+ *
+ * The rows are grouped like in writeToJson() and split by the value of the partition variable,
+ * e.g. the vehicle instance of a fleet query, which is not written into the rows. Each
+ * non-empty partition is stored like a result of its own.
+ *
+ * @param query_result A string containing the SPARQL JSON result of a query.
+ * @param partition_variable The variable that selects the partition of a row, without the `?`.
+ * @param is_ai_reasoner_inference_results A boolean indicating whether the reasoning results are
+ * inferred.
+ * @param output_file_path An optional directory to store the JSON objects in.
+ * @param output_sink The output sink writing the JSON objects to the files of the output
+ * directory. Nothing is stored if it is not provided.
+ * @param resource The memory resource for the scratch data of the parsing.
+ * @return The JSON array of the grouped rows of each partition, by the value of the variable.
+ * Rows in which the variable is unbound are under the empty key.
+ * @throws std::runtime_error If the query result cannot be parsed.
+ */
+std::map<std::string, nlohmann::json> JSONWriter::writeToJsonPartitioned(
+    const std::string &query_result, const std::string &partition_variable,
+    bool is_ai_reasoner_inference_results, std::optional<std::string> output_file_path,
+    const std::shared_ptr<IOutputSink> &output_sink, std::pmr::memory_resource *resource) {
+    std::map<std::string, nlohmann::json> partitions = SparqlJsonResultParser::parsePartitioned(
+        query_result, partition_variable, is_ai_reasoner_inference_results, resource);
+
+    if (output_sink && output_file_path.has_value() && !output_file_path->empty()) {
+        for (const auto &[partition, grouped_result] : partitions) {
+            if (!grouped_result.empty()) {
+                storeJsonToFile(grouped_result, *output_file_path, *output_sink);
+            }
+        }
+    }
+    return partitions;
+}
+
 /**
  * @brief Parses a query result string into a JSON object based on the specified
  * result format type.
@@ -56,29 +107,26 @@ nlohmann::json JSONWriter::writeToJson(const std::string &query_result,
  * types are:
  *        - DataQueryAcceptType::TEXT_CSV: Parses the result as a CSV table.
  *        - DataQueryAcceptType::TEXT_TSV: Parses the result as a TSV table.
- *        - DataQueryAcceptType::SPARQL_JSON: Parses the result as SPARQL JSON.
  *        - DataQueryAcceptType::SPARQL_XML: Parses the result as SPARQL XML.
+ * @param resource The memory resource for the scratch data of the parsing.
  *
  * @return nlohmann::json The parsed query result as a JSON object.
  *
  * @throws std::runtime_error If the result format type is unsupported.
  */
 nlohmann::json JSONWriter::parseQueryResult(const std::string &query_result,
-                                            const DataQueryAcceptType &result_format_type) {
+                                            const DataQueryAcceptType &result_format_type,
+                                            std::pmr::memory_resource *resource) {
     if (result_format_type == DataQueryAcceptType::TEXT_CSV) {
-        return parseTableFormat(query_result, ',');
+        return parseTableFormat(query_result, ',', resource);
     }
 
     if (result_format_type == DataQueryAcceptType::TEXT_TSV) {
-        return parseTableFormat(query_result, '\t');
-    }
-
-    if (result_format_type == DataQueryAcceptType::SPARQL_JSON) {
-        return parseSparqlJson(query_result);
+        return parseTableFormat(query_result, '\t', resource);
     }
 
     if (result_format_type == DataQueryAcceptType::SPARQL_XML) {
-        return parseSparqlXml(query_result);
+        return parseSparqlXml(query_result, resource);
     }
 
     throw std::runtime_error("Unsupported query result format");
@@ -152,8 +200,7 @@ nlohmann::json JSONWriter::groupItem(const nlohmann::json &item,
                 grouped[schema][flat_data_point] = value;
             }
         } else {
-            std::cerr << "Warning parsing reasoning query to JSON - No schema found for key: "
-                      << key << std::endl;
+            LOG_WARN("Warning parsing reasoning query to JSON - No schema found for key: " << key);
         }
     }
 
@@ -194,54 +241,46 @@ void JSONWriter::handleAIReasonerInferenceResults(nlohmann::json &grouped) {
  * parses it, and converts it into a JSON array format. Each row in the table is
  * represented as a JSON object within the array, where the keys are the column
  * headers from the first row of the table and the values are the corresponding
- * cell values. Underscores in header names are replaced with dots.
+ * cell values. Underscores in header names are replaced with dots. The tables
+ * carry no datatypes, so the type of each cell is detected from its text.
+ *
+ * The cells are read in place by the TabularResultReader. The cells of TSV
+ * results are RDF terms, so their literals are decoded and the '?' of the
+ * variables in the header is removed.
  *
  * @param query_result A string containing the table data to be parsed.
  * @param delimiter A character used to separate values in the table.
+ * @param resource The memory resource for the header names and the cells.
  * @return A string representing the JSON array of the parsed table rows,
  * formatted with an indentation of 2 spaces.
  */
-nlohmann::json JSONWriter::parseTableFormat(const std::string &query_result, char delimiter) {
+nlohmann::json JSONWriter::parseTableFormat(const std::string &query_result, char delimiter,
+                                            std::pmr::memory_resource *resource) {
     try {
-        std::stringstream str_stream(query_result);
-        std::string line;
-        std::vector<std::string> headers;
-        nlohmann::json json_array = nlohmann::json::array();
-
-        // Read headers from the first line
-        if (std::getline(str_stream, line)) {
-            std::stringstream header_stream(line);
-            std::string header;
-            while (std::getline(header_stream, header, delimiter)) {
-                header.erase(std::remove(header.begin(), header.end(), '\r'), header.end());
-                std::replace(header.begin(), header.end(), '_', '.');  // Convert _ to .
-                headers.push_back(header);
+        const bool is_tsv = delimiter == '\t';
+        TabularResultReader reader(query_result, delimiter, resource);
+        std::pmr::vector<std::string> headers(resource);
+        for (std::string_view header : reader.getHeader()) {
+            if (is_tsv && !header.empty() && header.front() == '?') {
+                header.remove_prefix(1);
             }
+            std::string &name = headers.emplace_back(header);
+            std::replace(name.begin(), name.end(), '_', '.');  // Convert _ to .
         }
 
-        // Process each row
-        while (std::getline(str_stream, line)) {
-            std::stringstream row_stream(line);
-            std::string value;
+        nlohmann::json json_array = nlohmann::json::array();
+        std::pmr::vector<std::string_view> cells(resource);
+        while (reader.nextRow(cells)) {
             nlohmann::json row_object;
-            size_t col_idx = 0;
-
-            while (std::getline(row_stream, value, delimiter)) {
-                value.erase(std::remove(value.begin(), value.end(), '\r'), value.end());
-                if (col_idx < headers.size()) {
-                    row_object[headers[col_idx]] = Helper::detectType(value);
-                }
-                col_idx++;
+            // Cells missing at the end of the row are empty
+            for (std::size_t col_idx = 0; col_idx < headers.size(); ++col_idx) {
+                const std::string_view cell =
+                    col_idx < cells.size() ? cells[col_idx] : std::string_view();
+                row_object[headers[col_idx]] =
+                    Helper::detectType(is_tsv ? TabularResultReader::decodeTerm(cell)
+                                              : std::string(cell));
             }
-
-            // Ensure all expected headers exist in the row
-            for (const auto &header : headers) {
-                if (!row_object.contains(header)) {
-                    row_object[header] = "";
-                }
-            }
-
-            json_array.push_back(row_object);
+            json_array.push_back(std::move(row_object));
         }
 
         return json_array;
@@ -250,51 +289,6 @@ nlohmann::json JSONWriter::parseTableFormat(const std::string &query_result, cha
     }
 }
 
-/**
- * Parses a SPARQL JSON result and converts it into a JSON array string.
- *
- * This function takes a JSON string representing the result of a SPARQL query,
- * parses it, and converts it into a JSON array format. Each SPARQL result is
- * represented as a JSON object within the array, where the keys are the
- * variable names from the SPARQL query and the values are the corresponding
- * result values. Underscores in variable names are replaced with dots.
- *
- * @param json_result A string containing the SPARQL JSON result to be parsed.
- * @return A string representing the JSON array of the parsed SPARQL results,
- * formatted with an indentation of 2 spaces.
- * @throws std::runtime_error If the JSON string does not contain the expected
- * SPARQL result format.
- */
-nlohmann::json JSONWriter::parseSparqlJson(const std::string &json_result) {
-    try {
-        nlohmann::json sparql_json = nlohmann::json::parse(json_result);
-        nlohmann::json json_array = nlohmann::json::array();
-
-        if (!sparql_json.contains("results") || !sparql_json["results"].contains("bindings")) {
-            throw std::runtime_error("Invalid SPARQL JSON response format");
-        }
-
-        for (const auto &binding : sparql_json["results"]["bindings"]) {
-            nlohmann::json row_object;
-
-            for (auto it = binding.begin(); it != binding.end(); ++it) {
-                std::string var_name = it.key();
-                std::string value = it.value()["value"].get<std::string>();
-
-                std::replace(var_name.begin(), var_name.end(), '_', '.');
-
-                row_object[var_name] = Helper::detectType(value);
-            }
-
-            json_array.push_back(row_object);
-        }
-
-        return json_array;
-    } catch (const nlohmann::json::exception &e) {
-        throw std::runtime_error("Failed to parse SPARQL JSON response: " + std::string(e.what()));
-    }
-}
-
 /**
  * Parses a SPARQL XML result and converts it into a JSON array string.
  *
@@ -302,14 +296,17 @@ nlohmann::json JSONWriter::parseSparqlJson(const std::string &json_result) {
  * parses it, and converts it into a JSON array format. Each SPARQL result is
  * represented as a JSON object within the array, where the keys are the
  * variable names from the SPARQL query and the values are the corresponding
- * result values. Underscores in variable names are replaced with dots.
+ * result values, converted by their datatype. Underscores in variable names are
+ * replaced with dots.
  *
  * @param xml_result A string containing the SPARQL XML result to be parsed.
+ * @param resource The memory resource for the variable names.
  * @return A string representing the JSON array of the parsed SPARQL results,
  * formatted with an indentation of 2 spaces.
  * @throws std::runtime_error If the XML string cannot be parsed.
  */
-nlohmann::json JSONWriter::parseSparqlXml(const std::string &xml_result) {
+nlohmann::json JSONWriter::parseSparqlXml(const std::string &xml_result,
+                                          std::pmr::memory_resource *resource) {
     try {
         pugi::xml_document doc;
         if (!doc.load_string(xml_result.c_str())) {
@@ -321,20 +318,17 @@ nlohmann::json JSONWriter::parseSparqlXml(const std::string &xml_result) {
         // Navigate to <results> node
         pugi::xml_node results_node = doc.child("sparql").child("results");
 
+        std::pmr::string name(resource);
         for (pugi::xml_node result : results_node.children("result")) {
             nlohmann::json row_object;
 
             for (pugi::xml_node binding_node : result.children("binding")) {
-                std::string name = binding_node.attribute("name").value();
-                std::string value;
-
-                // Handle any value type (literal, URI, etc.)
-                for (pugi::xml_node child : binding_node.children()) {
-                    value = child.child_value();
-                    break;
-                }
+                name.assign(binding_node.attribute("name").value());
+                // The term is the first child: <literal datatype="...">, <uri> or <bnode>
+                const pugi::xml_node term = binding_node.first_child();
                 std::replace(name.begin(), name.end(), '_', '.');
-                row_object[name] = Helper::detectType(value);
+                row_object[std::string(name)] = SparqlTermConverter::toJson(
+                    term.child_value(), term.name(), term.attribute("datatype").value());
             }
             json_array.push_back(row_object);
         }
@@ -346,40 +340,31 @@ nlohmann::json JSONWriter::parseSparqlXml(const std::string &xml_result) {
 }
 
 /**
- * @brief Stores a JSON object to a file at a specified path.
+ * @brief Queues a JSON object for the output files of a directory.
  *
- * This function ensures that the directory for the output file path exists,
- * creates a file name with a timestamp, and writes the JSON data to the file.
- * If a file handler is not provided, a default implementation is used.
+ * The JSON object is written compactly on a single line together with the current time, so the
+ * output files of the "reasoning" stream hold one result per line (JSON Lines). The output
+ * sink writes them in the background and may skip them if the stream is disabled or sampled.
  *
- * @param json_data The JSON object to be stored in the file.
- * @param output_file_path The path to the directory where the JSON file will be
- * stored. The function will create the directory if it does not exist.
- * @param file_handler An optional shared pointer to an IFileHandler
- * implementation. If not provided, a default FileHandlerImpl is used.
+ * @param json_data The JSON object to be stored.
+ * @param output_file_path The directory of the output files. It is created by the output sink
+ * if it does not exist.
+ * @param output_sink The output sink writing the files.
  */
 void JSONWriter::storeJsonToFile(const nlohmann::json &json_data,
-                                 const std::string &output_file_path,
-                                 const std::shared_ptr<IFileHandler> &file_handler) {
-    namespace fs = std::filesystem;
-
-    // Ensure the directory exists
-    if (!fs::exists(output_file_path)) {
-        std::cout << "Creating directory: " << output_file_path << std::endl << std::endl;
-        fs::create_directories(output_file_path);
+                                 const std::string &output_file_path, IOutputSink &output_sink) {
+    if (!output_sink.shouldWrite(OUTPUT_STREAM_NAME)) {
+        return;
     }
 
-    // Create file name
-    const std::string file_name = output_file_path + "gen_from_sparql_query_" +
-                                  Helper::getFormattedTimestampNow("%H:%M:%S", true, true) +
-                                  ".json";
+    // {"time":"...","result":...}, built around the dump to not copy the result
+    std::string line = "{\"time\":\"";
+    line.append(Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true))
+        .append("\",\"result\":")
+        .append(json_data.dump())
+        .append("}\n");
 
-    // Write the file
-    std::shared_ptr<IFileHandler> local_file_handler = file_handler;
-    if (!local_file_handler) {
-        local_file_handler = std::make_shared<FileHandlerImpl>();
-    }
-    local_file_handler->writeFile(file_name, json_data.dump(2), false);
-    std::cout << "A JSON SPARQL Output has been generated under: " << file_name << std::endl
-              << std::endl;
+    output_sink.write({OUTPUT_STREAM_NAME, output_file_path, "gen_from_sparql_query_", ".jsonl"},
+                      std::move(line));
+    LOG_DEBUG("A JSON SPARQL Output has been queued for the output under: " << output_file_path);
 }
\ No newline at end of file
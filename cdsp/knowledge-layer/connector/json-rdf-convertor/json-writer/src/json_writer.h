@@ -1,32 +1,45 @@
 #pragma once
 
+#include <map>
+#include <memory_resource>
 #include <optional>
 #include <string>
 
 #include "data_types.h"
-#include "i_file_handler.h"
+#include "i_output_sink.h"
 
 class JSONWriter {
    public:
+    static constexpr char OUTPUT_STREAM_NAME[] = "reasoning";
+
     static nlohmann::json writeToJson(const std::string &query_result,
                                       const DataQueryAcceptType &result_format_type,
                                       bool is_ai_reasoner_inference_results = false,
                                       std::optional<std::string> output_file_path = std::nullopt,
-                                      const std::shared_ptr<IFileHandler> &file_handler = nullptr);
+                                      const std::shared_ptr<IOutputSink> &output_sink = nullptr,
+                                      std::pmr::memory_resource *resource =
+                                          std::pmr::get_default_resource());
+    static std::map<std::string, nlohmann::json> writeToJsonPartitioned(
+        const std::string &query_result, const std::string &partition_variable,
+        bool is_ai_reasoner_inference_results = false,
+        std::optional<std::string> output_file_path = std::nullopt,
+        const std::shared_ptr<IOutputSink> &output_sink = nullptr,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
    private:
     static nlohmann::json parseQueryResult(const std::string &query_result,
-                                           const DataQueryAcceptType &result_format_type);
+                                           const DataQueryAcceptType &result_format_type,
+                                           std::pmr::memory_resource *resource);
     static nlohmann::json groupResult(const nlohmann::json &flat_result,
                                       bool is_ai_reasoner_inference_results);
     static nlohmann::json groupItem(const nlohmann::json &item,
                                     bool is_ai_reasoner_inference_results);
     static void handleAIReasonerInferenceResults(nlohmann::json &grouped);
-    static nlohmann::json parseTableFormat(const std::string &query_result, char delimiter);
-    static nlohmann::json parseSparqlJson(const std::string &json_result);
-    static nlohmann::json parseSparqlXml(const std::string &xml_result);
+    static nlohmann::json parseTableFormat(const std::string &query_result, char delimiter,
+                                           std::pmr::memory_resource *resource);
+    static nlohmann::json parseSparqlXml(const std::string &xml_result,
+                                         std::pmr::memory_resource *resource);
 
     static void storeJsonToFile(const nlohmann::json &json_data,
-                                const std::string &output_file_path,
-                                const std::shared_ptr<IFileHandler> &file_handler);
+                                const std::string &output_file_path, IOutputSink &output_sink);
 };
\ No newline at end of file
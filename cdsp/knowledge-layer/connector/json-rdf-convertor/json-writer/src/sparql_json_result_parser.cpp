@@ -0,0 +1,265 @@
+#include "sparql_json_result_parser.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "logger.h"
+#include "sparql_term_converter.h"
+
+/**
+ * @brief Parses a SPARQL JSON response in a single pass into the grouped JSON output.
+ *
+ * @param response The SPARQL JSON response.
+ * @param is_ai_reasoner_inference_results Whether the data points of each schema are nested and
+ * serialized under "AI.Reasoner.InferenceResults".
+ * @param resource The memory resource for the scratch data of the parsing, e.g. the arena of the
+ * message being processed.
+ * @return A JSON array with the grouped row of each binding.
+ * @throws std::runtime_error If the response is not valid JSON or has no `results.bindings`.
+ */
+nlohmann::json SparqlJsonResultParser::parse(std::string_view response,
+                                             bool is_ai_reasoner_inference_results,
+                                             std::pmr::memory_resource* resource) {
+    SparqlJsonResultParser parser(is_ai_reasoner_inference_results, resource);
+    try {
+        nlohmann::json::sax_parse(response.begin(), response.end(), &parser);
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Failed to parse SPARQL JSON response: " + std::string(e.what()));
+    }
+    if (!parser.has_bindings_) {
+        throw std::runtime_error("Invalid SPARQL JSON response format");
+    }
+    return std::move(parser.result_);
+}
+
+/**
+ * @brief Parses a SPARQL JSON response into the grouped JSON output, split by the value of a
+ * variable.
+ *
+ * @param response The SPARQL JSON response.
+ * @param partition_variable The variable that selects the partition of a row, without the `?`.
+ * Rows in which it is unbound go to the partition with the empty key.
+ * @param is_ai_reasoner_inference_results Whether the data points of each schema are nested and
+ * serialized under "AI.Reasoner.InferenceResults".
+ * @param resource The memory resource for the scratch data of the parsing.
+ * @return The JSON array with the grouped rows of each partition, by the value of the variable.
+ * @throws std::invalid_argument If the partition variable is empty.
+ * @throws std::runtime_error If the response is not valid JSON or has no `results.bindings`.
+ */
+std::map<std::string, nlohmann::json> SparqlJsonResultParser::parsePartitioned(
+    std::string_view response, std::string_view partition_variable,
+    bool is_ai_reasoner_inference_results, std::pmr::memory_resource* resource) {
+    if (partition_variable.empty()) {
+        throw std::invalid_argument("The partition variable of a SPARQL JSON result is empty");
+    }
+    SparqlJsonResultParser parser(is_ai_reasoner_inference_results, resource, partition_variable);
+    try {
+        nlohmann::json::sax_parse(response.begin(), response.end(), &parser);
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Failed to parse SPARQL JSON response: " + std::string(e.what()));
+    }
+    if (!parser.has_bindings_) {
+        throw std::runtime_error("Invalid SPARQL JSON response format");
+    }
+    return std::move(parser.partitions_);
+}
+
+SparqlJsonResultParser::SparqlJsonResultParser(bool is_ai_reasoner_inference_results,
+                                               std::pmr::memory_resource* resource,
+                                               std::string_view partition_variable)
+    : is_ai_reasoner_inference_results_(is_ai_reasoner_inference_results),
+      resource_(resource),
+      partition_variable_(partition_variable),
+      locations_(resource),
+      columns_(resource),
+      key_(resource),
+      value_(resource),
+      type_(resource),
+      datatype_(resource) {
+    locations_.reserve(8);
+}
+
+bool SparqlJsonResultParser::null() { return true; }
+
+bool SparqlJsonResultParser::boolean(bool /*value*/) { return true; }
+
+bool SparqlJsonResultParser::number_integer(number_integer_t /*value*/) { return true; }
+
+bool SparqlJsonResultParser::number_unsigned(number_unsigned_t /*value*/) { return true; }
+
+bool SparqlJsonResultParser::number_float(number_float_t /*value*/, const string_t& /*raw*/) {
+    return true;
+}
+
+bool SparqlJsonResultParser::string(string_t& value) {
+    const Location location = top();
+    if (location == Location::VARS) {
+        findOrAddColumn(value);
+    } else if (location == Location::TERM) {
+        if (key_ == "value") {
+            value_.assign(value);
+        } else if (key_ == "type") {
+            type_.assign(value);
+        } else if (key_ == "datatype") {
+            datatype_.assign(value);
+        }
+    }
+    return true;
+}
+
+bool SparqlJsonResultParser::binary(binary_t& /*value*/) { return true; }
+
+bool SparqlJsonResultParser::start_object(std::size_t /*elements*/) {
+    Location location = Location::OTHER;
+    switch (top()) {
+        case Location::OTHER:
+            location = locations_.empty() ? Location::ROOT : Location::OTHER;
+            break;
+        case Location::ROOT:
+            location = key_ == "head"      ? Location::HEAD
+                       : key_ == "results" ? Location::RESULTS
+                                           : Location::OTHER;
+            break;
+        case Location::BINDINGS:
+            location = Location::BINDING;
+            break;
+        case Location::BINDING:
+            location = Location::TERM;
+            current_column_ = findOrAddColumn(key_);
+            value_.clear();
+            type_.clear();
+            datatype_.clear();
+            break;
+        default:
+            break;
+    }
+    locations_.push_back(location);
+    return true;
+}
+
+bool SparqlJsonResultParser::key(string_t& value) {
+    key_.assign(value);
+    return true;
+}
+
+bool SparqlJsonResultParser::end_object() {
+    if (top() == Location::TERM) {
+        setValue();
+    } else if (top() == Location::BINDING) {
+        finishRow();
+    }
+    locations_.pop_back();
+    return true;
+}
+
+bool SparqlJsonResultParser::start_array(std::size_t /*elements*/) {
+    Location location = Location::OTHER;
+    if (top() == Location::HEAD && key_ == "vars") {
+        location = Location::VARS;
+    } else if (top() == Location::RESULTS && key_ == "bindings") {
+        location = Location::BINDINGS;
+        has_bindings_ = true;
+    }
+    locations_.push_back(location);
+    return true;
+}
+
+bool SparqlJsonResultParser::end_array() {
+    locations_.pop_back();
+    return true;
+}
+
+bool SparqlJsonResultParser::parse_error(std::size_t /*position*/,
+                                         const std::string& /*last_token*/,
+                                         const nlohmann::detail::exception& ex) {
+    throw std::runtime_error("Failed to parse SPARQL JSON response: " + std::string(ex.what()));
+}
+
+/**
+ * @brief Returns the innermost open container, OTHER before the root object.
+ */
+SparqlJsonResultParser::Location SparqlJsonResultParser::top() const {
+    return locations_.empty() ? Location::OTHER : locations_.back();
+}
+
+/**
+ * @brief Finds the column of a variable, mapping new variables to their schema and data point.
+ *
+ * Underscores in the variable name are replaced with dots, and the name is split at the first
+ * dot into the schema and the data point. Variables without a schema are reported once and
+ * their values are skipped.
+ *
+ * @param variable The variable name as it appears in the response.
+ * @return The index of the column.
+ */
+std::size_t SparqlJsonResultParser::findOrAddColumn(std::string_view variable) {
+    // The variables of a binding usually follow the order of the head
+    if (next_column_ < columns_.size() && columns_[next_column_].variable == variable) {
+        return next_column_++;
+    }
+    const auto column = std::find_if(columns_.begin(), columns_.end(), [&variable](const auto& c) {
+        return c.variable == variable;
+    });
+    if (column != columns_.end()) {
+        next_column_ = static_cast<std::size_t>(column - columns_.begin()) + 1;
+        return next_column_ - 1;
+    }
+
+    std::string name(variable);
+    std::replace(name.begin(), name.end(), '_', '.');
+    const std::size_t dot_pos = name.find('.');
+    if (!partition_variable_.empty() && variable == partition_variable_) {
+        columns_.push_back({std::pmr::string(variable, resource_), "", "", false, true});
+    } else if (dot_pos == std::string::npos) {
+        LOG_WARN("Warning parsing reasoning query to JSON - No schema found for key: " << name);
+        columns_.push_back({std::pmr::string(variable, resource_), "", "", false, false});
+    } else {
+        columns_.push_back({std::pmr::string(variable, resource_), name.substr(0, dot_pos),
+                            name.substr(dot_pos + 1), true, false});
+    }
+    next_column_ = columns_.size();
+    return columns_.size() - 1;
+}
+
+/**
+ * @brief Writes the value of the current term, converted by its datatype, into the grouped row.
+ */
+void SparqlJsonResultParser::setValue() {
+    const Column& column = columns_[current_column_];
+    if (column.is_partition) {
+        row_partition_.assign(value_);
+        return;
+    }
+    if (!column.has_schema) {
+        return;
+    }
+    nlohmann::json& section = is_ai_reasoner_inference_results_
+                                  ? inference_results_[column.schema]
+                                  : row_[column.schema];
+    section[column.data_point] = SparqlTermConverter::toJson(value_, type_, datatype_);
+}
+
+/**
+ * @brief Completes the grouped row of the current binding and appends it to the result, or to
+ * its partition.
+ */
+void SparqlJsonResultParser::finishRow() {
+    if (is_ai_reasoner_inference_results_ && inference_results_.is_object()) {
+        for (const auto& [schema, data_points] : inference_results_.items()) {
+            row_[schema][INFERENCE_RESULTS_KEY] = data_points.dump();
+        }
+    }
+    if (partition_variable_.empty()) {
+        result_.push_back(std::move(row_));
+    } else {
+        auto& partition = partitions_[row_partition_];
+        if (partition.is_null()) {
+            partition = nlohmann::json::array();
+        }
+        partition.push_back(std::move(row_));
+        row_partition_.clear();
+    }
+    row_ = nlohmann::json();
+    inference_results_ = nlohmann::json();
+    next_column_ = 0;
+}
@@ -0,0 +1,105 @@
+#ifndef SPARQL_JSON_RESULT_PARSER_H
+#define SPARQL_JSON_RESULT_PARSER_H
+
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Single-pass SAX parser for SPARQL query results in JSON format
+ * (`application/sparql-results+json`).
+ *
+ * Writes the grouped output of the JSONWriter straight from the response bytes, without building
+ * a DOM of the response or a flat row object per binding. Each variable name is mapped once to
+ * its schema and data point (`vehicle_speed` -> `Vehicle`, `speed`), either from the `head` of
+ * the response or when a variable first appears in a binding. The values of a binding are then
+ * converted by their datatype (see SparqlTermConverter) and written into the grouped row of the
+ * binding:
+ *
+ * - `[{"Vehicle": {"speed": 50}}]`, or
+ * - `[{"Vehicle": {"AI.Reasoner.InferenceResults": "{\"speed\":50}"}}]` for AI reasoner inference
+ *   results, where the data points of a schema are serialized when the binding ends.
+ *
+ * `parsePartitioned()` splits the rows by the value of one variable, e.g. the vehicle instance of
+ * a fleet query; that variable is not written into the rows.
+ */
+class SparqlJsonResultParser : public nlohmann::json_sax<nlohmann::json> {
+   public:
+    static constexpr char INFERENCE_RESULTS_KEY[] = "AI.Reasoner.InferenceResults";
+
+    static nlohmann::json parse(
+        std::string_view response, bool is_ai_reasoner_inference_results,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    static std::map<std::string, nlohmann::json> parsePartitioned(
+        std::string_view response, std::string_view partition_variable,
+        bool is_ai_reasoner_inference_results,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    bool null() override;
+    bool boolean(bool value) override;
+    bool number_integer(number_integer_t value) override;
+    bool number_unsigned(number_unsigned_t value) override;
+    bool number_float(number_float_t value, const string_t& raw) override;
+    bool string(string_t& value) override;
+    bool binary(binary_t& value) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& value) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& last_token,
+                     const nlohmann::detail::exception& ex) override;
+
+   private:
+    // Containers of the response the parser knows about, all others are skipped
+    enum class Location { OTHER, ROOT, HEAD, VARS, RESULTS, BINDINGS, BINDING, TERM };
+
+    // A variable of the result, mapped to the schema and data point it is grouped under
+    struct Column {
+        std::pmr::string variable;
+        std::string schema;
+        std::string data_point;
+        bool has_schema;
+        bool is_partition;
+    };
+
+    SparqlJsonResultParser(bool is_ai_reasoner_inference_results,
+                           std::pmr::memory_resource* resource,
+                           std::string_view partition_variable = {});
+
+    const bool is_ai_reasoner_inference_results_;
+    std::pmr::memory_resource* resource_;
+    // Variable whose value selects the partition of a row, empty if the rows are not split
+    const std::string_view partition_variable_;
+
+    std::pmr::vector<Location> locations_;
+    std::pmr::vector<Column> columns_;
+    std::pmr::string key_;
+    // Members of the term being parsed
+    std::pmr::string value_;
+    std::pmr::string type_;
+    std::pmr::string datatype_;
+    bool has_bindings_ = false;
+
+    // Column of the term being parsed, and the column expected next
+    std::size_t current_column_ = 0;
+    std::size_t next_column_ = 0;
+
+    nlohmann::json result_ = nlohmann::json::array();
+    std::map<std::string, nlohmann::json> partitions_;
+    std::string row_partition_;
+    nlohmann::json row_;
+    // Data points per schema of the current row, for AI reasoner inference results
+    nlohmann::json inference_results_;
+
+    Location top() const;
+    std::size_t findOrAddColumn(std::string_view variable);
+    void setValue();
+    void finishRow();
+};
+
+#endif  // SPARQL_JSON_RESULT_PARSER_H
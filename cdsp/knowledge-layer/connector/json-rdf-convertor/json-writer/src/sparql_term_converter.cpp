@@ -0,0 +1,75 @@
+#include "sparql_term_converter.h"
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <system_error>
+
+#include "xsd_datatype.h"
+
+namespace {
+
+/**
+ * @brief Parses the whole text as a number, std::nullopt if anything is left over.
+ */
+template <typename T>
+std::optional<T> parseNumber(std::string_view text) {
+    // XSD allows a leading '+', std::from_chars does not
+    if (text.size() > 1 && text.front() == '+' && text[1] != '-') {
+        text.remove_prefix(1);
+    }
+    T number{};
+    const char* end = text.data() + text.size();
+    const auto result = std::from_chars(text.data(), end, number);
+    if (text.empty() || result.ec != std::errc() || result.ptr != end) {
+        return std::nullopt;
+    }
+    return number;
+}
+
+}  // namespace
+
+/**
+ * @brief Converts an RDF term of a SPARQL result into a JSON value.
+ *
+ * @param value The lexical form of the term.
+ * @param type The type of the term: "uri", "bnode", "literal" or "typed-literal".
+ * @param datatype The datatype IRI of a typed literal, empty otherwise.
+ * @return The typed JSON value, or the lexical form as string.
+ */
+nlohmann::json SparqlTermConverter::toJson(std::string_view value, std::string_view type,
+                                           std::string_view datatype) {
+    if (type == "uri" || type == "bnode") {
+        return std::string(value);
+    }
+
+    switch (XsdDatatype::getKind(datatype)) {
+        case XsdDatatypeKind::BOOLEAN:
+            if (value == "true" || value == "1") {
+                return true;
+            }
+            if (value == "false" || value == "0") {
+                return false;
+            }
+            break;
+        case XsdDatatypeKind::INTEGER:
+            if (const auto integer = parseNumber<std::int64_t>(value)) {
+                return *integer;
+            }
+            // Values of xsd:unsignedLong may exceed the signed range
+            if (const auto integer = parseNumber<std::uint64_t>(value)) {
+                return *integer;
+            }
+            break;
+        case XsdDatatypeKind::DECIMAL:
+        case XsdDatatypeKind::FLOATING:
+            if (const auto floating = parseNumber<double>(value)) {
+                return *floating;
+            }
+            break;
+        case XsdDatatypeKind::OTHER:
+            break;
+    }
+    return std::string(value);
+}
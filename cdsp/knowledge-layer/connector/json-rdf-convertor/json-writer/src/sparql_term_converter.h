@@ -0,0 +1,28 @@
+#ifndef SPARQL_TERM_CONVERTER_H
+#define SPARQL_TERM_CONVERTER_H
+
+#include <nlohmann/json.hpp>
+#include <string_view>
+
+/**
+ * @brief Converts the RDF terms of SPARQL query results into typed JSON values.
+ *
+ * SPARQL JSON and XML results state the type of each term (`uri`, `bnode` or `literal`) and the
+ * datatype of typed literals, so the value is converted by its datatype instead of guessing the
+ * type from the text:
+ *
+ * - xsd:integer and the derived integer types become integers,
+ * - xsd:double, xsd:float and xsd:decimal become floating-point numbers,
+ * - xsd:boolean becomes a boolean,
+ * - all other literals (e.g. xsd:string, xsd:dateTime or literals without datatype), IRIs and blank
+ *   nodes are kept as strings, e.g. `"007"` stays `"007"`.
+ *
+ * Literals that are not valid for their datatype are kept as strings.
+ */
+class SparqlTermConverter {
+   public:
+    static nlohmann::json toJson(std::string_view value, std::string_view type,
+                                 std::string_view datatype);
+};
+
+#endif  // SPARQL_TERM_CONVERTER_H
@@ -11,6 +11,7 @@ class JSONWriterIntegrationTest : public ::testing::Test {
     std::string data_point_3_;
     static constexpr int MAX_RANDOM_BIG = 100;
     static constexpr int MAX_RANDOM_SMALL = 10;
+    static constexpr char XSD[] = "http://www.w3.org/2001/XMLSchema#";
     int value_dp_1_row_1_;
     float value_dp_1_row_2_;
     std::string value_dp_2_row_1_;
@@ -186,24 +187,24 @@ TEST_F(JSONWriterIntegrationTest, ConvertSparqlJsonToJson) {
             "bindings": [
                 {
                     ")" +
-        data_point_1_ + R"(": { "type": "literal", "value": ")" +
-        std::to_string(value_dp_1_row_1_) + R"(" },
+        data_point_1_ + R"(": { "type": "literal", "datatype": ")" + XSD +
+        R"(integer", "value": ")" + std::to_string(value_dp_1_row_1_) + R"(" },
                     ")" +
         data_point_2_ + R"(": { "type": "uri", "value": ")" + value_dp_2_row_1_ +
         R"(" },
                     ")" +
-        data_point_3_ + R"(": { "type": "literal", "value": ")" +
-        (value_dp_3_row_1_ ? "true" : "false") + R"(" }
+        data_point_3_ + R"(": { "type": "literal", "datatype": ")" + XSD +
+        R"(boolean", "value": ")" + (value_dp_3_row_1_ ? "true" : "false") + R"(" }
                 },
                 {
                     ")" +
-        data_point_1_ + R"(": { "type": "bnode", "value": ")" + std::to_string(value_dp_1_row_2_) +
-        R"(" },
+        data_point_1_ + R"(": { "type": "literal", "datatype": ")" + XSD +
+        R"(float", "value": ")" + std::to_string(value_dp_1_row_2_) + R"(" },
                     ")" +
         data_point_2_ + R"(": { "type": "literal", "value": ")" + value_dp_2_row_2_ + R"(" },
                     ")" +
-        data_point_3_ + R"(": { "type": "literal", "value": ")" +
-        std::to_string(value_dp_3_row_2_) + R"(" }
+        data_point_3_ + R"(": { "type": "literal", "datatype": ")" + XSD +
+        R"(double", "value": ")" + std::to_string(value_dp_3_row_2_) + R"(" }
                 }
             ]
         }
@@ -249,9 +250,9 @@ TEST_F(JSONWriterIntegrationTest, ConvertSparqXmlToJson) {
                         <binding name=")" +
         data_point_1_ +
         R"(">
-                            <uri>)" +
-        std::to_string(value_dp_1_row_1_) +
-        R"(</uri>
+                            <literal datatype=")" +
+        XSD + R"(integer">)" + std::to_string(value_dp_1_row_1_) +
+        R"(</literal>
                         </binding>
                         <binding name=")" +
         data_point_2_ +
@@ -263,18 +264,18 @@ TEST_F(JSONWriterIntegrationTest, ConvertSparqXmlToJson) {
                         <binding name=")" +
         data_point_3_ +
         R"(">
-                            <uri>)" +
-        (value_dp_3_row_1_ ? "true" : "false") +
-        R"(</uri>
+                            <literal datatype=")" +
+        XSD + R"(boolean">)" + (value_dp_3_row_1_ ? "true" : "false") +
+        R"(</literal>
                         </binding>
                     </result>
                     <result>
                         <binding name=")" +
         data_point_1_ +
         R"(">
-                            <bnode>)" +
-        std::to_string(value_dp_1_row_2_) +
-        R"(</bnode>
+                            <literal datatype=")" +
+        XSD + R"(float">)" + std::to_string(value_dp_1_row_2_) +
+        R"(</literal>
                         </binding>
                         <binding name=")" +
         data_point_2_ +
@@ -286,9 +287,9 @@ TEST_F(JSONWriterIntegrationTest, ConvertSparqXmlToJson) {
                         <binding name=")" +
         data_point_3_ +
         R"(">
-                            <uri>)" +
-        std::to_string(value_dp_3_row_2_) +
-        R"(</uri>
+                            <literal datatype=")" +
+        XSD + R"(double">)" + std::to_string(value_dp_3_row_2_) +
+        R"(</literal>
                         </binding>
                     </result>
                 </results>
@@ -1,7 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "json_writer.h"
-#include "mock_i_file_handler.h"
+#include "mock_i_output_sink.h"
 #include "random_utils.h"
 
 class JSONWriterTest : public ::testing::Test {};
@@ -11,7 +11,8 @@ class JSONWriterTest : public ::testing::Test {};
  *
  * This test verifies that the JSONWriter converts CSV input data
  * into JSON format and writes it to a specified file path. It uses a mock
- * file handler to ensure the write operation is called exactly once.
+ * output sink to ensure the write operation is called exactly once with a
+ * single JSON line holding the result.
  *
  * The test checks that the resulting JSON object contains the expected
  * fields.
@@ -21,12 +22,41 @@ TEST_F(JSONWriterTest, WriteJsonToFile) {
     std::optional<std::string> output_file_path = "./test_output/";
     bool is_ai_reasoner_inference_results = RandomUtils::generateRandomBool();
 
-    auto mockFileHandler = std::make_shared<MockIFileHandler>();
-    EXPECT_CALL(*mockFileHandler, writeFile(::testing::_, ::testing::_, false)).Times(1);
+    auto mockOutputSink = std::make_shared<MockIOutputSink>();
+    std::string written_line;
+    EXPECT_CALL(*mockOutputSink, shouldWrite(::testing::StrEq("reasoning")))
+        .WillOnce(::testing::Return(true));
+    EXPECT_CALL(*mockOutputSink,
+                write(::testing::Field(&OutputStream::directory, "./test_output/"), ::testing::_))
+        .WillOnce(::testing::SaveArg<1>(&written_line));
 
     nlohmann::json result = JSONWriter::writeToJson(csv_input, DataQueryAcceptType::TEXT_CSV,
                                                     is_ai_reasoner_inference_results,
-                                                    output_file_path, mockFileHandler);
+                                                    output_file_path, mockOutputSink);
+
+    ASSERT_FALSE(result.empty());
+    ASSERT_EQ(written_line.back(), '\n');
+    EXPECT_EQ(written_line.find('\n'), written_line.size() - 1);
+    const auto written_record = nlohmann::json::parse(written_line);
+    EXPECT_TRUE(written_record.contains("time"));
+    EXPECT_EQ(written_record["result"], result);
+}
+
+/**
+ * @brief Test case for writing JSON data when the output stream is disabled.
+ *
+ * This test verifies that the JSONWriter still returns the result, but does
+ * not write it when the output sink skips the stream.
+ */
+TEST_F(JSONWriterTest, WriteJsonSkipsDisabledOutput) {
+    std::string csv_input = "id,name,age\n1,Alice,30\n2,Bob,25";
+
+    auto mockOutputSink = std::make_shared<MockIOutputSink>();
+    EXPECT_CALL(*mockOutputSink, shouldWrite(::testing::_)).WillOnce(::testing::Return(false));
+    EXPECT_CALL(*mockOutputSink, write(::testing::_, ::testing::_)).Times(0);
+
+    nlohmann::json result = JSONWriter::writeToJson(csv_input, DataQueryAcceptType::TEXT_CSV,
+                                                    false, "./test_output/", mockOutputSink);
 
     ASSERT_FALSE(result.empty());
 }
@@ -36,7 +66,7 @@ TEST_F(JSONWriterTest, WriteJsonToFile) {
  *
  * This test verifies that the JSONWriter converts CSV input data
  * into JSON format and does not write it to a file. It uses a mock
- * file handler to ensure the write operation is not called.
+ * output sink to ensure the write operation is not called.
  *
  * The test checks that the resulting JSON object contains the expected
  * fields.
@@ -46,12 +76,13 @@ TEST_F(JSONWriterTest, WriteJsonWithoutFilePath) {
     std::optional<std::string> output_file_path = std::nullopt;  // No output file
     bool is_ai_reasoner_inference_results = RandomUtils::generateRandomBool();
 
-    auto mockFileHandler = std::make_shared<MockIFileHandler>();
-    EXPECT_CALL(*mockFileHandler, writeFile(::testing::_, ::testing::_, ::testing::_)).Times(0);
+    auto mockOutputSink = std::make_shared<MockIOutputSink>();
+    EXPECT_CALL(*mockOutputSink, shouldWrite(::testing::_)).Times(0);
+    EXPECT_CALL(*mockOutputSink, write(::testing::_, ::testing::_)).Times(0);
 
     nlohmann::json result =
         JSONWriter::writeToJson(csv_input, DataQueryAcceptType::TEXT_CSV,
-                                is_ai_reasoner_inference_results, output_file_path);
+                                is_ai_reasoner_inference_results, output_file_path, mockOutputSink);
 
     ASSERT_FALSE(result.empty());
 }
@@ -163,4 +194,26 @@ TEST_F(JSONWriterTest, InvalidSparqlXml) {
         },
         ::testing::ThrowsMessage<std::runtime_error>(
             ::testing::HasSubstr("Failed to parse SPARQL XML response")));
-}
\ No newline at end of file
+}
+/**
+ * @brief Test case for converting a SPARQL TSV result with RDF terms.
+ *
+ * This test verifies that the '?' of the variables in the header is removed
+ * and that quoted literals, with their escapes, datatypes and language tags,
+ * are decoded to their values.
+ */
+TEST_F(JSONWriterTest, WriteJsonDecodesTsvTerms) {
+    std::string tsv_input =
+        "?Vehicle_Speed\t?Vehicle_Name\t?Vehicle_Label\n"
+        "\"42\"^^<http://www.w3.org/2001/XMLSchema#int>\t\"a \\\"quoted\\\"\\tname\"\t"
+        "\"car\"@en\n";
+
+    nlohmann::json result =
+        JSONWriter::writeToJson(tsv_input, DataQueryAcceptType::TEXT_TSV, false, std::nullopt);
+
+    ASSERT_EQ(result.size(), 1u);
+    const nlohmann::json &vehicle = result[0]["Vehicle"];
+    EXPECT_EQ(vehicle["Speed"], 42);
+    EXPECT_EQ(vehicle["Name"], "a \"quoted\"\tname");
+    EXPECT_EQ(vehicle["Label"], "car");
+}
@@ -0,0 +1,107 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+#include "sparql_json_result_parser.h"
+#include "sparql_term_converter.h"
+
+class SparqlJsonResultParserUnitTest : public ::testing::Test {
+   protected:
+    static constexpr char RESPONSE[] = R"({
+        "head": {"vars": ["Vehicle_speed", "Vehicle_Cabin_isOpen", "label"]},
+        "results": {"bindings": [
+            {"Vehicle_speed": {"type": "literal", "value": "50",
+                               "datatype": "http://www.w3.org/2001/XMLSchema#integer"},
+             "Vehicle_Cabin_isOpen": {"datatype": "http://www.w3.org/2001/XMLSchema#boolean",
+                                      "type": "literal", "value": "true"},
+             "label": {"type": "literal", "value": "ignored"}},
+            {"Vehicle_Cabin_isOpen": {"type": "literal", "value": "false",
+                                      "datatype": "http://www.w3.org/2001/XMLSchema#boolean"},
+             "Vehicle_speed": {"type": "literal", "value": "12.5",
+                               "datatype": "http://www.w3.org/2001/XMLSchema#double"}}
+        ]}
+    })";
+};
+
+// Test that the values of each binding are grouped by schema with their detected types
+TEST_F(SparqlJsonResultParserUnitTest, GroupsBindingsBySchema) {
+    const nlohmann::json result = SparqlJsonResultParser::parse(RESPONSE, false);
+
+    const nlohmann::json expected = nlohmann::json::parse(R"([
+        {"Vehicle": {"speed": 50, "Cabin.isOpen": true}},
+        {"Vehicle": {"speed": 12.5, "Cabin.isOpen": false}}
+    ])");
+    EXPECT_EQ(result, expected);
+}
+
+// Test that AI reasoner inference results are serialized under the inference results key
+TEST_F(SparqlJsonResultParserUnitTest, SerializesInferenceResults) {
+    std::pmr::monotonic_buffer_resource arena;
+    const nlohmann::json result = SparqlJsonResultParser::parse(RESPONSE, true, &arena);
+
+    ASSERT_EQ(result.size(), 2u);
+    const std::string& inference_results =
+        result[0]["Vehicle"][SparqlJsonResultParser::INFERENCE_RESULTS_KEY]
+            .get_ref<const std::string&>();
+    EXPECT_EQ(nlohmann::json::parse(inference_results),
+              nlohmann::json::parse(R"({"speed": 50, "Cabin.isOpen": true})"));
+}
+
+// Test that variables missing from the head are mapped when they first appear in a binding
+TEST_F(SparqlJsonResultParserUnitTest, MapsVariablesMissingFromHead) {
+    const nlohmann::json result = SparqlJsonResultParser::parse(
+        R"({"results": {"bindings": [{"Tire_pressure": {"type": "literal", "value": "2.4",
+                                                       "datatype": "xsd:decimal"}}]},
+            "head": {"vars": []}})",
+        false);
+
+    EXPECT_EQ(result, nlohmann::json::parse(R"([{"Tire": {"pressure": 2.4}}])"));
+}
+
+// Test that the rows are split by the value of the partition variable, which is not written
+TEST_F(SparqlJsonResultParserUnitTest, SplitsRowsByPartitionVariable) {
+    const auto partitions = SparqlJsonResultParser::parsePartitioned(RESPONSE, "label", false);
+
+    ASSERT_EQ(partitions.size(), 2u);
+    EXPECT_EQ(partitions.at("ignored"),
+              nlohmann::json::parse(R"([{"Vehicle": {"speed": 50, "Cabin.isOpen": true}}])"));
+    // Rows that do not bind the variable are under the empty key
+    EXPECT_EQ(partitions.at(""),
+              nlohmann::json::parse(R"([{"Vehicle": {"speed": 12.5, "Cabin.isOpen": false}}])"));
+    EXPECT_THROW(SparqlJsonResultParser::parsePartitioned(RESPONSE, "", false),
+                 std::invalid_argument);
+}
+
+// Test that terms are converted by their datatype and kept as strings otherwise
+TEST_F(SparqlJsonResultParserUnitTest, ConvertsTermsByDatatype) {
+    const std::string xsd = "http://www.w3.org/2001/XMLSchema#";
+    EXPECT_EQ(SparqlTermConverter::toJson("-42", "literal", xsd + "int"), -42);
+    EXPECT_EQ(SparqlTermConverter::toJson("+7", "typed-literal", xsd + "integer"), 7);
+    EXPECT_EQ(SparqlTermConverter::toJson("18446744073709551615", "literal", xsd + "unsignedLong"),
+              18446744073709551615ULL);
+    EXPECT_EQ(SparqlTermConverter::toJson("1", "literal", xsd + "boolean"), true);
+    EXPECT_EQ(SparqlTermConverter::toJson("1e3", "literal", xsd + "double"), 1000.0);
+
+    // Values that only look like numbers or booleans
+    EXPECT_EQ(SparqlTermConverter::toJson("007", "literal", xsd + "string"), "007");
+    EXPECT_EQ(SparqlTermConverter::toJson("007", "literal", ""), "007");
+    EXPECT_EQ(SparqlTermConverter::toJson("true", "uri", ""), "true");
+    EXPECT_EQ(SparqlTermConverter::toJson("2024-01-01T00:00:00Z", "literal", xsd + "dateTime"),
+              "2024-01-01T00:00:00Z");
+    // Invalid literals of their datatype
+    EXPECT_EQ(SparqlTermConverter::toJson("12abc", "literal", xsd + "integer"), "12abc");
+    EXPECT_EQ(SparqlTermConverter::toJson("", "literal", xsd + "double"), "");
+}
+
+// Test that malformed or incomplete responses are rejected
+TEST_F(SparqlJsonResultParserUnitTest, RejectsInvalidResponses) {
+    EXPECT_THAT([] { SparqlJsonResultParser::parse(R"({"head": {"vars": []}})", false); },
+                ::testing::ThrowsMessage<std::runtime_error>(
+                    ::testing::HasSubstr("Invalid SPARQL JSON response format")));
+    EXPECT_THAT([] { SparqlJsonResultParser::parse(R"({"results": {"bindings": [)", false); },
+                ::testing::ThrowsMessage<std::runtime_error>(
+                    ::testing::HasSubstr("Failed to parse SPARQL JSON response")));
+}
@@ -1,28 +1,44 @@
 #include "triple_assembler.h"
 
-#include <iostream>
+#include <algorithm>
 #include <nlohmann/json.hpp>
-#include <sstream>
 
+#include "artifact_loader.h"
 #include "data_message.h"
 #include "helper.h"
+#include "logger.h"
+#include "tabular_result_reader.h"
 
 using json = nlohmann::json;
 
-TripleAssembler::TripleAssembler(std::shared_ptr<ModelConfig> model_config,
-                                 ReasonerService& reasoner_service, IFileHandler& file_reader,
+namespace {
+constexpr std::string_view LATITUDE_SIGNAL = "Vehicle.CurrentLocation.Latitude";
+constexpr std::string_view LONGITUDE_SIGNAL = "Vehicle.CurrentLocation.Longitude";
+
+// Releases the triples of the message on every exit, before the message resource goes away
+struct TripleRelease {
+    TripleWriter& triple_writer;
+    ~TripleRelease() { triple_writer.releaseTriple(); }
+};
+}  // namespace
+
+TripleAssembler::TripleAssembler(ModelConfigSnapshot model_config,
+                                 ReasonerService& reasoner_service, IOutputSink& output_sink,
                                  TripleWriter& triple_writer)
-    : model_config_(model_config),
+    : model_config_(std::move(model_config)),
       reasoner_service_(reasoner_service),
-      file_handler_(file_reader),
-      triple_writer_(triple_writer) {}
+      output_sink_(output_sink),
+      triple_writer_(triple_writer) {
+    resolveCoordinateSignalIds();
+}
 
 /**
  * @brief Initializes the TripleAssembler by checking the data store and loading validation shapes.
  *
  * This function first checks if the data store is available using the reasoner service. If the data
  * store is not available, it throws a runtime error. It then attempts to load validation shapes
- * from the model configuration. If no validation shapes are found or if loading fails, it throws a
+ * from the model configuration, skipping the shapes the data store already holds from a previous
+ * start (see ArtifactLoader). If no validation shapes are found or if loading fails, it throws a
  * runtime error.
  *
  * @throws std::runtime_error If the data store is unavailable or if validation shapes cannot be
@@ -32,20 +48,44 @@ void TripleAssembler::initialize() {
     if (!reasoner_service_.checkDataStore()) {
         throw std::runtime_error("Initialization failed: Unable to generate triples.");
     }
-    const auto validation_shapes = model_config_->getValidationShapes();
+    const auto& validation_shapes = model_config_->getValidationShapes();
     if (!validation_shapes.empty()) {
-        for (const auto& [reasoner_syntax_type, data] : validation_shapes) {
-            if (data.empty() || !reasoner_service_.loadData(data, reasoner_syntax_type)) {
-                throw std::runtime_error(
-                    "No validation shapes could be loaded. The triples cannot be generated.");
-            }
+        const bool any_empty = std::any_of(
+            validation_shapes.begin(), validation_shapes.end(),
+            [](const auto& validation_shape) { return validation_shape.second.empty(); });
+        const ArtifactLoadStatistics statistics =
+            any_empty ? ArtifactLoadStatistics{}
+                      : ArtifactLoader(reasoner_service_).addData(validation_shapes).load();
+        if (any_empty || statistics.failed > 0) {
+            throw std::runtime_error(
+                "No validation shapes could be loaded. The triples cannot be generated.");
         }
+        LOG_INFO("Loaded " << statistics.loaded << " validation shapes (" << statistics.unchanged
+                           << " unchanged) in " << statistics.duration.count() << " ms");
     } else {
         throw std::runtime_error(
             "No validation shapes were found to load. The triples cannot be generated.");
     }
 }
 
+/**
+ * @brief Swaps in a reloaded model configuration for the following messages.
+ *
+ * The queries and the output settings are read from the snapshot for every message. The signal
+ * IDs of the coordinates are resolved again only if the signal catalog changed. The coordinates
+ * waiting for their counterpart are kept.
+ *
+ * @param model_config The reloaded model configuration.
+ * @param signal_catalog_changed Whether the signal catalog of the configuration changed.
+ */
+void TripleAssembler::updateModelConfig(ModelConfigSnapshot model_config,
+                                        bool signal_catalog_changed) {
+    model_config_ = std::move(model_config);
+    if (signal_catalog_changed) {
+        resolveCoordinateSignalIds();
+    }
+}
+
 /**
  * Transforms a DataMessage into reasoning triples and stores the output.
  *
@@ -56,40 +96,39 @@ void TripleAssembler::initialize() {
  * Finally, it outputs the generated triples in the specified format.
  *
  * @param message The DataMessage containing the header and nodes to be transformed into triples.
+ * @param resource The memory resource for the triples of the message, e.g. the message arena.
+ * The triples are released before the function returns.
  * @throws std::runtime_error If the data store check fails.
  */
-void TripleAssembler::transformMessageToTriple(const DataMessage& message) {
+void TripleAssembler::transformMessageToTriple(const DataMessage& message,
+                                               std::pmr::memory_resource* resource) {
     if (!reasoner_service_.checkDataStore()) {
         throw std::runtime_error("Failed to call datastore. The triples cannot be generated.");
     }
 
-    MessageHeader header = message.getHeader();
-    std::vector<Node> nodes = message.getNodes();
+    const MessageHeader& header = message.getHeader();
+    const std::vector<Node>& nodes = message.getNodes();
 
     // Add the identifier to the triples that will be generated
-    triple_writer_.initiateTriple(header.getInstance());
+    triple_writer_.initiateTriple(header.getInstance(), resource);
+    const TripleRelease triple_release{triple_writer_};
 
     if (nodes.empty()) {
-        std::cout << "No nodes found in the message\n\n";
+        LOG_DEBUG("No nodes found in the message");
         return;
     }
 
     std::optional<CoordinateNodes> valid_coordinates = std::nullopt;
 
-    for (const auto node : nodes) {
-        if (node.getName() == "Vehicle.CurrentLocation.Latitude" ||
-            node.getName() == "Vehicle.CurrentLocation.Longitude") {
+    for (const auto& node : nodes) {
+        if (const auto coordinate_slot = getCoordinateSlot(node)) {
             const auto node_timestamp = getTimestampFromNode(node);
             const auto nanoseconds_since_epoch = Helper::getNanosecondsSinceEpoch(node_timestamp);
 
-            const auto found_key =
-                timestamp_coordinates_messages_map_.find(nanoseconds_since_epoch);
-            if (found_key != timestamp_coordinates_messages_map_.end()) {
-                found_key->second.insert({node.getName(), node});
-            } else {
-                timestamp_coordinates_messages_map_.emplace(
-                    nanoseconds_since_epoch,
-                    std::unordered_map<std::string, Node>{{node.getName(), node}});
+            // Keep the first node received for each coordinate and timestamp
+            auto& coordinates = timestamp_coordinates_messages_map_[nanoseconds_since_epoch];
+            if (!coordinates[*coordinate_slot].has_value()) {
+                coordinates[*coordinate_slot] = node;
             }
 
             valid_coordinates = getValidCoordinatesPair();
@@ -98,7 +137,7 @@ void TripleAssembler::transformMessageToTriple(const DataMessage& message) {
             try {
                 generateTriplesFromNode(node, header.getSchemaType());
             } catch (const std::exception& e) {
-                std::cerr << "An error occurred creating the triples: " << e.what() << std::endl;
+                LOG_ERROR("An error occurred creating the triples: " << e.what());
             }
         }
     }
@@ -113,7 +152,7 @@ void TripleAssembler::transformMessageToTriple(const DataMessage& message) {
     if (!generated_triples.empty()) {
         storeTripleOutput(generated_triples);
     } else {
-        std::cout << "No triples have been generated for the update message\n\n";
+        LOG_DEBUG("No triples have been generated for the update message");
     }
 }
 
@@ -137,17 +176,15 @@ std::optional<CoordinateNodes> TripleAssembler::getValidCoordinatesPair() {
 
     for (const auto& [time, nodes] : timestamp_coordinates_messages_map_) {
         // Check if latitude exists
-        if (const auto found_lat = nodes.find("Vehicle.CurrentLocation.Latitude");
-            found_lat != nodes.end()) {
+        if (nodes[LATITUDE].has_value()) {
             latitude_time = time;
-            latitude = &found_lat->second;
+            latitude = &*nodes[LATITUDE];
         }
 
         // Check if longitude exists
-        if (const auto found_long = nodes.find("Vehicle.CurrentLocation.Longitude");
-            found_long != nodes.end()) {
+        if (nodes[LONGITUDE].has_value()) {
             longitude_time = time;
-            longitude = &found_long->second;
+            longitude = &*nodes[LONGITUDE];
         }
     }
 
@@ -201,36 +238,31 @@ void TripleAssembler::cleanupOldTimestamps() {
 void TripleAssembler::generateTriplesFromNode(const Node& node, const SchemaType& msg_schema_type,
                                               const std::optional<double>& ntm_coord_value) {
     try {
-        // Split node data point into object and data elements
-        const auto [object_elements, data_element] = extractObjectsAndDataElements(node.getName());
+        // The last segment of the node data point is the data element, the others are objects
+        std::vector<std::string> split_segments;
+        const auto& segments = getSignalSegments(node, split_segments);
+        const std::size_t data_index = segments.size() - 1;
 
-        const auto queries = model_config_->getQueriesTripleAssemblerHelper().getQueries();
-        TripleAssemblerHelper::QueryPair query_pair;
-        if (queries.find(msg_schema_type) != queries.end()) {
-            query_pair = queries.at(msg_schema_type);
-        } else {
-            query_pair = queries.at(SchemaType::DEFAULT);
-        }
+        const auto& query_pair = model_config_->getQueryPair(msg_schema_type);
 
         // Query and add Object Elements
-        for (std::size_t i = 1; i < object_elements.size(); ++i) {
-            const auto [prefixes, object_values] = getQueryPrefixesAndData(
-                query_pair.object_property, object_elements[i - 1], object_elements[i]);
+        for (std::size_t i = 1; i < data_index; ++i) {
+            const auto [prefixes, object_values] =
+                getQueryPrefixesAndData(query_pair.object_property, segments[i - 1], segments[i]);
 
             triple_writer_.addElementObjectToTriple(prefixes, object_values);
         }
 
         // Query and add Data Element
         const auto [prefixes, data_values] = getQueryPrefixesAndData(
-            query_pair.data_property, object_elements[object_elements.size() - 1], data_element);
+            query_pair.data_property, segments[data_index - 1], segments[data_index]);
 
         const auto node_timestamp = getTimestampFromNode(node);
 
         triple_writer_.addElementDataToTriple(prefixes, data_values, node.getValue().value(),
                                               node_timestamp, ntm_coord_value);
     } catch (const std::exception& e) {
-        std::cerr << "An error occurred while creating the reasoning triples: " << e.what()
-                  << std::endl;
+        LOG_ERROR("An error occurred while creating the reasoning triples: " << e.what());
         throw;
     }
 }
@@ -255,9 +287,15 @@ void TripleAssembler::generateTriplesFromCoordinates(
     const DataMessage& message) {
     {
         try {
-            auto ntm_coord =
-                Helper::getCoordInNtm(valid_coordinates.value().latitude.getValue().value(),
-                                      valid_coordinates.value().longitude.getValue().value());
+            const auto latitude =
+                NodeValueFormatter::toDouble(valid_coordinates.value().latitude.getValue().value());
+            const auto longitude = NodeValueFormatter::toDouble(
+                valid_coordinates.value().longitude.getValue().value());
+            if (!latitude || !longitude) {
+                throw std::runtime_error("Coordinates must be numeric values");
+            }
+
+            auto ntm_coord = Helper::getCoordInNtm(latitude.value(), longitude.value());
             if (ntm_coord == std::nullopt) {
                 throw std::runtime_error("Failed to convert coordinates to NTM");
             }
@@ -267,7 +305,7 @@ void TripleAssembler::generateTriplesFromCoordinates(
             generateTriplesFromNode(valid_coordinates.value().longitude, msg_schema_type,
                                     ntm_coord.value().easting);
         } catch (const std::exception& e) {
-            std::cerr << "An error occurred creating the TTL triples: " << e.what() << std::endl;
+            LOG_ERROR("An error occurred creating the TTL triples: " << e.what());
         }
 
         // Manual cleanup of old timestamps
@@ -298,29 +336,69 @@ const std::chrono::system_clock::time_point TripleAssembler::getTimestampFromNod
 }
 
 /**
- * Extracts objects and data elements from a given node name.
+ * Retrieves the dot-separated segments of a node name.
+ *
+ * Nodes of cataloged signals use the segments kept in the signal catalog. Other node names are
+ * split into `split_segments`.
  *
- * @param node_name The node name to be processed, expected to be in the format
- *                  of dot-separated elements.
- * @return A pair where the first element is a vector of strings representing
- *         the objects, and the second element is a string representing the
- *         data element.
+ * @param node The node whose name is to be split, in the format of dot-separated elements.
+ * @param split_segments Storage for the segments of names that are not in the catalog.
+ * @return The segments of the node name. All but the last are objects, the last is the data
+ *         element.
  * @throws std::runtime_error if the node name contains fewer than two elements.
  */
-std::pair<std::vector<std::string>, std::string> TripleAssembler::extractObjectsAndDataElements(
-    const std::string& node_name) {
-    std::vector<std::string> elements = Helper::splitString(node_name, '.');
+const std::vector<std::string>& TripleAssembler::getSignalSegments(
+    const Node& node, std::vector<std::string>& split_segments) const {
+    const SignalCatalog& signal_catalog = model_config_->getSignalCatalog();
+    const bool is_cataloged = node.getSignalId() < signal_catalog.size() &&
+                              signal_catalog.getPath(node.getSignalId()) == node.getName();
+    if (!is_cataloged) {
+        split_segments = Helper::splitString(node.getName(), '.');
+    }
+    const auto& segments =
+        is_cataloged ? signal_catalog.getSegments(node.getSignalId()) : split_segments;
 
     // At least two elements are required to create a triple
-    if (elements.size() < 2) {
+    if (segments.size() < 2) {
         throw std::runtime_error("The message node must contain at least two elements: " +
-                                 node_name);
+                                 node.getName());
     }
-    // Separate the last element as `data_element`
-    std::string data_element = elements.back();
-    elements.pop_back();
+    return segments;
+}
 
-    return {elements, data_element};
+/**
+ * @brief Looks up the signal IDs of the latitude and longitude in the signal catalog.
+ */
+void TripleAssembler::resolveCoordinateSignalIds() {
+    const SignalCatalog& signal_catalog = model_config_->getSignalCatalog();
+    coordinate_signal_ids_[LATITUDE] = signal_catalog.find(LATITUDE_SIGNAL);
+    coordinate_signal_ids_[LONGITUDE] = signal_catalog.find(LONGITUDE_SIGNAL);
+}
+
+/**
+ * Determines whether a node is a latitude or longitude coordinate.
+ *
+ * The signal ID of the node is compared when both the node and the coordinates are in the signal
+ * catalog, otherwise the node name.
+ *
+ * @param node The node to check.
+ * @return The coordinate slot of the node, or std::nullopt if it is not a coordinate.
+ */
+std::optional<TripleAssembler::CoordinateSlot> TripleAssembler::getCoordinateSlot(
+    const Node& node) const {
+    constexpr std::array<std::string_view, 2> COORDINATE_SIGNALS = {LATITUDE_SIGNAL,
+                                                                    LONGITUDE_SIGNAL};
+    for (const CoordinateSlot slot : {LATITUDE, LONGITUDE}) {
+        const SignalId signal_id = coordinate_signal_ids_[slot];
+        const bool matches = signal_id != SignalCatalog::UNKNOWN_SIGNAL &&
+                                     node.getSignalId() != SignalCatalog::UNKNOWN_SIGNAL
+                                 ? node.getSignalId() == signal_id
+                                 : node.getName() == COORDINATE_SIGNALS[slot];
+        if (matches) {
+            return slot;
+        }
+    }
+    return std::nullopt;
 }
 
 /**
@@ -375,26 +453,24 @@ void TripleAssembler::replaceAllQueryVariables(std::string& query, const std::st
 /**
  * @brief Extracts subject, predicate, and object values from a query string.
  *
+ * The values are the cells of the first row of the TSV query result, read in place by the
+ * TabularResultReader. They are RDF terms, e.g. `<http://example.org/a>` or `"a b"`.
+ *
  * @param query The input query string from which to extract values.
  * @return A tuple containing the subject, predicate, and object as strings.
+ * @throws std::runtime_error if the result has no row with three values.
  */
 std::tuple<std::string, std::string, std::string> TripleAssembler::extractElementValuesFromQuery(
     const std::string& query) {
-    std::istringstream stream(query);
-    std::string line;
-
-    // Skip the first line
-    std::getline(stream, line);
-
-    // Read the second line
-    std::getline(stream, line);
-
-    // Extract the three values
-    std::istringstream second_line_stream(line);
-    std::string subject, predicate, object;
-    second_line_stream >> subject >> predicate >> object;
+    // The header is read by the reader, the values are in the first row
+    TabularResultReader reader(query, '\t');
+    std::pmr::vector<std::string_view> cells;
+    if (!reader.nextRow(cells) || cells.size() < 3) {
+        throw std::runtime_error(
+            "The query result has no row with a subject, predicate and object");
+    }
 
-    return std::make_tuple(subject, predicate, object);
+    return std::make_tuple(std::string(cells[0]), std::string(cells[1]), std::string(cells[2]));
 }
 
 /**
@@ -422,32 +498,41 @@ std::string TripleAssembler::extractPrefixesFromQuery(const std::string& query)
 }
 
 /**
- * @brief Stores the triple output to a file.
+ * @brief Loads the triple output into the reasoner and queues it for the triples output files.
  *
- * This function constructs a file name using the configured output file path,
- * the current timestamp, and the appropriate file extension. It then writes
- * the provided triple output to this file.
+ * The triples are appended to the files of the "triples" output stream under the configured
+ * output path, preceded by the current time. The output sink writes them in the background and
+ * may skip them if the stream is disabled or sampled. Archived streams get the triples as
+ * N-Triples, one self-contained line per triple, instead of the configured output format.
  *
  * @param triple_output The string containing the triple output to be stored.
  */
 void TripleAssembler::storeTripleOutput(const std::string& triple_output) {
     const ReasonerSyntaxType output_format = model_config_->getReasonerSettings().getOutputFormat();
     if (!reasoner_service_.loadData(triple_output, output_format)) {
-        std::cerr << "It was a problem loading triple data to Reasoner-Server" << std::endl;
+        LOG_ERROR("It was a problem loading triple data to Reasoner-Server");
     }
 
-    // Create file name
-    const std::string file_name = model_config_->getOutput() + "triples/gen_triple_t_" +
-                                  Helper::getFormattedTimestampNow("%H", false, true) +
-                                  reasonerSyntaxTypeToFileExtension(output_format);
-
-    // Add the current time to the log
-    std::ostringstream output;
-    output << "# Output from " << Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true)
-           << "\n\n"
-           << triple_output << "\n\n";
-
-    // Write the file
-    file_handler_.writeFile(file_name, output.str(), true);
-    std::cout << "A triple has been generated under: " << file_name << std::endl << std::endl;
+    if (!output_sink_.shouldWrite(OUTPUT_STREAM_NAME)) {
+        return;
+    }
+    const bool archived = output_sink_.isArchived(OUTPUT_STREAM_NAME);
+    const ReasonerSyntaxType stream_format =
+        archived ? ReasonerSyntaxType::NTRIPLES : output_format;
+    const std::string stream_output = stream_format != output_format
+                                          ? triple_writer_.generateTripleOutput(stream_format)
+                                          : triple_output;
+    const OutputStream stream{OUTPUT_STREAM_NAME, model_config_->getOutput() + "triples/",
+                              "gen_triple_", reasonerSyntaxTypeToFileExtension(stream_format)};
+
+    // Add the current time to the output
+    std::string output = "# Output from ";
+    output.reserve(output.size() + stream_output.size() + 40);
+    output.append(Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true))
+        .append(archived ? "\n" : "\n\n")
+        .append(stream_output)
+        .append(archived ? "\n" : "\n\n");
+
+    output_sink_.write(stream, std::move(output));
+    LOG_DEBUG("Triples have been queued for the output under: " << stream.directory);
 }
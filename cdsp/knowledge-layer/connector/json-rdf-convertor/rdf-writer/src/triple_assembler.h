@@ -1,8 +1,10 @@
 #ifndef TRIPLE_ASSEMBLER_H
 #define TRIPLE_ASSEMBLER_H
 
+#include <array>
 #include <chrono>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -11,10 +13,11 @@
 
 #include "data_message.h"
 #include "data_types.h"
-#include "i_file_handler.h"
+#include "i_output_sink.h"
 #include "model_config.h"
 #include "node.h"
 #include "reasoner_service.h"
+#include "signal_catalog.h"
 #include "triple_writer.h"
 
 using chrono_time_nanos = std::chrono::nanoseconds;
@@ -26,11 +29,16 @@ struct CoordinateNodes {
 
 class TripleAssembler {
    public:
-    TripleAssembler(std::shared_ptr<ModelConfig> model_config, ReasonerService& reasoner_service,
-                    IFileHandler& file_reader, TripleWriter& triple_writer);
+    static constexpr char OUTPUT_STREAM_NAME[] = "triples";
+
+    TripleAssembler(ModelConfigSnapshot model_config, ReasonerService& reasoner_service,
+                    IOutputSink& output_sink, TripleWriter& triple_writer);
 
     void initialize();
-    void transformMessageToTriple(const DataMessage& message);
+    void updateModelConfig(ModelConfigSnapshot model_config, bool signal_catalog_changed);
+    void transformMessageToTriple(
+        const DataMessage& message,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     ~TripleAssembler() = default;
 
    protected:
@@ -44,18 +52,23 @@ class TripleAssembler {
     void storeTripleOutput(const std::string& triple_output);
 
    private:
-    std::shared_ptr<ModelConfig> model_config_;
+    ModelConfigSnapshot model_config_;
     ReasonerService& reasoner_service_;
-    IFileHandler& file_handler_;
+    IOutputSink& output_sink_;
     TripleWriter& triple_writer_;
     const std::vector<std::map<std::string, std::string>> json_data_;
     chrono_time_nanos coordinates_last_time_stamp_{chrono_time_nanos(0)};
 
-    std::map<chrono_time_nanos, std::unordered_map<std::string, Node>>
+    // Coordinate nodes per timestamp, indexed by CoordinateSlot
+    enum CoordinateSlot : std::size_t { LATITUDE = 0, LONGITUDE = 1 };
+    std::map<chrono_time_nanos, std::array<std::optional<Node>, 2>>
         timestamp_coordinates_messages_map_{};
+    std::array<SignalId, 2> coordinate_signal_ids_;
 
-    std::pair<std::vector<std::string>, std::string> extractObjectsAndDataElements(
-        const std::string& node_name);
+    void resolveCoordinateSignalIds();
+    std::optional<CoordinateSlot> getCoordinateSlot(const Node& node) const;
+    const std::vector<std::string>& getSignalSegments(
+        const Node& node, std::vector<std::string>& split_segments) const;
 
     std::optional<CoordinateNodes> getValidCoordinatesPair();
     void cleanupOldTimestamps();
@@ -26,21 +26,76 @@ unsigned long write_serd_output_to_string(const void* buf, unsigned long len, vo
     return len;
 }
 
+namespace {
+
+std::optional<TripleNodes::Term> copyTerm(const std::optional<TripleNodes::Term>& term,
+                                          const TripleNodes::allocator_type& allocator) {
+    if (!term.has_value()) {
+        return std::nullopt;
+    }
+    return TripleNodes::Term(term->first, std::pmr::string(term->second, allocator));
+}
+
+}  // namespace
+
+TripleNodes::TripleNodes(const allocator_type& allocator)
+    : subject(SerdType{}, std::pmr::string(allocator)),
+      predicate(SerdType{}, std::pmr::string(allocator)),
+      object(SerdType{}, std::pmr::string(allocator)) {}
+
+TripleNodes::TripleNodes(const TripleNodes& other, const allocator_type& allocator)
+    : subject(other.subject.first, std::pmr::string(other.subject.second, allocator)),
+      predicate(other.predicate.first, std::pmr::string(other.predicate.second, allocator)),
+      object(other.object.first, std::pmr::string(other.object.second, allocator)),
+      datatype(copyTerm(other.datatype, allocator)) {}
+
+TripleNodes::TripleNodes(TripleNodes&& other, const allocator_type& allocator)
+    : subject(other.subject.first, std::pmr::string(std::move(other.subject.second), allocator)),
+      predicate(other.predicate.first,
+                std::pmr::string(std::move(other.predicate.second), allocator)),
+      object(other.object.first, std::pmr::string(std::move(other.object.second), allocator)),
+      datatype(copyTerm(other.datatype, allocator)) {}
+
+TripleWriter::MessageTriples::MessageTriples(std::pmr::memory_resource* resource)
+    : unique_rdf_prefix_definitions(resource), rdf_triples_definitions(resource) {}
+
 /**
  * @brief Initiates the TripleWriter.
  *
- * This function initiates and assigns a new identifier to the triple.
+ * This function initiates and assigns a new identifier to the triple. The prefixes and triples
+ * of the message are allocated from the given memory resource until releaseTriple is called or
+ * the next triple is initiated.
  *
  * @param identifier The new identifier for the triple.
+ * @param resource The memory resource for the data of the message, e.g. a message arena.
  *
  * @throws std::runtime_error If the provided identifier is an empty string.
  */
-void TripleWriter::initiateTriple(const std::string& identifier) {
+void TripleWriter::initiateTriple(const std::string& identifier,
+                                  std::pmr::memory_resource* resource) {
     if (identifier.empty())
         throw std::runtime_error("Triple identifier cannot be empty");
     identifier_ = identifier;
-    rdf_triples_definitions_.clear();
-    unique_rdf_prefix_definitions_.clear();
+    message_triples_.reset();
+    message_triples_.emplace(resource);
+}
+
+/**
+ * @brief Releases the prefixes and triples of the current message.
+ *
+ * Must be called before the memory resource passed to initiateTriple is released.
+ */
+void TripleWriter::releaseTriple() { message_triples_.reset(); }
+
+/**
+ * @brief Retrieves the prefixes and triples of the current message, starting them on the default
+ * memory resource if no triple was initiated.
+ */
+TripleWriter::MessageTriples& TripleWriter::getMessageTriples() {
+    if (!message_triples_.has_value()) {
+        message_triples_.emplace(std::pmr::get_default_resource());
+    }
+    return *message_triples_;
 }
 
 /**
@@ -74,19 +129,20 @@ void TripleWriter::addElementObjectToTriple(
     const std::string class_1_instance_uri = createInstanceUri(class_1_prefix, class_1_identifier);
     const std::string class_2_instance_uri = createInstanceUri(class_2_prefix, class_2_identifier);
 
-    TripleNodes triple_nodes;
+    auto& rdf_triples_definitions = getMessageTriples().rdf_triples_definitions;
+    TripleNodes triple_nodes(rdf_triples_definitions.get_allocator());
 
     // Create triples
     triple_nodes.subject = std::make_pair(SERD_CURIE, class_1_instance_uri);
     triple_nodes.predicate =
         std::make_pair(SERD_URI, "http://www.w3.org/1999/02/22-rdf-syntax-ns#type");
     triple_nodes.object = std::make_pair(SERD_CURIE, class_1_prefix + ":" + class_1_identifier);
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 
     triple_nodes.predicate =
         std::make_pair(SERD_CURIE, object_property_prefix + ":" + object_property_identifier);
     triple_nodes.object = std::make_pair(SERD_CURIE, class_2_instance_uri);
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 }
 
 /**
@@ -101,27 +157,29 @@ void TripleWriter::addElementObjectToTriple(
  *                        - The first element is the class identifier.
  *                        - The second element is the data property identifier.
  *                        - The third element is the data type identifier.
- * @param value A string representing the value to be used in the RDF triple.
+ * @param value The typed value to be used in the RDF triple. It is written in the lexical form of
+ *              the data type identifier.
  * @param timestamp A time_point object representing the timestamp for the RDF data.
  * @param ntmValue An optional double representing the NTM value, required for specific cases.
  *
- * @throws std::runtime_error If the value is empty, or if the NTM value is required
+ * @throws std::runtime_error If the value is an empty string, or if the NTM value is required
  *                            but not provided.
  */
 void TripleWriter::addElementDataToTriple(
     const std::string& prefixes,
     const std::tuple<std::string, std::string, std::string>& rdf_data_values,
-    const std::string& value, const std::chrono::system_clock::time_point& timestamp,
+    const NodeValue& value, const std::chrono::system_clock::time_point& timestamp,
     const std::optional<double>& ntmValue) {
-    if (value.empty()) {
+    if (const auto* text = std::get_if<std::string>(&value); text != nullptr && text->empty()) {
         throw std::runtime_error("Triple value cannot be empty");
     }
     // Add all prefixes in the system list
     addSuportedPrefixes(prefixes);
 
     // Insert a prefix to the definitions list that will be used for the observation
-    unique_rdf_prefix_definitions_.emplace("sosa", "http://www.w3.org/ns/sosa/");
-    unique_rdf_prefix_definitions_.emplace("xsd", "http://www.w3.org/2001/XMLSchema#");
+    auto& unique_rdf_prefix_definitions = getMessageTriples().unique_rdf_prefix_definitions;
+    unique_rdf_prefix_definitions.emplace("sosa", "http://www.w3.org/ns/sosa/");
+    unique_rdf_prefix_definitions.emplace("xsd", "http://www.w3.org/2001/XMLSchema#");
 
     // Split prefix and identifier for each RDF data value
     const auto [class_1_prefix, class_1_identifier] =
@@ -131,7 +189,8 @@ void TripleWriter::addElementDataToTriple(
     const auto [data_type_prefix, data_type_identifier] =
         extractPrefixAndIdentifierFromRdfElement(std::get<2>(rdf_data_values));
 
-    TripleNodes triple_nodes;
+    auto& rdf_triples_definitions = getMessageTriples().rdf_triples_definitions;
+    TripleNodes triple_nodes(rdf_triples_definitions.get_allocator());
 
     // Create identifiers instances for each class
 
@@ -155,32 +214,33 @@ void TripleWriter::addElementDataToTriple(
     triple_nodes.predicate =
         std::make_pair(SERD_URI, "http://www.w3.org/1999/02/22-rdf-syntax-ns#type");
     triple_nodes.object = std::make_pair(SERD_CURIE, class_1_prefix + ":" + class_1_identifier);
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 
     triple_nodes.subject = std::make_pair(SERD_CURIE, observation_instance_uri.str());
     triple_nodes.object = std::make_pair(SERD_CURIE, "sosa:Observation");
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 
     triple_nodes.predicate = std::make_pair(SERD_CURIE, "sosa:hasFeatureOfInterest");
     triple_nodes.object = std::make_pair(SERD_CURIE, class_1_instance_uri);
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 
     triple_nodes.predicate = std::make_pair(SERD_CURIE, "sosa:hasSimpleResult");
-    triple_nodes.object = std::make_pair(SERD_LITERAL, value);
+    triple_nodes.object =
+        std::make_pair(SERD_LITERAL, NodeValueFormatter::toLiteral(value, data_type_identifier));
     triple_nodes.datatype =
         std::make_pair(SERD_CURIE, data_type_prefix + ":" + data_type_identifier);
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 
     triple_nodes.predicate = std::make_pair(SERD_CURIE, "sosa:observedProperty");
     triple_nodes.object =
         std::make_pair(SERD_CURIE, data_property_prefix + ":" + data_property_identifier);
     triple_nodes.datatype = std::nullopt;
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 
     triple_nodes.predicate = std::make_pair(SERD_CURIE, "sosa:phenomenonTime");
     triple_nodes.object = std::make_pair(SERD_LITERAL, date_time_with_nano);
     triple_nodes.datatype = std::make_pair(SERD_CURIE, "xsd:dateTime");
-    rdf_triples_definitions_.push_back(triple_nodes);
+    rdf_triples_definitions.push_back(triple_nodes);
 
     if (class_1_identifier == "CurrentLocation" &&
         (data_property_identifier == "latitude" || data_property_identifier == "longitude")) {
@@ -188,12 +248,12 @@ void TripleWriter::addElementDataToTriple(
             throw std::runtime_error("NTM value cannot be empty");
         }
 
-        auto ntmValue_str = std::to_string(ntmValue.value());
         triple_nodes.predicate = std::make_pair(SERD_CURIE, class_1_prefix + ":hasSimpleResultNTM");
-        triple_nodes.object = std::make_pair(SERD_LITERAL, ntmValue_str);
+        triple_nodes.object = std::make_pair(
+            SERD_LITERAL, NodeValueFormatter::toLiteral(ntmValue.value(), data_type_identifier));
         triple_nodes.datatype =
             std::make_pair(SERD_CURIE, data_type_prefix + ":" + data_type_identifier);
-        rdf_triples_definitions_.push_back(triple_nodes);
+        rdf_triples_definitions.push_back(triple_nodes);
     }
 }
 
@@ -218,14 +278,15 @@ std::string TripleWriter::generateTripleOutput(const ReasonerSyntaxType& format)
                                               nullptr, write_serd_output_to_string, this);
 
     // Declare namespaces
-    for (const auto& [prefix, uri] : unique_rdf_prefix_definitions_) {
+    const MessageTriples& message_triples = getMessageTriples();
+    for (const auto& [prefix, uri] : message_triples.unique_rdf_prefix_definitions) {
         SerdNode car_prefix = serd_node_from_string(SERD_CURIE, (const uint8_t*) prefix.c_str());
         SerdNode car_uri = serd_node_from_string(SERD_URI, (const uint8_t*) uri.c_str());
         serd_writer_set_prefix(serd_writer, &car_prefix, &car_uri);
     }
 
     // Write triples
-    for (const TripleNodes& triple_nodes : rdf_triples_definitions_) {
+    for (const TripleNodes& triple_nodes : message_triples.rdf_triples_definitions) {
         SerdNode subject_node = serd_node_from_string(
             triple_nodes.subject.first, (const uint8_t*) triple_nodes.subject.second.c_str());
         SerdNode predicate_node = serd_node_from_string(
@@ -233,10 +294,11 @@ std::string TripleWriter::generateTripleOutput(const ReasonerSyntaxType& format)
         SerdNode object_node = serd_node_from_string(
             triple_nodes.object.first, (const uint8_t*) triple_nodes.object.second.c_str());
 
+        SerdNode datatype_node;
         const SerdNode* datatype_node_ptr = nullptr;
         if (triple_nodes.datatype.has_value()) {
-            std::pair<SerdType, std::string> datatype = triple_nodes.datatype.value();
-            SerdNode datatype_node =
+            const auto& datatype = triple_nodes.datatype.value();
+            datatype_node =
                 serd_node_from_string(datatype.first, (const uint8_t*) datatype.second.c_str());
             datatype_node_ptr = &datatype_node;
         }
@@ -344,7 +406,7 @@ void TripleWriter::addTriplePrefix(std::string& prefix) {
     // Search and add a URI and prefix to the triple prefixes
     for (const auto& [system_prefix, uri] : unique_supported_prefixes_) {
         if (uri.find(prefix) != std::string::npos) {
-            unique_rdf_prefix_definitions_.emplace(system_prefix, uri);
+            getMessageTriples().unique_rdf_prefix_definitions.emplace(system_prefix, uri);
             prefix = system_prefix;
             break;
         }
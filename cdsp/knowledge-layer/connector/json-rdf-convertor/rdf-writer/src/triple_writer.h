@@ -4,6 +4,8 @@
 #include <serd/serd.h>
 
 #include <chrono>
+#include <map>
+#include <memory_resource>
 #include <optional>
 #include <regex>
 #include <string>
@@ -13,24 +15,42 @@
 #include <vector>
 
 #include "data_types.h"
+#include "node_value.h"
 
+/**
+ * @brief Terms of one RDF triple. The strings are allocated from the memory resource of the
+ * container holding the triple, e.g. the arena of the message the triple belongs to.
+ */
 struct TripleNodes {
-    std::pair<SerdType, std::string> subject;
-    std::pair<SerdType, std::string> predicate;
-    std::pair<SerdType, std::string> object;
-    std::optional<std::pair<SerdType, std::string>> datatype;
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    using Term = std::pair<SerdType, std::pmr::string>;
+
+    explicit TripleNodes(const allocator_type& allocator = {});
+    TripleNodes(const TripleNodes& other, const allocator_type& allocator = {});
+    TripleNodes(TripleNodes&& other, const allocator_type& allocator);
+    TripleNodes(TripleNodes&& other) noexcept = default;
+    TripleNodes& operator=(const TripleNodes& other) = default;
+    TripleNodes& operator=(TripleNodes&& other) = default;
+
+    Term subject;
+    Term predicate;
+    Term object;
+    std::optional<Term> datatype;
 };
 
 class TripleWriter {
    public:
-    virtual void initiateTriple(const std::string& identifier);
+    virtual void initiateTriple(
+        const std::string& identifier,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    virtual void releaseTriple();
     virtual void addElementObjectToTriple(
         const std::string& prefixes,
         const std::tuple<std::string, std::string, std::string>& rdf_object_values);
     virtual void addElementDataToTriple(
         const std::string& prefixes,
         const std::tuple<std::string, std::string, std::string>& rdf_data_values,
-        const std::string& value, const std::chrono::system_clock::time_point& dataTime,
+        const NodeValue& value, const std::chrono::system_clock::time_point& dataTime,
         const std::optional<double>& ntmValue = std::nullopt);
 
     virtual std::string generateTripleOutput(const ReasonerSyntaxType& format);
@@ -41,8 +61,16 @@ class TripleWriter {
     std::string identifier_;
 
     std::unordered_map<std::string, std::string> unique_supported_prefixes_;
-    std::map<std::string, std::string> unique_rdf_prefix_definitions_;
-    std::vector<TripleNodes> rdf_triples_definitions_;
+    // Prefixes and triples of the message being written, allocated from the message resource
+    struct MessageTriples {
+        explicit MessageTriples(std::pmr::memory_resource* resource);
+
+        std::pmr::map<std::pmr::string, std::pmr::string> unique_rdf_prefix_definitions;
+        std::pmr::vector<TripleNodes> rdf_triples_definitions;
+    };
+    std::optional<MessageTriples> message_triples_;
+
+    MessageTriples& getMessageTriples();
 
     SerdSyntax getSerdSyntax(const ReasonerSyntaxType& format);
     void addSuportedPrefixes(const std::string& prefixes);
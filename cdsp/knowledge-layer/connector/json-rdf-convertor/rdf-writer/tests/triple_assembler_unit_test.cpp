@@ -7,9 +7,10 @@
 #include <string>
 #include <vector>
 
+#include "artifact_loader.h"
 #include "data_message.h"
 #include "data_types.h"
-#include "mock_i_file_handler.h"
+#include "mock_i_output_sink.h"
 #include "mock_model_config.h"
 #include "mock_reasoner_adapter.h"
 #include "mock_reasoner_service.h"
@@ -27,10 +28,20 @@ class TripleAssemblerUnitTest : public ::testing::Test {
     std::shared_ptr<MockReasonerAdapter> mock_adapter_;
     std::shared_ptr<MockModelConfig> mock_model_config_;
     std::shared_ptr<MockReasonerService> mock_reasoner_service_;
-    MockIFileHandler mock_i_file_handler_;
+    MockIOutputSink mock_i_output_sink_;
     MockTripleWriter mock_triple_writer_;
     std::vector<Node> nodes_{};
 
+    // Results of the SHACL queries as RDFox returns them, a header and one row
+    const std::string object_query_response_ =
+        "?class1\t?object_property\t?class2\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#object_property_1>\t"
+        "<http://www.example.com#object_class_2>";
+    const std::string data_query_response_ =
+        "?class1\t?data_property\t?datatype\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#data_property_1>\t"
+        "<http://www.some.com#datatype_1>";
+
     void SetUp() override {
         // ** Initialize Main Services **
         setenv("VEHICLE_OBJECT_ID", VinUtils::getRandomVinString().c_str(), 1);
@@ -43,7 +54,7 @@ class TripleAssemblerUnitTest : public ::testing::Test {
 
         // Initialize TripleAssembler
         triple_assembler_ = std::make_shared<TripleAssembler>(
-            mock_model_config_, *mock_reasoner_service_, mock_i_file_handler_, mock_triple_writer_);
+            mock_model_config_, *mock_reasoner_service_, mock_i_output_sink_, mock_triple_writer_);
     }
 
     void TearDown() override {
@@ -73,20 +84,22 @@ class TripleAssemblerUnitTest : public ::testing::Test {
      * @param times_executing_data_related_functions The number of times the data-related
      *        functions are expected to be executed.
      * @param query_object_response The predefined response to return when querying
-     *        data using the object-related SHACL query. Defaults to an empty string.
+     *        data using the object-related SHACL query. Defaults to object_query_response_.
      * @param query_data_response The predefined response to return when querying
-     *        data using the data-related SHACL query. Defaults to an empty string.
+     *        data using the data-related SHACL query. Defaults to data_query_response_.
      */
     void initialSetupExpectations(const int& times_initiation,
                                   const int& times_executing_object_related_functions,
                                   const int& times_executing_data_related_functions,
-                                  const std::string& query_object_response = "some_object_query",
-                                  const std::string& query_data_response = "some_data_query") {
+                                  const std::optional<std::string>& query_object_response =
+                                      std::nullopt,
+                                  const std::optional<std::string>& query_data_response =
+                                      std::nullopt) {
         // Mock data store has been setup
         EXPECT_CALL(*mock_reasoner_service_, checkDataStore())
             .Times(times_initiation)
             .WillRepeatedly(testing::Return(true));
-        EXPECT_CALL(mock_triple_writer_, initiateTriple(VIN)).Times(times_initiation);
+        EXPECT_CALL(mock_triple_writer_, initiateTriple(VIN, ::testing::_)).Times(times_initiation);
 
         // Define SHACL queries for object and data properties
         const std::string query_object = R"(prefix ex: <http://www.example.com#>
@@ -103,23 +116,23 @@ SELECT some_data_query)";
         TripleAssemblerHelper::QueryPair query_pair;
         query_pair.object_property = std::make_pair(QueryLanguageType::SPARQL, query_object);
         query_pair.data_property = std::make_pair(QueryLanguageType::SPARQL, query_data);
-        TripleAssemblerHelper triple_assembler_helper({{SchemaType::VEHICLE, query_pair}});
 
-        EXPECT_CALL(*mock_model_config_, getQueriesTripleAssemblerHelper())
+        EXPECT_CALL(*mock_model_config_, getQueryPair(SchemaType::VEHICLE))
             .Times(times_executing_data_related_functions)
-            .WillRepeatedly(testing::Return(triple_assembler_helper));
+            .WillRepeatedly(testing::ReturnRefOfCopy(query_pair));
 
         EXPECT_CALL(*mock_reasoner_service_,
                     queryData(query_object, QueryLanguageType::SPARQL,
                               ::testing::Eq(DataQueryAcceptType::TEXT_TSV)))
             .Times(times_executing_object_related_functions)
-            .WillRepeatedly(testing::Return(query_object_response));
+            .WillRepeatedly(
+                testing::Return(query_object_response.value_or(object_query_response_)));
 
         EXPECT_CALL(*mock_reasoner_service_,
                     queryData(query_data, QueryLanguageType::SPARQL,
                               ::testing::Eq(DataQueryAcceptType::TEXT_TSV)))
             .Times(times_executing_data_related_functions)
-            .WillRepeatedly(testing::Return(query_data_response));
+            .WillRepeatedly(testing::Return(query_data_response.value_or(data_query_response_)));
     }
 };
 
@@ -141,9 +154,15 @@ TEST_F(TripleAssemblerUnitTest, InitializeSuccess) {
     // Mock reading SHACL shape files and returning predefined data
     EXPECT_CALL(*mock_model_config_, getValidationShapes())
         .Times(1)
-        .WillOnce(testing::Return(std::vector<std::pair<ReasonerSyntaxType, std::string>>{
+        .WillOnce(testing::ReturnRefOfCopy(std::vector<std::pair<ReasonerSyntaxType, std::string>>{
             {ReasonerSyntaxType::TURTLE, "data1"}, {ReasonerSyntaxType::NQUADS, "data2"}}));
 
+    // Mock an empty data store, without fingerprints of loaded shapes
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(testing::HasSubstr(ArtifactLoader::FINGERPRINT_GRAPH), testing::_,
+                          testing::_))
+        .WillOnce(testing::Return("?fingerprint\n"));
+
     // Mock loading data into the reasoner service and returning success
     EXPECT_CALL(*mock_reasoner_service_,
                 loadData(testing::StrEq("data1"), ReasonerSyntaxType::TURTLE))
@@ -152,10 +171,41 @@ TEST_F(TripleAssemblerUnitTest, InitializeSuccess) {
                 loadData(testing::StrEq("data2"), ReasonerSyntaxType::NQUADS))
         .WillOnce(testing::Return(true));
 
+    // Mock storing the fingerprints of the loaded shapes
+    EXPECT_CALL(*mock_reasoner_service_, loadData(testing::_, ReasonerSyntaxType::TRIG))
+        .WillOnce(testing::Return(true));
+
     // Assert that the initialization process does not throw any exceptions
     EXPECT_NO_THROW(triple_assembler_->initialize());
 }
 
+/**
+ * @brief Unit test for the initialization of the Triple Assembler after a restart.
+ *
+ * This test verifies that validation shapes whose fingerprint is stored in the data store are
+ * not loaded again.
+ */
+TEST_F(TripleAssemblerUnitTest, InitializeSkipsUnchangedValidationShapes) {
+    EXPECT_CALL(*mock_reasoner_service_, checkDataStore()).WillOnce(testing::Return(true));
+    EXPECT_CALL(*mock_model_config_, getValidationShapes())
+        .WillOnce(testing::ReturnRefOfCopy(std::vector<std::pair<ReasonerSyntaxType, std::string>>{
+            {ReasonerSyntaxType::TURTLE, "data1"}, {ReasonerSyntaxType::TURTLE, "data2"}}));
+
+    // The first shape was loaded by a previous start
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(testing::HasSubstr(ArtifactLoader::FINGERPRINT_GRAPH), testing::_,
+                          testing::_))
+        .WillOnce(testing::Return("?fingerprint\n\"" +
+                                  ArtifactLoader::fingerprint("text/turtle", "data1") + "\"\n"));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(testing::StrEq("data1"), testing::_)).Times(0);
+    EXPECT_CALL(*mock_reasoner_service_, loadData(testing::StrEq("data2"), testing::_))
+        .WillOnce(testing::Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(testing::_, ReasonerSyntaxType::TRIG))
+        .WillOnce(testing::Return(true));
+
+    EXPECT_NO_THROW(triple_assembler_->initialize());
+}
+
 /**
  * @brief Unit test for transforming a message to triples successfully.
  *
@@ -173,12 +223,14 @@ TEST_F(TripleAssemblerUnitTest, TransformMessageToTripleSuccess) {
 
     // Define mock responses for the SHACL queries
     std::string query_object_response =
-        R"(?class1 ?object_property        ?class2
- <http://www.example.com#object_class_1> <http://www.example.com#object_property_1> <http://www.example.com#object_class_2>)";
+        "?class1\t?object_property\t?class2\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#object_property_1>\t"
+        "<http://www.example.com#object_class_2>";
 
     std::string query_data_response =
-        R"(?class1 ?data_property        ?datatype
- <http://www.example.com#object_class_1> <http://www.example.com#data_property_1> <http://www.some.com#datatype_1>)";
+        "?class1\t?data_property\t?datatype\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#data_property_1>\t"
+        "<http://www.some.com#datatype_1>";
 
     // Set up the initial expectations for the test
     initialSetupExpectations(1, 3, 1, query_object_response, query_data_response);
@@ -233,9 +285,13 @@ car:Observation20181116155027123456789
     EXPECT_CALL(*mock_model_config_, getReasonerSettings())
         .Times(2)
         .WillRepeatedly(
-            testing::Return(ReasonerSettings(InferenceEngineType::RDFOX, ReasonerSyntaxType::TURTLE,
-                                             std::vector<SchemaType>{SchemaType::VEHICLE}, true)));
-    EXPECT_CALL(*mock_model_config_, getOutput()).Times(1).WillOnce(testing::Return("output/"));
+            testing::ReturnRefOfCopy(ReasonerSettings(InferenceEngineType::RDFOX,
+                                                      ReasonerSyntaxType::TURTLE,
+                                                      std::vector<SchemaType>{SchemaType::VEHICLE},
+                                                      true)));
+    EXPECT_CALL(*mock_model_config_, getOutput())
+        .Times(1)
+        .WillOnce(testing::ReturnRefOfCopy(std::string("output/")));
     EXPECT_CALL(mock_triple_writer_, generateTripleOutput(ReasonerSyntaxType::TURTLE))
         .Times(1)
         .WillOnce(testing::Return(dummy_ttl));
@@ -246,14 +302,124 @@ car:Observation20181116155027123456789
         .WillOnce(testing::Return(true));
 
     // Mock writing the triple output to a file
-    EXPECT_CALL(mock_i_file_handler_,
-                writeFile(::testing::_, ::testing::Not(::testing::IsEmpty()), ::testing::Eq(true)))
+    EXPECT_CALL(mock_i_output_sink_, shouldWrite(::testing::StrEq("triples")))
+        .WillOnce(testing::Return(true));
+    EXPECT_CALL(mock_i_output_sink_, isArchived(::testing::StrEq("triples")))
+        .WillOnce(testing::Return(false));
+    EXPECT_CALL(mock_i_output_sink_,
+                write(::testing::Field(&OutputStream::directory, "output/triples/"),
+                      ::testing::Not(::testing::IsEmpty())))
         .Times(1);
 
     // Assert that the transformation process does not throw any exceptions
     EXPECT_NO_THROW(triple_assembler_->transformMessageToTriple(message_feature));
 }
 
+/**
+ * @brief Unit test for transforming a message to triples when the triples output is disabled.
+ *
+ * This test verifies that the generated triples are still loaded into the reasoner, but not
+ * written to the output when the output sink skips the triples stream.
+ */
+TEST_F(TripleAssemblerUnitTest, TransformMessageToTripleSkipsDisabledOutput) {
+    setUpMessage();
+    DataMessage message_feature(MessageHeader(VIN, SchemaType::VEHICLE), nodes_);
+
+    std::string query_object_response =
+        "?class1\t?object_property\t?class2\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#object_property_1>\t"
+        "<http://www.example.com#object_class_2>";
+    std::string query_data_response =
+        "?class1\t?data_property\t?datatype\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#data_property_1>\t"
+        "<http://www.some.com#datatype_1>";
+    initialSetupExpectations(1, 3, 1, query_object_response, query_data_response);
+
+    EXPECT_CALL(mock_triple_writer_, addElementObjectToTriple(::testing::_, ::testing::_))
+        .Times(3);
+    EXPECT_CALL(mock_triple_writer_,
+                addElementDataToTriple(::testing::_, ::testing::_, ::testing::_, ::testing::_,
+                                       ::testing::_))
+        .Times(1);
+    EXPECT_CALL(*mock_model_config_, getReasonerSettings())
+        .Times(2)
+        .WillRepeatedly(
+            testing::ReturnRefOfCopy(ReasonerSettings(InferenceEngineType::RDFOX,
+                                                      ReasonerSyntaxType::TURTLE,
+                                                      std::vector<SchemaType>{SchemaType::VEHICLE},
+                                                      true)));
+    EXPECT_CALL(mock_triple_writer_, generateTripleOutput(ReasonerSyntaxType::TURTLE))
+        .WillOnce(testing::Return("ex:a ex:b ex:c ."));
+
+    // The triples are loaded into the reasoner, but not written
+    EXPECT_CALL(*mock_reasoner_service_, loadData(::testing::_, ::testing::_))
+        .WillOnce(testing::Return(true));
+    EXPECT_CALL(mock_i_output_sink_, shouldWrite(::testing::StrEq("triples")))
+        .WillOnce(testing::Return(false));
+    EXPECT_CALL(*mock_model_config_, getOutput()).Times(0);
+    EXPECT_CALL(mock_i_output_sink_, write(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_NO_THROW(triple_assembler_->transformMessageToTriple(message_feature));
+}
+
+/**
+ * @brief Unit test for transforming a message to triples when the triples output is archived.
+ *
+ * This test verifies that the reasoner still gets the triples in the configured format, while
+ * the archived output gets them as N-Triples.
+ */
+TEST_F(TripleAssemblerUnitTest, TransformMessageToTripleWritesArchivedOutputAsNTriples) {
+    setUpMessage();
+    DataMessage message_feature(MessageHeader(VIN, SchemaType::VEHICLE), nodes_);
+
+    std::string query_object_response =
+        "?class1\t?object_property\t?class2\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#object_property_1>\t"
+        "<http://www.example.com#object_class_2>";
+    std::string query_data_response =
+        "?class1\t?data_property\t?datatype\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#data_property_1>\t"
+        "<http://www.some.com#datatype_1>";
+    initialSetupExpectations(1, 3, 1, query_object_response, query_data_response);
+
+    EXPECT_CALL(mock_triple_writer_, addElementObjectToTriple(::testing::_, ::testing::_))
+        .Times(3);
+    EXPECT_CALL(mock_triple_writer_,
+                addElementDataToTriple(::testing::_, ::testing::_, ::testing::_, ::testing::_,
+                                       ::testing::_))
+        .Times(1);
+    EXPECT_CALL(*mock_model_config_, getReasonerSettings())
+        .Times(2)
+        .WillRepeatedly(
+            testing::ReturnRefOfCopy(ReasonerSettings(InferenceEngineType::RDFOX,
+                                                      ReasonerSyntaxType::TURTLE,
+                                                      std::vector<SchemaType>{SchemaType::VEHICLE},
+                                                      true)));
+    EXPECT_CALL(*mock_model_config_, getOutput())
+        .WillOnce(testing::ReturnRefOfCopy(std::string("output/")));
+
+    const std::string turtle = "ex:a ex:b ex:c .";
+    const std::string ntriples = "<http://ex#a> <http://ex#b> <http://ex#c> .";
+    EXPECT_CALL(mock_triple_writer_, generateTripleOutput(ReasonerSyntaxType::TURTLE))
+        .WillOnce(testing::Return(turtle));
+    EXPECT_CALL(mock_triple_writer_, generateTripleOutput(ReasonerSyntaxType::NTRIPLES))
+        .WillOnce(testing::Return(ntriples));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(::testing::StrEq(turtle), ::testing::_))
+        .WillOnce(testing::Return(true));
+
+    EXPECT_CALL(mock_i_output_sink_, shouldWrite(::testing::StrEq("triples")))
+        .WillOnce(testing::Return(true));
+    EXPECT_CALL(mock_i_output_sink_, isArchived(::testing::StrEq("triples")))
+        .WillOnce(testing::Return(true));
+    EXPECT_CALL(mock_i_output_sink_,
+                write(::testing::Field(&OutputStream::extension, ".nt"),
+                      ::testing::AllOf(::testing::HasSubstr(ntriples),
+                                       ::testing::Not(::testing::HasSubstr(turtle)))))
+        .Times(1);
+
+    EXPECT_NO_THROW(triple_assembler_->transformMessageToTriple(message_feature));
+}
+
 /**
  * @brief Unit test for transforming a multi-node message to triples with exception handling.
  *
@@ -276,7 +442,7 @@ TEST_F(TripleAssemblerUnitTest,
     // Mock data store has been setup
     EXPECT_CALL(*mock_reasoner_service_, checkDataStore()).WillOnce(testing::Return(true));
     EXPECT_CALL(mock_triple_writer_,
-                initiateTriple(VIN))  // ID is the same from message header id
+                initiateTriple(VIN, ::testing::_))  // ID is the same from message header id
         .Times(1);
 
     // Mock the file reader to extract the reasoner query:
@@ -289,34 +455,33 @@ TEST_F(TripleAssemblerUnitTest,
         std::make_pair(QueryLanguageType::SPARQL, "MOCK QUERY FOR OBJECTS PROPERTY");
     query_pair.data_property =
         std::make_pair(QueryLanguageType::SPARQL, "MOCK QUERY FOR DATA PROPERTY");
-    std::map<SchemaType, TripleAssemblerHelper::QueryPair> query_map = {
-        {SchemaType::VEHICLE, query_pair}};
-    TripleAssemblerHelper triple_assembler_helper(query_map);
 
-    EXPECT_CALL(*mock_model_config_, getQueriesTripleAssemblerHelper())
+    EXPECT_CALL(*mock_model_config_, getQueryPair(SchemaType::VEHICLE))
         .Times(2)
-        .WillRepeatedly(testing::Return(triple_assembler_helper));
+        .WillRepeatedly(testing::ReturnRefOfCopy(query_pair));
 
     // Mock the SHACL queries responses (first and second node)
     EXPECT_CALL(*mock_reasoner_service_, queryData("MOCK QUERY FOR OBJECTS PROPERTY",
                                                    QueryLanguageType::SPARQL, ::testing::_))
         .Times(3)
-        .WillRepeatedly(testing::Return("MOCK RESPONSE FOR OBJECTS PROPERTY"));
+        .WillRepeatedly(testing::Return(object_query_response_));
     EXPECT_CALL(*mock_reasoner_service_,
                 queryData("MOCK QUERY FOR DATA PROPERTY", QueryLanguageType::SPARQL, ::testing::_))
         .Times(2)
-        .WillRepeatedly(testing::Return("MOCK RESPONSE FOR DATA PROPERTY"));
+        .WillRepeatedly(testing::Return(data_query_response_));
 
     // Mock the data added to the RDF triples (only first node)
     EXPECT_CALL(mock_triple_writer_, addElementObjectToTriple(::testing::_, ::testing::_)).Times(3);
 
     // Mock the data triple writer adding the values of the correct nodes one and two
     EXPECT_CALL(mock_triple_writer_,
-                addElementDataToTriple(::testing::_, ::testing::_, ::testing::Eq("98.6"),
+                addElementDataToTriple(::testing::_, ::testing::_,
+                                       ::testing::Eq(NodeValue(std::string("98.6"))),
                                        ::testing::_, ::testing::_))
         .Times(1);
     EXPECT_CALL(mock_triple_writer_,
-                addElementDataToTriple(::testing::_, ::testing::_, ::testing::Eq("75"),
+                addElementDataToTriple(::testing::_, ::testing::_,
+                                       ::testing::Eq(NodeValue(std::string("75"))),
                                        ::testing::_, ::testing::_))
         .Times(1);
 
@@ -326,9 +491,13 @@ TEST_F(TripleAssemblerUnitTest,
     EXPECT_CALL(*mock_model_config_, getReasonerSettings())
         .Times(2)
         .WillRepeatedly(
-            testing::Return(ReasonerSettings(InferenceEngineType::RDFOX, ReasonerSyntaxType::TURTLE,
-                                             std::vector<SchemaType>{SchemaType::VEHICLE}, true)));
-    EXPECT_CALL(*mock_model_config_, getOutput()).Times(1).WillOnce(testing::Return("output/"));
+            testing::ReturnRefOfCopy(ReasonerSettings(InferenceEngineType::RDFOX,
+                                                      ReasonerSyntaxType::TURTLE,
+                                                      std::vector<SchemaType>{SchemaType::VEHICLE},
+                                                      true)));
+    EXPECT_CALL(*mock_model_config_, getOutput())
+        .Times(1)
+        .WillOnce(testing::ReturnRefOfCopy(std::string("output/")));
 
     EXPECT_CALL(mock_triple_writer_, generateTripleOutput(::testing::_))
         .Times(1)
@@ -340,13 +509,48 @@ TEST_F(TripleAssemblerUnitTest,
         .WillOnce(testing::Return(true));
 
     // Mock write triple output file (only first two nodes)
-    EXPECT_CALL(mock_i_file_handler_, writeFile(::testing::_, ::testing::_, ::testing::Eq(true)))
-        .Times(1);
+    EXPECT_CALL(mock_i_output_sink_, shouldWrite(::testing::_)).WillOnce(testing::Return(true));
+    EXPECT_CALL(mock_i_output_sink_, isArchived(::testing::_)).WillOnce(testing::Return(false));
+    EXPECT_CALL(mock_i_output_sink_, write(::testing::_, ::testing::_)).Times(1);
 
     // Assert
     EXPECT_NO_THROW(triple_assembler_->transformMessageToTriple(message_feature));
 }
 
+/**
+ * @brief Unit test for transforming a message whose data query returns a malformed result.
+ *
+ * This test verifies that a result row without a subject, predicate and object is not read as
+ * empty values, but skips the data element of the node.
+ */
+TEST_F(TripleAssemblerUnitTest, TransformMessageToTripleSkipsMalformedQueryResult) {
+    setUpMessage();
+    DataMessage message_feature(MessageHeader(VIN, SchemaType::VEHICLE), nodes_);
+
+    const std::string malformed_data_response =
+        "?class1\t?data_property\t?datatype\n"
+        "<http://www.example.com#object_class_1>\t<http://www.example.com#data_property_1>";
+    initialSetupExpectations(1, 3, 1, std::nullopt, malformed_data_response);
+
+    EXPECT_CALL(mock_triple_writer_, addElementObjectToTriple(::testing::_, ::testing::_))
+        .Times(3);
+    EXPECT_CALL(mock_triple_writer_,
+                addElementDataToTriple(::testing::_, ::testing::_, ::testing::_, ::testing::_,
+                                       ::testing::_))
+        .Times(0);
+    EXPECT_CALL(*mock_model_config_, getReasonerSettings())
+        .WillOnce(
+            testing::ReturnRefOfCopy(ReasonerSettings(InferenceEngineType::RDFOX,
+                                                      ReasonerSyntaxType::TURTLE,
+                                                      std::vector<SchemaType>{SchemaType::VEHICLE},
+                                                      true)));
+    EXPECT_CALL(mock_triple_writer_, generateTripleOutput(ReasonerSyntaxType::TURTLE))
+        .WillOnce(testing::Return(""));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_NO_THROW(triple_assembler_->transformMessageToTriple(message_feature));
+}
+
 /**
  * @brief Unit test for initialization failure of the Triple Assembler when no data store is
  * set.
@@ -370,7 +574,7 @@ TEST_F(TripleAssemblerUnitTest, InitializeFailIfValidationShapesAreEmptyInTheMod
     // Create a mock ModelConfig with an empty list of validation shapes files
     EXPECT_CALL(*mock_model_config_, getValidationShapes())
         .Times(1)
-        .WillOnce(testing::Return(
+        .WillOnce(testing::ReturnRefOfCopy(
             std::vector<std::pair<ReasonerSyntaxType, std::string>>{}));  // This cannot be empty
                                                                           // for successful
                                                                           // initialization
@@ -390,9 +594,14 @@ TEST_F(TripleAssemblerUnitTest, InitializeFailsIfLoadingDataFromValidationShapes
     // Mock reading SHACL shape files
     EXPECT_CALL(*mock_model_config_, getValidationShapes())
         .Times(1)
-        .WillOnce(testing::Return(std::vector<std::pair<ReasonerSyntaxType, std::string>>{
+        .WillOnce(testing::ReturnRefOfCopy(std::vector<std::pair<ReasonerSyntaxType, std::string>>{
             {ReasonerSyntaxType::TURTLE, "some_validation_shape_content"}}));
 
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(testing::HasSubstr(ArtifactLoader::FINGERPRINT_GRAPH), testing::_,
+                          testing::_))
+        .WillOnce(testing::Return(""));
+
     // Simulate a failure in loading the data, returning false
     EXPECT_CALL(*mock_reasoner_service_,
                 loadData(testing::StrEq("some_validation_shape_content"), ::testing::_))
@@ -416,10 +625,10 @@ TEST_F(TripleAssemblerUnitTest, TransformMessageToTripleFailsWhenAnyDataStoreIsS
     EXPECT_CALL(*mock_reasoner_service_, checkDataStore()).WillOnce(testing::Return(false));
 
     // Ensure that no other functions are called since the data store is not set up
-    EXPECT_CALL(mock_triple_writer_, initiateTriple(::testing::_)).Times(0);
+    EXPECT_CALL(mock_triple_writer_, initiateTriple(::testing::_, ::testing::_)).Times(0);
     EXPECT_CALL(*mock_reasoner_service_, queryData(::testing::_, ::testing::_, ::testing::_))
         .Times(0);
-    EXPECT_CALL(*mock_model_config_, getQueriesTripleAssemblerHelper()).Times(0);
+    EXPECT_CALL(*mock_model_config_, getQueryPair(::testing::_)).Times(0);
     EXPECT_CALL(*mock_model_config_, getReasonerSettings()).Times(0);
     EXPECT_CALL(*mock_model_config_, getOutput()).Times(0);
     EXPECT_CALL(mock_triple_writer_, addElementObjectToTriple(::testing::_, ::testing::_)).Times(0);
@@ -470,9 +679,13 @@ TEST_F(TripleAssemblerUnitTest, TransformMessageToRDFTripleWithCoordinatesSucces
     EXPECT_CALL(*mock_model_config_, getReasonerSettings())
         .Times(2)
         .WillRepeatedly(
-            testing::Return(ReasonerSettings(InferenceEngineType::RDFOX, ReasonerSyntaxType::TURTLE,
-                                             std::vector<SchemaType>{SchemaType::VEHICLE}, true)));
-    EXPECT_CALL(*mock_model_config_, getOutput()).Times(1).WillOnce(testing::Return("output/"));
+            testing::ReturnRefOfCopy(ReasonerSettings(InferenceEngineType::RDFOX,
+                                                      ReasonerSyntaxType::TURTLE,
+                                                      std::vector<SchemaType>{SchemaType::VEHICLE},
+                                                      true)));
+    EXPECT_CALL(*mock_model_config_, getOutput())
+        .Times(1)
+        .WillOnce(testing::ReturnRefOfCopy(std::string("output/")));
     EXPECT_CALL(mock_triple_writer_, generateTripleOutput(ReasonerSyntaxType::TURTLE))
         .Times(1)
         .WillOnce(testing::Return(dummy_ttl));
@@ -483,8 +696,13 @@ TEST_F(TripleAssemblerUnitTest, TransformMessageToRDFTripleWithCoordinatesSucces
         .WillOnce(testing::Return(true));
 
     // Mock writing the triple output to a file
-    EXPECT_CALL(mock_i_file_handler_,
-                writeFile(::testing::_, ::testing::Not(::testing::IsEmpty()), ::testing::Eq(true)))
+    EXPECT_CALL(mock_i_output_sink_, shouldWrite(::testing::StrEq("triples")))
+        .WillOnce(testing::Return(true));
+    EXPECT_CALL(mock_i_output_sink_, isArchived(::testing::StrEq("triples")))
+        .WillOnce(testing::Return(false));
+    EXPECT_CALL(mock_i_output_sink_,
+                write(::testing::Field(&OutputStream::directory, "output/triples/"),
+                      ::testing::Not(::testing::IsEmpty())))
         .Times(1);
 
     // Assert that the transformation process does not throw any exceptions
@@ -525,9 +743,13 @@ TEST_F(TripleAssemblerUnitTest, TransformMessageToTripleFailsWhenCoordinatesAreN
     EXPECT_CALL(*mock_model_config_, getReasonerSettings())
         .Times(2)
         .WillRepeatedly(
-            testing::Return(ReasonerSettings(InferenceEngineType::RDFOX, ReasonerSyntaxType::TURTLE,
-                                             std::vector<SchemaType>{SchemaType::VEHICLE}, true)));
-    EXPECT_CALL(*mock_model_config_, getOutput()).Times(1).WillOnce(testing::Return("output/"));
+            testing::ReturnRefOfCopy(ReasonerSettings(InferenceEngineType::RDFOX,
+                                                      ReasonerSyntaxType::TURTLE,
+                                                      std::vector<SchemaType>{SchemaType::VEHICLE},
+                                                      true)));
+    EXPECT_CALL(*mock_model_config_, getOutput())
+        .Times(1)
+        .WillOnce(testing::ReturnRefOfCopy(std::string("output/")));
     EXPECT_CALL(mock_triple_writer_, generateTripleOutput(::testing::_))
         .Times(1)
         .WillRepeatedly(testing::Return(dummy_ttl));
@@ -538,8 +760,9 @@ TEST_F(TripleAssemblerUnitTest, TransformMessageToTripleFailsWhenCoordinatesAreN
         .WillOnce(testing::Return(true));
 
     // Mock write triple output file (only first node)
-    EXPECT_CALL(mock_i_file_handler_, writeFile(::testing::_, ::testing::_, ::testing::Eq(true)))
-        .Times(1);
+    EXPECT_CALL(mock_i_output_sink_, shouldWrite(::testing::_)).WillOnce(testing::Return(true));
+    EXPECT_CALL(mock_i_output_sink_, isArchived(::testing::_)).WillOnce(testing::Return(false));
+    EXPECT_CALL(mock_i_output_sink_, write(::testing::_, ::testing::_)).Times(1);
 
     // Assert
     EXPECT_NO_THROW(triple_assembler_->transformMessageToTriple(message_feature));
@@ -7,14 +7,15 @@
 
 class MockTripleWriter : public TripleWriter {
    public:
-    MOCK_METHOD(void, initiateTriple, (const std::string&), (override));
+    MOCK_METHOD(void, initiateTriple, (const std::string&, std::pmr::memory_resource*),
+                (override));
     MOCK_METHOD(void, addElementObjectToTriple,
                 (const std::string&, (const std::tuple<std::string, std::string, std::string>&) ),
                 (override));
 
     MOCK_METHOD(void, addElementDataToTriple,
                 ((const std::string&), (const std::tuple<std::string, std::string, std::string>&),
-                 (const std::string&), (const std::chrono::system_clock::time_point&),
+                 (const NodeValue&), (const std::chrono::system_clock::time_point&),
                  (const std::optional<double>&) ),
                 (override));
     MOCK_METHOD(std::string, generateTripleOutput, (const ReasonerSyntaxType&), (override));
@@ -0,0 +1,45 @@
+#include "fleet_query.h"
+
+#include <stdexcept>
+
+#include "helper.h"
+#include "query_marker.h"
+
+/**
+ * @brief Finds the instance variable of a fleet query, e.g. `#FLEET(?instance)`.
+ *
+ * @param query The query text.
+ * @return The variable without the leading '?', or std::nullopt if it is not a fleet query.
+ * @throws std::invalid_argument if the marker does not name a variable.
+ */
+std::optional<std::string> FleetQuery::findInstanceVariable(const std::string& query) {
+    const auto marker = findQueryMarker(query, MARKER);
+    if (!marker) {
+        return std::nullopt;
+    }
+    return marker->variable;
+}
+
+/**
+ * @brief Binds the instance variable of a fleet query to the given instances.
+ *
+ * @param query The query text.
+ * @param variable The instance variable without the leading '?'.
+ * @param instances The instances the query runs for.
+ * @return The query with a trailing `VALUES` clause over the instances.
+ * @throws std::invalid_argument if there is no instance.
+ */
+std::string FleetQuery::applyInstances(const std::string& query, const std::string& variable,
+                                       const std::vector<std::string>& instances) {
+    if (instances.empty()) {
+        throw std::invalid_argument("A fleet query needs at least one instance");
+    }
+    // The clause starts on a new line, as the query may end with a comment
+    std::string fleet_query = query;
+    fleet_query += "\nVALUES ?" + variable + " {";
+    for (const auto& instance : instances) {
+        fleet_query += " \"" + Helper::escapeLiteral(instance) + '"';
+    }
+    fleet_query += " }\n";
+    return fleet_query;
+}
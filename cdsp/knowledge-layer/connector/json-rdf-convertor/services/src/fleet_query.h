@@ -0,0 +1,29 @@
+#ifndef FLEET_QUERY_H
+#define FLEET_QUERY_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Rewriting of output queries that run for a whole fleet of vehicles at once.
+ *
+ * An output query becomes a fleet query with a marker comment naming the variable that holds the
+ * vehicle instance, e.g. `#FLEET(?instance)`. Instead of one run per vehicle, the query runs once
+ * with a `VALUES ?instance { "VIN1" "VIN2" }` clause appended, so the variable is bound to each
+ * instance with new data as a string literal. The query uses it to select the facts of a vehicle,
+ * e.g. `BIND(IRI(CONCAT(STR(car:Vehicle), ?instance)) AS ?vehicle)`, and the combined result is
+ * split back into one result per instance by the value of the variable.
+ *
+ * The query must not have a VALUES clause of its own after its WHERE clause.
+ */
+class FleetQuery {
+   public:
+    static constexpr char MARKER[] = "#FLEET(";
+
+    static std::optional<std::string> findInstanceVariable(const std::string& query);
+    static std::string applyInstances(const std::string& query, const std::string& variable,
+                                      const std::vector<std::string>& instances);
+};
+
+#endif  // FLEET_QUERY_H
@@ -0,0 +1,49 @@
+#include "query_marker.h"
+
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+bool isVariableCharacter(char character) {
+    return std::isalnum(static_cast<unsigned char>(character)) != 0 || character == '_';
+}
+}  // namespace
+
+/**
+ * @brief Finds a marker comment that names a variable in a query, e.g. `#FLEET(?instance)`.
+ *
+ * Spaces and tabs are allowed around the variable.
+ *
+ * @param query The query text.
+ * @param marker The start of the marker up to the opening parenthesis, e.g. `#FLEET(`.
+ * @return The marker, or std::nullopt if the query does not contain it.
+ * @throws std::invalid_argument if the marker does not name a variable.
+ */
+std::optional<QueryMarker> findQueryMarker(const std::string& query, std::string_view marker) {
+    const std::size_t position = query.find(marker);
+    if (position == std::string::npos) {
+        return std::nullopt;
+    }
+
+    std::size_t index = position + marker.size();
+    const auto skip_spaces = [&query, &index]() {
+        while (index < query.size() && (query[index] == ' ' || query[index] == '\t')) {
+            ++index;
+        }
+    };
+    skip_spaces();
+    if (index < query.size() && query[index] == '?') {
+        const std::size_t variable_start = ++index;
+        while (index < query.size() && isVariableCharacter(query[index])) {
+            ++index;
+        }
+        const std::size_t variable_end = index;
+        skip_spaces();
+        if (variable_end > variable_start && index < query.size() && query[index] == ')') {
+            return QueryMarker{position, index + 1 - position,
+                               query.substr(variable_start, variable_end - variable_start)};
+        }
+    }
+    throw std::invalid_argument("Invalid marker in output query, expected " + std::string(marker) +
+                                "?variable)");
+}
@@ -0,0 +1,21 @@
+#ifndef QUERY_MARKER_H
+#define QUERY_MARKER_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief A marker comment in an output query that names a variable, e.g. `#WATERMARK(?t)`.
+ */
+struct QueryMarker {
+    std::size_t position;
+    std::size_t length;
+    // The variable without the leading '?'
+    std::string variable;
+};
+
+std::optional<QueryMarker> findQueryMarker(const std::string& query, std::string_view marker);
+
+#endif  // QUERY_MARKER_H
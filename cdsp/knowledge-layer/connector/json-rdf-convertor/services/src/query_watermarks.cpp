@@ -0,0 +1,307 @@
+#include "query_watermarks.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory_resource>
+#include <sstream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "helper.h"
+#include "logger.h"
+#include "sparql_json_result_parser.h"
+#include "tabular_result_reader.h"
+
+namespace {
+/**
+ * @brief Builds the TriG document of the watermark triple of a query.
+ *
+ * The watermark is stored as its serialized JSON, which keeps numbers and strings apart.
+ */
+std::string buildWatermarkTrig(const std::string& key, const nlohmann::json& watermark) {
+    return std::string("<") + QueryWatermarks::WATERMARK_GRAPH + "> {\n<" +
+           QueryWatermarks::QUERY_IRI_PREFIX + key + "> <" + QueryWatermarks::WATERMARK_PREDICATE +
+           "> \"" + Helper::escapeLiteral(watermark.dump()) + "\" .\n}\n";
+}
+}  // namespace
+
+/**
+ * @brief Constructs the watermarks of the output queries.
+ *
+ * @param reasoner_service The reasoner service whose datastore stores the watermarks.
+ */
+QueryWatermarks::QueryWatermarks(std::shared_ptr<ReasonerService> reasoner_service)
+    : reasoner_service_(std::move(reasoner_service)) {}
+
+/**
+ * @brief Finds the watermark marker of a query, e.g. `#WATERMARK(?Vehicle_Speed_Timestamp)`.
+ *
+ * @param query The query text.
+ * @return The marker, or std::nullopt if the query is not incremental.
+ * @throws std::invalid_argument if the marker does not name a variable.
+ */
+std::optional<QueryWatermarks::Marker> QueryWatermarks::findMarker(const std::string& query) {
+    return findQueryMarker(query, MARKER);
+}
+
+/**
+ * @brief Replaces the marker of a query with a filter on its watermark.
+ *
+ * @param query The query text.
+ * @param marker The marker of the query.
+ * @return The query with the filter, or the unchanged query if it has no watermark yet.
+ */
+std::string QueryWatermarks::applyWatermark(const std::string& query, const Marker& marker) {
+    const std::optional<nlohmann::json> watermark = getWatermark(query);
+    if (!watermark) {
+        return query;
+    }
+
+    std::string filtered_query = query;
+    filtered_query.replace(marker.position, marker.length,
+                           "FILTER(" + buildCondition(marker.variable, *watermark) + ")");
+    return filtered_query;
+}
+
+/**
+ * @brief Replaces the marker of a fleet query with a filter on the watermark of each instance.
+ *
+ * @param query The query text, without the VALUES clause over the instances.
+ * @param marker The marker of the query.
+ * @param instance_variable The instance variable without the leading '?'.
+ * @param instances The instances the query runs for.
+ * @return The query with the filter, or the unchanged query if no instance has a watermark yet.
+ */
+std::string QueryWatermarks::applyFleetWatermarks(const std::string& query, const Marker& marker,
+                                                  const std::string& instance_variable,
+                                                  const std::vector<std::string>& instances) {
+    std::string conditions;
+    for (const auto& instance : instances) {
+        const std::optional<nlohmann::json> watermark = getWatermark(query, instance);
+        if (!watermark) {
+            continue;
+        }
+        if (!conditions.empty()) {
+            conditions += " && ";
+        }
+        conditions += "(?" + instance_variable + " != \"" + Helper::escapeLiteral(instance) +
+                      "\" || " + buildCondition(marker.variable, *watermark) + ")";
+    }
+    if (conditions.empty()) {
+        return query;
+    }
+
+    std::string filtered_query = query;
+    filtered_query.replace(marker.position, marker.length, "FILTER(" + conditions + ")");
+    return filtered_query;
+}
+
+/**
+ * @brief Advances the watermark of a query to the largest value of its variable in a result and
+ * stores it in the datastore.
+ *
+ * @param query The query text.
+ * @param marker The marker of the query.
+ * @param result The grouped result of the query (see JSONWriter).
+ * @param is_ai_reasoner_inference_results Whether the values are grouped as inference results.
+ * @param instance The vehicle instance of the result, if the query is a fleet query.
+ */
+void QueryWatermarks::advanceWatermark(const std::string& query, const Marker& marker,
+                                       const nlohmann::json& result,
+                                       bool is_ai_reasoner_inference_results,
+                                       const std::optional<std::string>& instance) {
+    const std::optional<nlohmann::json> maximum =
+        findMaximum(result, marker.variable, is_ai_reasoner_inference_results);
+    if (!maximum) {
+        return;
+    }
+
+    const std::string key = watermarkKey(query, instance);
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_) {
+        loadWatermarks();
+    }
+    std::optional<nlohmann::json> previous;
+    if (const auto entry = watermarks_.find(key); entry != watermarks_.end()) {
+        if (!isGreater(*maximum, entry->second)) {
+            return;
+        }
+        previous = entry->second;
+    }
+
+    watermarks_[key] = *maximum;
+    if (!storeWatermark(key, *maximum, previous)) {
+        LOG_WARN("The watermark " << maximum->dump() << " of an output query could not be stored");
+    }
+}
+
+/**
+ * @brief Retrieves the watermark of a query, loading the stored watermarks on first use.
+ *
+ * @param query The query text.
+ * @param instance The vehicle instance, if the query is a fleet query.
+ * @return The watermark, or std::nullopt if the query has none yet.
+ */
+std::optional<nlohmann::json> QueryWatermarks::getWatermark(
+    const std::string& query, const std::optional<std::string>& instance) {
+    const std::string key = watermarkKey(query, instance);
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_) {
+        loadWatermarks();
+    }
+    const auto entry = watermarks_.find(key);
+    if (entry == watermarks_.end()) {
+        return std::nullopt;
+    }
+    return entry->second;
+}
+
+/**
+ * @brief Computes the key of a query, the 64-bit FNV-1a hash of its text.
+ *
+ * @param query The query text.
+ * @return The hash as 16 hexadecimal digits.
+ */
+std::string QueryWatermarks::queryKey(const std::string& query) {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << Helper::hashFnv1a(query);
+    return stream.str();
+}
+
+/**
+ * @brief Computes the key of the watermark of a query, or of one instance of a fleet query.
+ */
+std::string QueryWatermarks::watermarkKey(const std::string& query,
+                                          const std::optional<std::string>& instance) {
+    return instance ? queryKey(query + '\n' + *instance) : queryKey(query);
+}
+
+/**
+ * @brief Builds the condition that a value of a variable is above a watermark, e.g. `?t > 42`.
+ */
+std::string QueryWatermarks::buildCondition(const std::string& variable,
+                                            const nlohmann::json& watermark) {
+    if (watermark.is_number()) {
+        return "?" + variable + " > " + watermark.dump();
+    }
+    return "STR(?" + variable + ") > \"" + Helper::escapeLiteral(watermark.get<std::string>()) +
+           "\"";
+}
+
+/**
+ * @brief Loads the watermarks stored in the watermark graph of the datastore.
+ *
+ * Stored values that cannot be parsed are skipped, so their queries run in full once.
+ */
+void QueryWatermarks::loadWatermarks() {
+    const std::string query = std::string("SELECT ?query ?watermark WHERE { GRAPH <") +
+                              WATERMARK_GRAPH + "> { ?query <" + WATERMARK_PREDICATE +
+                              "> ?watermark } }";
+    const std::string response = reasoner_service_->queryData(query, QueryLanguageType::SPARQL,
+                                                              DataQueryAcceptType::TEXT_TSV);
+
+    const std::string iri_prefix = std::string("<") + QUERY_IRI_PREFIX;
+    TabularResultReader reader(response, '\t');
+    std::pmr::vector<std::string_view> cells;
+    while (reader.nextRow(cells)) {
+        if (cells.size() < 2 || cells[0].size() <= iri_prefix.size() + 1 ||
+            cells[0].substr(0, iri_prefix.size()) != iri_prefix) {
+            continue;
+        }
+        const std::string key(cells[0].substr(iri_prefix.size(),
+                                              cells[0].size() - iri_prefix.size() - 1));
+        nlohmann::json watermark = nlohmann::json::parse(
+            TabularResultReader::decodeTerm(cells[1]), nullptr, false);
+        if (watermark.is_number() || watermark.is_string()) {
+            watermarks_[key] = std::move(watermark);
+        } else {
+            LOG_WARN("Skipping an invalid stored watermark: " << cells[1]);
+        }
+    }
+    loaded_ = true;
+}
+
+/**
+ * @brief Replaces the stored watermark of a query. The watermark graph is written as a graph of
+ * the connector, which keeps the cached results of the output queries.
+ *
+ * @param key The key of the query.
+ * @param watermark The new watermark.
+ * @param previous The stored watermark to delete, if any.
+ * @return true if the new watermark was stored.
+ */
+bool QueryWatermarks::storeWatermark(const std::string& key, const nlohmann::json& watermark,
+                                     const std::optional<nlohmann::json>& previous) {
+    if (previous) {
+        reasoner_service_->deleteGraphData(WATERMARK_GRAPH, buildWatermarkTrig(key, *previous),
+                                           ReasonerSyntaxType::TRIG);
+    }
+    return reasoner_service_->loadGraphData(WATERMARK_GRAPH, buildWatermarkTrig(key, watermark),
+                                            ReasonerSyntaxType::TRIG);
+}
+
+/**
+ * @brief Finds the largest value of a variable in a grouped query result.
+ *
+ * The variable is mapped to its schema and data point like the JSONWriter does: underscores
+ * become dots and the name is split at the first dot.
+ *
+ * @return The largest value, or std::nullopt if the result has no value of the variable.
+ */
+std::optional<nlohmann::json> QueryWatermarks::findMaximum(const nlohmann::json& result,
+                                                           const std::string& variable,
+                                                           bool is_ai_reasoner_inference_results) {
+    if (!result.is_array()) {
+        return std::nullopt;
+    }
+    std::string name = variable;
+    std::replace(name.begin(), name.end(), '_', '.');
+    const std::size_t dot_pos = name.find('.');
+    if (dot_pos == std::string::npos) {
+        return std::nullopt;
+    }
+    const std::string schema = name.substr(0, dot_pos);
+    const std::string data_point = name.substr(dot_pos + 1);
+
+    std::optional<nlohmann::json> maximum;
+    for (const auto& row : result) {
+        const auto section = row.find(schema);
+        if (section == row.end() || !section->is_object()) {
+            continue;
+        }
+        nlohmann::json values;
+        if (is_ai_reasoner_inference_results) {
+            const auto inference_results =
+                section->find(SparqlJsonResultParser::INFERENCE_RESULTS_KEY);
+            if (inference_results == section->end() || !inference_results->is_string()) {
+                continue;
+            }
+            values = nlohmann::json::parse(inference_results->get<std::string>(), nullptr, false);
+        }
+        const nlohmann::json& data_points = is_ai_reasoner_inference_results ? values : *section;
+        const auto value = data_points.find(data_point);
+        if (value == data_points.end() || !(value->is_number() || value->is_string())) {
+            continue;
+        }
+        if (!maximum || isGreater(*value, *maximum)) {
+            maximum = *value;
+        }
+    }
+    return maximum;
+}
+
+/**
+ * @brief Compares a value with a watermark: numbers numerically, strings lexicographically.
+ *
+ * @return true if the value is greater. Values of another type than the watermark are not.
+ */
+bool QueryWatermarks::isGreater(const nlohmann::json& value, const nlohmann::json& watermark) {
+    if (value.is_number() && watermark.is_number()) {
+        return value > watermark;
+    }
+    if (value.is_string() && watermark.is_string()) {
+        return value.get_ref<const std::string&>() > watermark.get_ref<const std::string&>();
+    }
+    return false;
+}
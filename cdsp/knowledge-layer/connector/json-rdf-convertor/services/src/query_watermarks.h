@@ -0,0 +1,89 @@
+#ifndef QUERY_WATERMARKS_H
+#define QUERY_WATERMARKS_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "query_marker.h"
+#include "reasoner_service.h"
+
+/**
+ * @brief Watermarks of incremental output queries.
+ *
+ * An output query becomes incremental with a marker comment in its WHERE clause, naming a variable
+ * that the query selects, e.g. `#WATERMARK(?Vehicle_DrivingStyle_End_Timestamp)`. The watermark of
+ * the query is the largest value of that variable in its results so far. Once there is a
+ * watermark, the marker is replaced by a filter, so the query only matches newer facts:
+ *
+ * - numbers are compared as numbers, e.g. `FILTER(?t > 42)`,
+ * - all other values are compared by their lexical form, e.g.
+ *   `FILTER(STR(?t) > "2024-01-01T10:00:00Z")`. Timestamps must therefore be written in one
+ *   ISO 8601 format with the same time zone.
+ *
+ * Facts that arrive later with a value below the watermark are not matched anymore. Without a
+ * watermark the marker stays a comment and the query runs in full.
+ *
+ * A fleet query (see FleetQuery) has a watermark per vehicle instance, as the vehicles send their
+ * data independently. The marker becomes one filter with a condition per instance that has a
+ * watermark, e.g. `FILTER((?instance != "VIN1" || ?t > 42) && (?instance != "VIN2" || ?t > 17))`.
+ *
+ * The watermarks are stored in the named graph `urn:cdsp:watermarks` of the datastore, keyed by a
+ * hash of the query text and the instance, so they survive restarts and are reset together with
+ * the data. A changed query starts without a watermark. Storing a watermark only outdates the
+ * cached results of queries that read named graphs, so it does not make the output queries run
+ * again on unchanged data.
+ */
+class QueryWatermarks {
+   public:
+    static constexpr char WATERMARK_GRAPH[] = "urn:cdsp:watermarks";
+    static constexpr char WATERMARK_PREDICATE[] = "urn:cdsp:watermark";
+    static constexpr char QUERY_IRI_PREFIX[] = "urn:cdsp:query:";
+    static constexpr char MARKER[] = "#WATERMARK(";
+
+    using Marker = QueryMarker;
+
+    explicit QueryWatermarks(std::shared_ptr<ReasonerService> reasoner_service);
+
+    static std::optional<Marker> findMarker(const std::string& query);
+
+    std::string applyWatermark(const std::string& query, const Marker& marker);
+    std::string applyFleetWatermarks(const std::string& query, const Marker& marker,
+                                     const std::string& instance_variable,
+                                     const std::vector<std::string>& instances);
+    void advanceWatermark(const std::string& query, const Marker& marker,
+                          const nlohmann::json& result, bool is_ai_reasoner_inference_results,
+                          const std::optional<std::string>& instance = std::nullopt);
+    std::optional<nlohmann::json> getWatermark(
+        const std::string& query, const std::optional<std::string>& instance = std::nullopt);
+
+    static std::string queryKey(const std::string& query);
+
+   private:
+    std::shared_ptr<ReasonerService> reasoner_service_;
+
+    // Guards the watermarks, as queries may be processed on several threads
+    std::mutex mutex_;
+    bool loaded_ = false;
+    std::unordered_map<std::string, nlohmann::json> watermarks_;
+
+    void loadWatermarks();
+    bool storeWatermark(const std::string& key, const nlohmann::json& watermark,
+                        const std::optional<nlohmann::json>& previous);
+
+    static std::string watermarkKey(const std::string& query,
+                                    const std::optional<std::string>& instance);
+    static std::string buildCondition(const std::string& variable,
+                                      const nlohmann::json& watermark);
+    static std::optional<nlohmann::json> findMaximum(const nlohmann::json& result,
+                                                     const std::string& variable,
+                                                     bool is_ai_reasoner_inference_results);
+    static bool isGreater(const nlohmann::json& value, const nlohmann::json& watermark);
+};
+
+#endif  // QUERY_WATERMARKS_H
@@ -1,32 +1,119 @@
 #include "reasoning_query_service.h"
 
+#include <stdexcept>
+
 #include "data_types.h"
+#include "fleet_query.h"
 #include "json_writer.h"
 
-ReasoningQueryService::ReasoningQueryService(std::shared_ptr<ReasonerService> reasoning_service)
-    : reasoning_service_(reasoning_service) {}
+/**
+ * @brief Constructs a ReasoningQueryService.
+ *
+ * @param reasoning_service The reasoner service to run the queries on.
+ * @param output_sink The output sink for the query results, the results are not stored if it is
+ * not provided.
+ */
+ReasoningQueryService::ReasoningQueryService(std::shared_ptr<ReasonerService> reasoning_service,
+                                             std::shared_ptr<IOutputSink> output_sink)
+    : reasoning_service_(reasoning_service),
+      output_sink_(std::move(output_sink)),
+      watermarks_(reasoning_service) {}
 
 /**
  * Processes a reasoning query and returns the result in JSON format.
  *
+ * Incremental queries, marked with `#WATERMARK(?variable)`, only match facts beyond the largest
+ * value of the variable they returned so far (see QueryWatermarks).
+ *
  * @param reasoning_output_query The reasoning output query containing the query
  * string, query language, and other relevant details.
  * @param is_ai_reasoner_inference_results A boolean indicating whether the reasoning results are
  * inferred.
- * @param output_file_path An optional string representing the path to an output file where results
- * may be saved.
+ * @param output_file_path An optional string representing the path to an output directory where
+ * results may be saved.
+ * @param resource The memory resource for the scratch data of the result parsing, e.g. the arena
+ * of the message being processed.
  * @return A nlohmann::json object containing the results of the reasoning query.
  */
 nlohmann::json ReasoningQueryService::processReasoningQuery(
     const ReasoningOutputQuery& reasoning_output_query, const bool is_ai_reasoner_inference_results,
-    const std::optional<std::string>& output_file_path) {
-    nlohmann::json result;
+    const std::optional<std::string>& output_file_path, std::pmr::memory_resource* resource) {
+    const std::optional<QueryWatermarks::Marker> marker =
+        QueryWatermarks::findMarker(reasoning_output_query.query);
+    const std::string query =
+        marker ? watermarks_.applyWatermark(reasoning_output_query.query, *marker)
+               : reasoning_output_query.query;
 
     // Process each query
-    std::string query_result = reasoning_service_->queryData(reasoning_output_query.query,
-                                                             reasoning_output_query.query_language,
-                                                             DataQueryAcceptType::SPARQL_JSON);
+    std::string query_result = reasoning_service_->queryData(
+        query, reasoning_output_query.query_language, DataQueryAcceptType::SPARQL_JSON);
+
+    nlohmann::json result = JSONWriter::writeToJson(
+        query_result, DataQueryAcceptType::SPARQL_JSON, is_ai_reasoner_inference_results,
+        output_file_path, output_sink_, resource);
+    if (marker) {
+        watermarks_.advanceWatermark(reasoning_output_query.query, *marker, result,
+                                     is_ai_reasoner_inference_results);
+    }
+    return result;
+}
+
+/**
+ * Processes a fleet query once for several vehicle instances and splits its result by instance.
+ *
+ * The query is marked with `#FLEET(?variable)`, and the variable is bound to the instances with a
+ * `VALUES` clause (see FleetQuery), so the vehicles take one round trip to the reasoner instead of
+ * one each. If the query is incremental, each instance has a watermark of its own.
+ *
+ * @param reasoning_output_query The fleet query.
+ * @param instances The vehicle instances to run the query for, e.g. the ones with new data.
+ * @param is_ai_reasoner_inference_results A boolean indicating whether the reasoning results are
+ * inferred.
+ * @param output_file_path An optional string representing the path to an output directory where
+ * results may be saved.
+ * @param resource The memory resource for the scratch data of the result parsing.
+ * @return The result of each instance that has rows, by instance. Rows that do not bind the
+ * instance variable are under the empty key.
+ * @throws std::invalid_argument if the query is not a fleet query.
+ */
+std::map<std::string, nlohmann::json> ReasoningQueryService::processFleetReasoningQuery(
+    const ReasoningOutputQuery& reasoning_output_query, const std::vector<std::string>& instances,
+    const bool is_ai_reasoner_inference_results,
+    const std::optional<std::string>& output_file_path, std::pmr::memory_resource* resource) {
+    const std::optional<std::string> variable =
+        FleetQuery::findInstanceVariable(reasoning_output_query.query);
+    if (!variable) {
+        throw std::invalid_argument("The output query has no " + std::string(FleetQuery::MARKER) +
+                                    "?variable) marker");
+    }
+    if (instances.empty()) {
+        return {};
+    }
+
+    const std::optional<QueryWatermarks::Marker> marker =
+        QueryWatermarks::findMarker(reasoning_output_query.query);
+    const std::string query = FleetQuery::applyInstances(
+        marker ? watermarks_.applyFleetWatermarks(reasoning_output_query.query, *marker,
+                                                  *variable, instances)
+               : reasoning_output_query.query,
+        *variable, instances);
+
+    std::string query_result = reasoning_service_->queryData(
+        query, reasoning_output_query.query_language, DataQueryAcceptType::SPARQL_JSON);
 
-    return JSONWriter::writeToJson(query_result, DataQueryAcceptType::SPARQL_JSON,
-                                   is_ai_reasoner_inference_results, output_file_path);
+    std::map<std::string, nlohmann::json> results =
+        JSONWriter::writeToJsonPartitioned(query_result, *variable,
+                                           is_ai_reasoner_inference_results, output_file_path,
+                                           output_sink_, resource);
+    if (marker) {
+        for (const auto& [instance, rows] : results) {
+            // Rows without an instance cannot be filtered by one
+            if (instance.empty()) {
+                continue;
+            }
+            watermarks_.advanceWatermark(reasoning_output_query.query, *marker, rows,
+                                         is_ai_reasoner_inference_results, instance);
+        }
+    }
+    return results;
 }
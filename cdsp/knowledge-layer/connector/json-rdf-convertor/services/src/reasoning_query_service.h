@@ -1,25 +1,40 @@
 #ifndef REASONING_QUERY_SERVICE_H
 #define REASONING_QUERY_SERVICE_H
 
+#include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "data_types.h"
+#include "i_output_sink.h"
+#include "query_watermarks.h"
 #include "reasoner_service.h"
 
 class ReasoningQueryService {
    public:
-    ReasoningQueryService(std::shared_ptr<ReasonerService> reasoning_service);
+    ReasoningQueryService(std::shared_ptr<ReasonerService> reasoning_service,
+                          std::shared_ptr<IOutputSink> output_sink = nullptr);
 
     nlohmann::json processReasoningQuery(
         const ReasoningOutputQuery& reasoning_output_query,
         const bool is_ai_reasoner_inference_results = false,
-        const std::optional<std::string>& output_file_path = std::nullopt);
+        const std::optional<std::string>& output_file_path = std::nullopt,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    std::map<std::string, nlohmann::json> processFleetReasoningQuery(
+        const ReasoningOutputQuery& reasoning_output_query,
+        const std::vector<std::string>& instances,
+        const bool is_ai_reasoner_inference_results = false,
+        const std::optional<std::string>& output_file_path = std::nullopt,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
    private:
     std::shared_ptr<ReasonerService> reasoning_service_;
+    std::shared_ptr<IOutputSink> output_sink_;
     const std::optional<std::string> output_file_path_;
+    QueryWatermarks watermarks_;
 };
 
 #endif  // REASONING_QUERY_SERVICE_H
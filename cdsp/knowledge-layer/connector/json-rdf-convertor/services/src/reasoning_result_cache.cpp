@@ -0,0 +1,120 @@
+#include "reasoning_result_cache.h"
+
+#include <utility>
+
+#include "helper.h"
+#include "logger.h"
+
+/**
+ * @brief Reads the cache settings from the environment.
+ *
+ * REASONING_RESULT_DIFF enables sending only changed rows (default true) and
+ * REASONING_RESULT_REFRESH_SECONDS sets the interval of the full refresh (default 0,
+ * disabled).
+ *
+ * @return The cache settings.
+ * @throws std::invalid_argument if a variable has an invalid value.
+ */
+ReasoningResultCacheSettings ReasoningResultCacheSettings::fromEnvironment() {
+    ReasoningResultCacheSettings settings;
+    settings.enabled = Helper::getBoolEnvVariable("REASONING_RESULT_DIFF", settings.enabled);
+
+    settings.full_refresh_interval = std::chrono::seconds(Helper::getUnsignedEnvVariable(
+        "REASONING_RESULT_REFRESH_SECONDS", settings.full_refresh_interval.count()));
+    return settings;
+}
+
+ReasoningResultCache::ReasoningResultCache(ReasoningResultCacheSettings settings)
+    : settings_(settings) {}
+
+/**
+ * @brief Filters the result of an output query down to the rows that have to be sent.
+ *
+ * @param query The output query, which identifies the previous result.
+ * @param result The grouped result of the query, an array of rows or an empty object if the query
+ * returned nothing.
+ * @param now The current time, used for the full refresh.
+ * @return An array with the inserted and changed rows, all rows on a full refresh. It is empty if
+ * nothing has to be sent.
+ */
+nlohmann::json ReasoningResultCache::filter(const std::string& query, const nlohmann::json& result,
+                                            Clock::time_point now) {
+    nlohmann::json rows_to_send = nlohmann::json::array();
+    const bool has_rows = result.is_array() && !result.empty();
+
+    if (!settings_.enabled) {
+        if (has_rows) {
+            rows_to_send = result;
+        }
+        const std::lock_guard<std::mutex> lock(mutex_);
+        ++statistics_.results;
+        statistics_.rows_sent += rows_to_send.size();
+        return rows_to_send;
+    }
+
+    auto [entry, first_result] = queries_.try_emplace(query);
+    QueryState& state = entry->second;
+    const bool full_refresh = !first_result && has_rows &&
+                              settings_.full_refresh_interval.count() > 0 &&
+                              now - state.last_full_send >= settings_.full_refresh_interval;
+    if (first_result || full_refresh) {
+        state.last_full_send = now;
+    }
+
+    std::unordered_set<std::uint64_t> row_hashes;
+    std::uint64_t rows_suppressed = 0;
+    if (has_rows) {
+        row_hashes.reserve(result.size());
+        for (const auto& row : result) {
+            const std::uint64_t hash = hashRow(row);
+            // Identical rows of one result are sent once
+            const bool duplicate = !row_hashes.insert(hash).second;
+            if (!duplicate && (full_refresh || state.row_hashes.count(hash) == 0)) {
+                rows_to_send.push_back(row);
+            } else {
+                ++rows_suppressed;
+            }
+        }
+    }
+    state.row_hashes = std::move(row_hashes);
+
+    if (has_rows && rows_to_send.empty()) {
+        LOG_DEBUG("The result of an output query has not changed, nothing is sent");
+    }
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    ++statistics_.results;
+    statistics_.rows_sent += rows_to_send.size();
+    statistics_.rows_suppressed += rows_suppressed;
+    if (has_rows && rows_to_send.empty()) {
+        ++statistics_.sends_suppressed;
+    }
+    if (full_refresh) {
+        ++statistics_.full_refreshes;
+    }
+    return rows_to_send;
+}
+
+/**
+ * @brief Forgets the previous results, so the next result of every query is sent in full.
+ */
+void ReasoningResultCache::clear() { queries_.clear(); }
+
+/**
+ * @brief Retrieves the cache counters.
+ *
+ * @return A copy of the counters.
+ */
+ReasoningResultCacheStatistics ReasoningResultCache::getStatistics() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+/**
+ * @brief Hashes the serialized JSON of a result row with 64-bit FNV-1a.
+ *
+ * The keys of JSON objects are sorted, so equal rows have the same serialization.
+ */
+std::uint64_t ReasoningResultCache::hashRow(const nlohmann::json& row) {
+    return Helper::hashFnv1a(row.dump());
+}
@@ -0,0 +1,77 @@
+#ifndef REASONING_RESULT_CACHE_H
+#define REASONING_RESULT_CACHE_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * @brief Settings of the ReasoningResultCache.
+ */
+struct ReasoningResultCacheSettings {
+    // Send only the rows that changed since the previous result of a query
+    bool enabled = true;
+    // Interval of sending the full result of a query again, 0 disables the full refresh
+    std::chrono::seconds full_refresh_interval{0};
+
+    static ReasoningResultCacheSettings fromEnvironment();
+};
+
+/**
+ * @brief Counters of the ReasoningResultCache.
+ */
+struct ReasoningResultCacheStatistics {
+    std::uint64_t results = 0;
+    std::uint64_t rows_sent = 0;
+    // Rows that were part of the previous result of their query
+    std::uint64_t rows_suppressed = 0;
+    // Results without any new or changed row, for which nothing is sent
+    std::uint64_t sends_suppressed = 0;
+    std::uint64_t full_refreshes = 0;
+};
+
+/**
+ * @brief Remembers the last result of each output query to send only what has changed.
+ *
+ * Each row of a grouped query result (see JSONWriter) is identified by a hash of its serialized
+ * JSON. A row is sent if its hash was not part of the previous result of the same query, i.e. if
+ * it was inserted or one of its values changed. Rows that are no longer returned are forgotten;
+ * there is no message to remove a value in the information layer.
+ *
+ * With a full refresh interval, the whole result of a query is sent again once the interval has
+ * passed since its last full send, so that the information layer recovers from lost messages.
+ */
+class ReasoningResultCache {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ReasoningResultCache(
+        ReasoningResultCacheSettings settings = ReasoningResultCacheSettings());
+
+    nlohmann::json filter(const std::string& query, const nlohmann::json& result,
+                          Clock::time_point now = Clock::now());
+    void clear();
+
+    [[nodiscard]] ReasoningResultCacheStatistics getStatistics() const;
+
+   private:
+    struct QueryState {
+        std::unordered_set<std::uint64_t> row_hashes;
+        Clock::time_point last_full_send;
+    };
+
+    const ReasoningResultCacheSettings settings_;
+    std::unordered_map<std::string, QueryState> queries_;
+
+    // Guards the statistics, which may be read from another thread
+    mutable std::mutex mutex_;
+    ReasoningResultCacheStatistics statistics_;
+
+    static std::uint64_t hashRow(const nlohmann::json& row);
+};
+
+#endif  // REASONING_RESULT_CACHE_H
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mock_reasoner_adapter.h"
+#include "mock_reasoner_service.h"
+#include "query_watermarks.h"
+
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Return;
+
+class QueryWatermarksUnitTest : public ::testing::Test {
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+   protected:
+    static constexpr char QUERY[] =
+        "SELECT ?Vehicle_Speed ?Vehicle_Speed_Timestamp WHERE {\n"
+        "  ?s <urn:speed> ?Vehicle_Speed; <urn:time> ?Vehicle_Speed_Timestamp.\n"
+        "  #WATERMARK(?Vehicle_Speed_Timestamp)\n"
+        "}";
+    static constexpr char STORED_HEADER[] = "?query\t?watermark\n";
+
+    std::shared_ptr<MockReasonerAdapter> mock_adapter_;
+    std::shared_ptr<MockReasonerService> mock_reasoner_service_;
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+
+    void SetUp() override {
+        mock_adapter_ = std::make_shared<MockReasonerAdapter>();
+        EXPECT_CALL(*mock_adapter_, initialize()).Times(1);
+        mock_reasoner_service_ = std::make_shared<MockReasonerService>(mock_adapter_);
+    }
+
+    void expectStoredWatermarks(const std::string& response) {
+        EXPECT_CALL(*mock_reasoner_service_,
+                    queryData(HasSubstr(QueryWatermarks::WATERMARK_GRAPH),
+                              QueryLanguageType::SPARQL, DataQueryAcceptType::TEXT_TSV))
+            .WillOnce(Return(response));
+    }
+
+    static nlohmann::json speedRow(const nlohmann::json& timestamp) {
+        return {{"Vehicle", {{"Speed", 50}, {"Speed.Timestamp", timestamp}}}};
+    }
+};
+
+// Test that the marker of an incremental query is found
+TEST_F(QueryWatermarksUnitTest, FindMarkerReturnsVariable) {
+    const auto marker = QueryWatermarks::findMarker(QUERY);
+    ASSERT_TRUE(marker.has_value());
+    EXPECT_EQ(marker->variable, "Vehicle_Speed_Timestamp");
+    EXPECT_EQ(std::string(QUERY).substr(marker->position, marker->length),
+              "#WATERMARK(?Vehicle_Speed_Timestamp)");
+
+    EXPECT_FALSE(QueryWatermarks::findMarker("SELECT * WHERE { ?s ?p ?o }").has_value());
+    EXPECT_THROW(QueryWatermarks::findMarker("SELECT * WHERE { #WATERMARK(t) }"),
+                 std::invalid_argument);
+}
+
+// Test that a query without watermark runs in full and that the largest emitted value becomes
+// its watermark
+TEST_F(QueryWatermarksUnitTest, AdvanceWatermarkStoresMaximumAndFiltersNextQuery) {
+    expectStoredWatermarks(STORED_HEADER);
+    QueryWatermarks watermarks(mock_reasoner_service_);
+    const auto marker = *QueryWatermarks::findMarker(QUERY);
+
+    EXPECT_EQ(watermarks.applyWatermark(QUERY, marker), QUERY);
+
+    EXPECT_CALL(*mock_reasoner_service_, deleteGraphData(_, _, _)).Times(0);
+    EXPECT_CALL(*mock_reasoner_service_,
+                loadGraphData(QueryWatermarks::WATERMARK_GRAPH,
+                              HasSubstr("\"\\\"2024-01-01T10:00:05Z\\\"\""),
+                              ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+    const nlohmann::json result = {speedRow("2024-01-01T10:00:01Z"),
+                                   speedRow("2024-01-01T10:00:05Z"),
+                                   speedRow("2024-01-01T10:00:03Z")};
+    watermarks.advanceWatermark(QUERY, marker, result, false);
+
+    EXPECT_EQ(watermarks.getWatermark(QUERY), nlohmann::json("2024-01-01T10:00:05Z"));
+    const std::string filtered_query = watermarks.applyWatermark(QUERY, marker);
+    EXPECT_THAT(filtered_query,
+                HasSubstr("FILTER(STR(?Vehicle_Speed_Timestamp) > \"2024-01-01T10:00:05Z\")"));
+    EXPECT_THAT(filtered_query, ::testing::Not(HasSubstr("#WATERMARK")));
+}
+
+// Test that advancing a watermark keeps the cached results of the output queries
+TEST_F(QueryWatermarksUnitTest, AdvanceWatermarkKeepsCachedQueryResults) {
+    const std::string output_query = "SELECT ?s WHERE { ?s <urn:speed> ?v }";
+    EXPECT_CALL(*mock_adapter_, initialize());
+    EXPECT_CALL(*mock_adapter_, queryData(output_query, QueryLanguageType::SPARQL, _))
+        .WillOnce(Return("?s\n<a>\n"));
+    EXPECT_CALL(*mock_adapter_, queryData(HasSubstr(QueryWatermarks::WATERMARK_GRAPH), _, _))
+        .WillOnce(Return(STORED_HEADER));
+    EXPECT_CALL(*mock_adapter_, loadData(HasSubstr(QueryWatermarks::WATERMARK_GRAPH), _))
+        .Times(2)
+        .WillRepeatedly(Return(true));
+    EXPECT_CALL(*mock_adapter_, deleteData(HasSubstr(QueryWatermarks::WATERMARK_GRAPH), _))
+        .WillOnce(Return(true));
+    const auto reasoner_service = std::make_shared<ReasonerService>(mock_adapter_, false);
+    QueryWatermarks watermarks(reasoner_service);
+    const auto marker = *QueryWatermarks::findMarker(QUERY);
+
+    EXPECT_EQ(reasoner_service->queryData(output_query, QueryLanguageType::SPARQL), "?s\n<a>\n");
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::array({speedRow(10)}), false);
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::array({speedRow(12)}), false);
+
+    EXPECT_EQ(reasoner_service->queryData(output_query, QueryLanguageType::SPARQL), "?s\n<a>\n");
+    EXPECT_EQ(reasoner_service->getQueryCacheStatistics().hits, 1u);
+}
+
+// Test that a watermark only moves forward and replaces the stored one
+TEST_F(QueryWatermarksUnitTest, AdvanceWatermarkIgnoresOlderValues) {
+    expectStoredWatermarks(STORED_HEADER);
+    QueryWatermarks watermarks(mock_reasoner_service_);
+    const auto marker = *QueryWatermarks::findMarker(QUERY);
+
+    EXPECT_CALL(*mock_reasoner_service_,
+                loadGraphData(QueryWatermarks::WATERMARK_GRAPH, _, ReasonerSyntaxType::TRIG))
+        .Times(2)
+        .WillRepeatedly(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_,
+                deleteGraphData(QueryWatermarks::WATERMARK_GRAPH, HasSubstr("10"),
+                                ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::array({speedRow(10)}), false);
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::array({speedRow(7)}), false);
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::object(), false);
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::array({speedRow(12.5)}), false);
+
+    EXPECT_EQ(watermarks.getWatermark(QUERY), nlohmann::json(12.5));
+    EXPECT_THAT(watermarks.applyWatermark(QUERY, marker),
+                HasSubstr("FILTER(?Vehicle_Speed_Timestamp > 12.5)"));
+}
+
+// Test that the watermarks stored in the datastore are used after a restart
+TEST_F(QueryWatermarksUnitTest, StoredWatermarksAreLoaded) {
+    expectStoredWatermarks(std::string(STORED_HEADER) + "<" + QueryWatermarks::QUERY_IRI_PREFIX +
+                           QueryWatermarks::queryKey(QUERY) + ">\t\"42\"\n" + "<" +
+                           QueryWatermarks::QUERY_IRI_PREFIX + "0000000000000000>\t\"{\"\n");
+    QueryWatermarks watermarks(mock_reasoner_service_);
+    const auto marker = *QueryWatermarks::findMarker(QUERY);
+
+    EXPECT_THAT(watermarks.applyWatermark(QUERY, marker),
+                HasSubstr("FILTER(?Vehicle_Speed_Timestamp > 42)"));
+
+    // A changed query starts without a watermark
+    const std::string changed_query = std::string(QUERY) + " LIMIT 10";
+    EXPECT_EQ(watermarks.applyWatermark(changed_query, marker), changed_query);
+}
+
+// Test that the values of inference results are read from their serialized data points
+TEST_F(QueryWatermarksUnitTest, AdvanceWatermarkReadsInferenceResults) {
+    expectStoredWatermarks(STORED_HEADER);
+    QueryWatermarks watermarks(mock_reasoner_service_);
+    const auto marker = *QueryWatermarks::findMarker(QUERY);
+
+    EXPECT_CALL(*mock_reasoner_service_,
+                loadGraphData(QueryWatermarks::WATERMARK_GRAPH, _, ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+    const nlohmann::json inference_results = {{"Speed", 50}, {"Speed.Timestamp", 30}};
+    const nlohmann::json result = {
+        {{"Vehicle", {{"AI.Reasoner.InferenceResults", inference_results.dump()}}}}};
+    watermarks.advanceWatermark(QUERY, marker, result, true);
+
+    EXPECT_EQ(watermarks.getWatermark(QUERY), nlohmann::json(30));
+}
+
+// Test that each instance of a fleet query has a watermark of its own
+TEST_F(QueryWatermarksUnitTest, FleetQueryHasWatermarkPerInstance) {
+    expectStoredWatermarks(STORED_HEADER);
+    QueryWatermarks watermarks(mock_reasoner_service_);
+    const auto marker = *QueryWatermarks::findMarker(QUERY);
+    const std::vector<std::string> instances = {"VIN1", "VIN2", "VIN3"};
+
+    EXPECT_EQ(watermarks.applyFleetWatermarks(QUERY, marker, "instance", instances), QUERY);
+
+    EXPECT_CALL(*mock_reasoner_service_,
+                loadGraphData(QueryWatermarks::WATERMARK_GRAPH, _, ReasonerSyntaxType::TRIG))
+        .Times(2)
+        .WillRepeatedly(Return(true));
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::array({speedRow(42)}), false,
+                                std::string("VIN1"));
+    watermarks.advanceWatermark(QUERY, marker, nlohmann::json::array({speedRow(17)}), false,
+                                std::string("VIN2"));
+
+    EXPECT_EQ(watermarks.getWatermark(QUERY, std::string("VIN2")), nlohmann::json(17));
+    EXPECT_FALSE(watermarks.getWatermark(QUERY).has_value());
+    EXPECT_FALSE(watermarks.getWatermark(QUERY, std::string("VIN3")).has_value());
+
+    // The vehicle with older data is not filtered by the watermark of the other one
+    EXPECT_THAT(watermarks.applyFleetWatermarks(QUERY, marker, "instance", instances),
+                HasSubstr("FILTER((?instance != \"VIN1\" || ?Vehicle_Speed_Timestamp > 42) && "
+                          "(?instance != \"VIN2\" || ?Vehicle_Speed_Timestamp > 17))"));
+    EXPECT_EQ(watermarks.applyFleetWatermarks(QUERY, marker, "instance", {"VIN3"}), QUERY);
+}
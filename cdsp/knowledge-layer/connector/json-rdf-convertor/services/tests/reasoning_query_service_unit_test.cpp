@@ -51,4 +51,110 @@ TEST_F(ReasoningQueryServiceUnitTest, ProcessReasoningQuery_JSONWriterThrowsExce
                                                                  is_ai_reasoner_inference_results,
                                                                  reasoning_results_file_path),
                  std::runtime_error);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test case for processing a fleet query for several vehicle instances.
+ *
+ * This test verifies that a query marked with `#FLEET(?instance)` is sent once with a VALUES
+ * clause over the instances, and that its result is split by the value of the instance variable.
+ */
+TEST_F(ReasoningQueryServiceUnitTest, ProcessFleetReasoningQuery_SplitsResultByInstance) {
+    // Arrange
+    ReasoningOutputQuery fleet_query;
+    fleet_query.query =
+        "SELECT ?instance ?Vehicle_Speed WHERE { ?s <urn:speed> ?Vehicle_Speed } #FLEET(?instance)";
+    fleet_query.query_language = QueryLanguageType::SPARQL;
+
+    const std::string expected_query =
+        fleet_query.query + "\nVALUES ?instance { \"VIN1\" \"V\\\"2\" }\n";
+    const std::string response = R"({
+        "head": {"vars": ["instance", "Vehicle_Speed"]},
+        "results": {"bindings": [
+            {"instance": {"type": "literal", "value": "VIN1"},
+             "Vehicle_Speed": {"type": "literal", "value": "50",
+                               "datatype": "http://www.w3.org/2001/XMLSchema#int"}},
+            {"instance": {"type": "literal", "value": "V\"2"},
+             "Vehicle_Speed": {"type": "literal", "value": "30",
+                               "datatype": "http://www.w3.org/2001/XMLSchema#int"}},
+            {"instance": {"type": "literal", "value": "VIN1"},
+             "Vehicle_Speed": {"type": "literal", "value": "55",
+                               "datatype": "http://www.w3.org/2001/XMLSchema#int"}}
+        ]}
+    })";
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(expected_query, fleet_query.query_language,
+                          DataQueryAcceptType::SPARQL_JSON))
+        .WillOnce(testing::Return(response));
+
+    // Act
+    const auto results =
+        reasoning_query_service_->processFleetReasoningQuery(fleet_query, {"VIN1", "V\"2"});
+
+    // Assert
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results.at("VIN1"),
+              nlohmann::json::parse(R"([{"Vehicle": {"Speed": 50}}, {"Vehicle": {"Speed": 55}}])"));
+    EXPECT_EQ(results.at("V\"2"), nlohmann::json::parse(R"([{"Vehicle": {"Speed": 30}}])"));
+
+    // No instance, no query; queries without the marker are no fleet queries
+    EXPECT_TRUE(reasoning_query_service_->processFleetReasoningQuery(fleet_query, {}).empty());
+    ReasoningOutputQuery regular_query = fleet_query;
+    regular_query.query = "SELECT ?s WHERE { ?s ?p ?o }";
+    EXPECT_THROW(reasoning_query_service_->processFleetReasoningQuery(regular_query, {"VIN1"}),
+                 std::invalid_argument);
+}
+
+/**
+ * @brief Test case for an incremental fleet query.
+ *
+ * This test verifies that each instance of a fleet query with a `#WATERMARK(?variable)` marker
+ * advances a watermark of its own, so the next run filters each instance by its own watermark.
+ */
+TEST_F(ReasoningQueryServiceUnitTest, ProcessFleetReasoningQuery_WatermarkPerInstance) {
+    // Arrange
+    ReasoningOutputQuery fleet_query;
+    fleet_query.query =
+        "SELECT ?instance ?Vehicle_Speed WHERE { ?s <urn:speed> ?Vehicle_Speed "
+        "#WATERMARK(?Vehicle_Speed)\n} #FLEET(?instance)";
+    fleet_query.query_language = QueryLanguageType::SPARQL;
+
+    const std::string response = R"({
+        "head": {"vars": ["instance", "Vehicle_Speed"]},
+        "results": {"bindings": [
+            {"instance": {"type": "literal", "value": "VIN1"},
+             "Vehicle_Speed": {"type": "literal", "value": "50",
+                               "datatype": "http://www.w3.org/2001/XMLSchema#int"}},
+            {"instance": {"type": "literal", "value": "VIN2"},
+             "Vehicle_Speed": {"type": "literal", "value": "30",
+                               "datatype": "http://www.w3.org/2001/XMLSchema#int"}}
+        ]}
+    })";
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(testing::HasSubstr(QueryWatermarks::WATERMARK_GRAPH), testing::_,
+                          DataQueryAcceptType::TEXT_TSV))
+        .WillOnce(testing::Return("?query\t?watermark\n"));
+    EXPECT_CALL(*mock_reasoner_service_,
+                loadGraphData(QueryWatermarks::WATERMARK_GRAPH, testing::_,
+                              ReasonerSyntaxType::TRIG))
+        .Times(2)
+        .WillRepeatedly(testing::Return(true));
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(testing::HasSubstr("#WATERMARK"), fleet_query.query_language,
+                          DataQueryAcceptType::SPARQL_JSON))
+        .WillOnce(testing::Return(response));
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(testing::HasSubstr("FILTER((?instance != \"VIN1\" || ?Vehicle_Speed > "
+                                             "50) && (?instance != \"VIN2\" || ?Vehicle_Speed "
+                                             "> 30))"),
+                          fleet_query.query_language, DataQueryAcceptType::SPARQL_JSON))
+        .WillOnce(testing::Return(R"({"head": {"vars": []}, "results": {"bindings": []}})"));
+
+    // Act && Assert
+    EXPECT_EQ(
+        reasoning_query_service_->processFleetReasoningQuery(fleet_query, {"VIN1", "VIN2"}).size(),
+        2u);
+    EXPECT_TRUE(
+        reasoning_query_service_->processFleetReasoningQuery(fleet_query, {"VIN1", "VIN2"})
+            .empty());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+#include "reasoning_result_cache.h"
+
+class ReasoningResultCacheUnitTest : public ::testing::Test {
+   protected:
+    static nlohmann::json drivingStyle(const std::string& style) {
+        return {{"Vehicle", {{"DrivingStyle", style}}}};
+    }
+};
+
+// Test that only inserted and changed rows of a query result are returned
+TEST_F(ReasoningResultCacheUnitTest, FilterReturnsOnlyChangedRows) {
+    ReasoningResultCache cache;
+    const nlohmann::json first = {drivingStyle("sporty"), {{"Vehicle", {{"Speed", 50}}}}};
+    EXPECT_EQ(cache.filter("q1", first), first);
+
+    // The same result is suppressed
+    EXPECT_TRUE(cache.filter("q1", first).empty());
+
+    // A changed row is returned, the unchanged one is not
+    const nlohmann::json second = {drivingStyle("sporty"), {{"Vehicle", {{"Speed", 60}}}}};
+    EXPECT_EQ(cache.filter("q1", second), nlohmann::json::array({second[1]}));
+
+    // Results of other queries are tracked separately
+    EXPECT_EQ(cache.filter("q2", first), first);
+
+    const auto statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.results, 4u);
+    EXPECT_EQ(statistics.rows_sent, 5u);
+    EXPECT_EQ(statistics.rows_suppressed, 3u);
+    EXPECT_EQ(statistics.sends_suppressed, 1u);
+}
+
+// Test that a row is sent again after it has been missing from a result
+TEST_F(ReasoningResultCacheUnitTest, FilterForgetsRowsMissingFromResult) {
+    ReasoningResultCache cache;
+    const nlohmann::json sporty = {drivingStyle("sporty")};
+    EXPECT_EQ(cache.filter("q1", sporty), sporty);
+    EXPECT_TRUE(cache.filter("q1", nlohmann::json::object()).empty());
+    EXPECT_EQ(cache.filter("q1", sporty), sporty);
+}
+
+// Test that the full result is sent again once the refresh interval has passed
+TEST_F(ReasoningResultCacheUnitTest, FilterSendsFullResultOnRefresh) {
+    ReasoningResultCacheSettings settings;
+    settings.full_refresh_interval = std::chrono::seconds(30);
+    ReasoningResultCache cache(settings);
+    const auto start = ReasoningResultCache::Clock::now();
+    const nlohmann::json result = {drivingStyle("calm")};
+
+    EXPECT_EQ(cache.filter("q1", result, start), result);
+    EXPECT_TRUE(cache.filter("q1", result, start + std::chrono::seconds(10)).empty());
+    EXPECT_EQ(cache.filter("q1", result, start + std::chrono::seconds(30)), result);
+    EXPECT_TRUE(cache.filter("q1", result, start + std::chrono::seconds(40)).empty());
+    EXPECT_EQ(cache.getStatistics().full_refreshes, 1u);
+
+    // After clearing, the next result is sent in full
+    cache.clear();
+    EXPECT_EQ(cache.filter("q1", result, start + std::chrono::seconds(41)), result);
+}
+
+// Test that every result is returned when the diffing is disabled
+TEST_F(ReasoningResultCacheUnitTest, FilterPassesResultsWhenDisabled) {
+    ReasoningResultCacheSettings settings;
+    settings.enabled = false;
+    ReasoningResultCache cache(settings);
+    const nlohmann::json result = {drivingStyle("calm")};
+
+    EXPECT_EQ(cache.filter("q1", result), result);
+    EXPECT_EQ(cache.filter("q1", result), result);
+    EXPECT_TRUE(cache.filter("q1", nlohmann::json::object()).empty());
+    EXPECT_EQ(cache.getStatistics().rows_sent, 2u);
+}
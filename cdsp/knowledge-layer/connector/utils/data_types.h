@@ -1,6 +1,7 @@
 #ifndef DATA_TYPES_H
 #define DATA_TYPES_H
 
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -83,6 +84,19 @@ enum class MessageStructureFormat {
     LEAF,
 };
 
+/**
+ * @brief Configuration of the WebSocket permessage-deflate extension (RFC 7692).
+ *
+ * Compression is opt-in. When enabled, the client offers the extension during the handshake and
+ * messages are compressed in both directions if the server accepts it.
+ */
+struct WSCompressionSettings {
+    bool enabled = false;
+    int max_window_bits = 15;          ///< LZ77 window size (9..15) offered for both directions.
+    int compression_level = 8;         ///< zlib compression level (0..9).
+    std::size_t min_message_size = 0;  ///< Messages smaller than this are sent uncompressed.
+};
+
 /**
  * @brief Configuration structure for the websocket servers
  */
@@ -90,6 +104,7 @@ struct WSServerData {
     std::string host;
     std::string port;
     std::string target;
+    WSCompressionSettings compression;
 };
 
 /**
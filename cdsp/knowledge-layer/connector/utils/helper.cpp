@@ -3,16 +3,29 @@
 #include <GeographicLib/TransverseMercator.hpp>
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <iomanip>
-#include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 #include "coordinate_transform.h"
+#include "logger.h"
 
 // Define the static constant
 // TODO: Should be a more generic geographical point?
 const Wgs84Coord Helper::ZONE_ORIGIN{11.579144, 48.137416, 0.0};
 
+namespace {
+std::string trimWhitespace(const std::string& value) {
+    const std::size_t first = value.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+    const std::size_t last = value.find_last_not_of(" \t\r\n");
+    return value.substr(first, last - first + 1);
+}
+}  // namespace
+
 /**
  * @brief Retrieves the current timestamp formatted as a string.
  *
@@ -118,7 +131,7 @@ std::tuple<std::optional<std::tm>, std::optional<int>> Helper::parseISO8601ToTim
     std::istringstream iss(iso_string);
     iss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
     if (iss.fail()) {
-        std::cout << "Failed to parse datetime" << std::endl;
+        LOG_WARN("Failed to parse datetime: " << iso_string);
         return {std::nullopt, std::nullopt};
     }
 
@@ -184,28 +197,79 @@ std::string Helper::getEnvVariable(const std::string& env_var,
 }
 
 /**
- * @brief Converts latitude and longitude strings to NTM coordinates.
+ * @brief Reads a boolean ("true"/"false" or "1"/"0", case-insensitive) from an environment
+ * variable. Surrounding whitespace is ignored.
  *
- * This function takes latitude and longitude as strings, converts them to
- * a WGS84 coordinate, and then transforms it into NTM coordinates using
- * the `CoordinateTransform::ntmPoseFromWgs84` function. If either input
- * string is empty, it returns an empty optional.
- *
- * @param latitude The latitude as a string.
- * @param longitude The longitude as a string.
- * @return std::optional<NtmCoord> The converted NTM coordinates wrapped in
- *         an optional. If the conversion fails or inputs are empty, returns
- *         an empty optional.
+ * @param env_var The name of the environment variable.
+ * @param default_value The value used when the variable is not set or empty.
+ * @return The parsed value.
+ * @throws std::invalid_argument if the value is not a boolean.
  */
-std::optional<NtmCoord> Helper::getCoordInNtm(const std::string& latitude,
-                                              const std::string& longitude) {
-    if (latitude.empty() || longitude.empty()) {
-        return std::nullopt;
+bool Helper::getBoolEnvVariable(const std::string& env_var, bool default_value) {
+    const std::string value = toLowerCase(trimWhitespace(getEnvVariable(env_var)));
+    if (value.empty()) {
+        return default_value;
+    }
+    if (value == "true" || value == "1") {
+        return true;
     }
+    if (value == "false" || value == "0") {
+        return false;
+    }
+    throw std::invalid_argument("Invalid value for " + env_var + ": '" + value +
+                                "'. Use true or false.");
+}
+
+/**
+ * @brief Reads a non-negative integer from an environment variable. Surrounding whitespace is
+ * ignored.
+ *
+ * @param env_var The name of the environment variable.
+ * @param default_value The value used when the variable is not set or empty.
+ * @param min The smallest accepted value.
+ * @param max The largest accepted value.
+ * @return The parsed value.
+ * @throws std::invalid_argument if the value is not a non-negative integer, does not fit into 64
+ * bits or is out of range.
+ */
+std::uint64_t Helper::getUnsignedEnvVariable(const std::string& env_var,
+                                             std::uint64_t default_value, std::uint64_t min,
+                                             std::uint64_t max) {
+    const std::string value = trimWhitespace(getEnvVariable(env_var));
+    if (value.empty()) {
+        return default_value;
+    }
+    std::uint64_t parsed = 0;
+    const char* end = value.data() + value.size();
+    const auto [position, error] = std::from_chars(value.data(), end, parsed);
+    if (error != std::errc() || position != end) {
+        throw std::invalid_argument("Invalid value for " + env_var + ": '" + value +
+                                    "'. A non-negative integer is expected.");
+    }
+    if (parsed < min || parsed > max) {
+        throw std::invalid_argument("Invalid value for " + env_var + ": '" + value +
+                                    "'. An integer between " + std::to_string(min) + " and " +
+                                    std::to_string(max) + " is expected.");
+    }
+    return parsed;
+}
 
+/**
+ * @brief Converts latitude and longitude to NTM coordinates.
+ *
+ * This function builds a WGS84 coordinate from the latitude and longitude, and
+ * then transforms it into NTM coordinates using the
+ * `CoordinateTransform::ntmPoseFromWgs84` function.
+ *
+ * @param latitude The latitude in degrees.
+ * @param longitude The longitude in degrees.
+ * @return std::optional<NtmCoord> The converted NTM coordinates wrapped in
+ *         an optional. If the conversion fails, returns an empty optional.
+ */
+std::optional<NtmCoord> Helper::getCoordInNtm(double latitude, double longitude) {
     Wgs84Coord coord_to_convert;
-    coord_to_convert.latitude = std::stod(latitude);
-    coord_to_convert.longitude = std::stod(longitude);
+    coord_to_convert.latitude = latitude;
+    coord_to_convert.longitude = longitude;
 
     return CoordinateTransform::ntmPoseFromWgs84(ZONE_ORIGIN, coord_to_convert);
 }
@@ -294,40 +358,81 @@ nlohmann::json Helper::detectType(const std::string& value) {
     // Default to string
     return value;
 }
+
+/**
+ * @brief Splits a string at every occurrence of a delimiter.
+ *
+ * Empty tokens between two delimiters are kept, a trailing delimiter does not add an empty
+ * token.
+ *
+ * @param str The string to split.
+ * @param delimiter The character separating the tokens.
+ * @return The tokens of the string.
+ */
 std::vector<std::string> Helper::splitString(const std::string& str, char delimiter) {
     std::vector<std::string> tokens;
-    std::string token;
-    std::istringstream tokenStream(str);
-    while (std::getline(tokenStream, token, delimiter)) {
-        tokens.push_back(token);
+    std::size_t start = 0;
+    while (start < str.size()) {
+        std::size_t end = str.find(delimiter, start);
+        if (end == std::string::npos) {
+            end = str.size();
+        }
+        tokens.emplace_back(str, start, end - start);
+        start = end + 1;
     }
     return tokens;
 }
 
 /**
- * @brief Converts a JSON value to its string representation.
+ * @brief Hashes bytes with 64-bit FNV-1a.
+ *
+ * The hash of several strings is computed by passing the hash of the previous ones as the start
+ * value.
+ *
+ * @param bytes The bytes to hash.
+ * @param hash The start value, FNV_OFFSET_BASIS for a new hash.
+ * @return The hash of the bytes.
+ */
+std::uint64_t Helper::hashFnv1a(std::string_view bytes, std::uint64_t hash) {
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+    for (const char character : bytes) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Escapes a string for a quoted SPARQL, Turtle or TriG literal.
  *
- * This function takes a JSON value and converts it to a string representation
- * based on its type. Supported types include string, float, integer, unsigned integer,
- * and boolean. If the JSON value is of an unsupported type, a runtime error is thrown.
+ * Quotes, backslashes and line breaks are escaped, the quotes around the literal are not added.
  *
- * @param json_value The JSON value to be converted to a string.
- * @return std::string The string representation of the JSON value.
- * @throws std::runtime_error If the JSON value is of an unsupported type.
+ * @param value The string to escape.
+ * @return The escaped string.
  */
-std::string Helper::jsonToString(const nlohmann::json& json_value) {
-    if (json_value.is_string()) {
-        return json_value.get<std::string>();
-    } else if (json_value.is_number_float()) {
-        return std::to_string(json_value.get<double>());
-    } else if (json_value.is_number_integer()) {
-        return std::to_string(json_value.get<int>());
-    } else if (json_value.is_number_unsigned()) {
-        return std::to_string(json_value.get<unsigned>());
-    } else if (json_value.is_boolean()) {
-        return json_value.get<bool>() ? "true" : "false";
+std::string Helper::escapeLiteral(std::string_view value) {
+    std::string escaped;
+    escaped.reserve(value.size() + 2);
+    for (const char character : value) {
+        switch (character) {
+            case '"':
+                escaped.append("\\\"");
+                break;
+            case '\\':
+                escaped.append("\\\\");
+                break;
+            case '\n':
+                escaped.append("\\n");
+                break;
+            case '\r':
+                escaped.append("\\r");
+                break;
+            default:
+                escaped.push_back(character);
+                break;
+        }
     }
-    throw std::runtime_error("The message contains a node with an unsupported value.");
+    return escaped;
 }
 
 /**
@@ -2,10 +2,13 @@
 #define HELPER_H
 
 #include <chrono>
+#include <cstdint>
 #include <ctime>
+#include <limits>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <variant>
@@ -15,6 +18,9 @@
 
 class Helper {
    public:
+    // Start value of a 64-bit FNV-1a hash
+    static constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
     static std::string getFormattedTimestampNow(const std::string& format,
                                                 bool include_nanoseconds = false,
                                                 bool use_utc = true);
@@ -32,18 +38,22 @@ class Helper {
     static std::tuple<std::optional<std::tm>, std::optional<int>> parseISO8601ToTime(
         const std::string& iso_string);
 
-    static std::optional<NtmCoord> getCoordInNtm(const std::string& latitude,
-                                                 const std::string& longitude);
+    static std::optional<NtmCoord> getCoordInNtm(double latitude, double longitude);
 
     static std::string getEnvVariable(
         const std::string& env_var, const std::optional<std::string>& default_value = std::nullopt);
+    static bool getBoolEnvVariable(const std::string& env_var, bool default_value);
+    static std::uint64_t getUnsignedEnvVariable(
+        const std::string& env_var, std::uint64_t default_value, std::uint64_t min = 0,
+        std::uint64_t max = std::numeric_limits<std::uint64_t>::max());
 
     static std::string toLowerCase(const std::string& input);
     static std::string toUppercase(const std::string& input);
     static std::string trimTrailingNewlines(const std::string& str);
     static nlohmann::json detectType(const std::string& value);
     static std::vector<std::string> splitString(const std::string& str, char delimiter);
-    static std::string jsonToString(const nlohmann::json& json);
+    static std::uint64_t hashFnv1a(std::string_view bytes, std::uint64_t hash = FNV_OFFSET_BASIS);
+    static std::string escapeLiteral(std::string_view value);
     static std::string variantToString(
         const std::variant<std::string, int, double, float, bool>& var);
     static std::chrono::system_clock::time_point convertToTimestamp(int64_t seconds, int64_t nanos);
@@ -0,0 +1,36 @@
+#ifndef I_OUTPUT_SINK_H
+#define I_OUTPUT_SINK_H
+
+#include <string>
+
+/**
+ * @brief Stream of output records written to files of one directory, e.g. the generated triples.
+ *
+ * The files of a stream are named `<directory><file_prefix><timestamp><extension>`.
+ */
+struct OutputStream {
+    // Name of the stream, selects the per-stream settings (enabled, sampling).
+    std::string name;
+    std::string directory;
+    std::string file_prefix;
+    std::string extension;
+};
+
+// Interface for writing output records
+class IOutputSink {
+   public:
+    /**
+     * @brief Decides whether the next record of a stream should be written, so that the caller
+     * only builds records that are not dropped because the stream is disabled or sampled.
+     */
+    virtual bool shouldWrite(const std::string& stream_name) = 0;
+    /**
+     * @brief Whether the records of a stream are archived, so that the caller can write them in a
+     * compact, line-based format (e.g. N-Triples instead of Turtle).
+     */
+    virtual bool isArchived(const std::string& stream_name) = 0;
+    virtual void write(const OutputStream& stream, std::string content) = 0;
+    virtual ~IOutputSink() = default;
+};
+
+#endif  // I_OUTPUT_SINK_H
@@ -0,0 +1,114 @@
+#ifndef LOCK_FREE_RING_BUFFER_H
+#define LOCK_FREE_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Bounded lock-free multi-producer queue backed by a ring buffer.
+ *
+ * Each cell carries a sequence number that tells producers and consumers whether the cell is
+ * free or holds a value for the current lap (D. Vyukov's bounded MPMC queue). Pushing into a full
+ * buffer fails instead of blocking, so producers on a hot path never wait.
+ *
+ * @tparam T The element type, must be default constructible and movable.
+ */
+template <typename T>
+class LockFreeRingBuffer {
+   public:
+    /**
+     * @brief Creates a ring buffer holding at least `capacity` elements.
+     *
+     * @param capacity The minimum capacity, rounded up to the next power of two.
+     */
+    explicit LockFreeRingBuffer(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
+    LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
+
+    /**
+     * @brief Tries to append a value.
+     *
+     * @param value The value to move into the buffer.
+     * @return false if the buffer is full, in which case `value` is left untouched.
+     */
+    bool tryPush(T&& value) {
+        std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Tries to remove the oldest value.
+     *
+     * @param value Receives the removed value.
+     * @return false if the buffer is empty.
+     */
+    bool tryPop(T& value) {
+        std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0) {
+                if (dequeue_position_.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+   private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    // Keep the producer and consumer positions on separate cache lines
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_position_{0};
+};
+
+#endif  // LOCK_FREE_RING_BUFFER_H
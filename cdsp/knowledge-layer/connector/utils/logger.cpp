@@ -0,0 +1,409 @@
+#include "logger.h"
+
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+#include "helper.h"
+
+/**
+ * @brief Builds the logger settings from the LOG_* environment variables.
+ *
+ * @return The settings, with defaults for the variables that are not set.
+ * @throws std::invalid_argument if a variable holds an invalid value.
+ */
+LoggerSettings LoggerSettings::fromEnvironment() {
+    LoggerSettings settings;
+    settings.level = Logger::parseLevel(Helper::getEnvVariable("LOG_LEVEL", "info"));
+
+    const std::string file_path = Helper::getEnvVariable("LOG_FILE");
+    if (!file_path.empty()) {
+        settings.file_path = file_path;
+    }
+    settings.max_file_size =
+        Helper::getUnsignedEnvVariable("LOG_FILE_MAX_SIZE", settings.max_file_size);
+    settings.max_files = Helper::getUnsignedEnvVariable("LOG_FILE_MAX_FILES", settings.max_files);
+    settings.payload_sample_rate =
+        Helper::getUnsignedEnvVariable("LOG_PAYLOAD_SAMPLE_RATE", settings.payload_sample_rate);
+    settings.payload_max_per_second =
+        Helper::getUnsignedEnvVariable("LOG_PAYLOAD_MAX_PER_SECOND",
+                                       settings.payload_max_per_second);
+    settings.payload_max_bytes =
+        Helper::getUnsignedEnvVariable("LOG_PAYLOAD_MAX_BYTES", settings.payload_max_bytes);
+    return settings;
+}
+
+Logger::Logger() : queue_(std::make_unique<LockFreeRingBuffer<Record>>(settings_.queue_capacity)) {
+    start();
+}
+
+Logger::~Logger() { stop(); }
+
+/**
+ * @brief Returns the process wide logger, started with the default settings.
+ */
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+/**
+ * @brief Applies new settings and restarts the background writer.
+ *
+ * Meant to be called once at startup, before other threads log.
+ *
+ * @param settings The settings to apply.
+ */
+void Logger::configure(const LoggerSettings& settings) {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+        if (file_.is_open()) {
+            file_.close();
+        }
+        if (settings.queue_capacity != settings_.queue_capacity) {
+            queue_ = std::make_unique<LockFreeRingBuffer<Record>>(settings.queue_capacity);
+        }
+        settings_ = settings;
+        level_.store(settings.level, std::memory_order_relaxed);
+        if (settings_.file_path) {
+            openLogFile();
+        }
+    }
+    start();
+}
+
+void Logger::setLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+
+LogLevel Logger::getLevel() const { return level_.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Queues a formatted message for the background writer.
+ *
+ * The timestamp is taken here, but formatted by the writer. If the queue is full the record is
+ * dropped and counted, the writer reports the number of dropped records.
+ *
+ * @param level The level of the message.
+ * @param message The formatted message.
+ */
+void Logger::log(LogLevel level, std::string message) {
+    Record record{level, std::chrono::system_clock::now(), std::move(message)};
+
+    // Announces the caller before checking the flag, stop() does the opposite, so either stop()
+    // waits for this record or the record is not queued
+    queuing_callers_.fetch_add(1);
+    if (accepting_.load()) {
+        pending_records_.fetch_add(1, std::memory_order_relaxed);
+        const bool queued = queue_->tryPush(std::move(record));
+        if (!queued) {
+            pending_records_.fetch_sub(1, std::memory_order_relaxed);
+            dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        }
+        queuing_callers_.fetch_sub(1, std::memory_order_release);
+        if (queued) {
+            worker_condition_.notify_one();
+        }
+        return;
+    }
+    queuing_callers_.fetch_sub(1, std::memory_order_release);
+
+    // Logging during or after shutdown is written synchronously.
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    write(record);
+    flushSink();
+}
+
+/**
+ * @brief Decides whether the next message payload should be logged.
+ *
+ * Only every n-th payload is considered (sampling) and at most a configured number of payloads per
+ * second is let through. Rejected payloads are counted and reported with the next logged one.
+ *
+ * @return true if the payload should be logged.
+ */
+bool Logger::shouldLogPayload() {
+    const std::uint64_t counter = payload_counter_.fetch_add(1, std::memory_order_relaxed);
+    if (settings_.payload_sample_rate > 1 && counter % settings_.payload_sample_rate != 0) {
+        suppressed_payloads_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (settings_.payload_max_per_second == 0) {
+        return true;
+    }
+
+    const std::int64_t second = std::chrono::duration_cast<std::chrono::seconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+    std::int64_t window = payload_window_second_.load(std::memory_order_relaxed);
+    if (window != second && payload_window_second_.compare_exchange_strong(window, second)) {
+        payloads_in_window_.store(0, std::memory_order_relaxed);
+    }
+    if (payloads_in_window_.fetch_add(1, std::memory_order_relaxed) >=
+        settings_.payload_max_per_second) {
+        suppressed_payloads_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Logs a message payload, truncated to the configured maximum size.
+ *
+ * @param level The level of the message.
+ * @param label A short description of the payload.
+ * @param payload The payload to log.
+ */
+void Logger::logPayload(LogLevel level, std::string_view label, std::string_view payload) {
+    const bool truncate =
+        settings_.payload_max_bytes > 0 && payload.size() > settings_.payload_max_bytes;
+    const std::string_view logged_payload =
+        truncate ? payload.substr(0, settings_.payload_max_bytes) : payload;
+
+    std::string message;
+    message.reserve(label.size() + logged_payload.size() + 96);
+    message.append(label).append(": ").append(logged_payload);
+    if (truncate) {
+        message.append("... (truncated, ")
+            .append(std::to_string(payload.size()))
+            .append(" bytes)");
+    }
+
+    const std::uint64_t suppressed = suppressed_payloads_.load(std::memory_order_relaxed);
+    const std::uint64_t reported =
+        reported_suppressed_payloads_.exchange(suppressed, std::memory_order_relaxed);
+    if (suppressed > reported) {
+        message.append(" [")
+            .append(std::to_string(suppressed - reported))
+            .append(" payloads not logged since the previous one]");
+    }
+    log(level, std::move(message));
+}
+
+/**
+ * @brief Blocks until all queued records have been written.
+ */
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(worker_mutex_);
+    worker_condition_.notify_one();
+    flushed_condition_.wait(lock, [this] {
+        return pending_records_.load(std::memory_order_relaxed) == 0 ||
+               !running_.load(std::memory_order_relaxed);
+    });
+}
+
+/**
+ * @brief Writes the queued records and stops the background writer.
+ *
+ * Records logged afterwards are written synchronously.
+ */
+void Logger::shutdown() { stop(); }
+
+std::uint64_t Logger::getDroppedRecords() const {
+    return dropped_records_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Logger::getSuppressedPayloads() const {
+    return suppressed_payloads_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the name of a log level as written in the log.
+ */
+std::string_view Logger::toString(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE:
+            return "TRACE";
+        case LogLevel::DEBUG:
+            return "DEBUG";
+        case LogLevel::INFO:
+            return "INFO";
+        case LogLevel::WARN:
+            return "WARN";
+        case LogLevel::ERROR:
+            return "ERROR";
+        default:
+            return "OFF";
+    }
+}
+
+/**
+ * @brief Parses a log level name (case-insensitive).
+ *
+ * @param level One of trace, debug, info, warn, error or off.
+ * @return The corresponding log level.
+ * @throws std::invalid_argument if the name is unknown.
+ */
+LogLevel Logger::parseLevel(const std::string& level) {
+    const std::string name = Helper::toLowerCase(level);
+    if (name == "trace") {
+        return LogLevel::TRACE;
+    } else if (name == "debug") {
+        return LogLevel::DEBUG;
+    } else if (name == "info") {
+        return LogLevel::INFO;
+    } else if (name == "warn" || name == "warning") {
+        return LogLevel::WARN;
+    } else if (name == "error") {
+        return LogLevel::ERROR;
+    } else if (name == "off") {
+        return LogLevel::OFF;
+    }
+    throw std::invalid_argument("Unknown log level: '" + level +
+                                "'. Use trace, debug, info, warn, error or off.");
+}
+
+void Logger::start() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    running_ = true;
+    worker_ = std::thread(&Logger::run, this);
+    accepting_ = true;
+}
+
+void Logger::stop() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    if (!running_) {
+        return;
+    }
+    // Waits for the records being queued, later ones are written synchronously
+    accepting_ = false;
+    while (queuing_callers_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> worker_lock(worker_mutex_);
+        running_ = false;
+    }
+    worker_condition_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    // Records queued while the writer was stopping
+    drain();
+    flushed_condition_.notify_all();
+}
+
+/**
+ * @brief Main loop of the background writer.
+ *
+ * Sleeps until records are queued (or the idle timeout expires to report dropped records) and
+ * writes everything that is queued in one batch with a single flush.
+ */
+void Logger::run() {
+    std::unique_lock<std::mutex> lock(worker_mutex_);
+    while (running_) {
+        worker_condition_.wait_for(lock, WORKER_IDLE_TIMEOUT, [this] {
+            return !running_ || pending_records_.load(std::memory_order_relaxed) > 0;
+        });
+        lock.unlock();
+        const bool wrote = drain();
+        lock.lock();
+        if (wrote) {
+            flushed_condition_.notify_all();
+        }
+    }
+    lock.unlock();
+    drain();
+}
+
+/**
+ * @brief Writes all queued records and flushes the sink once.
+ *
+ * @return true if anything was written.
+ */
+bool Logger::drain() {
+    Record record;
+    std::uint64_t popped = 0;
+    while (queue_->tryPop(record)) {
+        write(record);
+        ++popped;
+    }
+    std::uint64_t written = popped;
+
+    const std::uint64_t dropped = dropped_records_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_records_) {
+        write(Record{LogLevel::WARN, std::chrono::system_clock::now(),
+                     std::to_string(dropped - reported_dropped_records_) +
+                         " log records dropped because the log queue was full"});
+        reported_dropped_records_ = dropped;
+        ++written;
+    }
+
+    if (written == 0) {
+        return false;
+    }
+    flushSink();
+    pending_records_.fetch_sub(popped, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Formats a record and writes it to the sink, rotating the log file if needed.
+ *
+ * @param record The record to write.
+ */
+void Logger::write(const Record& record) {
+    std::string line = Helper::getFormattedTimestampCustom("%Y-%m-%dT%H:%M:%S", record.timestamp,
+                                                           true, true);
+    line.append(" [").append(toString(record.level)).append("] ");
+    line.append(record.message).push_back('\n');
+
+    if (file_.is_open()) {
+        file_ << line;
+        file_size_ += line.size();
+        if (settings_.max_file_size > 0 && file_size_ >= settings_.max_file_size) {
+            rotateLogFile();
+        }
+    } else if (record.level >= LogLevel::WARN) {
+        std::cerr << line;
+    } else {
+        std::cout << line;
+    }
+}
+
+void Logger::flushSink() {
+    if (file_.is_open()) {
+        file_.flush();
+    } else {
+        std::cout.flush();
+    }
+}
+
+/**
+ * @brief Opens the configured log file in append mode, falling back to the console on failure.
+ */
+void Logger::openLogFile() {
+    const std::filesystem::path path(*settings_.file_path);
+    std::error_code error;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    file_.open(path, std::ios::out | std::ios::app);
+    if (!file_.is_open()) {
+        std::cerr << "Failed to open log file " << path << ", logging to the console instead\n";
+        settings_.file_path.reset();
+        return;
+    }
+    const auto size = std::filesystem::file_size(path, error);
+    file_size_ = error ? 0 : static_cast<std::size_t>(size);
+}
+
+/**
+ * @brief Rotates the log file: file.log becomes file.log.1, file.log.1 becomes file.log.2 and so
+ * on, the oldest file beyond the configured number of files is removed.
+ */
+void Logger::rotateLogFile() {
+    file_.close();
+    const std::string base = *settings_.file_path;
+    std::error_code error;
+    if (settings_.max_files == 0) {
+        std::filesystem::remove(base, error);
+    } else {
+        std::filesystem::remove(base + "." + std::to_string(settings_.max_files), error);
+        for (std::size_t index = settings_.max_files - 1; index >= 1; --index) {
+            std::filesystem::rename(base + "." + std::to_string(index),
+                                    base + "." + std::to_string(index + 1), error);
+        }
+        std::filesystem::rename(base, base + ".1", error);
+    }
+    openLogFile();
+}
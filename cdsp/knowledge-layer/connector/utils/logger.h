@@ -0,0 +1,173 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "lock_free_ring_buffer.h"
+
+enum class LogLevel : std::uint8_t { TRACE = 0, DEBUG, INFO, WARN, ERROR, OFF };
+
+// Levels below this value are compiled out of the LOG_* macros, set through CMake.
+#ifndef CDSP_LOG_COMPILE_LEVEL
+#define CDSP_LOG_COMPILE_LEVEL 0
+#endif
+
+/**
+ * @brief Whether a level is compiled into the LOG_* macros.
+ */
+constexpr bool isLogLevelCompiledIn(LogLevel level) {
+    return level >= static_cast<LogLevel>(CDSP_LOG_COMPILE_LEVEL);
+}
+
+/**
+ * @brief Runtime settings of the Logger, usually read from the environment.
+ */
+struct LoggerSettings {
+    LogLevel level = LogLevel::INFO;
+    // Log file to write to, stdout/stderr are used when not set.
+    std::optional<std::string> file_path;
+    std::size_t max_file_size = 10 * 1024 * 1024;
+    std::size_t max_files = 5;
+    // Only every n-th payload is logged.
+    std::size_t payload_sample_rate = 1;
+    // Upper bound of logged payloads per second, 0 disables the limit.
+    std::size_t payload_max_per_second = 10;
+    // Payloads are truncated to this size, 0 disables truncation.
+    std::size_t payload_max_bytes = 4096;
+    std::size_t queue_capacity = 8192;
+
+    static LoggerSettings fromEnvironment();
+};
+
+/**
+ * @brief Asynchronous leveled logger.
+ *
+ * Callers only check the level, format the message and push it into a lock-free ring buffer. A
+ * background thread adds the timestamp and level and writes the records in batches to the console
+ * (WARN and ERROR go to stderr) or to a size-rotated log file. When the buffer is full, records
+ * are dropped and counted instead of blocking the caller. Only records logged while the writer
+ * stops are written synchronously, under a lock.
+ */
+class Logger {
+   public:
+    static Logger& getInstance();
+
+    void configure(const LoggerSettings& settings);
+    void setLevel(LogLevel level);
+    LogLevel getLevel() const;
+
+    bool isEnabled(LogLevel level) const {
+        return level >= level_.load(std::memory_order_relaxed) && level != LogLevel::OFF;
+    }
+
+    void log(LogLevel level, std::string message);
+    bool shouldLogPayload();
+    void logPayload(LogLevel level, std::string_view label, std::string_view payload);
+
+    void flush();
+    void shutdown();
+
+    std::uint64_t getDroppedRecords() const;
+    std::uint64_t getSuppressedPayloads() const;
+
+    static std::string_view toString(LogLevel level);
+    static LogLevel parseLevel(const std::string& level);
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+   private:
+    struct Record {
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point timestamp;
+        std::string message;
+    };
+
+    static constexpr auto WORKER_IDLE_TIMEOUT = std::chrono::milliseconds(50);
+
+    Logger();
+    ~Logger();
+
+    std::atomic<LogLevel> level_{LogLevel::INFO};
+    LoggerSettings settings_;
+    std::unique_ptr<LockFreeRingBuffer<Record>> queue_;
+
+    // Worker thread state
+    std::thread worker_;
+    std::mutex worker_mutex_;
+    std::condition_variable worker_condition_;
+    std::condition_variable flushed_condition_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> pending_records_{0};
+    std::mutex lifecycle_mutex_;
+    // Whether log() queues records. stop() clears it and waits until no caller is queuing, so no
+    // record is queued after the final drain or into a queue that configure() replaces
+    std::atomic<bool> accepting_{false};
+    std::atomic<std::uint32_t> queuing_callers_{0};
+
+    // Counters
+    std::atomic<std::uint64_t> dropped_records_{0};
+    std::uint64_t reported_dropped_records_ = 0;
+    std::atomic<std::uint64_t> payload_counter_{0};
+    std::atomic<std::int64_t> payload_window_second_{0};
+    std::atomic<std::uint64_t> payloads_in_window_{0};
+    std::atomic<std::uint64_t> suppressed_payloads_{0};
+    std::atomic<std::uint64_t> reported_suppressed_payloads_{0};
+
+    // Sink state, only touched by the writer thread while it runs
+    std::ofstream file_;
+    std::size_t file_size_ = 0;
+
+    void start();
+    void stop();
+    void run();
+    bool drain();
+    void write(const Record& record);
+    void flushSink();
+    void openLogFile();
+    void rotateLogFile();
+};
+
+#define CDSP_LOG(level, message_stream)                                                   \
+    do {                                                                                  \
+        if constexpr (isLogLevelCompiledIn(level)) {                                      \
+            Logger& cdsp_logger = Logger::getInstance();                                  \
+            if (cdsp_logger.isEnabled(level)) {                                           \
+                std::ostringstream cdsp_log_stream;                                       \
+                cdsp_log_stream << message_stream;                                        \
+                cdsp_logger.log(level, cdsp_log_stream.str());                            \
+            }                                                                             \
+        }                                                                                 \
+    } while (false)
+
+// The message is only formatted when the level is enabled, e.g. LOG_INFO("Sent " << bytes).
+#define LOG_TRACE(message_stream) CDSP_LOG(LogLevel::TRACE, message_stream)
+#define LOG_DEBUG(message_stream) CDSP_LOG(LogLevel::DEBUG, message_stream)
+#define LOG_INFO(message_stream) CDSP_LOG(LogLevel::INFO, message_stream)
+#define LOG_WARN(message_stream) CDSP_LOG(LogLevel::WARN, message_stream)
+#define LOG_ERROR(message_stream) CDSP_LOG(LogLevel::ERROR, message_stream)
+
+// Logs a (potentially large) message payload subject to sampling, rate limit and truncation.
+#define LOG_PAYLOAD(level, label, payload)                                                \
+    do {                                                                                  \
+        if constexpr (isLogLevelCompiledIn(level)) {                                      \
+            Logger& cdsp_logger = Logger::getInstance();                                  \
+            if (cdsp_logger.isEnabled(level) && cdsp_logger.shouldLogPayload()) {         \
+                cdsp_logger.logPayload(level, label, payload);                            \
+            }                                                                             \
+        }                                                                                 \
+    } while (false)
+
+#endif  // LOGGER_H
@@ -0,0 +1,195 @@
+#include "message_arena_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "logger.h"
+
+namespace {
+
+/**
+ * @brief Memory resource forwarding to an upstream resource and counting the allocated bytes.
+ */
+class CountingResource : public std::pmr::memory_resource {
+   public:
+    explicit CountingResource(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+
+    [[nodiscard]] std::size_t bytes() const { return bytes_; }
+    void reset() { bytes_ = 0; }
+
+   private:
+    std::pmr::memory_resource* upstream_;
+    std::size_t bytes_ = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        bytes_ += bytes;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+        upstream_->deallocate(pointer, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief Memory block of an arena and the resources allocating from it.
+ *
+ * The monotonic resource serves allocations from the block and asks the heap (counted by
+ * `upstream`) only when the block is exhausted. `allocations` counts what the arena handed out.
+ */
+struct MessageArenaPool::ArenaState {
+    explicit ArenaState(std::size_t size)
+        : block(new std::byte[size]),
+          block_size(size),
+          upstream(std::pmr::new_delete_resource()),
+          arena(block.get(), block_size, &upstream),
+          allocations(&arena) {}
+
+    std::unique_ptr<std::byte[]> block;
+    std::size_t block_size;
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena;
+    CountingResource allocations;
+};
+
+MessageArenaPool::Arena::Arena(std::unique_ptr<ArenaState> state,
+                               std::weak_ptr<MessageArenaPool> pool)
+    : state_(std::move(state)), pool_(std::move(pool)) {}
+
+MessageArenaPool::Arena::Arena(Arena&& other) noexcept = default;
+
+MessageArenaPool::Arena& MessageArenaPool::Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        release();
+        state_ = std::move(other.state_);
+        pool_ = std::move(other.pool_);
+    }
+    return *this;
+}
+
+MessageArenaPool::Arena::~Arena() { release(); }
+
+/**
+ * @brief Retrieves the memory resource of the arena, to be passed to `std::pmr` containers.
+ */
+std::pmr::memory_resource* MessageArenaPool::Arena::resource() const {
+    return &state_->allocations;
+}
+
+/**
+ * @brief Returns the number of bytes allocated from the arena so far.
+ */
+std::size_t MessageArenaPool::Arena::bytesAllocated() const {
+    return state_->allocations.bytes();
+}
+
+/**
+ * @brief Returns the arena to its pool, or frees it if the pool no longer exists.
+ */
+void MessageArenaPool::Arena::release() {
+    if (!state_) {
+        return;
+    }
+    if (auto pool = pool_.lock()) {
+        pool->release(std::move(state_));
+    } else {
+        state_.reset();
+    }
+}
+
+/**
+ * @brief Constructs a MessageArenaPool.
+ *
+ * @param block_size The initial size of the memory block of each arena.
+ * @param max_block_size The size up to which the blocks grow when messages need more memory.
+ * @param max_pooled_arenas The maximum number of idle arenas kept for reuse.
+ */
+MessageArenaPool::MessageArenaPool(std::size_t block_size, std::size_t max_block_size,
+                                   std::size_t max_pooled_arenas)
+    : max_block_size_(std::max(block_size, max_block_size)),
+      max_pooled_arenas_(max_pooled_arenas) {
+    statistics_.block_size = std::max<std::size_t>(block_size, 1);
+}
+
+MessageArenaPool::~MessageArenaPool() = default;
+
+/**
+ * @brief Hands out an empty arena, reusing an idle one if available.
+ *
+ * @return The lease of the arena, which returns it to the pool when destroyed.
+ */
+MessageArenaPool::Arena MessageArenaPool::acquire() {
+    std::unique_ptr<ArenaState> state;
+    std::size_t block_size = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        statistics_.acquired++;
+        if (!free_arenas_.empty()) {
+            state = std::move(free_arenas_.back());
+            free_arenas_.pop_back();
+            statistics_.pooled = free_arenas_.size();
+        }
+        block_size = statistics_.block_size;
+    }
+    if (!state) {
+        state = std::make_unique<ArenaState>(block_size);
+    }
+    return {std::move(state), weak_from_this()};
+}
+
+/**
+ * @brief Returns a snapshot of the pool counters.
+ */
+MessageArenaStatistics MessageArenaPool::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+/**
+ * @brief Takes an arena back, recording how much memory it used.
+ *
+ * The memory of the arena is released in one step. Arenas whose block is smaller than the
+ * current block size, e.g. after the blocks grew, are freed instead of being pooled.
+ *
+ * @param state The arena released by its lease.
+ */
+void MessageArenaPool::release(std::unique_ptr<ArenaState> state) {
+    const std::size_t bytes = state->allocations.bytes();
+    const bool overflowed = state->upstream.bytes() > 0;
+    state->arena.release();
+    state->allocations.reset();
+    state->upstream.reset();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.last_bytes = bytes;
+    statistics_.high_water_bytes = std::max(statistics_.high_water_bytes, bytes);
+    if (overflowed) {
+        statistics_.overflowed++;
+    }
+
+    if (bytes > statistics_.block_size && statistics_.block_size < max_block_size_) {
+        std::size_t block_size = statistics_.block_size;
+        while (block_size < bytes && block_size < max_block_size_) {
+            block_size *= 2;
+        }
+        statistics_.block_size = std::min(block_size, max_block_size_);
+        LOG_DEBUG("Message arena blocks grow to " << statistics_.block_size << " bytes");
+    }
+
+    if (state->block_size == statistics_.block_size &&
+        free_arenas_.size() < max_pooled_arenas_) {
+        free_arenas_.push_back(std::move(state));
+    }
+    free_arenas_.erase(std::remove_if(free_arenas_.begin(), free_arenas_.end(),
+                                      [this](const auto& free_arena) {
+                                          return free_arena->block_size != statistics_.block_size;
+                                      }),
+                       free_arenas_.end());
+    statistics_.pooled = free_arenas_.size();
+}
@@ -0,0 +1,88 @@
+#ifndef MESSAGE_ARENA_POOL_H
+#define MESSAGE_ARENA_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Counters of the message arena pool.
+ */
+struct MessageArenaStatistics {
+    std::uint64_t acquired = 0;
+    // Most bytes allocated from a single arena, i.e. for the processing of one message.
+    std::size_t high_water_bytes = 0;
+    std::size_t last_bytes = 0;
+    // Arenas whose block was too small, so memory had to be requested from the heap.
+    std::uint64_t overflowed = 0;
+    // Size of the block of new arenas. It grows up to the high-water mark.
+    std::size_t block_size = 0;
+    std::size_t pooled = 0;
+};
+
+/**
+ * @brief Pool of memory arenas for the data that only lives while one message is processed.
+ *
+ * An arena is a `std::pmr::monotonic_buffer_resource` on a pooled memory block: allocations are
+ * served by bumping a pointer and are all released at once when the arena goes back to the pool.
+ * When a message needs more than the block, the arena falls back to the heap and the block size
+ * of later arenas grows to the high-water mark (up to a maximum), so that the data of a message
+ * usually fits in one block. The pool must be created with `std::make_shared`.
+ */
+class MessageArenaPool : public std::enable_shared_from_this<MessageArenaPool> {
+   public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    static constexpr std::size_t DEFAULT_MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+    static constexpr std::size_t DEFAULT_MAX_POOLED_ARENAS = 4;
+
+   private:
+    struct ArenaState;
+
+   public:
+    /**
+     * @brief Lease of an arena, returned to the pool when it is destroyed.
+     *
+     * Everything allocated from the arena must be destroyed before the lease.
+     */
+    class Arena {
+       public:
+        Arena(Arena&& other) noexcept;
+        Arena& operator=(Arena&& other) noexcept;
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+        ~Arena();
+
+        [[nodiscard]] std::pmr::memory_resource* resource() const;
+        [[nodiscard]] std::size_t bytesAllocated() const;
+
+       private:
+        friend class MessageArenaPool;
+        Arena(std::unique_ptr<ArenaState> state, std::weak_ptr<MessageArenaPool> pool);
+        void release();
+
+        std::unique_ptr<ArenaState> state_;
+        std::weak_ptr<MessageArenaPool> pool_;
+    };
+
+    explicit MessageArenaPool(std::size_t block_size = DEFAULT_BLOCK_SIZE,
+                              std::size_t max_block_size = DEFAULT_MAX_BLOCK_SIZE,
+                              std::size_t max_pooled_arenas = DEFAULT_MAX_POOLED_ARENAS);
+    ~MessageArenaPool();
+
+    Arena acquire();
+    [[nodiscard]] MessageArenaStatistics getStatistics() const;
+
+   private:
+    void release(std::unique_ptr<ArenaState> state);
+
+    const std::size_t max_block_size_;
+    const std::size_t max_pooled_arenas_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ArenaState>> free_arenas_;
+    MessageArenaStatistics statistics_;
+};
+
+#endif  // MESSAGE_ARENA_POOL_H
@@ -0,0 +1,353 @@
+#include "output_archive.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "logger.h"
+
+namespace {
+constexpr std::size_t CHUNK_SIZE = 16 * 1024;
+// Window size of the deflate stream, +16 selects the gzip format
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+constexpr int MEMORY_LEVEL = 8;
+constexpr int OS_UNKNOWN = 255;
+
+std::int64_t toSeconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromSeconds(std::int64_t seconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+}  // namespace
+
+/**
+ * @brief Constructs a writer appending to a new, empty archive file.
+ *
+ * @param file The archive file, opened for writing by the caller.
+ * @param index_path The path of the index file of the archive.
+ * @param block_interval The duration of a time block, 0 writes a single block.
+ * @param compression_level The zlib compression level (0-9).
+ */
+OutputArchiveWriter::OutputArchiveWriter(std::FILE* file, std::string index_path,
+                                         std::chrono::seconds block_interval,
+                                         int compression_level)
+    : file_(file),
+      index_path_(std::move(index_path)),
+      block_interval_(block_interval),
+      compression_level_(compression_level) {}
+
+/**
+ * @brief Releases the deflate stream. The open block is not finished, call `finish()` before
+ * closing the file.
+ */
+OutputArchiveWriter::~OutputArchiveWriter() {
+    if (block_open_) {
+        deflateEnd(&stream_);
+    }
+}
+
+/**
+ * @brief Compresses a record into the open block, starting a new block if the current one is
+ * older than the block interval.
+ *
+ * @param content The record to write.
+ * @param now The time the record is written at, decides the block of the record.
+ * @return true if the record was compressed and the output written to the file.
+ */
+bool OutputArchiveWriter::write(std::string_view content,
+                                std::chrono::system_clock::time_point now) {
+    if (block_open_ && block_interval_.count() > 0 && now - block_start_ >= block_interval_) {
+        if (!finish()) {
+            return false;
+        }
+    }
+    if (!block_open_ && !startBlock(now)) {
+        return false;
+    }
+
+    while (!content.empty()) {
+        const std::size_t size =
+            std::min<std::size_t>(content.size(), std::numeric_limits<uInt>::max());
+        // zlib does not modify the input, the cast only satisfies its C interface
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(content.data()));
+        stream_.avail_in = static_cast<uInt>(size);
+        if (!deflateInput(Z_NO_FLUSH)) {
+            return false;
+        }
+        content.remove_prefix(size);
+    }
+    return true;
+}
+
+/**
+ * @brief Adds a flush point, after which everything written so far can be decompressed from
+ * the file.
+ *
+ * @return true if the pending output was written to the file.
+ */
+bool OutputArchiveWriter::flush() { return !block_open_ || deflateInput(Z_SYNC_FLUSH); }
+
+/**
+ * @brief Finishes the open block, writing the end of its gzip member. The next record starts a
+ * new block.
+ *
+ * @return true if the end of the block was written to the file.
+ */
+bool OutputArchiveWriter::finish() {
+    if (!block_open_) {
+        return true;
+    }
+    const bool finished = deflateInput(Z_FINISH);
+    deflateEnd(&stream_);
+    block_open_ = false;
+    return finished;
+}
+
+/**
+ * @brief Returns the number of compressed bytes written to the file.
+ */
+std::uint64_t OutputArchiveWriter::getCompressedSize() const { return compressed_size_; }
+
+/**
+ * @brief Starts a new gzip member at the end of the file and adds it to the index.
+ *
+ * @param now The start time of the block, stored in seconds in the gzip header and the index.
+ * @return true if the deflate stream was initialized.
+ */
+bool OutputArchiveWriter::startBlock(std::chrono::system_clock::time_point now) {
+    stream_ = z_stream{};
+    if (deflateInit2(&stream_, compression_level_, Z_DEFLATED, GZIP_WINDOW_BITS, MEMORY_LEVEL,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        LOG_ERROR("Failed to initialize the archive compression: "
+                  << (stream_.msg != nullptr ? stream_.msg : "unknown error"));
+        return false;
+    }
+
+    block_start_ = fromSeconds(toSeconds(now));
+    header_ = gz_header{};
+    header_.time = static_cast<uLong>(toSeconds(block_start_));
+    header_.os = OS_UNKNOWN;
+    deflateSetHeader(&stream_, &header_);
+    block_open_ = true;
+
+    if (!appendIndex({block_start_, compressed_size_})) {
+        // The reader falls back to scanning the archive
+        LOG_WARN("Failed to update the archive index " << index_path_ << ": "
+                                                       << std::strerror(errno));
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the deflate stream on the pending input and writes the output to the file.
+ *
+ * @param flush The zlib flush mode: Z_NO_FLUSH, Z_SYNC_FLUSH or Z_FINISH.
+ * @return true if all output was written.
+ */
+bool OutputArchiveWriter::deflateInput(int flush) {
+    std::array<unsigned char, CHUNK_SIZE> buffer;
+    int result = Z_OK;
+    do {
+        stream_.next_out = buffer.data();
+        stream_.avail_out = static_cast<uInt>(buffer.size());
+        result = deflate(&stream_, flush);
+        if (result == Z_STREAM_ERROR) {
+            LOG_ERROR("Failed to compress the archive output");
+            return false;
+        }
+
+        const std::size_t produced = buffer.size() - stream_.avail_out;
+        if (produced > 0 && std::fwrite(buffer.data(), 1, produced, file_) != produced) {
+            return false;
+        }
+        compressed_size_ += produced;
+    } while (flush == Z_FINISH ? result != Z_STREAM_END : stream_.avail_out == 0);
+    return true;
+}
+
+/**
+ * @brief Appends a `<seconds> <offset>` line for a block to the index file.
+ */
+bool OutputArchiveWriter::appendIndex(const OutputArchiveBlock& block) const {
+    std::FILE* index = std::fopen(index_path_.c_str(), "a");
+    if (index == nullptr) {
+        return false;
+    }
+    const bool written = std::fprintf(index, "%lld %llu\n",
+                                      static_cast<long long>(toSeconds(block.start)),
+                                      static_cast<unsigned long long>(block.offset)) > 0;
+    return std::fclose(index) == 0 && written;
+}
+
+/**
+ * @brief Opens an archive and collects its time blocks.
+ *
+ * @param path The path of the archive.
+ * @param use_index Whether the index file is used, if it exists, instead of scanning the archive.
+ * @throws std::runtime_error if the archive does not exist.
+ */
+OutputArchiveReader::OutputArchiveReader(std::string path, bool use_index)
+    : path_(std::move(path)) {
+    if (!std::filesystem::exists(path_)) {
+        throw std::runtime_error("Output archive not found: " + path_);
+    }
+    if (!use_index || !readIndex()) {
+        scanBlocks();
+    }
+}
+
+/**
+ * @brief Returns the time blocks of the archive, ordered by their offset.
+ */
+const std::vector<OutputArchiveBlock>& OutputArchiveReader::getBlocks() const { return blocks_; }
+
+/**
+ * @brief Decompresses the blocks that overlap a time range.
+ *
+ * A block covers the time from its start to the start of the next block, records are only
+ * located by their block. Hence the output can contain records up to one block interval
+ * before and after the range.
+ *
+ * @param from The start of the range (inclusive), unbounded if not set.
+ * @param to The end of the range (exclusive), unbounded if not set.
+ * @param output The stream the decompressed records are written to.
+ * @return The number of blocks read.
+ * @throws std::runtime_error if the archive cannot be opened.
+ */
+std::size_t OutputArchiveReader::read(std::optional<std::chrono::system_clock::time_point> from,
+                                      std::optional<std::chrono::system_clock::time_point> to,
+                                      std::ostream& output) const {
+    std::FILE* file = std::fopen(path_.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Failed to open output archive " + path_ + ": " +
+                                 std::strerror(errno));
+    }
+
+    std::size_t read_blocks = 0;
+    for (std::size_t index = 0; index < blocks_.size(); ++index) {
+        const OutputArchiveBlock& block = blocks_[index];
+        const bool starts_before_end = !to.has_value() || block.start < *to;
+        const bool ends_after_start = !from.has_value() || index + 1 == blocks_.size() ||
+                                      blocks_[index + 1].start > *from;
+        if (starts_before_end && ends_after_start) {
+            inflateBlock(file, block.offset, &output);
+            ++read_blocks;
+        }
+    }
+    std::fclose(file);
+    return read_blocks;
+}
+
+/**
+ * @brief Reads the blocks from the index file of the archive.
+ *
+ * @return false if there is no index file.
+ */
+bool OutputArchiveReader::readIndex() {
+    std::ifstream index(path_ + ".idx");
+    if (!index.is_open()) {
+        return false;
+    }
+    std::int64_t seconds = 0;
+    std::uint64_t offset = 0;
+    while (index >> seconds >> offset) {
+        blocks_.push_back({fromSeconds(seconds), offset});
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the blocks by decompressing the archive member by member, the start time of a
+ * block is taken from its gzip header.
+ */
+void OutputArchiveReader::scanBlocks() {
+    std::FILE* file = std::fopen(path_.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Failed to open output archive " + path_ + ": " +
+                                 std::strerror(errno));
+    }
+
+    const std::uint64_t size = std::filesystem::file_size(path_);
+    std::uint64_t offset = 0;
+    while (offset < size) {
+        std::optional<std::uint32_t> start_seconds;
+        const std::uint64_t consumed = inflateBlock(file, offset, nullptr, &start_seconds);
+        if (consumed == 0) {
+            break;
+        }
+        blocks_.push_back({fromSeconds(start_seconds.value_or(0)), offset});
+        offset += consumed;
+    }
+    std::fclose(file);
+}
+
+/**
+ * @brief Decompresses the gzip member at an offset of the archive.
+ *
+ * @param file The archive file.
+ * @param offset The offset of the member.
+ * @param output The stream the decompressed data is written to, nullptr to discard it.
+ * @param start_seconds Receives the MTIME of the member header, if requested.
+ * @return The compressed size of the member, or of the data read until the end of the file for
+ * a truncated member. 0 if the data is not a valid gzip member.
+ */
+std::uint64_t OutputArchiveReader::inflateBlock(std::FILE* file, std::uint64_t offset,
+                                                std::ostream* output,
+                                                std::optional<std::uint32_t>* start_seconds) const {
+    if (std::fseek(file, static_cast<long>(offset), SEEK_SET) != 0) {
+        return 0;
+    }
+
+    z_stream stream{};
+    if (inflateInit2(&stream, GZIP_WINDOW_BITS) != Z_OK) {
+        return 0;
+    }
+    gz_header header{};
+    inflateGetHeader(&stream, &header);
+
+    std::array<unsigned char, CHUNK_SIZE> input;
+    std::array<unsigned char, CHUNK_SIZE> buffer;
+    bool finished = false;
+    bool failed = false;
+    while (!finished && !failed) {
+        const std::size_t size = std::fread(input.data(), 1, input.size(), file);
+        if (size == 0) {
+            // A truncated member is read up to its last flush point
+            break;
+        }
+        stream.next_in = input.data();
+        stream.avail_in = static_cast<uInt>(size);
+        do {
+            stream.next_out = buffer.data();
+            stream.avail_out = static_cast<uInt>(buffer.size());
+            const int result = inflate(&stream, Z_NO_FLUSH);
+            if (result == Z_STREAM_END) {
+                finished = true;
+            } else if (result != Z_OK && result != Z_BUF_ERROR) {
+                LOG_WARN("Corrupt block at offset " << offset << " of " << path_);
+                failed = true;
+            }
+
+            const std::size_t produced = buffer.size() - stream.avail_out;
+            if (output != nullptr && produced > 0) {
+                output->write(reinterpret_cast<const char*>(buffer.data()),
+                              static_cast<std::streamsize>(produced));
+            }
+        } while (!finished && !failed && stream.avail_out == 0);
+    }
+
+    if (start_seconds != nullptr && header.done == 1) {
+        *start_seconds = static_cast<std::uint32_t>(header.time);
+    }
+    const std::uint64_t consumed = failed ? 0 : stream.total_in;
+    inflateEnd(&stream);
+    return consumed;
+}
@@ -0,0 +1,98 @@
+#ifndef OUTPUT_ARCHIVE_H
+#define OUTPUT_ARCHIVE_H
+
+#include <zlib.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Time block of an output archive: one gzip member starting at a byte offset.
+ */
+struct OutputArchiveBlock {
+    std::chrono::system_clock::time_point start;
+    std::uint64_t offset = 0;
+};
+
+/**
+ * @brief Writes output records as a gzip file made of one gzip member per time block.
+ *
+ * A new member is started when a record is written after the block interval has elapsed, its
+ * gzip header carries the start time of the block (MTIME). The start time and byte offset of
+ * each block are appended to an index file (`<archive>.idx`, one `<seconds> <offset>` line per
+ * block), so that a time range can be read without decompressing the whole archive. The file is
+ * a valid multi-member gzip file, `zcat` decompresses all blocks at once.
+ *
+ * `flush()` adds a flush point (Z_SYNC_FLUSH): everything written before it can be decompressed
+ * from the file, so that the open block of a growing archive can be tailed.
+ *
+ * The archive file is opened and closed by the caller, the writer only appends to it.
+ */
+class OutputArchiveWriter {
+   public:
+    OutputArchiveWriter(std::FILE* file, std::string index_path,
+                        std::chrono::seconds block_interval,
+                        int compression_level = Z_DEFAULT_COMPRESSION);
+    ~OutputArchiveWriter();
+
+    OutputArchiveWriter(const OutputArchiveWriter&) = delete;
+    OutputArchiveWriter& operator=(const OutputArchiveWriter&) = delete;
+
+    bool write(std::string_view content,
+               std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+    bool flush();
+    bool finish();
+
+    [[nodiscard]] std::uint64_t getCompressedSize() const;
+
+   private:
+    std::FILE* file_;
+    const std::string index_path_;
+    const std::chrono::seconds block_interval_;
+    const int compression_level_;
+
+    z_stream stream_{};
+    gz_header header_{};
+    bool block_open_ = false;
+    std::chrono::system_clock::time_point block_start_;
+    std::uint64_t compressed_size_ = 0;
+
+    bool startBlock(std::chrono::system_clock::time_point now);
+    bool deflateInput(int flush);
+    bool appendIndex(const OutputArchiveBlock& block) const;
+};
+
+/**
+ * @brief Reads the records of chosen time blocks from an archive of the OutputArchiveWriter.
+ *
+ * The blocks are taken from the index file of the archive. Without an index (or with
+ * `use_index` set to false) the archive is scanned once to find the blocks. A truncated last
+ * block, e.g. of an archive that is still being written, is read up to its last flush point.
+ */
+class OutputArchiveReader {
+   public:
+    explicit OutputArchiveReader(std::string path, bool use_index = true);
+
+    [[nodiscard]] const std::vector<OutputArchiveBlock>& getBlocks() const;
+
+    std::size_t read(std::optional<std::chrono::system_clock::time_point> from,
+                     std::optional<std::chrono::system_clock::time_point> to,
+                     std::ostream& output) const;
+
+   private:
+    const std::string path_;
+    std::vector<OutputArchiveBlock> blocks_;
+
+    bool readIndex();
+    void scanBlocks();
+    std::uint64_t inflateBlock(std::FILE* file, std::uint64_t offset, std::ostream* output,
+                               std::optional<std::uint32_t>* start_seconds = nullptr) const;
+};
+
+#endif  // OUTPUT_ARCHIVE_H
@@ -0,0 +1,472 @@
+#include "output_writer.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include "helper.h"
+#include "logger.h"
+
+namespace {
+bool isSameFile(const OutputStream& stream, const OutputStream& other) {
+    return stream.directory == other.directory && stream.file_prefix == other.file_prefix &&
+           stream.extension == other.extension;
+}
+}  // namespace
+
+/**
+ * @brief Returns the settings of a stream, or the default settings if it has no entry.
+ */
+const OutputStreamSettings& OutputWriterSettings::getStreamSettings(
+    std::string_view stream_name) const {
+    static const OutputStreamSettings DEFAULT_STREAM_SETTINGS;
+    const auto stream = streams.find(stream_name);
+    return stream != streams.end() ? stream->second : DEFAULT_STREAM_SETTINGS;
+}
+
+/**
+ * @brief Builds the output writer settings from the OUTPUT_* environment variables.
+ *
+ * Each stream is configured through `OUTPUT_<STREAM>_ENABLED`, `OUTPUT_<STREAM>_SAMPLE_RATE` and
+ * `OUTPUT_<STREAM>_ARCHIVE`, where `<STREAM>` is the upper case name of the stream.
+ *
+ * @param stream_names The names of the streams to read the settings for.
+ * @return The settings, with defaults for the variables that are not set.
+ * @throws std::invalid_argument if a variable holds an invalid value.
+ */
+OutputWriterSettings OutputWriterSettings::fromEnvironment(
+    const std::vector<std::string>& stream_names) {
+    OutputWriterSettings settings;
+    settings.queue_capacity =
+        Helper::getUnsignedEnvVariable("OUTPUT_QUEUE_CAPACITY", settings.queue_capacity);
+    settings.fsync_policy = parseFsyncPolicy(Helper::getEnvVariable("OUTPUT_FSYNC", "never"));
+    settings.max_file_size =
+        Helper::getUnsignedEnvVariable("OUTPUT_FILE_MAX_SIZE", settings.max_file_size);
+    settings.max_file_age = std::chrono::seconds(
+        Helper::getUnsignedEnvVariable("OUTPUT_FILE_MAX_AGE", settings.max_file_age.count()));
+    settings.archive_block_interval = std::chrono::seconds(Helper::getUnsignedEnvVariable(
+        "OUTPUT_ARCHIVE_BLOCK_SECONDS", settings.archive_block_interval.count()));
+
+    for (const auto& stream_name : stream_names) {
+        const std::string prefix = "OUTPUT_" + Helper::toUppercase(stream_name) + "_";
+        OutputStreamSettings stream_settings;
+        stream_settings.enabled =
+            Helper::getBoolEnvVariable(prefix + "ENABLED", stream_settings.enabled);
+        stream_settings.sample_rate =
+            Helper::getUnsignedEnvVariable(prefix + "SAMPLE_RATE", stream_settings.sample_rate);
+        stream_settings.archive =
+            Helper::getBoolEnvVariable(prefix + "ARCHIVE", stream_settings.archive);
+        settings.streams[stream_name] = stream_settings;
+    }
+    return settings;
+}
+
+/**
+ * @brief Parses an fsync policy name (case-insensitive).
+ *
+ * @param policy One of never, batch or always.
+ * @return The corresponding fsync policy.
+ * @throws std::invalid_argument if the name is unknown.
+ */
+FsyncPolicy OutputWriterSettings::parseFsyncPolicy(const std::string& policy) {
+    const std::string name = Helper::toLowerCase(policy);
+    if (name == "never") {
+        return FsyncPolicy::NEVER;
+    } else if (name == "batch") {
+        return FsyncPolicy::BATCH;
+    } else if (name == "always") {
+        return FsyncPolicy::ALWAYS;
+    }
+    throw std::invalid_argument("Unknown fsync policy: '" + policy +
+                                "'. Use never, batch or always.");
+}
+
+AsyncOutputWriter::AsyncOutputWriter(OutputWriterSettings settings)
+    : settings_(std::move(settings)), queue_(settings_.queue_capacity) {
+    start();
+}
+
+AsyncOutputWriter::~AsyncOutputWriter() { stop(); }
+
+/**
+ * @brief Decides whether the next record of a stream should be written.
+ *
+ * Records of disabled streams are skipped, of sampled streams only every n-th record is written.
+ * Skipped records are counted.
+ *
+ * @param stream_name The name of the stream.
+ * @return true if the record should be built and written.
+ */
+bool AsyncOutputWriter::shouldWrite(const std::string& stream_name) {
+    const OutputStreamSettings& stream_settings = settings_.getStreamSettings(stream_name);
+    if (!stream_settings.enabled) {
+        skipped_records_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (stream_settings.sample_rate <= 1) {
+        return true;
+    }
+
+    std::uint64_t counter = 0;
+    {
+        std::lock_guard<std::mutex> lock(sampling_mutex_);
+        auto stream_counter = stream_counters_.find(stream_name);
+        if (stream_counter == stream_counters_.end()) {
+            stream_counter = stream_counters_.emplace(stream_name, 0).first;
+        }
+        counter = stream_counter->second++;
+    }
+    if (counter % stream_settings.sample_rate != 0) {
+        skipped_records_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns whether the records of a stream are written to a compressed archive, so that
+ * the caller can pick a format suited for archiving.
+ *
+ * @param stream_name The name of the stream.
+ */
+bool AsyncOutputWriter::isArchived(const std::string& stream_name) {
+    return settings_.getStreamSettings(stream_name).archive;
+}
+
+/**
+ * @brief Queues a record for the background writer.
+ *
+ * If the queue is full the record is dropped and counted, the writer reports the number of
+ * dropped records.
+ *
+ * @param stream The stream the record belongs to.
+ * @param content The content to append to the file of the stream.
+ */
+void AsyncOutputWriter::write(const OutputStream& stream, std::string content) {
+    Record record{stream, std::move(content)};
+
+    // Announces the caller before checking the flag, stop() does the opposite, so either stop()
+    // waits for this record or the record is not queued
+    queuing_callers_.fetch_add(1);
+    if (accepting_.load()) {
+        pending_records_.fetch_add(1, std::memory_order_relaxed);
+        const bool queued = queue_.tryPush(std::move(record));
+        if (!queued) {
+            pending_records_.fetch_sub(1, std::memory_order_relaxed);
+            dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        }
+        queuing_callers_.fetch_sub(1, std::memory_order_release);
+        if (queued) {
+            worker_condition_.notify_one();
+        }
+        return;
+    }
+    queuing_callers_.fetch_sub(1, std::memory_order_release);
+
+    // Records written during or after shutdown are written synchronously.
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    writeRecord(record);
+    if (auto open_file = files_.find(stream.name); open_file != files_.end()) {
+        closeFile(open_file->second);
+    }
+}
+
+/**
+ * @brief Blocks until all queued records have been written.
+ */
+void AsyncOutputWriter::flush() {
+    std::unique_lock<std::mutex> lock(worker_mutex_);
+    worker_condition_.notify_one();
+    flushed_condition_.wait(lock, [this] {
+        return pending_records_.load(std::memory_order_relaxed) == 0 ||
+               !running_.load(std::memory_order_relaxed);
+    });
+}
+
+/**
+ * @brief Writes the queued records, closes the files and stops the background writer.
+ *
+ * Records written afterwards are written synchronously.
+ */
+void AsyncOutputWriter::shutdown() { stop(); }
+
+/**
+ * @brief Returns a snapshot of the writer counters.
+ */
+OutputWriterStatistics AsyncOutputWriter::getStatistics() const {
+    OutputWriterStatistics statistics;
+    statistics.written_records = written_records_.load(std::memory_order_relaxed);
+    statistics.written_bytes = written_bytes_.load(std::memory_order_relaxed);
+    statistics.dropped_records = dropped_records_.load(std::memory_order_relaxed);
+    statistics.skipped_records = skipped_records_.load(std::memory_order_relaxed);
+    statistics.failed_records = failed_records_.load(std::memory_order_relaxed);
+    statistics.rotated_files = rotated_files_.load(std::memory_order_relaxed);
+    statistics.fsyncs = fsyncs_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void AsyncOutputWriter::start() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    running_ = true;
+    worker_ = std::thread(&AsyncOutputWriter::run, this);
+    accepting_ = true;
+}
+
+void AsyncOutputWriter::stop() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    if (!running_) {
+        return;
+    }
+    // Waits for the records being queued, later ones are written synchronously
+    accepting_ = false;
+    while (queuing_callers_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> worker_lock(worker_mutex_);
+        running_ = false;
+    }
+    worker_condition_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    // Records queued while the writer was stopping
+    drain();
+    for (auto& [stream_name, open_file] : files_) {
+        closeFile(open_file);
+    }
+    flushed_condition_.notify_all();
+}
+
+/**
+ * @brief Main loop of the background writer.
+ *
+ * Sleeps until records are queued (or the idle timeout expires to report dropped records) and
+ * writes everything that is queued in one batch.
+ */
+void AsyncOutputWriter::run() {
+    std::unique_lock<std::mutex> lock(worker_mutex_);
+    while (running_) {
+        worker_condition_.wait_for(lock, WORKER_IDLE_TIMEOUT, [this] {
+            return !running_ || pending_records_.load(std::memory_order_relaxed) > 0;
+        });
+        lock.unlock();
+        const bool wrote = drain();
+        lock.lock();
+        if (wrote) {
+            flushed_condition_.notify_all();
+        }
+    }
+    lock.unlock();
+    drain();
+}
+
+/**
+ * @brief Writes all queued records and commits them as one batch.
+ *
+ * Every file written in the batch is flushed once and, with the `BATCH` fsync policy, synced
+ * once. Archives get a flush point first, so that the batch can be decompressed from the file.
+ *
+ * @return true if anything was written.
+ */
+bool AsyncOutputWriter::drain() {
+    Record record;
+    std::uint64_t popped = 0;
+    while (queue_.tryPop(record)) {
+        writeRecord(record);
+        ++popped;
+    }
+
+    const std::uint64_t dropped = dropped_records_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_records_) {
+        LOG_WARN(dropped - reported_dropped_records_
+                 << " output records dropped because the output queue was full");
+        reported_dropped_records_ = dropped;
+    }
+
+    if (popped == 0) {
+        return false;
+    }
+    for (auto& [stream_name, open_file] : files_) {
+        if (!open_file.dirty || open_file.file == nullptr) {
+            continue;
+        }
+        if (open_file.archive != nullptr) {
+            open_file.archive->flush();
+            open_file.size = open_file.archive->getCompressedSize();
+        }
+        std::fflush(open_file.file);
+        if (settings_.fsync_policy == FsyncPolicy::BATCH) {
+            syncFile(open_file);
+        }
+        open_file.dirty = false;
+    }
+    pending_records_.fetch_sub(popped, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Appends a record to the file of its stream.
+ *
+ * @param record The record to write.
+ */
+void AsyncOutputWriter::writeRecord(const Record& record) {
+    OpenFile* open_file = getFile(record.stream);
+    if (open_file == nullptr) {
+        failed_records_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const std::size_t size = record.content.size();
+    const bool written =
+        open_file->archive != nullptr
+            ? open_file->archive->write(record.content)
+            : std::fwrite(record.content.data(), 1, size, open_file->file) == size;
+    if (!written) {
+        LOG_ERROR("Failed to write to " << open_file->path << ": " << std::strerror(errno));
+        failed_records_.fetch_add(1, std::memory_order_relaxed);
+        closeFile(*open_file);
+        return;
+    }
+    // Archives are rotated by their compressed size
+    open_file->size = open_file->archive != nullptr ? open_file->archive->getCompressedSize()
+                                                    : open_file->size + size;
+    open_file->dirty = true;
+    written_records_.fetch_add(1, std::memory_order_relaxed);
+    written_bytes_.fetch_add(size, std::memory_order_relaxed);
+
+    if (settings_.fsync_policy == FsyncPolicy::ALWAYS) {
+        if (open_file->archive != nullptr) {
+            open_file->archive->flush();
+        }
+        std::fflush(open_file->file);
+        syncFile(*open_file);
+        open_file->dirty = false;
+    }
+}
+
+/**
+ * @brief Returns the open file of a stream, opening a new file if the stream has none yet, its
+ * file is due for rotation or the stream changed its directory.
+ *
+ * @param stream The stream to get the file for.
+ * @return The open file, or nullptr if the file could not be opened.
+ */
+AsyncOutputWriter::OpenFile* AsyncOutputWriter::getFile(const OutputStream& stream) {
+    auto entry = files_.find(stream.name);
+    if (entry == files_.end()) {
+        entry = files_.emplace(stream.name, OpenFile{}).first;
+    }
+    OpenFile& open_file = entry->second;
+
+    if (open_file.file != nullptr) {
+        const bool moved = !isSameFile(open_file.stream, stream);
+        const bool full = settings_.max_file_size > 0 && open_file.size >= settings_.max_file_size;
+        const bool expired =
+            settings_.max_file_age.count() > 0 &&
+            std::chrono::steady_clock::now() - open_file.opened_at >= settings_.max_file_age;
+        if (moved || full || expired) {
+            closeFile(open_file);
+            if (!moved) {
+                rotated_files_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (open_file.file == nullptr) {
+        open_file.stream = stream;
+        if (!openFile(open_file)) {
+            return nullptr;
+        }
+    }
+    return &open_file;
+}
+
+/**
+ * @brief Opens a new file for a stream, named after the current time.
+ *
+ * The directory of the stream is created if it does not exist. If a file of the same name
+ * already exists, a counter is added to the name. The files of archived streams get a `.gz`
+ * extension and an index file next to them.
+ *
+ * @param open_file The file entry of the stream.
+ * @return true if the file was opened.
+ */
+bool AsyncOutputWriter::openFile(OpenFile& open_file) {
+    const OutputStream& stream = open_file.stream;
+    std::error_code error;
+    if (!stream.directory.empty()) {
+        std::filesystem::create_directories(stream.directory, error);
+        if (error) {
+            LOG_ERROR("Failed to create output directory " << stream.directory << ": "
+                                                           << error.message());
+            return false;
+        }
+    }
+
+    const std::string base =
+        stream.directory + stream.file_prefix +
+        Helper::getFormattedTimestampNow("%Y%m%dT%H%M%S", false, true);
+    const bool archived = settings_.getStreamSettings(stream.name).archive;
+    const std::string extension = archived ? stream.extension + ".gz" : stream.extension;
+    std::string path = base + extension;
+    for (int index = 1; std::filesystem::exists(path, error); ++index) {
+        path = base + "_" + std::to_string(index) + extension;
+    }
+
+    open_file.file = std::fopen(path.c_str(), "ab");
+    if (open_file.file == nullptr) {
+        LOG_ERROR("Failed to open output file " << path << ": " << std::strerror(errno));
+        return false;
+    }
+    if (archived) {
+        open_file.archive = std::make_unique<OutputArchiveWriter>(
+            open_file.file, path + ".idx", settings_.archive_block_interval);
+    }
+    open_file.path = std::move(path);
+    open_file.size = 0;
+    open_file.opened_at = std::chrono::steady_clock::now();
+    open_file.dirty = false;
+    LOG_INFO("Writing the " << stream.name << " output to: " << open_file.path);
+    return true;
+}
+
+/**
+ * @brief Flushes and closes the file of a stream, syncing it unless the fsync policy is `NEVER`.
+ * The open block of an archive is finished first.
+ *
+ * @param open_file The file entry of the stream.
+ */
+void AsyncOutputWriter::closeFile(OpenFile& open_file) {
+    if (open_file.file == nullptr) {
+        return;
+    }
+    if (open_file.archive != nullptr) {
+        open_file.archive->finish();
+        open_file.archive.reset();
+    }
+    std::fflush(open_file.file);
+    if (settings_.fsync_policy != FsyncPolicy::NEVER) {
+        syncFile(open_file);
+    }
+    std::fclose(open_file.file);
+    open_file.file = nullptr;
+    open_file.dirty = false;
+}
+
+/**
+ * @brief Syncs the flushed content of a file to the storage device.
+ *
+ * @param open_file The file entry of the stream.
+ */
+void AsyncOutputWriter::syncFile(OpenFile& open_file) {
+    if (::fsync(::fileno(open_file.file)) != 0) {
+        LOG_WARN("Failed to sync " << open_file.path << ": " << std::strerror(errno));
+        return;
+    }
+    fsyncs_.fetch_add(1, std::memory_order_relaxed);
+}
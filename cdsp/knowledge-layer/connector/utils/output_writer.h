@@ -0,0 +1,171 @@
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "i_output_sink.h"
+#include "lock_free_ring_buffer.h"
+#include "output_archive.h"
+
+/**
+ * @brief When the output files are synced to the storage device.
+ */
+enum class FsyncPolicy : std::uint8_t {
+    NEVER = 0,  // The files are flushed after each batch, the OS decides when to persist them.
+    BATCH,      // One fsync per file and batch of records (group commit).
+    ALWAYS      // One fsync per record.
+};
+
+/**
+ * @brief Settings of a single output stream.
+ */
+struct OutputStreamSettings {
+    bool enabled = true;
+    // Only every n-th record of the stream is written.
+    std::size_t sample_rate = 1;
+    // The records are written to a compressed archive (see OutputArchiveWriter).
+    bool archive = false;
+};
+
+/**
+ * @brief Runtime settings of the AsyncOutputWriter, usually read from the environment.
+ */
+struct OutputWriterSettings {
+    std::size_t queue_capacity = 1024;
+    FsyncPolicy fsync_policy = FsyncPolicy::NEVER;
+    // The file of a stream is rotated when it reaches this size or age, 0 disables the limit.
+    std::size_t max_file_size = 64 * 1024 * 1024;
+    std::chrono::seconds max_file_age{3600};
+    // Duration of the time blocks of archived streams.
+    std::chrono::seconds archive_block_interval{60};
+    // Streams without an entry use the default settings.
+    std::map<std::string, OutputStreamSettings, std::less<>> streams;
+
+    [[nodiscard]] const OutputStreamSettings& getStreamSettings(std::string_view stream_name) const;
+
+    static OutputWriterSettings fromEnvironment(const std::vector<std::string>& stream_names);
+    static FsyncPolicy parseFsyncPolicy(const std::string& policy);
+};
+
+/**
+ * @brief Counters of the AsyncOutputWriter.
+ */
+struct OutputWriterStatistics {
+    std::uint64_t written_records = 0;
+    std::uint64_t written_bytes = 0;
+    // Records dropped because the queue was full.
+    std::uint64_t dropped_records = 0;
+    // Records not written because their stream is disabled or sampled.
+    std::uint64_t skipped_records = 0;
+    std::uint64_t failed_records = 0;
+    std::uint64_t rotated_files = 0;
+    std::uint64_t fsyncs = 0;
+};
+
+/**
+ * @brief Output sink writing records to files on a background thread.
+ *
+ * Callers push records into a bounded lock-free queue and return immediately, records are dropped
+ * and counted when the queue is full. Records written while the writer stops are written
+ * synchronously, under a lock. The writer thread keeps the file of each stream open,
+ * appends everything that is queued in one batch and then flushes (and syncs, depending on the
+ * fsync policy) every file it touched once. Files are rotated by size and age; the directory of
+ * a stream is only created when a new file is opened.
+ *
+ * Archived streams are written gzip compressed (`<extension>.gz`) in time blocks, with a flush
+ * point at the end of every batch so that the archives can be tailed.
+ */
+class AsyncOutputWriter : public IOutputSink {
+   public:
+    explicit AsyncOutputWriter(OutputWriterSettings settings = OutputWriterSettings());
+    ~AsyncOutputWriter() override;
+
+    AsyncOutputWriter(const AsyncOutputWriter&) = delete;
+    AsyncOutputWriter& operator=(const AsyncOutputWriter&) = delete;
+
+    bool shouldWrite(const std::string& stream_name) override;
+    bool isArchived(const std::string& stream_name) override;
+    void write(const OutputStream& stream, std::string content) override;
+
+    void flush();
+    void shutdown();
+
+    [[nodiscard]] OutputWriterStatistics getStatistics() const;
+
+   private:
+    struct Record {
+        OutputStream stream;
+        std::string content;
+    };
+
+    struct OpenFile {
+        OutputStream stream;
+        std::string path;
+        std::FILE* file = nullptr;
+        // Set for archived streams, the records are compressed into the file
+        std::unique_ptr<OutputArchiveWriter> archive;
+        std::size_t size = 0;
+        std::chrono::steady_clock::time_point opened_at;
+        bool dirty = false;
+    };
+
+    static constexpr auto WORKER_IDLE_TIMEOUT = std::chrono::milliseconds(100);
+
+    const OutputWriterSettings settings_;
+    LockFreeRingBuffer<Record> queue_;
+
+    // Worker thread state
+    std::thread worker_;
+    std::mutex worker_mutex_;
+    std::condition_variable worker_condition_;
+    std::condition_variable flushed_condition_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> pending_records_{0};
+    std::mutex lifecycle_mutex_;
+    // Whether write() queues records. stop() clears it and waits until no caller is queuing, so
+    // no record is queued after the final drain
+    std::atomic<bool> accepting_{false};
+    std::atomic<std::uint32_t> queuing_callers_{0};
+
+    // Record counters of the streams, used for sampling
+    std::mutex sampling_mutex_;
+    std::map<std::string, std::uint64_t, std::less<>> stream_counters_;
+
+    // Counters
+    std::atomic<std::uint64_t> written_records_{0};
+    std::atomic<std::uint64_t> written_bytes_{0};
+    std::atomic<std::uint64_t> dropped_records_{0};
+    std::uint64_t reported_dropped_records_ = 0;
+    std::atomic<std::uint64_t> skipped_records_{0};
+    std::atomic<std::uint64_t> failed_records_{0};
+    std::atomic<std::uint64_t> rotated_files_{0};
+    std::atomic<std::uint64_t> fsyncs_{0};
+
+    // Open file of each stream, only touched by the writer thread while it runs
+    std::map<std::string, OpenFile, std::less<>> files_;
+
+    void start();
+    void stop();
+    void run();
+    bool drain();
+    void writeRecord(const Record& record);
+    OpenFile* getFile(const OutputStream& stream);
+    bool openFile(OpenFile& open_file);
+    void closeFile(OpenFile& open_file);
+    void syncFile(OpenFile& open_file);
+};
+
+#endif  // OUTPUT_WRITER_H
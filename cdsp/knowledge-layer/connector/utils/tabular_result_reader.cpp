@@ -0,0 +1,247 @@
+#include "tabular_result_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+
+/**
+ * @brief Appends a Unicode code point encoded as UTF-8.
+ */
+void appendUtf8(std::string& output, std::uint32_t code_point) {
+    if (code_point < 0x80) {
+        output.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        output.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        output.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        output.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        output.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Creates a reader for a query result and reads its header.
+ *
+ * @param buffer The query result. It must outlive the reader and the cells read from it.
+ * @param delimiter The delimiter of the cells, '\t' for TSV or ',' for CSV.
+ * @param resource The memory resource for the header and the row buffer.
+ */
+TabularResultReader::TabularResultReader(std::string_view buffer, char delimiter,
+                                         std::pmr::memory_resource* resource)
+    : buffer_(buffer),
+      delimiter_(delimiter),
+      header_(resource),
+      header_buffer_(resource),
+      row_buffer_(resource),
+      unescaped_cells_(resource) {
+    readLine(header_, header_buffer_);
+}
+
+/**
+ * @brief Retrieves the cells of the first line, e.g. the variables of a SPARQL result.
+ */
+const std::pmr::vector<std::string_view>& TabularResultReader::getHeader() const {
+    return header_;
+}
+
+/**
+ * @brief Reads the next row.
+ *
+ * @param cells Receives the cells of the row. They stay valid until the next call.
+ * @return false if there are no more rows.
+ * @throws std::runtime_error if a quoted CSV cell is not terminated.
+ */
+bool TabularResultReader::nextRow(std::pmr::vector<std::string_view>& cells) {
+    return readLine(cells, row_buffer_);
+}
+
+/**
+ * @brief Returns the lexical form of an RDF term of a TSV result.
+ *
+ * Quoted literals lose their quotes, datatype and language tag, and their escape sequences
+ * (`\t`, `\n`, `\"`, `\uXXXX`, ...) are resolved, e.g. `"a\tb"@en` becomes `a<TAB>b`. Escapes of
+ * code points that are no Unicode characters, e.g. `\U00110000` or the surrogate `\uD800`, are
+ * kept as written. Other terms, such as IRIs and numbers written without quotes, are returned as
+ * they are.
+ *
+ * @param term The term as written in the TSV result.
+ * @return The lexical form of the term.
+ */
+std::string TabularResultReader::decodeTerm(std::string_view term) {
+    if (term.size() < 2 || term.front() != '"') {
+        return std::string(term);
+    }
+
+    std::string value;
+    value.reserve(term.size());
+    for (std::size_t i = 1; i < term.size(); ++i) {
+        const char character = term[i];
+        if (character == '"') {
+            return value;
+        }
+        if (character != '\\' || i + 1 == term.size()) {
+            value.push_back(character);
+            continue;
+        }
+
+        const char escaped = term[++i];
+        switch (escaped) {
+            case 't':
+                value.push_back('\t');
+                break;
+            case 'n':
+                value.push_back('\n');
+                break;
+            case 'r':
+                value.push_back('\r');
+                break;
+            case 'b':
+                value.push_back('\b');
+                break;
+            case 'f':
+                value.push_back('\f');
+                break;
+            case 'u':
+            case 'U': {
+                const std::size_t digits = escaped == 'u' ? 4 : 8;
+                std::uint32_t code_point = 0;
+                const char* first = term.data() + i + 1;
+                const char* last = first + digits;
+                // Code points beyond Unicode and surrogates are no characters
+                if (i + digits < term.size() &&
+                    std::from_chars(first, last, code_point, 16).ptr == last &&
+                    code_point <= 0x10FFFF && (code_point < 0xD800 || code_point > 0xDFFF)) {
+                    appendUtf8(value, code_point);
+                    i += digits;
+                } else {
+                    value.push_back('\\');
+                    value.push_back(escaped);
+                }
+                break;
+            }
+            case '"':
+            case '\'':
+            case '\\':
+                value.push_back(escaped);
+                break;
+            default:
+                value.push_back('\\');
+                value.push_back(escaped);
+                break;
+        }
+    }
+    // Not terminated, so not a literal
+    return std::string(term);
+}
+
+/**
+ * @brief Splits the line at the current position into cells and moves to the next line.
+ *
+ * @param cells Receives the cells of the line.
+ * @param row_buffer Receives the unescaped CSV cells of the line.
+ * @return false if the end of the buffer was reached before.
+ */
+bool TabularResultReader::readLine(std::pmr::vector<std::string_view>& cells,
+                                   std::pmr::string& row_buffer) {
+    cells.clear();
+    if (position_ >= buffer_.size()) {
+        return false;
+    }
+    row_buffer.clear();
+    unescaped_cells_.clear();
+
+    // Line breaks and delimiters are found with memchr, line by line
+    std::size_t line_end = buffer_.find('\n', position_);
+    while (true) {
+        std::string_view cell;
+        const bool quoted =
+            delimiter_ != '\t' && position_ < buffer_.size() && buffer_[position_] == '"';
+        if (quoted) {
+            const std::size_t offset = row_buffer.size();
+            bool unescaped = false;
+            cell = readQuotedCell(row_buffer, unescaped);
+            if (unescaped) {
+                unescaped_cells_.push_back({cells.size(), offset, row_buffer.size() - offset});
+            }
+            // The quoted cell may contain line breaks
+            if (line_end != std::string_view::npos && line_end < position_) {
+                line_end = buffer_.find('\n', position_);
+            }
+        }
+
+        // Anything between a closing quote and the separator is ignored
+        const std::size_t line_size =
+            (line_end == std::string_view::npos ? buffer_.size() : line_end) - position_;
+        const std::size_t delimiter_pos =
+            buffer_.substr(position_, line_size).find(delimiter_);
+        const bool is_last_cell = delimiter_pos == std::string_view::npos;
+        const std::size_t cell_size = is_last_cell ? line_size : delimiter_pos;
+        if (!quoted) {
+            cell = buffer_.substr(position_, cell_size);
+            if (is_last_cell && !cell.empty() && cell.back() == '\r') {
+                cell.remove_suffix(1);
+            }
+        }
+        cells.push_back(cell);
+
+        position_ += cell_size + 1;
+        if (is_last_cell) {
+            position_ = std::min(position_, buffer_.size());
+            break;
+        }
+    }
+
+    const std::string_view unescaped_cells(row_buffer);
+    for (const auto& unescaped_cell : unescaped_cells_) {
+        cells[unescaped_cell.index] =
+            unescaped_cells.substr(unescaped_cell.offset, unescaped_cell.length);
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a quoted CSV cell starting at the current position and moves behind its closing
+ * quote.
+ *
+ * @param row_buffer Receives the cell if it contains doubled quotes.
+ * @param unescaped Set to true if the cell was written to the row buffer.
+ * @return The cell without quotes if it was not unescaped.
+ * @throws std::runtime_error if the closing quote is missing.
+ */
+std::string_view TabularResultReader::readQuotedCell(std::pmr::string& row_buffer,
+                                                     bool& unescaped) {
+    const std::size_t start = position_ + 1;
+    std::size_t segment_start = start;
+    while (true) {
+        const std::size_t quote = buffer_.find('"', segment_start);
+        if (quote == std::string_view::npos) {
+            throw std::runtime_error("Unterminated quoted cell in the query result");
+        }
+        if (quote + 1 < buffer_.size() && buffer_[quote + 1] == '"') {
+            // Doubled quote, keep one
+            unescaped = true;
+            row_buffer.append(buffer_.substr(segment_start, quote + 1 - segment_start));
+            segment_start = quote + 2;
+            continue;
+        }
+
+        position_ = quote + 1;
+        if (unescaped) {
+            row_buffer.append(buffer_.substr(segment_start, quote - segment_start));
+            return {};
+        }
+        return buffer_.substr(start, quote - start);
+    }
+}
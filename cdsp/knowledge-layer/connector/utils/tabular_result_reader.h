@@ -0,0 +1,57 @@
+#ifndef TABULAR_RESULT_READER_H
+#define TABULAR_RESULT_READER_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Reads query results in a table format (`text/tab-separated-values` or `text/csv`) row by
+ * row, without copying the cells.
+ *
+ * The buffer is tokenized once: the cells of a row are `std::string_view`s into the buffer, so the
+ * buffer must outlive the reader and the cells. The header, i.e. the first line, is read when the
+ * reader is created.
+ *
+ * - TSV (SPARQL 1.1 TSV as written by RDFox): the cells are RDF terms. Tabs and line breaks inside
+ *   literals are escaped (`\t`, `\n`), so rows and cells are split at raw tabs and line breaks,
+ *   and the cells are returned as written, e.g. `"a\tb"@en` or `<http://example.org/a>`.
+ *   `decodeTerm` returns the lexical form of a literal.
+ * - CSV (RFC 4180): quoted cells may contain delimiters, line breaks and doubled quotes. The
+ *   quotes are removed. Only cells with doubled quotes are unescaped into a buffer of the row.
+ *
+ * A trailing carriage return of a line (CRLF line endings) is not part of the last cell.
+ */
+class TabularResultReader {
+   public:
+    TabularResultReader(std::string_view buffer, char delimiter,
+                        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    [[nodiscard]] const std::pmr::vector<std::string_view>& getHeader() const;
+    bool nextRow(std::pmr::vector<std::string_view>& cells);
+
+    static std::string decodeTerm(std::string_view term);
+
+   private:
+    // A CSV cell unescaped into the row buffer, resolved once the row is complete
+    struct UnescapedCell {
+        std::size_t index;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    const std::string_view buffer_;
+    const char delimiter_;
+    std::size_t position_ = 0;
+    std::pmr::vector<std::string_view> header_;
+    std::pmr::string header_buffer_;
+    std::pmr::string row_buffer_;
+    std::pmr::vector<UnescapedCell> unescaped_cells_;
+
+    bool readLine(std::pmr::vector<std::string_view>& cells, std::pmr::string& row_buffer);
+    std::string_view readQuotedCell(std::pmr::string& row_buffer, bool& unescaped);
+};
+
+#endif  // TABULAR_RESULT_READER_H
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lock_free_ring_buffer.h"
+#include "logger.h"
+
+class LoggerUnitTest : public ::testing::Test {
+   protected:
+    std::filesystem::path log_file_ =
+        std::filesystem::path(TEST_OUTPUT_DIR) / "logger_unit_test.log";
+
+    void SetUp() override { removeLogFiles(); }
+
+    void TearDown() override {
+        Logger::getInstance().configure(LoggerSettings{});
+        removeLogFiles();
+    }
+
+    void removeLogFiles() {
+        std::filesystem::remove(log_file_);
+        for (int index = 1; index <= 3; ++index) {
+            std::filesystem::remove(log_file_.string() + "." + std::to_string(index));
+        }
+    }
+
+    static std::string readFile(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+};
+
+// Test that the ring buffer keeps FIFO order, rejects pushes when full and accepts concurrent
+// producers
+TEST_F(LoggerUnitTest, RingBufferIsBoundedAndOrdered) {
+    LockFreeRingBuffer<int> buffer(3);
+    EXPECT_EQ(buffer.capacity(), 4u);
+    for (int value = 0; value < 4; ++value) {
+        EXPECT_TRUE(buffer.tryPush(int{value}));
+    }
+    EXPECT_FALSE(buffer.tryPush(4));
+
+    int value = -1;
+    for (int expected = 0; expected < 4; ++expected) {
+        ASSERT_TRUE(buffer.tryPop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(buffer.tryPop(value));
+
+    LockFreeRingBuffer<int> shared(1024);
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < 4; ++producer) {
+        producers.emplace_back([&shared] {
+            for (int i = 0; i < 200; ++i) {
+                EXPECT_TRUE(shared.tryPush(1));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    int sum = 0;
+    while (shared.tryPop(value)) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 800);
+}
+
+// Test that messages below the runtime level are filtered and the others are written with level
+TEST_F(LoggerUnitTest, WritesEnabledLevelsToFile) {
+    LoggerSettings settings;
+    settings.level = LogLevel::INFO;
+    settings.file_path = log_file_.string();
+    Logger::getInstance().configure(settings);
+
+    LOG_DEBUG("hidden " << 1);
+    LOG_INFO("visible " << 2);
+    LOG_ERROR("failure " << 3);
+    Logger::getInstance().flush();
+
+    const std::string content = readFile(log_file_);
+    EXPECT_EQ(content.find("hidden"), std::string::npos);
+    EXPECT_NE(content.find("[INFO] visible 2\n"), std::string::npos);
+    EXPECT_NE(content.find("[ERROR] failure 3\n"), std::string::npos);
+}
+
+// Test that payloads are sampled, rate limited and truncated
+TEST_F(LoggerUnitTest, LimitsPayloads) {
+    LoggerSettings settings;
+    settings.file_path = log_file_.string();
+    settings.payload_sample_rate = 2;
+    settings.payload_max_per_second = 0;
+    settings.payload_max_bytes = 4;
+    Logger::getInstance().configure(settings);
+
+    const std::uint64_t suppressed_before = Logger::getInstance().getSuppressedPayloads();
+    for (int i = 0; i < 4; ++i) {
+        LOG_PAYLOAD(LogLevel::INFO, "Payload", "abcdefgh");
+    }
+    Logger::getInstance().flush();
+
+    EXPECT_EQ(Logger::getInstance().getSuppressedPayloads() - suppressed_before, 2u);
+    const std::string content = readFile(log_file_);
+    EXPECT_NE(content.find("Payload: abcd... (truncated, 8 bytes)"), std::string::npos);
+    EXPECT_EQ(content.find("abcde"), std::string::npos);
+}
+
+// Test that the log file is rotated once it exceeds the maximum size
+TEST_F(LoggerUnitTest, RotatesLogFile) {
+    LoggerSettings settings;
+    settings.file_path = log_file_.string();
+    settings.max_file_size = 256;
+    settings.max_files = 2;
+    Logger::getInstance().configure(settings);
+
+    for (int i = 0; i < 20; ++i) {
+        LOG_INFO("Rotating log line number " << i);
+    }
+    Logger::getInstance().flush();
+
+    EXPECT_TRUE(std::filesystem::exists(log_file_.string() + ".1"));
+    EXPECT_TRUE(std::filesystem::exists(log_file_.string() + ".2"));
+    EXPECT_FALSE(std::filesystem::exists(log_file_.string() + ".3"));
+    EXPECT_NE(readFile(log_file_.string() + ".1").find("[INFO] Rotating"), std::string::npos);
+}
+
+// Test that no message is lost when it is logged while the logger shuts down
+TEST_F(LoggerUnitTest, KeepsMessagesLoggedDuringShutdown) {
+    constexpr int THREADS = 4;
+    constexpr int MESSAGES = 200;
+    LoggerSettings settings;
+    settings.file_path = log_file_.string();
+    Logger::getInstance().configure(settings);
+
+    std::atomic<int> started{0};
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < THREADS; ++thread) {
+        threads.emplace_back([&started]() {
+            started++;
+            for (int message = 0; message < MESSAGES; ++message) {
+                LOG_INFO("Concurrent message");
+            }
+        });
+    }
+    while (started < THREADS) {
+        std::this_thread::yield();
+    }
+    Logger::getInstance().shutdown();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::string content = readFile(log_file_);
+    std::size_t messages = 0;
+    for (std::size_t position = content.find("[INFO] Concurrent message");
+         position != std::string::npos;
+         position = content.find("[INFO] Concurrent message", position + 1)) {
+        messages++;
+    }
+    EXPECT_EQ(messages, static_cast<std::size_t>(THREADS * MESSAGES));
+}
+
+// Test that level names are parsed case-insensitively and unknown names are rejected
+TEST_F(LoggerUnitTest, ParseLevel) {
+    EXPECT_EQ(Logger::parseLevel("DEBUG"), LogLevel::DEBUG);
+    EXPECT_EQ(Logger::parseLevel("warning"), LogLevel::WARN);
+    EXPECT_EQ(Logger::parseLevel("off"), LogLevel::OFF);
+    EXPECT_THROW(Logger::parseLevel("verbose"), std::invalid_argument);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "message_arena_pool.h"
+
+// Test that a released arena is reused by the next message
+TEST(MessageArenaPoolUnitTest, ReuseReleasedArena) {
+    auto pool = std::make_shared<MessageArenaPool>(1024);
+
+    std::pmr::memory_resource* first_resource = nullptr;
+    {
+        auto arena = pool->acquire();
+        first_resource = arena.resource();
+        std::pmr::string text("a string long enough to not fit the small string buffer",
+                              arena.resource());
+        EXPECT_GT(arena.bytesAllocated(), 0U);
+    }
+    EXPECT_EQ(pool->getStatistics().pooled, 1U);
+
+    auto arena = pool->acquire();
+    EXPECT_EQ(arena.resource(), first_resource);
+    EXPECT_EQ(arena.bytesAllocated(), 0U);
+
+    const auto statistics = pool->getStatistics();
+    EXPECT_EQ(statistics.acquired, 2U);
+    EXPECT_EQ(statistics.pooled, 0U);
+    EXPECT_EQ(statistics.overflowed, 0U);
+}
+
+// Test that the statistics keep the largest amount of memory used by a single message
+TEST(MessageArenaPoolUnitTest, TrackHighWaterMark) {
+    auto pool = std::make_shared<MessageArenaPool>(4096);
+
+    for (std::size_t size : {256U, 1024U, 128U}) {
+        auto arena = pool->acquire();
+        std::pmr::vector<char> buffer(size, 'x', arena.resource());
+    }
+
+    const auto statistics = pool->getStatistics();
+    EXPECT_EQ(statistics.acquired, 3U);
+    EXPECT_GE(statistics.high_water_bytes, 1024U);
+    EXPECT_LT(statistics.high_water_bytes, 2048U);
+    EXPECT_GE(statistics.last_bytes, 128U);
+    EXPECT_LT(statistics.last_bytes, 256U);
+    EXPECT_EQ(statistics.block_size, 4096U);
+}
+
+// Test that messages larger than the block overflow to the heap and make the blocks grow
+TEST(MessageArenaPoolUnitTest, GrowBlocksAfterOverflow) {
+    auto pool = std::make_shared<MessageArenaPool>(1024, 8192);
+
+    {
+        auto arena = pool->acquire();
+        std::pmr::vector<char> buffer(3000, 'x', arena.resource());
+    }
+
+    auto statistics = pool->getStatistics();
+    EXPECT_EQ(statistics.overflowed, 1U);
+    EXPECT_EQ(statistics.block_size, 4096U);
+    // The arena with the old block size is not kept
+    EXPECT_EQ(statistics.pooled, 0U);
+
+    {
+        auto arena = pool->acquire();
+        std::pmr::vector<char> buffer(3000, 'x', arena.resource());
+    }
+
+    statistics = pool->getStatistics();
+    EXPECT_EQ(statistics.overflowed, 1U);
+    EXPECT_EQ(statistics.pooled, 1U);
+
+    // The blocks do not grow beyond the maximum size
+    {
+        auto arena = pool->acquire();
+        std::pmr::vector<char> buffer(100000, 'x', arena.resource());
+    }
+    EXPECT_EQ(pool->getStatistics().block_size, 8192U);
+}
+
+// Test that no more than the configured number of idle arenas are kept
+TEST(MessageArenaPoolUnitTest, LimitPooledArenas) {
+    auto pool = std::make_shared<MessageArenaPool>(1024, 1024, 2);
+
+    {
+        std::vector<MessageArenaPool::Arena> arenas;
+        for (int i = 0; i < 4; ++i) {
+            arenas.push_back(pool->acquire());
+        }
+    }
+
+    EXPECT_EQ(pool->getStatistics().pooled, 2U);
+}
+
+// Test that an arena can outlive its pool
+TEST(MessageArenaPoolUnitTest, ArenaOutlivesPool) {
+    auto pool = std::make_shared<MessageArenaPool>(1024);
+    auto arena = pool->acquire();
+    pool.reset();
+
+    std::pmr::string text("a string long enough to not fit the small string buffer",
+                          arena.resource());
+    EXPECT_EQ(text, "a string long enough to not fit the small string buffer");
+}
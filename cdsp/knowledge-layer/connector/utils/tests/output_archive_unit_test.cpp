@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "output_archive.h"
+
+class OutputArchiveUnitTest : public ::testing::Test {
+   protected:
+    const std::string output_directory_ =
+        (std::filesystem::path(TEST_OUTPUT_DIR) / "output_archive_unit_test").string() + "/";
+    const std::string archive_path_ = output_directory_ + "archive.nt.gz";
+    const std::chrono::system_clock::time_point start_ =
+        std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+
+    void SetUp() override {
+        std::filesystem::remove_all(output_directory_);
+        std::filesystem::create_directories(output_directory_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(output_directory_); }
+
+    // Writes one record at each of the given seconds after the start, with 60 second blocks
+    void writeArchive(const std::vector<int>& seconds) const {
+        std::FILE* file = std::fopen(archive_path_.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        {
+            OutputArchiveWriter writer(file, archive_path_ + ".idx", std::chrono::seconds(60));
+            for (int second : seconds) {
+                ASSERT_TRUE(writer.write("record " + std::to_string(second) + "\n",
+                                         start_ + std::chrono::seconds(second)));
+            }
+            ASSERT_TRUE(writer.finish());
+        }
+        std::fclose(file);
+    }
+
+    std::string read(const OutputArchiveReader& reader, int from, int to) const {
+        std::ostringstream output;
+        reader.read(start_ + std::chrono::seconds(from), start_ + std::chrono::seconds(to),
+                    output);
+        return output.str();
+    }
+};
+
+// Test that the records are split into time blocks that can be read by time range
+TEST_F(OutputArchiveUnitTest, ReadsBlocksOfTimeRange) {
+    writeArchive({0, 30, 61, 125});
+
+    const OutputArchiveReader reader(archive_path_);
+    ASSERT_EQ(reader.getBlocks().size(), 3u);
+    EXPECT_EQ(reader.getBlocks()[0].start, start_);
+    EXPECT_EQ(reader.getBlocks()[0].offset, 0u);
+    EXPECT_EQ(reader.getBlocks()[1].start, start_ + std::chrono::seconds(61));
+    EXPECT_EQ(reader.getBlocks()[2].start, start_ + std::chrono::seconds(125));
+
+    EXPECT_EQ(read(reader, 70, 100), "record 61\n");
+    EXPECT_EQ(read(reader, 10, 62), "record 0\nrecord 30\nrecord 61\n");
+    EXPECT_EQ(read(reader, 200, 300), "record 125\n");
+    EXPECT_EQ(read(reader, -100, -1), "");
+
+    std::ostringstream output;
+    EXPECT_EQ(reader.read(std::nullopt, std::nullopt, output), 3u);
+    EXPECT_EQ(output.str(), "record 0\nrecord 30\nrecord 61\nrecord 125\n");
+}
+
+// Test that the blocks are found by scanning the archive if there is no index
+TEST_F(OutputArchiveUnitTest, ScansArchiveWithoutIndex) {
+    writeArchive({0, 30, 61, 125});
+    std::filesystem::remove(archive_path_ + ".idx");
+
+    const OutputArchiveReader reader(archive_path_);
+    ASSERT_EQ(reader.getBlocks().size(), 3u);
+    EXPECT_EQ(reader.getBlocks()[1].start, start_ + std::chrono::seconds(61));
+    EXPECT_GT(reader.getBlocks()[1].offset, 0u);
+    EXPECT_EQ(read(reader, 70, 100), "record 61\n");
+}
+
+// Test that the archive is a regular multi-member gzip file
+TEST_F(OutputArchiveUnitTest, WritesGzipFile) {
+    writeArchive({0, 61});
+
+    gzFile file = gzopen(archive_path_.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    char buffer[256] = {};
+    const int size = gzread(file, buffer, sizeof(buffer));
+    gzclose(file);
+    EXPECT_EQ(std::string(buffer, size), "record 0\nrecord 61\n");
+}
+
+// Test that the open block of an archive can be read up to its last flush point
+TEST_F(OutputArchiveUnitTest, ReadsFlushedRecordsOfOpenBlock) {
+    std::FILE* file = std::fopen(archive_path_.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    OutputArchiveWriter writer(file, archive_path_ + ".idx", std::chrono::seconds(60));
+    ASSERT_TRUE(writer.write("flushed\n", start_));
+    ASSERT_TRUE(writer.flush());
+    std::fflush(file);
+
+    std::ostringstream output;
+    OutputArchiveReader(archive_path_).read(std::nullopt, std::nullopt, output);
+    EXPECT_EQ(output.str(), "flushed\n");
+    EXPECT_EQ(writer.getCompressedSize(), std::filesystem::file_size(archive_path_));
+
+    writer.finish();
+    std::fclose(file);
+}
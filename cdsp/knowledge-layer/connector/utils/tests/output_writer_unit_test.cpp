@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "output_archive.h"
+#include "output_writer.h"
+
+class OutputWriterUnitTest : public ::testing::Test {
+   protected:
+    const std::string output_directory_ =
+        (std::filesystem::path(TEST_OUTPUT_DIR) / "output_writer_unit_test").string() + "/";
+    const OutputStream stream_{"test", output_directory_, "gen_test_", ".txt"};
+
+    void SetUp() override { std::filesystem::remove_all(output_directory_); }
+
+    void TearDown() override { std::filesystem::remove_all(output_directory_); }
+
+    std::vector<std::string> readFiles() const {
+        std::vector<std::filesystem::path> paths;
+        for (const auto& entry : std::filesystem::directory_iterator(output_directory_)) {
+            paths.push_back(entry.path());
+        }
+        // Files are named gen_test_<time>[_<counter>].txt, the counter orders files of one second
+        const auto order = [](const std::filesystem::path& path) {
+            const std::string stem = path.stem().string();
+            const std::size_t counter = stem.find('_', std::string("gen_test_").size());
+            if (counter == std::string::npos) {
+                return std::make_pair(stem, 0);
+            }
+            return std::make_pair(stem.substr(0, counter), std::stoi(stem.substr(counter + 1)));
+        };
+        std::sort(paths.begin(), paths.end(), [&order](const auto& path, const auto& other) {
+            return order(path) < order(other);
+        });
+
+        std::vector<std::string> contents;
+        for (const auto& path : paths) {
+            std::ifstream file(path);
+            std::stringstream content;
+            content << file.rdbuf();
+            contents.push_back(content.str());
+        }
+        return contents;
+    }
+};
+
+// Test that the records of a stream are appended to one file that is kept open
+TEST_F(OutputWriterUnitTest, AppendsRecordsToOpenFile) {
+    AsyncOutputWriter writer;
+    writer.write(stream_, "first\n");
+    writer.write(stream_, "second\n");
+    writer.write(stream_, "third\n");
+    writer.flush();
+
+    const auto files = readFiles();
+    ASSERT_EQ(files.size(), 1u);
+    EXPECT_EQ(files[0], "first\nsecond\nthird\n");
+
+    const auto statistics = writer.getStatistics();
+    EXPECT_EQ(statistics.written_records, 3u);
+    EXPECT_EQ(statistics.written_bytes, 19u);
+    EXPECT_EQ(statistics.dropped_records, 0u);
+    EXPECT_EQ(statistics.rotated_files, 0u);
+}
+
+// Test that a new file is started when the current one reaches the maximum size
+TEST_F(OutputWriterUnitTest, RotatesFilesBySize) {
+    OutputWriterSettings settings;
+    settings.max_file_size = 10;
+    AsyncOutputWriter writer(settings);
+    writer.write(stream_, "0123456789");
+    writer.write(stream_, "abcde");
+    writer.write(stream_, "fghij");
+    writer.write(stream_, "last");
+    writer.flush();
+
+    EXPECT_EQ(readFiles(), (std::vector<std::string>{"0123456789", "abcdefghij", "last"}));
+    EXPECT_EQ(writer.getStatistics().rotated_files, 2u);
+}
+
+// Test that records of disabled streams are skipped and sampled streams write every n-th record
+TEST_F(OutputWriterUnitTest, SkipsDisabledAndSampledStreams) {
+    OutputWriterSettings settings;
+    settings.streams["disabled"] = OutputStreamSettings{false, 1};
+    settings.streams["sampled"] = OutputStreamSettings{true, 3};
+    AsyncOutputWriter writer(settings);
+
+    EXPECT_FALSE(writer.shouldWrite("disabled"));
+    EXPECT_TRUE(writer.shouldWrite("not_configured"));
+
+    int written = 0;
+    for (int i = 0; i < 6; ++i) {
+        written += writer.shouldWrite("sampled") ? 1 : 0;
+    }
+    EXPECT_EQ(written, 2);
+    EXPECT_EQ(writer.getStatistics().skipped_records, 5u);
+}
+
+// Test that the fsync policy syncs once per record or once per file and batch
+TEST_F(OutputWriterUnitTest, SyncsFilesByPolicy) {
+    OutputWriterSettings settings;
+    settings.fsync_policy = FsyncPolicy::ALWAYS;
+    {
+        AsyncOutputWriter writer(settings);
+        for (int i = 0; i < 3; ++i) {
+            writer.write(stream_, "record\n");
+        }
+        writer.flush();
+        EXPECT_EQ(writer.getStatistics().fsyncs, 3u);
+    }
+
+    settings.fsync_policy = FsyncPolicy::BATCH;
+    {
+        AsyncOutputWriter writer(settings);
+        for (int i = 0; i < 3; ++i) {
+            writer.write(stream_, "record\n");
+        }
+        writer.flush();
+        const auto statistics = writer.getStatistics();
+        EXPECT_GE(statistics.fsyncs, 1u);
+        EXPECT_LE(statistics.fsyncs, 3u);
+    }
+
+    settings.fsync_policy = FsyncPolicy::NEVER;
+    AsyncOutputWriter writer(settings);
+    writer.write(stream_, "record\n");
+    writer.shutdown();
+    EXPECT_EQ(writer.getStatistics().fsyncs, 0u);
+}
+
+// Test that archived streams are compressed and can be read while the file is still open
+TEST_F(OutputWriterUnitTest, WritesArchivedStreams) {
+    OutputWriterSettings settings;
+    settings.streams["test"] = OutputStreamSettings{true, 1, true};
+    AsyncOutputWriter writer(settings);
+    EXPECT_TRUE(writer.isArchived("test"));
+    EXPECT_FALSE(writer.isArchived("not_configured"));
+
+    writer.write(stream_, "first\n");
+    writer.write(stream_, "second\n");
+    writer.flush();
+
+    std::string archive_path;
+    for (const auto& entry : std::filesystem::directory_iterator(output_directory_)) {
+        if (entry.path().extension() == ".gz") {
+            archive_path = entry.path().string();
+        }
+    }
+    ASSERT_NE(archive_path.find(".txt.gz"), std::string::npos);
+    EXPECT_TRUE(std::filesystem::exists(archive_path + ".idx"));
+
+    std::ostringstream output;
+    OutputArchiveReader(archive_path).read(std::nullopt, std::nullopt, output);
+    EXPECT_EQ(output.str(), "first\nsecond\n");
+    EXPECT_EQ(writer.getStatistics().written_bytes, 13u);
+    writer.shutdown();
+}
+
+// Test that records written after the shutdown are written synchronously
+TEST_F(OutputWriterUnitTest, WritesSynchronouslyAfterShutdown) {
+    AsyncOutputWriter writer;
+    writer.write(stream_, "queued\n");
+    writer.shutdown();
+    writer.write(stream_, "direct\n");
+
+    std::string content;
+    for (const auto& file : readFiles()) {
+        content += file;
+    }
+    EXPECT_EQ(content, "queued\ndirect\n");
+}
+
+// Test that no record is lost when it is written while the writer shuts down
+TEST_F(OutputWriterUnitTest, KeepsRecordsWrittenDuringShutdown) {
+    constexpr int THREADS = 4;
+    constexpr int RECORDS = 500;
+    OutputWriterSettings settings;
+    settings.queue_capacity = THREADS * RECORDS;
+    AsyncOutputWriter writer(settings);
+
+    std::atomic<int> started{0};
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < THREADS; ++thread) {
+        threads.emplace_back([this, &writer, &started]() {
+            started++;
+            for (int record = 0; record < RECORDS; ++record) {
+                writer.write(stream_, "record\n");
+            }
+        });
+    }
+    while (started < THREADS) {
+        std::this_thread::yield();
+    }
+    writer.shutdown();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::size_t lines = 0;
+    for (const auto& file : readFiles()) {
+        lines += std::count(file.begin(), file.end(), '\n');
+    }
+    EXPECT_EQ(lines, static_cast<std::size_t>(THREADS * RECORDS));
+    EXPECT_EQ(writer.getStatistics().dropped_records, 0u);
+}
+
+// Test that the settings are read from the OUTPUT_* environment variables
+TEST_F(OutputWriterUnitTest, ReadsSettingsFromEnvironment) {
+    setenv("OUTPUT_FSYNC", "Batch", 1);
+    setenv("OUTPUT_FILE_MAX_AGE", "60", 1);
+    setenv("OUTPUT_TRIPLES_ENABLED", "false", 1);
+    setenv("OUTPUT_REASONING_SAMPLE_RATE", "10", 1);
+    setenv("OUTPUT_TRIPLES_ARCHIVE", "true", 1);
+    setenv("OUTPUT_ARCHIVE_BLOCK_SECONDS", "300", 1);
+
+    const auto settings = OutputWriterSettings::fromEnvironment({"triples", "reasoning"});
+    EXPECT_EQ(settings.fsync_policy, FsyncPolicy::BATCH);
+    EXPECT_EQ(settings.max_file_age, std::chrono::seconds(60));
+    EXPECT_FALSE(settings.getStreamSettings("triples").enabled);
+    EXPECT_TRUE(settings.getStreamSettings("reasoning").enabled);
+    EXPECT_EQ(settings.getStreamSettings("reasoning").sample_rate, 10u);
+    EXPECT_TRUE(settings.getStreamSettings("triples").archive);
+    EXPECT_FALSE(settings.getStreamSettings("reasoning").archive);
+    EXPECT_EQ(settings.archive_block_interval, std::chrono::seconds(300));
+
+    setenv("OUTPUT_FSYNC", "sometimes", 1);
+    EXPECT_THROW(OutputWriterSettings::fromEnvironment({}), std::invalid_argument);
+
+    unsetenv("OUTPUT_FSYNC");
+    unsetenv("OUTPUT_FILE_MAX_AGE");
+    unsetenv("OUTPUT_TRIPLES_ENABLED");
+    unsetenv("OUTPUT_REASONING_SAMPLE_RATE");
+    unsetenv("OUTPUT_TRIPLES_ARCHIVE");
+    unsetenv("OUTPUT_ARCHIVE_BLOCK_SECONDS");
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tabular_result_reader.h"
+
+namespace {
+std::vector<std::string> toStrings(const std::pmr::vector<std::string_view>& cells) {
+    return std::vector<std::string>(cells.begin(), cells.end());
+}
+}  // namespace
+
+// Test that TSV rows are split at tabs and line breaks only, the cells pointing into the buffer
+TEST(TabularResultReaderUnitTest, ReadTsvCellsInPlace) {
+    const std::string tsv =
+        "?s\t?label\r\n<http://example.org/a>\t\"a b\\tc\"@en\r\n<http://example.org/b>\n";
+    TabularResultReader reader(tsv, '\t');
+    EXPECT_EQ(toStrings(reader.getHeader()), (std::vector<std::string>{"?s", "?label"}));
+
+    std::pmr::vector<std::string_view> cells;
+    ASSERT_TRUE(reader.nextRow(cells));
+    EXPECT_EQ(toStrings(cells),
+              (std::vector<std::string>{"<http://example.org/a>", "\"a b\\tc\"@en"}));
+    EXPECT_GE(cells[0].data(), tsv.data());
+    EXPECT_LT(cells[0].data(), tsv.data() + tsv.size());
+
+    ASSERT_TRUE(reader.nextRow(cells));
+    EXPECT_EQ(toStrings(cells), (std::vector<std::string>{"<http://example.org/b>"}));
+    EXPECT_FALSE(reader.nextRow(cells));
+}
+
+// Test that quoted CSV cells may contain delimiters, line breaks and doubled quotes
+TEST(TabularResultReaderUnitTest, ReadQuotedCsvCells) {
+    const std::string csv = "id,text,empty\r\n1,\"a, \"\"b\"\"\nc\",\r\n\"2\",plain,\"\"";
+    TabularResultReader reader(csv, ',');
+    EXPECT_EQ(toStrings(reader.getHeader()), (std::vector<std::string>{"id", "text", "empty"}));
+
+    std::pmr::vector<std::string_view> cells;
+    ASSERT_TRUE(reader.nextRow(cells));
+    EXPECT_EQ(toStrings(cells), (std::vector<std::string>{"1", "a, \"b\"\nc", ""}));
+    ASSERT_TRUE(reader.nextRow(cells));
+    EXPECT_EQ(toStrings(cells), (std::vector<std::string>{"2", "plain", ""}));
+    EXPECT_FALSE(reader.nextRow(cells));
+
+    TabularResultReader unterminated("id\n\"1", ',');
+    EXPECT_THROW(unterminated.nextRow(cells), std::runtime_error);
+}
+
+// Test that literals of TSV results are decoded to their lexical form
+TEST(TabularResultReaderUnitTest, DecodeTsvTerms) {
+    EXPECT_EQ(TabularResultReader::decodeTerm("\"a\\tb\\n\\\"c\\\"\"@en"), "a\tb\n\"c\"");
+    EXPECT_EQ(TabularResultReader::decodeTerm(
+                  "\"42\"^^<http://www.w3.org/2001/XMLSchema#string>"),
+              "42");
+    EXPECT_EQ(TabularResultReader::decodeTerm("\"\\u00E9\\U0001F697\""), "é\U0001F697");
+    EXPECT_EQ(TabularResultReader::decodeTerm("<http://example.org/a>"), "<http://example.org/a>");
+    EXPECT_EQ(TabularResultReader::decodeTerm("4.2E0"), "4.2E0");
+    EXPECT_EQ(TabularResultReader::decodeTerm(""), "");
+
+    // Escapes of code points that are no Unicode characters are kept as written
+    EXPECT_EQ(TabularResultReader::decodeTerm("\"\\U00110000\""), "\\U00110000");
+    EXPECT_EQ(TabularResultReader::decodeTerm("\"\\uD800\\uDFFF\""), "\\uD800\\uDFFF");
+    EXPECT_EQ(TabularResultReader::decodeTerm("\"\\U0010FFFF\""), "\U0010FFFF");
+}
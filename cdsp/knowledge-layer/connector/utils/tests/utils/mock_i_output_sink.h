@@ -0,0 +1,14 @@
+#ifndef MOCK_I_OUTPUT_SINK_H
+#define MOCK_I_OUTPUT_SINK_H
+
+#include <gmock/gmock.h>
+
+#include "i_output_sink.h"
+
+class MockIOutputSink : public IOutputSink {
+   public:
+    MOCK_METHOD(bool, shouldWrite, (const std::string& stream_name), (override));
+    MOCK_METHOD(bool, isArchived, (const std::string& stream_name), (override));
+    MOCK_METHOD(void, write, (const OutputStream& stream, std::string content), (override));
+};
+#endif  // MOCK_I_OUTPUT_SINK_H
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "helper.h"
+#include "output_archive.h"
+
+void displayHelp() {
+    std::cout << "Usage: output_archive_reader <archive> [options]\n\n"
+              << "Decompresses the time blocks of an output archive (*.gz) of the reasoner "
+                 "client.\n\n"
+              << "The following options are available:\n"
+              << "  --from <time>    : first time to read (inclusive).\n"
+              << "  --to <time>      : end of the time range (exclusive).\n"
+              << "  --list           : list the time blocks instead of reading them.\n"
+              << "  --no-index       : scan the archive instead of reading its index file.\n\n"
+              << "Times are seconds since the epoch or UTC times like 2025-01-31T12:00:00.\n"
+              << "Whole blocks are read, so records up to one block before and after the range "
+                 "can be included.\n";
+}
+
+/**
+ * @brief Parses a time given as seconds since the epoch or as an ISO 8601 UTC time.
+ *
+ * @param value The time to parse.
+ * @return The parsed time point.
+ * @throws std::invalid_argument if the time cannot be parsed.
+ */
+std::chrono::system_clock::time_point parseTime(const std::string& value) {
+    if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) {
+        return std::chrono::system_clock::time_point(std::chrono::seconds(std::stoll(value)));
+    }
+    auto [time, milliseconds] = Helper::parseISO8601ToTime(value);
+    if (!time.has_value()) {
+        throw std::invalid_argument("Invalid time: '" + value + "'");
+    }
+    return std::chrono::system_clock::from_time_t(timegm(&time.value()));
+}
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    std::optional<std::chrono::system_clock::time_point> from;
+    std::optional<std::chrono::system_clock::time_point> to;
+    bool list = false;
+    bool use_index = true;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help") {
+                displayHelp();
+                return EXIT_SUCCESS;
+            } else if ((arg == "--from" || arg == "--to") && i + 1 < argc) {
+                (arg == "--from" ? from : to) = parseTime(argv[++i]);
+            } else if (arg == "--list") {
+                list = true;
+            } else if (arg == "--no-index") {
+                use_index = false;
+            } else if (path.empty() && arg.rfind("--", 0) != 0) {
+                path = arg;
+            } else {
+                std::cerr << "Unknown argument: " << arg << "\n";
+                std::cerr << "Use --help for usage information.\n";
+                return EXIT_FAILURE;
+            }
+        }
+        if (path.empty()) {
+            displayHelp();
+            return EXIT_FAILURE;
+        }
+
+        const OutputArchiveReader reader(path, use_index);
+        if (list) {
+            for (const auto& block : reader.getBlocks()) {
+                std::cout << Helper::getFormattedTimestampCustom("%Y-%m-%dT%H:%M:%S", block.start)
+                          << " offset " << block.offset << "\n";
+            }
+            return EXIT_SUCCESS;
+        }
+        reader.read(from, to, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tabular_result_reader.h"
+
+void displayHelp() {
+    std::cout << "Usage: tabular_result_benchmark [rows] [columns] [iterations]\n\n"
+              << "Compares the TabularResultReader with the stream based splitting it replaced, "
+                 "on a generated TSV query result.\n"
+              << "Defaults: 10000 rows, 8 columns, 20 iterations.\n";
+}
+
+/**
+ * @brief Generates a TSV result with a header of variables and rows of IRIs, numbers and
+ * literals.
+ */
+std::string generateTsv(std::size_t rows, std::size_t columns) {
+    std::string tsv;
+    for (std::size_t column = 0; column < columns; ++column) {
+        tsv.append(column == 0 ? "?" : "\t?").append("Vehicle_data_" + std::to_string(column));
+    }
+    tsv.append("\r\n");
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t column = 0; column < columns; ++column) {
+            if (column > 0) {
+                tsv.push_back('\t');
+            }
+            switch (column % 3) {
+                case 0:
+                    tsv.append("<http://example.org/vehicle/" + std::to_string(row) + ">");
+                    break;
+                case 1:
+                    tsv.append(std::to_string(row * column) + ".5");
+                    break;
+                default:
+                    tsv.append("\"value " + std::to_string(row) + "\\tescaped\"");
+                    break;
+            }
+        }
+        tsv.append("\r\n");
+    }
+    return tsv;
+}
+
+/**
+ * @brief Splits the result as before the TabularResultReader: a string stream per line and per
+ * row, and carriage returns erased from every cell.
+ */
+std::size_t splitWithStreams(const std::string& tsv) {
+    std::size_t bytes = 0;
+    std::stringstream str_stream(tsv);
+    std::string line;
+    std::vector<std::string> headers;
+    if (std::getline(str_stream, line)) {
+        std::stringstream header_stream(line);
+        std::string header;
+        while (std::getline(header_stream, header, '\t')) {
+            header.erase(std::remove(header.begin(), header.end(), '\r'), header.end());
+            headers.push_back(header);
+        }
+    }
+    while (std::getline(str_stream, line)) {
+        std::stringstream row_stream(line);
+        std::string value;
+        while (std::getline(row_stream, value, '\t')) {
+            value.erase(std::remove(value.begin(), value.end(), '\r'), value.end());
+            bytes += value.size();
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief Splits the result with the TabularResultReader.
+ */
+std::size_t splitWithReader(const std::string& tsv) {
+    std::size_t bytes = 0;
+    TabularResultReader reader(tsv, '\t');
+    std::pmr::vector<std::string_view> cells;
+    while (reader.nextRow(cells)) {
+        for (const auto& cell : cells) {
+            bytes += cell.size();
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief Runs a splitting function and reports the time per iteration.
+ */
+template <typename Split>
+void run(const std::string& name, const std::string& tsv, std::size_t iterations, Split split) {
+    std::size_t bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+        bytes += split(tsv);
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << std::left << std::setw(20) << name << std::fixed << std::setprecision(3)
+              << elapsed.count() / static_cast<double>(iterations) << " ms per result ("
+              << bytes / iterations << " cell bytes)\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
+        displayHelp();
+        return EXIT_SUCCESS;
+    }
+    const std::size_t rows = argc > 1 ? std::stoul(argv[1]) : 10000;
+    const std::size_t columns = argc > 2 ? std::stoul(argv[2]) : 8;
+    const std::size_t iterations = std::max<std::size_t>(argc > 3 ? std::stoul(argv[3]) : 20, 1);
+
+    const std::string tsv = generateTsv(rows, columns);
+    std::cout << "TSV result of " << rows << " rows and " << columns << " columns ("
+              << tsv.size() << " bytes), " << iterations << " iterations\n";
+    run("string streams", tsv, iterations, splitWithStreams);
+    run("TabularResultReader", tsv, iterations, splitWithReader);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,37 @@
+#include "xsd_datatype.h"
+
+#include <array>
+
+/**
+ * @brief Classifies an XSD datatype by the values of its literals.
+ *
+ * The datatype may be a full IRI ("http://www.w3.org/2001/XMLSchema#integer"), a prefixed name
+ * ("xsd:integer") or a local name ("integer"). Empty and unknown datatypes are OTHER.
+ *
+ * @param datatype The datatype to classify.
+ * @return The kind of the datatype.
+ */
+XsdDatatypeKind XsdDatatype::getKind(std::string_view datatype) {
+    if (const auto separator = datatype.find_last_of("#:"); separator != std::string_view::npos) {
+        datatype.remove_prefix(separator + 1);
+    }
+    if (datatype == "boolean") {
+        return XsdDatatypeKind::BOOLEAN;
+    }
+    if (datatype == "float" || datatype == "double") {
+        return XsdDatatypeKind::FLOATING;
+    }
+    if (datatype == "decimal") {
+        return XsdDatatypeKind::DECIMAL;
+    }
+    constexpr std::array<std::string_view, 13> INTEGER_TYPES = {
+        "integer", "int", "long", "short", "byte", "unsignedLong", "unsignedInt", "unsignedShort",
+        "unsignedByte", "positiveInteger", "negativeInteger", "nonPositiveInteger",
+        "nonNegativeInteger"};
+    for (const auto& integer_type : INTEGER_TYPES) {
+        if (datatype == integer_type) {
+            return XsdDatatypeKind::INTEGER;
+        }
+    }
+    return XsdDatatypeKind::OTHER;
+}
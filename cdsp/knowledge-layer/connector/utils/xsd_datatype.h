@@ -0,0 +1,15 @@
+#ifndef XSD_DATATYPE_H
+#define XSD_DATATYPE_H
+
+#include <string_view>
+
+/**
+ * @brief The kinds of XSD datatypes that need their own handling of literal values.
+ */
+enum class XsdDatatypeKind { BOOLEAN, INTEGER, DECIMAL, FLOATING, OTHER };
+
+namespace XsdDatatype {
+XsdDatatypeKind getKind(std::string_view datatype);
+};
+
+#endif  // XSD_DATATYPE_H
@@ -0,0 +1,68 @@
+#include "message_buffer_pool.h"
+
+/**
+ * @brief Constructs a MessageBufferPool.
+ *
+ * @param max_pooled_buffers The maximum number of idle buffers kept for reuse.
+ * @param max_buffer_capacity Buffers that grew beyond this capacity are freed instead of being
+ * kept, so a single large message does not pin its memory.
+ */
+MessageBufferPool::MessageBufferPool(std::size_t max_pooled_buffers,
+                                     std::size_t max_buffer_capacity)
+    : max_pooled_buffers_(max_pooled_buffers), max_buffer_capacity_(max_buffer_capacity) {}
+
+/**
+ * @brief Hands out an empty buffer, reusing an idle one if available.
+ *
+ * @return A shared pointer to an empty buffer, returned to the pool when the last owner
+ * releases it.
+ */
+std::shared_ptr<std::string> MessageBufferPool::acquire() {
+    std::unique_ptr<std::string> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_buffers_.empty()) {
+            buffer = std::move(free_buffers_.back());
+            free_buffers_.pop_back();
+        }
+    }
+    if (!buffer) {
+        buffer = std::make_unique<std::string>();
+    }
+
+    std::weak_ptr<MessageBufferPool> weak_pool = weak_from_this();
+    return {buffer.release(), [weak_pool](std::string* released) {
+                if (auto pool = weak_pool.lock()) {
+                    pool->release(released);
+                } else {
+                    delete released;
+                }
+            }};
+}
+
+/**
+ * @brief Returns the number of idle buffers ready for reuse.
+ */
+std::size_t MessageBufferPool::available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_buffers_.size();
+}
+
+/**
+ * @brief Takes a buffer back into the pool, or frees it if the pool is full or the buffer is
+ * oversized.
+ *
+ * @param buffer The buffer released by its last owner.
+ */
+void MessageBufferPool::release(std::string* buffer) {
+    std::unique_ptr<std::string> owned(buffer);
+    if (owned->capacity() > max_buffer_capacity_) {
+        return;
+    }
+    owned->clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_buffers_.size() < max_pooled_buffers_) {
+        free_buffers_.push_back(std::move(owned));
+    }
+}
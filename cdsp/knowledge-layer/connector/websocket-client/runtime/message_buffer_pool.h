@@ -0,0 +1,38 @@
+#ifndef MESSAGE_BUFFER_POOL_H
+#define MESSAGE_BUFFER_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Pool of reusable string buffers for serialized outgoing messages.
+ *
+ * Buffers are handed out as shared pointers whose deleter returns them (cleared, capacity kept)
+ * to the pool, so a buffer stays owned by whoever holds it, e.g. an asynchronous write, and is
+ * recycled as soon as the last owner releases it. The pool must be created with
+ * `std::make_shared`.
+ */
+class MessageBufferPool : public std::enable_shared_from_this<MessageBufferPool> {
+   public:
+    static constexpr std::size_t DEFAULT_MAX_POOLED_BUFFERS = 16;
+    static constexpr std::size_t DEFAULT_MAX_BUFFER_CAPACITY = 1024 * 1024;
+
+    explicit MessageBufferPool(std::size_t max_pooled_buffers = DEFAULT_MAX_POOLED_BUFFERS,
+                               std::size_t max_buffer_capacity = DEFAULT_MAX_BUFFER_CAPACITY);
+
+    std::shared_ptr<std::string> acquire();
+    [[nodiscard]] std::size_t available() const;
+
+   private:
+    void release(std::string* buffer);
+
+    const std::size_t max_pooled_buffers_;
+    const std::size_t max_buffer_capacity_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<std::string>> free_buffers_;
+};
+
+#endif  // MESSAGE_BUFFER_POOL_H
@@ -0,0 +1,43 @@
+#include "outgoing_message_queue.h"
+
+#include <stdexcept>
+
+OutgoingMessageQueue::OutgoingMessageQueue()
+    : buffer_pool_(std::make_shared<MessageBufferPool>()) {}
+
+/**
+ * @brief Provides an empty pooled buffer to serialize a message into.
+ *
+ * @return A shared pointer to an empty buffer.
+ */
+std::shared_ptr<std::string> OutgoingMessageQueue::acquireBuffer() {
+    return buffer_pool_->acquire();
+}
+
+/**
+ * @brief Appends a serialized message to the end of the queue.
+ *
+ * @param message The serialized message.
+ */
+void OutgoingMessageQueue::push(std::shared_ptr<const std::string> message) {
+    messages_.push_back(std::move(message));
+}
+
+/**
+ * @brief Removes and returns the oldest queued message.
+ *
+ * @return The serialized message.
+ * @throws std::runtime_error if the queue is empty.
+ */
+std::shared_ptr<const std::string> OutgoingMessageQueue::pop() {
+    if (messages_.empty()) {
+        throw std::runtime_error("No messages in the outgoing queue");
+    }
+    auto message = std::move(messages_.front());
+    messages_.pop_front();
+    return message;
+}
+
+bool OutgoingMessageQueue::empty() const { return messages_.empty(); }
+
+std::size_t OutgoingMessageQueue::size() const { return messages_.size(); }
@@ -0,0 +1,33 @@
+#ifndef OUTGOING_MESSAGE_QUEUE_H
+#define OUTGOING_MESSAGE_QUEUE_H
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "message_buffer_pool.h"
+
+/**
+ * @brief FIFO queue of serialized messages waiting to be written to the WebSocket.
+ *
+ * Messages are serialized once into buffers obtained from the queue's MessageBufferPool and
+ * queued as immutable shared buffers, which the connection keeps alive until the write completes.
+ */
+class OutgoingMessageQueue {
+   public:
+    OutgoingMessageQueue();
+
+    std::shared_ptr<std::string> acquireBuffer();
+    void push(std::shared_ptr<const std::string> message);
+    std::shared_ptr<const std::string> pop();
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+
+   private:
+    std::shared_ptr<MessageBufferPool> buffer_pool_;
+    std::deque<std::shared_ptr<const std::string>> messages_;
+};
+
+#endif  // OUTGOING_MESSAGE_QUEUE_H
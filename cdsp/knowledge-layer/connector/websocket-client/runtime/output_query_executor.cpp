@@ -0,0 +1,118 @@
+#include "output_query_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/post.hpp>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace {
+/**
+ * @brief Progress of one runAll() call, shared with the workers that take part in it.
+ */
+struct Batch {
+    const std::vector<OutputQueryExecutor::Task>* tasks = nullptr;
+    std::size_t count = 0;
+    std::atomic<std::size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t completed = 0;
+    std::exception_ptr error;
+};
+
+/**
+ * @brief Runs tasks of the batch until none is left to start.
+ *
+ * A worker may start after runAll() has returned and the task list is gone, e.g. when the pool
+ * was busy. The index of the next task is therefore checked against the count kept in the batch
+ * before the task list is touched: runAll() waits for every index below the count it hands out.
+ */
+void work(Batch& batch) {
+    const std::size_t count = batch.count;
+    for (std::size_t index = batch.next++; index < count; index = batch.next++) {
+        std::exception_ptr error;
+        try {
+            (*batch.tasks)[index]();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        const std::lock_guard<std::mutex> lock(batch.mutex);
+        if (error && !batch.error) {
+            batch.error = error;
+        }
+        if (++batch.completed == count) {
+            batch.done.notify_one();
+        }
+    }
+}
+}  // namespace
+
+/**
+ * @brief Constructs an executor.
+ *
+ * @param concurrency The maximum number of tasks that run at the same time. 0 is treated as 1.
+ */
+OutputQueryExecutor::OutputQueryExecutor(std::size_t concurrency)
+    : concurrency_(std::max<std::size_t>(concurrency, 1)), owns_workers_(true) {
+    if (concurrency_ > 1) {
+        workers_ = std::make_shared<boost::asio::thread_pool>(concurrency_ - 1);
+    }
+}
+
+/**
+ * @brief Constructs an executor that runs its tasks on a thread pool shared with other work.
+ *
+ * @param concurrency The maximum number of tasks that run at the same time. 0 is treated as 1.
+ * @param workers The pool the tasks that do not run on the calling thread are posted to. It is
+ * not joined by the executor.
+ */
+OutputQueryExecutor::OutputQueryExecutor(std::size_t concurrency,
+                                         std::shared_ptr<boost::asio::thread_pool> workers)
+    : concurrency_(std::max<std::size_t>(concurrency, 1)),
+      owns_workers_(false),
+      workers_(concurrency_ > 1 ? std::move(workers) : nullptr) {}
+
+/**
+ * @brief Stops the worker threads, unless the pool is shared.
+ */
+OutputQueryExecutor::~OutputQueryExecutor() {
+    if (workers_ && owns_workers_) {
+        workers_->join();
+    }
+}
+
+/**
+ * @brief Runs the tasks and waits until all of them have completed.
+ *
+ * @param tasks The tasks to run.
+ * @throws The first exception thrown by a task, once all tasks have completed.
+ */
+void OutputQueryExecutor::runAll(const std::vector<Task>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->tasks = &tasks;
+    batch->count = tasks.size();
+    if (workers_) {
+        const std::size_t helpers = std::min(concurrency_, tasks.size()) - 1;
+        for (std::size_t helper = 0; helper < helpers; ++helper) {
+            boost::asio::post(*workers_, [batch]() { work(*batch); });
+        }
+    }
+    work(*batch);
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done.wait(lock, [&batch, &tasks]() { return batch->completed == tasks.size(); });
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
+/**
+ * @brief Retrieves the maximum number of tasks that run at the same time.
+ */
+std::size_t OutputQueryExecutor::getConcurrency() const { return concurrency_; }
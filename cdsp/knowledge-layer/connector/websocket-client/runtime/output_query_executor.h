@@ -0,0 +1,44 @@
+#ifndef OUTPUT_QUERY_EXECUTOR_H
+#define OUTPUT_QUERY_EXECUTOR_H
+
+#include <boost/asio/thread_pool.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Runs the independent output queries of one scheduler run concurrently.
+ *
+ * `runAll()` blocks until every task has completed, so the caller sees the results of a run
+ * together and can merge them in a fixed order, independent of the order in which the reasoner
+ * answered. The calling thread takes part in the work, so at most `concurrency` tasks run at the
+ * same time on the calling thread and `concurrency - 1` worker threads. With a concurrency of 1,
+ * the tasks run one after another on the calling thread.
+ *
+ * Tasks must not share mutable state without synchronization; each should write its result to its
+ * own slot.
+ */
+class OutputQueryExecutor {
+   public:
+    using Task = std::function<void()>;
+
+    explicit OutputQueryExecutor(std::size_t concurrency = 1);
+    OutputQueryExecutor(std::size_t concurrency,
+                        std::shared_ptr<boost::asio::thread_pool> workers);
+    ~OutputQueryExecutor();
+
+    OutputQueryExecutor(const OutputQueryExecutor&) = delete;
+    OutputQueryExecutor& operator=(const OutputQueryExecutor&) = delete;
+
+    void runAll(const std::vector<Task>& tasks);
+    [[nodiscard]] std::size_t getConcurrency() const;
+
+   private:
+    const std::size_t concurrency_;
+    const bool owns_workers_;
+    // Only set for a concurrency above 1
+    std::shared_ptr<boost::asio::thread_pool> workers_;
+};
+
+#endif  // OUTPUT_QUERY_EXECUTOR_H
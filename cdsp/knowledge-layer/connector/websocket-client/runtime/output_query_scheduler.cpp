@@ -0,0 +1,239 @@
+#include "output_query_scheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+#include "helper.h"
+
+namespace {
+/**
+ * @brief Parses a non-negative number of milliseconds.
+ *
+ * @param name The name of the setting, for the error message.
+ * @param value The value to parse.
+ * @return The parsed duration.
+ * @throws std::invalid_argument if the value is not a non-negative integer.
+ */
+std::chrono::milliseconds parseMilliseconds(const std::string& name, const std::string& value) {
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+        throw std::invalid_argument("Invalid value for " + name + ": '" + value +
+                                    "'. A non-negative integer is expected.");
+    }
+    return std::chrono::milliseconds(std::stoull(value));
+}
+
+/**
+ * @brief Reads a number of milliseconds from an environment variable.
+ *
+ * @param env_var The name of the environment variable.
+ * @param default_value The value used when the variable is not set.
+ * @return The parsed value.
+ * @throws std::invalid_argument if the value is not a non-negative integer.
+ */
+std::chrono::milliseconds getMillisecondsEnvVariable(const std::string& env_var,
+                                                     std::chrono::milliseconds default_value) {
+    return std::chrono::milliseconds(
+        Helper::getUnsignedEnvVariable(env_var, default_value.count()));
+}
+
+std::string trim(std::string_view value) {
+    const std::size_t first = value.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return "";
+    }
+    const std::size_t last = value.find_last_not_of(" \t");
+    return std::string(value.substr(first, last - first + 1));
+}
+}  // namespace
+
+/**
+ * @brief Reads the default settings of the output queries from the environment.
+ *
+ * OUTPUT_QUERY_MIN_INTERVAL_MS sets the minimum interval (default 0), OUTPUT_QUERY_DEBOUNCE_MS
+ * the debounce (default 0), OUTPUT_QUERY_MAX_DELAY_MS the maximum delay of the debounce
+ * (default 1000) and OUTPUT_QUERY_CONCURRENCY the number of queries that run at the same time
+ * (default 4).
+ *
+ * @return The scheduler settings.
+ * @throws std::invalid_argument if a variable has an invalid value.
+ */
+OutputQuerySchedulerSettings OutputQuerySchedulerSettings::fromEnvironment() {
+    OutputQuerySchedulerSettings settings;
+    settings.min_interval =
+        getMillisecondsEnvVariable("OUTPUT_QUERY_MIN_INTERVAL_MS", settings.min_interval);
+    settings.debounce = getMillisecondsEnvVariable("OUTPUT_QUERY_DEBOUNCE_MS", settings.debounce);
+    settings.max_delay =
+        getMillisecondsEnvVariable("OUTPUT_QUERY_MAX_DELAY_MS", settings.max_delay);
+    settings.max_concurrency =
+        Helper::getUnsignedEnvVariable("OUTPUT_QUERY_CONCURRENCY", settings.max_concurrency, 1);
+    return settings;
+}
+
+/**
+ * @brief Applies the `#SCHEDULE(...)` comment of a query to these settings.
+ *
+ * The comment holds comma-separated `min_interval_ms`, `debounce_ms` and `max_delay_ms` values;
+ * settings that it does not mention keep their value.
+ *
+ * @param query The query text.
+ * @return The settings of the query.
+ * @throws std::invalid_argument if the comment is malformed.
+ */
+OutputQuerySchedulerSettings OutputQuerySchedulerSettings::forQuery(
+    const std::string& query) const {
+    OutputQuerySchedulerSettings settings = *this;
+    const std::size_t marker = query.find(OutputQueryScheduler::SCHEDULE_MARKER);
+    if (marker == std::string::npos) {
+        return settings;
+    }
+    const std::size_t start =
+        marker + std::string_view(OutputQueryScheduler::SCHEDULE_MARKER).size();
+    const std::size_t end = query.find(')', start);
+    if (end == std::string::npos || query.find('\n', start) < end) {
+        throw std::invalid_argument("Unterminated " +
+                                    std::string(OutputQueryScheduler::SCHEDULE_MARKER) +
+                                    "...) comment in output query");
+    }
+
+    const std::string_view arguments = std::string_view(query).substr(start, end - start);
+    std::size_t position = 0;
+    while (position <= arguments.size()) {
+        const std::size_t separator = std::min(arguments.find(',', position), arguments.size());
+        const std::string argument = trim(arguments.substr(position, separator - position));
+        position = separator + 1;
+        if (argument.empty()) {
+            continue;
+        }
+
+        const std::size_t equals = argument.find('=');
+        const std::string key = trim(std::string_view(argument).substr(0, equals));
+        const std::string value =
+            equals == std::string::npos ? "" : trim(std::string_view(argument).substr(equals + 1));
+        if (key == "min_interval_ms") {
+            settings.min_interval = parseMilliseconds(key, value);
+        } else if (key == "debounce_ms") {
+            settings.debounce = parseMilliseconds(key, value);
+        } else if (key == "max_delay_ms") {
+            settings.max_delay = parseMilliseconds(key, value);
+        } else {
+            throw std::invalid_argument("Unknown output query schedule setting: '" + key + "'");
+        }
+    }
+    return settings;
+}
+
+/**
+ * @brief Constructs a scheduler.
+ *
+ * @param settings The default settings of the queries.
+ */
+OutputQueryScheduler::OutputQueryScheduler(OutputQuerySchedulerSettings settings)
+    : settings_(settings) {}
+
+/**
+ * @brief Makes a query pending because new data has arrived.
+ *
+ * @param query The output query.
+ * @param now The arrival time of the data.
+ * @throws std::invalid_argument if the `#SCHEDULE(...)` comment of the query is malformed.
+ */
+void OutputQueryScheduler::notifyDataArrived(const std::string& query, Clock::time_point now) {
+    auto entry = queries_.find(query);
+    if (entry == queries_.end()) {
+        QueryState state;
+        state.settings = settings_.forQuery(query);
+        entry = queries_.emplace(query, state).first;
+    }
+
+    QueryState& state = entry->second;
+    const bool coalesced = state.pending;
+    if (!state.pending) {
+        state.pending = true;
+        state.first_arrival = now;
+    }
+    state.last_arrival = now;
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    ++statistics_.notifications;
+    if (coalesced) {
+        ++statistics_.coalesced;
+    }
+}
+
+/**
+ * @brief Retrieves the time at which the next pending query is due.
+ *
+ * @return The earliest due time, or std::nullopt if no query is pending.
+ */
+std::optional<OutputQueryScheduler::Clock::time_point> OutputQueryScheduler::nextDueTime() const {
+    std::optional<Clock::time_point> next;
+    for (const auto& [query, state] : queries_) {
+        if (state.pending && (!next || dueTime(state) < *next)) {
+            next = dueTime(state);
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief Takes the queries that are due, which are no longer pending afterwards.
+ *
+ * @param now The current time, which becomes the time of the last run of the returned queries.
+ * @return The due queries.
+ */
+std::unordered_set<std::string> OutputQueryScheduler::takeDueQueries(Clock::time_point now) {
+    std::unordered_set<std::string> due_queries;
+    std::chrono::milliseconds total_lag{0};
+    std::chrono::milliseconds max_lag{0};
+    for (auto& [query, state] : queries_) {
+        if (!state.pending || dueTime(state) > now) {
+            continue;
+        }
+        const auto lag = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - state.first_arrival);
+        total_lag += lag;
+        max_lag = std::max(max_lag, lag);
+        state.pending = false;
+        state.last_run = now;
+        due_queries.insert(query);
+    }
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.runs += due_queries.size();
+    statistics_.total_lag += total_lag;
+    statistics_.max_lag = std::max(statistics_.max_lag, max_lag);
+    return due_queries;
+}
+
+/**
+ * @brief Forgets all queries, e.g. when the output queries were reloaded.
+ */
+void OutputQueryScheduler::clear() { queries_.clear(); }
+
+/**
+ * @brief Retrieves the scheduler counters.
+ *
+ * @return A copy of the counters.
+ */
+OutputQuerySchedulerStatistics OutputQueryScheduler::getStatistics() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+/**
+ * @brief Computes when a pending query is due.
+ *
+ * The debounce waits for the end of a burst of data, but not longer than the maximum delay after
+ * its first data; the minimum interval since the previous run always applies.
+ */
+OutputQueryScheduler::Clock::time_point OutputQueryScheduler::dueTime(const QueryState& state) {
+    Clock::time_point due = state.last_arrival + state.settings.debounce;
+    if (state.settings.max_delay.count() > 0) {
+        due = std::min(due, state.first_arrival + state.settings.max_delay);
+    }
+    if (state.last_run) {
+        due = std::max(due, *state.last_run + state.settings.min_interval);
+    }
+    return due;
+}
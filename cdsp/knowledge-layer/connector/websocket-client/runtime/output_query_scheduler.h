@@ -0,0 +1,95 @@
+#ifndef OUTPUT_QUERY_SCHEDULER_H
+#define OUTPUT_QUERY_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * @brief Settings of the OutputQueryScheduler, the defaults of all queries or the settings of one
+ * query.
+ */
+struct OutputQuerySchedulerSettings {
+    // Minimum time between two runs of a query
+    std::chrono::milliseconds min_interval{0};
+    // Time without new data before a query runs (trailing edge), 0 runs it after the current batch
+    std::chrono::milliseconds debounce{0};
+    // Longest time the debounce may delay a query while data keeps arriving, 0 for no limit
+    std::chrono::milliseconds max_delay{1000};
+    // Most due queries that run at the same time, applies to all queries
+    std::size_t max_concurrency = 4;
+
+    static OutputQuerySchedulerSettings fromEnvironment();
+    OutputQuerySchedulerSettings forQuery(const std::string& query) const;
+};
+
+/**
+ * @brief Counters of the OutputQueryScheduler.
+ */
+struct OutputQuerySchedulerStatistics {
+    // Data arrivals per query, i.e. data messages times output queries
+    std::uint64_t notifications = 0;
+    // Notifications for a query that was already pending, merged into its next run
+    std::uint64_t coalesced = 0;
+    std::uint64_t runs = 0;
+    // Lag between the first data of a run and the run
+    std::chrono::milliseconds total_lag{0};
+    std::chrono::milliseconds max_lag{0};
+};
+
+/**
+ * @brief Decides when the output queries run, decoupled from the arrival of data messages.
+ *
+ * Every data message makes the output queries pending. A pending query is due once no data has
+ * arrived for its debounce time (trailing edge) and its minimum interval since the previous run
+ * has passed; the debounce delays a query by at most its maximum delay after the first pending
+ * data. Further data for a pending query is coalesced into the same run, so a burst of messages
+ * runs each query once.
+ *
+ * The settings of a query can be overridden with a comment in the query, e.g.
+ * `#SCHEDULE(min_interval_ms=500, debounce_ms=100, max_delay_ms=2000)`.
+ *
+ * The scheduler only keeps time; the caller runs the due queries, e.g. on a timer set to
+ * `nextDueTime()`.
+ */
+class OutputQueryScheduler {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr char SCHEDULE_MARKER[] = "#SCHEDULE(";
+
+    explicit OutputQueryScheduler(
+        OutputQuerySchedulerSettings settings = OutputQuerySchedulerSettings());
+
+    void notifyDataArrived(const std::string& query, Clock::time_point now = Clock::now());
+    [[nodiscard]] std::optional<Clock::time_point> nextDueTime() const;
+    std::unordered_set<std::string> takeDueQueries(Clock::time_point now = Clock::now());
+    void clear();
+
+    [[nodiscard]] OutputQuerySchedulerStatistics getStatistics() const;
+
+   private:
+    struct QueryState {
+        OutputQuerySchedulerSettings settings;
+        bool pending = false;
+        Clock::time_point first_arrival;
+        Clock::time_point last_arrival;
+        std::optional<Clock::time_point> last_run;
+    };
+
+    const OutputQuerySchedulerSettings settings_;
+    std::unordered_map<std::string, QueryState> queries_;
+
+    // Guards the statistics, which may be read from another thread
+    mutable std::mutex mutex_;
+    OutputQuerySchedulerStatistics statistics_;
+
+    static Clock::time_point dueTime(const QueryState& state);
+};
+
+#endif  // OUTPUT_QUERY_SCHEDULER_H
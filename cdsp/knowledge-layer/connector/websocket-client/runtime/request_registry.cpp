@@ -1,60 +1,103 @@
 #include "request_registry.h"
 
-#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "logger.h"
+
+RequestRegistry::RequestKey::RequestKey(const RequestInfo &info)
+    : type(info.type), schema(info.schema), instance(info.instance) {
+    if (info.path) {
+        path = *info.path;
+    }
+}
+
+bool RequestRegistry::RequestKey::operator==(const RequestKey &other) const {
+    return type == other.type && schema == other.schema && instance == other.instance &&
+           path == other.path;
+}
+
+std::size_t RequestRegistry::RequestKeyHash::operator()(const RequestKey &key) const noexcept {
+    const std::hash<std::string_view> hasher;
+    std::size_t seed = key.type;
+    const auto combine = [&seed](std::size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(hasher(key.schema));
+    combine(hasher(key.instance));
+    combine(key.path ? hasher(*key.path) : 0);
+    return seed;
+}
+
+/**
+ * @brief Creates an empty registry.
+ *
+ * @param request_ttl Time after which GET and SET requests without response are expired.
+ * @param max_requests Maximum number of tracked requests.
+ */
+RequestRegistry::RequestRegistry(std::chrono::milliseconds request_ttl, std::size_t max_requests)
+    : request_ttl_(request_ttl), max_requests_(max_requests) {
+    requests_.reserve(std::min<std::size_t>(max_requests_, 1024));
+    index_.reserve(std::min<std::size_t>(max_requests_, 1024));
+}
+
 /**
  * @brief Adds a new request to the registry.
  *
- * This function takes a RequestInfo object and adds it to the
- * requests list associated with the next available identifier.
- * The identifier is then incremented for future requests.
+ * This function stores the RequestInfo object under the next available identifier and indexes
+ * it by its type, schema, instance and path. Expired GET/SET requests are removed first, and if
+ * the registry is still full the oldest GET/SET requests are evicted.
  *
- * @param info The RequestInfo object containing details of the
- * request to be added.
+ * @param info The RequestInfo object containing details of the request to be added.
  * @return The identifier of the newly added request.
+ * @throws std::runtime_error if the registry is full of subscriptions.
  */
-int RequestRegistry::addRequest(const RequestInfo &info) {
-    requests_[next_identifier_] = info;
-    return next_identifier_++;
+int RequestRegistry::addRequest(RequestInfo info) {
+    const auto now = Clock::now();
+    expireRequests(now);
+    makeRoom();
+
+    const int identifier = next_identifier_++;
+    const RequestInfo &request_info = requests_.emplace(identifier, std::move(info)).first->second;
+    index_[RequestKey(request_info)].push_back(identifier);
+
+    if (request_info.type == RequestInfo::Type::GET ||
+        request_info.type == RequestInfo::Type::SET) {
+        expiry_queue_.emplace_back(now + request_ttl_, identifier);
+    }
+    statistics_.added++;
+    return identifier;
 }
 
 /**
- * @brief Retrieves the request information associated with the given
- * identifier.
- *
- * This function searches for the request in the registry using the
- * provided identifier. If a request is found and it is not empty, the
- * first request info is returned. Otherwise, it returns an empty optional.
+ * @brief Retrieves the request information associated with the given identifier.
  *
  * @param identifier The unique identifier for the request to retrieve.
- * @return std::optional<RequestInfo> An optional containing the
- * request info if found, or std::nullopt if no request exists for the
- * given identifier.
+ * @return A pointer to the request info, or nullptr if no request exists for the given
+ * identifier. The pointer is valid until the request is removed.
  */
-std::optional<RequestInfo> RequestRegistry::getRequest(int identifier) const {
+const RequestInfo *RequestRegistry::getRequest(int identifier) const {
     auto iterator = requests_.find(identifier);
     if (iterator != requests_.end()) {
-        return iterator->second;
+        return &iterator->second;
     }
-    return std::nullopt;
+    return nullptr;
 }
 
 /**
  * @brief Finds the request ID associated with the given request information.
  *
- * This method iterates through the registered requests and compares the
- * provided RequestInfo object with each request's information. If a match
- * is found based on type, schema, instance, and path, the corresponding
- * request ID is returned. If no match is found, -1 is returned to indicate
- * that the request ID could not be found.
+ * The lookup goes through the reverse index keyed by type, schema, instance and path. If several
+ * requests match, the oldest one is returned.
  *
  * @param info The RequestInfo object containing the details to match against.
- * @return The identifier of the matching request if found; otherwise, -1.
+ * @return The identifier of the matching request if found; otherwise, std::nullopt.
  */
 std::optional<int> RequestRegistry::findRequestId(const RequestInfo &info) const {
-    for (const auto &[identifier, request_info] : requests_) {
-        if (request_info == info) {
-            return identifier;
-        }
+    auto iterator = index_.find(RequestKey(info));
+    if (iterator != index_.end() && !iterator->second.empty()) {
+        return iterator->second.front();
     }
     return std::nullopt;  // Not found
 }
@@ -62,21 +105,107 @@ std::optional<int> RequestRegistry::findRequestId(const RequestInfo &info) const
 /**
  * @brief Removes a request from the registry using the given identifier.
  *
- * This function searches for the request in the registry using the
- * provided identifier. If found, it removes the request and returns
- * true. If not found, it returns false.
- *
  * @param identifier The unique identifier for the request to remove.
- * @return bool True if the request was successfully removed, false
- * otherwise.
  */
 void RequestRegistry::removeRequest(int identifier) {
     auto iterator = requests_.find(identifier);
     if (iterator != requests_.end()) {
-        RequestInfo request_info = iterator->second;
-
-        requests_.erase(iterator);
+        eraseRequest(iterator);
+        statistics_.removed++;
     } else {
-        std::cout << "Request with identifier " << identifier << " not found in the registry.\n";
+        LOG_DEBUG("Request with identifier " << identifier << " not found in the registry.");
+    }
+}
+
+/**
+ * @brief Removes the GET and SET requests whose TTL has elapsed without a response.
+ *
+ * @param now The point in time to compare the expiry deadlines against.
+ * @return The number of expired requests.
+ */
+std::size_t RequestRegistry::expireRequests(Clock::time_point now) {
+    std::size_t expired = 0;
+    while (!expiry_queue_.empty() && expiry_queue_.front().first <= now) {
+        auto iterator = requests_.find(expiry_queue_.front().second);
+        expiry_queue_.pop_front();
+        // Requests that were answered in time are no longer registered
+        if (iterator != requests_.end()) {
+            eraseRequest(iterator);
+            expired++;
+        }
+    }
+
+    if (expired > 0) {
+        statistics_.expired += expired;
+        LOG_WARN(expired << " request(s) expired without response (total expired: "
+                         << statistics_.expired << ")");
+    }
+    return expired;
+}
+
+std::size_t RequestRegistry::size() const { return requests_.size(); }
+
+/**
+ * @brief Returns the current size and the counters of the registry.
+ */
+RequestRegistryStatistics RequestRegistry::getStatistics() const {
+    RequestRegistryStatistics statistics = statistics_;
+    statistics.size = requests_.size();
+    return statistics;
+}
+
+/**
+ * @brief Removes a request from both the identifier map and the reverse index.
+ *
+ * If other requests share the key of the removed one, the index key is rebuilt on the oldest of
+ * them, since the key views the strings of the request it was created for.
+ *
+ * @param iterator The request to remove.
+ */
+void RequestRegistry::eraseRequest(std::unordered_map<int, RequestInfo>::iterator iterator) {
+    const int identifier = iterator->first;
+    const RequestInfo &info = iterator->second;
+
+    auto index_iterator = index_.find(RequestKey(info));
+    if (index_iterator != index_.end()) {
+        auto &identifiers = index_iterator->second;
+        identifiers.erase(std::remove(identifiers.begin(), identifiers.end(), identifier),
+                          identifiers.end());
+        if (identifiers.empty()) {
+            index_.erase(index_iterator);
+        } else if (index_iterator->first.schema.data() == info.schema.data()) {
+            auto node = index_.extract(index_iterator);
+            node.key() = RequestKey(requests_.at(node.mapped().front()));
+            index_.insert(std::move(node));
+        }
+    }
+    requests_.erase(iterator);
+}
+
+/**
+ * @brief Evicts the oldest GET/SET requests until a new request fits into the registry.
+ *
+ * @throws std::runtime_error if only subscriptions are left and the registry is full.
+ */
+void RequestRegistry::makeRoom() {
+    std::size_t evicted = 0;
+    while (requests_.size() >= max_requests_ && !expiry_queue_.empty()) {
+        auto iterator = requests_.find(expiry_queue_.front().second);
+        expiry_queue_.pop_front();
+        if (iterator != requests_.end()) {
+            eraseRequest(iterator);
+            evicted++;
+        }
+    }
+
+    if (evicted > 0) {
+        statistics_.evicted += evicted;
+        LOG_WARN("Request registry full, evicted " << evicted
+                                                   << " pending request(s) (total evicted: "
+                                                   << statistics_.evicted << ")");
+    }
+    if (requests_.size() >= max_requests_) {
+        throw std::runtime_error("Request registry is full (" + std::to_string(max_requests_) +
+                                 " requests)");
     }
 }
@@ -1,10 +1,16 @@
 #ifndef REQUEST_REGISTRY_H
 #define REQUEST_REGISTRY_H
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <map>
+#include <deque>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 struct RequestInfo {
     enum Type : std::uint8_t { SUBSCRIBE, UNSUBSCRIBE, GET, SET } type;
@@ -33,16 +39,75 @@ struct RequestInfo {
     }
 };
 
+/**
+ * @brief Counters of the request registry.
+ */
+struct RequestRegistryStatistics {
+    std::size_t size = 0;
+    std::uint64_t added = 0;
+    std::uint64_t removed = 0;
+    // GET/SET requests removed because no response arrived within the TTL.
+    std::uint64_t expired = 0;
+    // GET/SET requests removed before their TTL to keep the registry below its capacity.
+    std::uint64_t evicted = 0;
+};
+
+/**
+ * @brief Tracks in-flight requests by identifier and by (type, schema, instance, path).
+ *
+ * Lookups in both directions are hash-based. GET and SET requests whose response never arrives
+ * expire after a TTL, and the number of tracked requests is capped, evicting the oldest GET/SET
+ * requests first. Subscriptions are only removed explicitly.
+ */
 class RequestRegistry {
    public:
-    int addRequest(const RequestInfo &info);
-    [[nodiscard]] std::optional<RequestInfo> getRequest(int identifier) const;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds DEFAULT_REQUEST_TTL = std::chrono::seconds(60);
+    static constexpr std::size_t DEFAULT_MAX_REQUESTS = 10000;
+
+    explicit RequestRegistry(std::chrono::milliseconds request_ttl = DEFAULT_REQUEST_TTL,
+                             std::size_t max_requests = DEFAULT_MAX_REQUESTS);
+
+    int addRequest(RequestInfo info);
+    [[nodiscard]] const RequestInfo *getRequest(int identifier) const;
     [[nodiscard]] std::optional<int> findRequestId(const RequestInfo &info) const;
     void removeRequest(int identifier);
+    std::size_t expireRequests(Clock::time_point now = Clock::now());
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] RequestRegistryStatistics getStatistics() const;
 
    private:
-    std::map<int, RequestInfo> requests_;
+    // Lookup key viewing the strings of a registered RequestInfo (or of the searched one).
+    struct RequestKey {
+        RequestInfo::Type type;
+        std::string_view schema;
+        std::string_view instance;
+        std::optional<std::string_view> path;
+
+        explicit RequestKey(const RequestInfo &info);
+        bool operator==(const RequestKey &other) const;
+    };
+
+    struct RequestKeyHash {
+        std::size_t operator()(const RequestKey &key) const noexcept;
+    };
+
+    std::chrono::milliseconds request_ttl_;
+    std::size_t max_requests_;
+
+    std::unordered_map<int, RequestInfo> requests_;
+    // Identifiers of the registered requests per key, oldest first.
+    std::unordered_map<RequestKey, std::vector<int>, RequestKeyHash> index_;
+    // Expiry deadlines of GET/SET requests in registration order (the TTL is constant).
+    std::deque<std::pair<Clock::time_point, int>> expiry_queue_;
+
     int next_identifier_ = 0;
+    RequestRegistryStatistics statistics_;
+
+    void eraseRequest(std::unordered_map<int, RequestInfo>::iterator iterator);
+    void makeRoom();
 };
 
-#endif  // REQUEST_REGISTRY_H
\ No newline at end of file
+#endif  // REQUEST_REGISTRY_H
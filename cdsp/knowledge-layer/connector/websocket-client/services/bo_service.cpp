@@ -1,7 +1,7 @@
 #include "bo_service.h"
 
-#include <iostream>
-
+#include "converter_helper.h"
+#include "logger.h"
 #include "message_header.h"
 #include "node.h"
 
@@ -26,8 +26,7 @@
 SubscribeMessage BoService::createSubscribeMessage(const std::string& object_id,
                                                    SchemaType schema_type,
                                                    const std::vector<Node>& nodes) {
-    MessageHeader subscribe_header(object_id, schema_type);
-    return {subscribe_header, nodes};
+    return {MessageHeader(object_id, schema_type), nodes};
 }
 
 /**
@@ -43,8 +42,7 @@ SubscribeMessage BoService::createSubscribeMessage(const std::string& object_id,
 UnsubscribeMessage BoService::createUnsubscribeMessage(const std::string& object_id,
                                                        SchemaType schema_type,
                                                        const std::vector<Node>& nodes) {
-    MessageHeader unsubscribe_header(object_id, schema_type);
-    return {unsubscribe_header, nodes};
+    return {MessageHeader(object_id, schema_type), nodes};
 }
 
 /**
@@ -74,7 +72,7 @@ GetMessage BoService::createGetMessage(const std::string& object_id, SchemaType
         nodes.emplace_back(data_point, std::nullopt, Metadata());
     }
 
-    return {get_header, nodes};
+    return {std::move(get_header), std::move(nodes)};
 }
 
 /**
@@ -103,22 +101,28 @@ std::vector<SetMessage> BoService::createSetMessage(
         for (const auto& [schema, data_points] : groups.items()) {
             SchemaType schema_type = stringToSchemaType(schema);
             if (object_ids.find(schema_type) == object_ids.end()) {
-                std::cerr << "Warning: Schema type " << schema << " not found in object ID map."
-                          << std::endl;
+                LOG_WARN("Schema type " << schema << " not found in object ID map.");
                 continue;
             }
 
             std::vector<Node> nodes;
 
-            Metadata::OriginType origin_system = {origin_system_name, std::nullopt};
+            nodes.reserve(data_points.size());
+
+            const Metadata::OriginType origin_system = {origin_system_name, std::nullopt};
 
             for (const auto& [data_point, value] : data_points.items()) {
-                Metadata metadata({std::nullopt, std::chrono::system_clock::now()}, origin_system);
-                nodes.emplace_back(data_point, value.dump(), metadata);
+                // Values other than primitives are kept as their serialized JSON
+                NodeValue node_value = value.is_primitive() && !value.is_null()
+                                           ? ConverterHelper::toNodeValue(value)
+                                           : NodeValue(value.dump());
+                nodes.emplace_back(
+                    data_point, std::move(node_value),
+                    Metadata({std::nullopt, std::chrono::system_clock::now()}, origin_system));
             }
 
-            MessageHeader header(object_ids.at(schema_type), schema_type);
-            set_messages.emplace_back(header, nodes);
+            set_messages.emplace_back(MessageHeader(object_ids.at(schema_type), schema_type),
+                                      std::move(nodes));
         }
     }
 
@@ -1,8 +1,8 @@
 #include "bo_to_dto.h"
 
-#include <iostream>
-
+#include "converter_helper.h"
 #include "data_types.h"
+#include "logger.h"
 #include "nlohmann/json.hpp"
 
 /**
@@ -122,13 +122,7 @@ std::vector<SetMessageDTO> BoToDto::convert(const SetMessage& b_obj) {
         DataDTO data;
         data.name = node.getName();
         if (node.getValue()) {
-            try {
-                data.value = nlohmann::json::parse(*node.getValue());
-            } catch (const std::exception& e) {
-                std::cerr << "JSON parsing failed for value: " << *node.getValue() << " - "
-                          << e.what() << std::endl;
-                data.value = *node.getValue();  // fallback
-            }
+            data.value = ConverterHelper::toJson(*node.getValue());
         } else {
             data.value = "";
         }
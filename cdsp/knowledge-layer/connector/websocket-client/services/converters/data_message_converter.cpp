@@ -1,8 +1,11 @@
 #include "data_message_converter.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 
 #include "converter_helper.h"
+#include "logger.h"
 #include "node.h"
 
 /**
@@ -12,185 +15,220 @@
  *
  * Converts a DataMessageDTO object to a DataMessage object.
  *
+ * The data is walked once: node names are built in a single reused buffer and
+ * the metadata of each node is resolved while the node is created, using the
+ * offset in the name at which the path leaves the requested base path.
+ *
  * @param dto The DataMessageDTO object to be converted. It must have a type of
  * "data".
  * @param registry The RequestRegistry object that contains information about
  * the request associated with the DTO.
+ * @param signal_catalog The catalog used to tag the nodes with their signal ID. Without a catalog
+ * all nodes get SignalCatalog::UNKNOWN_SIGNAL.
+ * @param resource The memory resource for the scratch data of the conversion, e.g. the message
+ * arena.
  * @return A DataMessage object constructed from the provided DataMessageDTO.
  * @throws std::invalid_argument if the dto type is not "data".
  */
-DataMessage DataMessageConverter::convert(const DataMessageDTO &dto, RequestRegistry &registry) {
+DataMessage DataMessageConverter::convert(const DataMessageDTO &dto, RequestRegistry &registry,
+                                          const SignalCatalog *signal_catalog,
+                                          std::pmr::memory_resource *resource) {
     // Check if the message belongs to the request registry
     auto request_registry = registry.getRequest(dto.id);
 
-    if (!request_registry.has_value()) {
+    if (request_registry == nullptr) {
         throw std::invalid_argument("Registry not found for the ID: " + std::to_string(dto.id));
     }
 
-    SchemaType schema_type = stringToSchemaType(request_registry->schema);
+    const std::string &schema_collection = request_registry->schema;
+    SchemaType schema_type = stringToSchemaType(schema_collection);
 
     MessageHeader header(request_registry->instance, schema_type);
 
-    std::vector<Node> nodes;
-    std::string base_path = request_registry->path.value_or("");
+    const std::string_view base_path =
+        request_registry->path ? std::string_view(*request_registry->path) : std::string_view();
 
     if (base_path.empty() && !dto.data.is_object()) {
         throw std::invalid_argument("Path is missing and data is not an object");
     }
 
-    parseNodes(base_path, dto.data, nodes, request_registry->schema);
+    ConversionContext context(resource);
+    context.name.reserve(schema_collection.size() + base_path.size() + 64);
+    context.name.append(schema_collection).push_back('.');
+    context.path_offset = context.name.size();
+    context.name.append(base_path);
+    context.metadata_offset = context.name.size();
+    context.metadata_dto = dto.metadata ? &*dto.metadata : nullptr;
+    context.signal_catalog = signal_catalog;
+    context.nodes.reserve(countLeaves(dto.data));
 
-    // Combine nodes with their associated metadata to produce the final node
-    // collection
-    std::vector<Node> nodes_with_metadata =
-        includeMetadata(request_registry->schema, base_path, dto.metadata, nodes);
+    parseNodes(dto.data, context);
 
     if (request_registry->type != RequestInfo::Type::SUBSCRIBE) {
         // Remove the request from the registry after processing
         registry.removeRequest(dto.id);
     }
 
-    return {header, nodes_with_metadata};
+    return {std::move(header), std::move(context.nodes)};
 }
 
 /**
- * @brief Parses a JSON object and converts it into a vector of Node objects.
+ * @brief Counts the values that will become nodes, to reserve the node vector up front.
  *
- * This function recursively traverses a JSON object, constructing a path for
- * each key-value pair. If a value is an object, the function calls itself
- * recursively. Otherwise, it creates a Node object with the constructed path,
- * the value converted to a string, and optional metadata, then adds it to the
- * nodes vector.
+ * @param data The JSON value to count the leaves of.
+ * @return The number of primitive values in the JSON value.
+ */
+std::size_t DataMessageConverter::countLeaves(const nlohmann::json &data) {
+    if (!data.is_structured()) {
+        return 1;
+    }
+    std::size_t leaves = 0;
+    for (const auto &element : data) {
+        leaves += countLeaves(element);
+    }
+    return leaves;
+}
+
+/**
+ * @brief Converts the members of a JSON object (or the elements of a top-level array) into nodes.
  *
- * @param base_path The base path used to construct the full path for each node.
- * @param data The JSON object to parse.
- * @param nodes A reference to a vector where the resulting Node objects will be
- * stored.
- * @param schema_collection A string representing the schema used to prefix the
- * node names.
- * @param metadata Optional metadata that can be associated with each node.
+ * The path of each member is appended to the name buffer of the context and removed again once
+ * the member is processed, so the buffer is reused for the whole message. A primitive value is
+ * converted into a node named after the current path.
+ *
+ * @param data The JSON value to parse.
+ * @param context The conversion state holding the name buffer and the resulting nodes.
  */
-void DataMessageConverter::parseNodes(const std::string &base_path, const nlohmann::json &data,
-                                      std::vector<Node> &nodes,
-                                      const std::string &schema_collection) {
-    for (const auto &[key, value] : data.items()) {
-        std::string path;
-        if (key.empty()) {
-            // Leaf message
-            path = base_path;
-        } else if (base_path.empty()) {
-            path = key;
-        } else {
-            // Detect array index by checking if key is numeric (used to correctly
-            // format paths)
-            bool is_numeric = std::all_of(key.begin(), key.end(), ::isdigit);
-            path = base_path;
-            if (is_numeric) {
-                path.append("[").append(key).append("]");
-            } else {
-                path.append(".").append(key);
-            }
+void DataMessageConverter::parseNodes(const nlohmann::json &data, ConversionContext &context) {
+    const std::size_t mark = context.name.size();
+    if (data.is_object()) {
+        for (auto iterator = data.begin(); iterator != data.end(); ++iterator) {
+            appendKey(iterator.key(), context);
+            parseValue(iterator.value(), context);
+            context.name.resize(mark);
         }
-
-        if (value.is_object()) {
-            parseNodes(path, value, nodes, schema_collection);
-        } else if (value.is_array()) {
-            for (size_t i = 0; i < value.size(); ++i) {
-                std::string indexed_path = path + "[" + std::to_string(i) + "]";
-                const auto &element = value[i];
-
-                if (element.is_primitive()) {
-                    // Handle primitive values in the array
-                    std::string name = schema_collection;
-                    name.append(".").append(indexed_path);
-                    auto node_value = Helper::jsonToString(element);
-                    nodes.emplace_back(name, node_value, Metadata());
-                } else {
-                    // Recursively parse nested objects in the array
-                    parseNodes(indexed_path, value[i], nodes, schema_collection);
-                }
-            }
-        } else {
-            try {
-                std::string name = schema_collection;
-                name.append(".").append(path);
-                auto node_value = Helper::jsonToString(value);
-                nodes.emplace_back(name, node_value, Metadata());
-            } catch (const std::invalid_argument &e) {
-                std::cerr << "Failed to create node: " << e.what() << std::endl;
-            }
+    } else if (data.is_array()) {
+        char index[20];
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            const auto result = std::to_chars(std::begin(index), std::end(index), i);
+            appendKey(std::string_view(index, result.ptr - index), context);
+            parseValue(data[i], context);
+            context.name.resize(mark);
         }
+    } else {
+        // Leaf message
+        addNode(data, context);
     }
 }
 
 /**
- * @brief Includes metadata for a collection of nodes based on the provided
- * schema and metadata DTO.
+ * @brief Converts a JSON value at the current path into nodes.
  *
- * This function processes a vector of nodes and associates them with metadata
- * if available. If no metadata is provided, it creates nodes with default
- * metadata. For each node, it determines the appropriate metadata path and
- * retrieves the corresponding metadata, if it exists.
+ * Objects are parsed recursively, array elements get their index appended as `[i]`, and
+ * primitive values become nodes.
  *
- * @param schema_collection The schema collection name used to construct the
- * metadata path.
- * @param base_path The base path used in conjunction with the schema collection
- * to identify nodes.
- * @param metadata_dto An optional MetadataDTO containing metadata information
- * for the nodes.
- * @param nodes A vector of Node objects to which metadata will be added.
- * @return A vector of Node objects that includes metadata.
+ * @param value The JSON value to convert.
+ * @param context The conversion state holding the name buffer and the resulting nodes.
  */
-std::vector<Node> DataMessageConverter::includeMetadata(
-    const std::string &schema_collection, const std::string &base_path,
-    const std::optional<MetadataDTO> &metadata_dto, const std::vector<Node> &nodes) {
-    std::vector<Node> nodes_with_metadata;
-
-    for (const auto &node : nodes) {
-        if (!metadata_dto.has_value()) {
-            nodes_with_metadata.emplace_back(node.getName(), node.getValue(), Metadata());
-        } else {
-            std::string metadata_path =
-                normalizeMetadataPath(schema_collection, {base_path, node.getName()});
-            const auto &metadata = findMetadata(metadata_dto->nodes, metadata_path);
-            nodes_with_metadata.emplace_back(node.getName(), node.getValue(), metadata);
+void DataMessageConverter::parseValue(const nlohmann::json &value, ConversionContext &context) {
+    if (value.is_object()) {
+        parseNodes(value, context);
+    } else if (value.is_array()) {
+        const std::size_t mark = context.name.size();
+        char index[20];
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            const auto result = std::to_chars(std::begin(index), std::end(index), i);
+            context.name.push_back('[');
+            context.name.append(index, result.ptr).push_back(']');
+
+            const auto &element = value[i];
+            if (element.is_primitive()) {
+                addNode(element, context);
+            } else {
+                // Recursively parse nested objects in the array
+                parseNodes(element, context);
+            }
+            context.name.resize(mark);
         }
+    } else {
+        addNode(value, context);
     }
-
-    return nodes_with_metadata;
 }
+
 /**
- * @brief Normalizes the metadata path by removing the schema collection prefix
- * and any leading dots.
+ * @brief Appends a key to the path in the name buffer.
  *
- * This function takes a schema collection name and a MetadataPathComponents
- * object, constructs the metadata path, and removes the schema collection
- * prefix. It also handles leading dots and array indices in the path.
+ * Numeric keys are formatted as array indices (`[key]`), other keys are separated by a dot. The
+ * first key of an empty path is appended as is, and empty keys leave the path unchanged.
  *
- * @param schema_collection The schema collection name used to construct the
- * metadata path.
- * @param components The MetadataPathComponents object containing base path and
- * node name.
- * @return A normalized metadata path as a string.
+ * @param key The key to append.
+ * @param context The conversion state holding the name buffer.
  */
+void DataMessageConverter::appendKey(std::string_view key, ConversionContext &context) {
+    if (key.empty()) {
+        return;
+    }
+    if (context.name.size() == context.path_offset) {
+        context.name.append(key);
+        return;
+    }
+    const bool is_numeric =
+        std::all_of(key.begin(), key.end(), [](unsigned char c) { return std::isdigit(c); });
+    if (is_numeric) {
+        context.name.append("[").append(key).append("]");
+    } else {
+        context.name.append(".").append(key);
+    }
+}
 
-std::string DataMessageConverter::normalizeMetadataPath(const std::string &schema_collection,
-                                                        const MetadataPathComponents &components) {
-    std::string prefix_to_remove = schema_collection + "." + components.base_path;
-    std::string metadata_path = (components.node_name != prefix_to_remove)
-                                    ? components.node_name.substr(prefix_to_remove.size())
-                                    : "";
+/**
+ * @brief Creates a node for a primitive value named after the current path, with its metadata.
+ *
+ * @param value The primitive JSON value.
+ * @param context The conversion state holding the name buffer and the resulting nodes.
+ */
+void DataMessageConverter::addNode(const nlohmann::json &value, ConversionContext &context) {
+    try {
+        const SignalId signal_id = context.signal_catalog != nullptr
+                                       ? context.signal_catalog->find(context.name)
+                                       : SignalCatalog::UNKNOWN_SIGNAL;
+        context.nodes.emplace_back(std::string(context.name), ConverterHelper::toNodeValue(value),
+                                   resolveMetadata(context), signal_id);
+    } catch (const std::invalid_argument &e) {
+        LOG_WARN("Failed to create node: " << e.what());
+    }
+}
 
-    if (!metadata_path.empty() && metadata_path[0] == '.') {
-        metadata_path = metadata_path.substr(1);
+/**
+ * @brief Resolves the metadata of the node whose name is in the name buffer.
+ *
+ * The metadata path is the part of the name after the requested base path, without leading dot
+ * and without array indices. Consecutive nodes with the same metadata path (e.g. the elements of
+ * an array) share the lookup.
+ *
+ * @param context The conversion state holding the name buffer and the metadata DTO.
+ * @return The metadata of the node, or default metadata if the message has none.
+ */
+const Metadata &DataMessageConverter::resolveMetadata(ConversionContext &context) {
+    if (context.metadata_dto == nullptr) {
+        if (!context.metadata) {
+            context.metadata.emplace();
+        }
+        return *context.metadata;
     }
 
-    auto pos = metadata_path.find('[');
-    if (pos != std::string::npos) {
-        metadata_path = metadata_path.substr(0, pos);
+    std::string_view metadata_path = std::string_view(context.name);
+    metadata_path.remove_prefix(std::min(context.metadata_offset, metadata_path.size()));
+    if (!metadata_path.empty() && metadata_path.front() == '.') {
+        metadata_path.remove_prefix(1);
     }
+    metadata_path = metadata_path.substr(0, metadata_path.find('['));
 
-    return metadata_path;
+    if (!context.metadata || metadata_path != context.metadata_key) {
+        context.metadata_key.assign(metadata_path);
+        context.metadata = findMetadata(context.metadata_dto->nodes, context.metadata_key);
+    }
+    return *context.metadata;
 }
 
 /**
@@ -1,31 +1,55 @@
 #ifndef DATA_MESSAGE_CONVERTER_H
 #define DATA_MESSAGE_CONVERTER_H
 
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 #include "data_message.h"
 #include "data_message_dto.h"
 #include "request_registry.h"
-
-struct MetadataPathComponents {
-    std::string base_path;
-    std::string node_name;
-};
+#include "signal_catalog.h"
 
 class DataMessageConverter {
    public:
-    static DataMessage convert(const DataMessageDTO &dto, RequestRegistry &registry);
+    static DataMessage convert(
+        const DataMessageDTO &dto, RequestRegistry &registry,
+        const SignalCatalog *signal_catalog = nullptr,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
    private:
-    static void parseNodes(const std::string &base_path, const nlohmann::json &data,
-                           std::vector<Node> &nodes, const std::string &schema_collection);
-    static std::vector<Node> includeMetadata(const std::string &schema_collection,
-                                             const std::string &base_path,
-                                             const std::optional<MetadataDTO> &metadata_dto,
-                                             const std::vector<Node> &nodes);
-    static std::string normalizeMetadataPath(const std::string &schema_collection,
-                                             const MetadataPathComponents &components);
+    /**
+     * @brief State shared while walking the data of one message.
+     */
+    struct ConversionContext {
+        explicit ConversionContext(std::pmr::memory_resource *resource) : name(resource) {}
+
+        // Full node name being built: "<schema>.<path>", allocated from the message resource
+        std::pmr::string name;
+        // Offset in `name` where the path starts and where it leaves the requested base path
+        std::size_t path_offset = 0;
+        std::size_t metadata_offset = 0;
+        const MetadataDTO *metadata_dto = nullptr;
+        const SignalCatalog *signal_catalog = nullptr;
+        // Metadata of the last looked up metadata path, reused by consecutive nodes
+        std::string metadata_key;
+        std::optional<Metadata> metadata;
+        std::vector<Node> nodes;
+    };
+
+    static std::size_t countLeaves(const nlohmann::json &data);
+    static void parseNodes(const nlohmann::json &data, ConversionContext &context);
+    static void parseValue(const nlohmann::json &value, ConversionContext &context);
+    static void appendKey(std::string_view key, ConversionContext &context);
+    static void addNode(const nlohmann::json &value, ConversionContext &context);
+    static const Metadata &resolveMetadata(ConversionContext &context);
     static Metadata findMetadata(
         const std::unordered_map<std::string, MetadataDTO::NodeMetadata> &nodes,
         const std::string &metadata_path);
 };
 
-#endif  // DATA_MESSAGE_CONVERTER_H
\ No newline at end of file
+#endif  // DATA_MESSAGE_CONVERTER_H
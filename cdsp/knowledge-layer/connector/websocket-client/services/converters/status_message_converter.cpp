@@ -1,8 +1,7 @@
 #include "status_message_converter.h"
 
-#include <iostream>
-
 #include "error.h"
+#include "logger.h"
 /**
  * Converts a StatusMessageDTO to a StatusMessage.
  *
@@ -21,7 +20,7 @@ StatusMessage StatusMessageConverter::convert(const StatusMessageDTO &dto,
     // Check if the message belongs to the request registry
     auto request_registry = registry.getRequest(dto.id);
 
-    if (!request_registry.has_value()) {
+    if (request_registry == nullptr) {
         throw std::invalid_argument("Registry not found for the ID: " + std::to_string(dto.id));
     }
 
@@ -32,7 +31,7 @@ StatusMessage StatusMessageConverter::convert(const StatusMessageDTO &dto,
         if (!dto.error->data.empty()) {
             data = dto.error->data;
         }
-        error = Error(dto.error->code, dto.error->message, data);
+        error = Error(dto.error->code, dto.error->message, std::move(data));
     }
 
     if (request_registry->type != RequestInfo::Type::SUBSCRIBE) {
@@ -43,14 +42,13 @@ StatusMessage StatusMessageConverter::convert(const StatusMessageDTO &dto,
             if (subscribe_identifier.has_value()) {
                 registry.removeRequest(*subscribe_identifier);
             } else {
-                std::cout
-                    << "Info: No matching subscribe request found for unsubscribe message ID: "
-                    << dto.id << std::endl;
+                LOG_INFO("No matching subscribe request found for unsubscribe message ID: "
+                         << dto.id);
             }
         }
         // Remove the request from the registry after processing
         registry.removeRequest(dto.id);
     }
 
-    return {dto.id, error};
+    return {dto.id, std::move(error)};
 }
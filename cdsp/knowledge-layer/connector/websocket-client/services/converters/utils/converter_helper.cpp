@@ -1,6 +1,8 @@
 #include "converter_helper.h"
 
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 #include "helper.h"
 
@@ -28,4 +30,46 @@ std::optional<std::chrono::system_clock::time_point> ConverterHelper::parseTimes
         std::cerr << "Failed to parse timestamp: " << e.what() << std::endl;
         return std::nullopt;
     }
-}
\ No newline at end of file
+}
+/**
+ * @brief Converts a primitive JSON value to a typed node value.
+ *
+ * Strings, booleans and numbers keep their type. Unsigned integers that do not fit into a signed
+ * 64-bit integer are stored as doubles.
+ *
+ * @param value The JSON value to convert.
+ * @return The typed node value.
+ * @throws std::runtime_error If the JSON value is null, an object or an array.
+ */
+NodeValue ConverterHelper::toNodeValue(const nlohmann::json& value) {
+    switch (value.type()) {
+        case nlohmann::json::value_t::string:
+            return value.get<std::string>();
+        case nlohmann::json::value_t::boolean:
+            return value.get<bool>();
+        case nlohmann::json::value_t::number_integer:
+            return value.get<std::int64_t>();
+        case nlohmann::json::value_t::number_unsigned: {
+            const auto unsigned_value = value.get<std::uint64_t>();
+            if (unsigned_value <=
+                static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                return static_cast<std::int64_t>(unsigned_value);
+            }
+            return static_cast<double>(unsigned_value);
+        }
+        case nlohmann::json::value_t::number_float:
+            return value.get<double>();
+        default:
+            throw std::runtime_error("The message contains a node with an unsupported value.");
+    }
+}
+
+/**
+ * @brief Converts a typed node value to the JSON value of the same type.
+ *
+ * @param value The node value to convert.
+ * @return The JSON value.
+ */
+nlohmann::json ConverterHelper::toJson(const NodeValue& value) {
+    return std::visit([](const auto& typed_value) { return nlohmann::json(typed_value); }, value);
+}
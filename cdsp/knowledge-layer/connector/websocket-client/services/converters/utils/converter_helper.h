@@ -5,10 +5,14 @@
 #include <optional>
 #include <string>
 
+#include "node_value.h"
+
 class ConverterHelper {
    public:
     static std::optional<std::chrono::system_clock::time_point> parseTimestamp(int64_t seconds,
                                                                                int64_t nanos);
+    static NodeValue toNodeValue(const nlohmann::json& value);
+    static nlohmann::json toJson(const NodeValue& value);
 };
 
 #endif
\ No newline at end of file
@@ -1,151 +1,19 @@
 #include "dto_service.h"
 
-#include <iostream>
-
-#include "helper.h"
-#include "metadata_dto.h"
+#include "json_rpc_message_parser.h"
 
 /**
- * Parses a JSON object into a DataMessageDTO object.
+ * Parses a raw JSON-RPC message into a DataMessageDTO or a StatusMessageDTO.
  *
- * @param json The JSON object to parse, expected to contain keys: "type",
- * "schema", "instance", and optionally "path", "metadata", and "requestId".
- * @return A DataMessageDTO object populated with data extracted from the JSON
- * object.
- */
-DataMessageDTO DtoService::parseDataJsonToDto(const nlohmann::json& json) {
-    try {
-        if (!json.contains("id")) {
-            throw std::invalid_argument("Missing required id field in DataMessageDTO");
-        }
-
-        if (!json["result"].contains("data")) {
-            throw std::invalid_argument("Missing required result data field in DataMessageDTO");
-        }
-
-        DataMessageDTO dto;
-        dto.id = json["id"].get<int>();
-        dto.data = json["result"]["data"].get<nlohmann::json>();
-        dto.metadata =
-            json["result"].contains("metadata")
-                ? std::optional<MetadataDTO>(parseMetadataJsonToDto(json["result"]["metadata"]))
-                : std::nullopt;
-        return dto;
-    } catch (const nlohmann::json::exception& e) {
-        throw std::invalid_argument("Failed to parse DataMessageDTO: " + std::string(e.what()));
-    }
-}
-
-/**
- * Parses a JSON object into a StatusMessageDTO.
+ * The message is parsed in a single SAX pass (see JsonRpcMessageParser), so no DOM is built for
+ * the message and the DTO fields are filled directly from the input.
  *
- * @param json The JSON object containing the status message data.
- * @return A StatusMessageDTO object populated with data from the JSON object.
+ * @param message The raw JSON-RPC message.
+ * @return A std::variant containing either a DataMessageDTO or a StatusMessageDTO.
  */
-StatusMessageDTO DtoService::parseStatusJsonToDto(const nlohmann::json& json) {
-    try {
-        StatusMessageDTO dto;
-        dto.id = json["id"];
-        if (json.contains("error")) {
-            StatusMessageErrorDTO error;
-
-            if (json.contains("error") && json["error"].contains("code")) {
-                error.code = json["error"]["code"].get<int>();
-            }
-
-            if (json["error"].contains("message")) {
-                error.message = json["error"]["message"].get<std::string>();
-            }
-
-            if (json["error"].contains("data")) {
-                error.data = json["error"]["data"].get<nlohmann::json>();
-            } else {
-                error.data = "";
-            }
-            dto.error = error;
-        } else if (json.contains("result")) {
-            dto.error = std::nullopt;
-        } else {
-            throw std::invalid_argument(
-                "Invalid StatusMessageDTO: missing error or "
-                "result field");
-        }
-
-        return dto;
-    } catch (const std::exception& e) {
-        std::cout << Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true)
-                  << " Status message received:\n"
-                  << json.dump() << std::endl
-                  << std::endl;
-        std::cerr << " Failed to parse StatusMessageDTO: " << e.what() << std::endl;
-        return {};
-    }
-}
-
-/**
- * Parses a JSON object containing timestamps into a MetadataDTO object.
- *
- * @param metadata_json The JSON object containing the metadata data.
- * @return A MetadataDTO object populated with data from the JSON object.
- */
-MetadataDTO DtoService::parseMetadataJsonToDto(const nlohmann::json& metadata_json) {
-    MetadataDTO dto;
-    try {
-        // Helper lambda to parse timestamp data
-        auto parseTimestamp = [](const nlohmann::json& timestamp_json,
-                                 const std::string& timestamp_type) -> MetadataDTO::Timestamp {
-            if (!timestamp_json.contains("seconds")) {
-                throw std::invalid_argument("Missing required seconds field into " +
-                                            timestamp_type + " timestamp in MetadataDTO");
-            }
-
-            MetadataDTO::Timestamp timestamp;
-            timestamp.seconds = timestamp_json["seconds"].get<int64_t>();
-
-            if (timestamp_json.contains("nanos")) {
-                timestamp.nanos = timestamp_json["nanos"].get<int64_t>();
-            }
-
-            return timestamp;
-        };
-
-        // Helper lambda to parse confidence data
-        auto parseConfidence =
-            [](const nlohmann::json& confidence_json) -> MetadataDTO::Confidence {
-            if (!confidence_json.contains("type") || !confidence_json.contains("value")) {
-                throw std::invalid_argument("Missing required confidence fields in MetadataDTO");
-            }
-
-            return MetadataDTO::Confidence{confidence_json["type"].get<std::string>(),
-                                           confidence_json["value"].get<int>()};
-        };
-
-        for (const auto& [node, metadata] : metadata_json.items()) {
-            MetadataDTO::NodeMetadata node_metadata;
-
-            // Parse received timestamps
-            if (metadata.contains("timestamps") && metadata["timestamps"].contains("received")) {
-                node_metadata.received =
-                    parseTimestamp(metadata["timestamps"]["received"], "received");
-            }
-
-            // Parse generated timestamps
-            if (metadata.contains("timestamps") && metadata["timestamps"].contains("generated")) {
-                node_metadata.generated =
-                    parseTimestamp(metadata["timestamps"]["generated"], "generated");
-            }
-
-            // Parse confidence
-            if (metadata.contains("confidence")) {
-                node_metadata.confidence = parseConfidence(metadata["confidence"]);
-            }
-
-            dto.nodes[node] = node_metadata;
-        }
-        return dto;
-    } catch (const nlohmann::json::exception& e) {
-        throw std::invalid_argument("Failed to parse MetadataDTO: " + std::string(e.what()));
-    }
+std::variant<DataMessageDTO, StatusMessageDTO> DtoService::parseJsonRpcMessageToDto(
+    std::string_view message) {
+    return JsonRpcMessageParser::parse(message);
 }
 
 /**
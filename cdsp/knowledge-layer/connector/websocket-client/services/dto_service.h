@@ -2,6 +2,8 @@
 #define DTO_SERVICE_H
 
 #include <nlohmann/json.hpp>
+#include <string_view>
+#include <variant>
 
 #include "data_message_dto.h"
 #include "model_config_dto.h"
@@ -9,13 +11,11 @@
 
 class DtoService {
    public:
-    static DataMessageDTO parseDataJsonToDto(const nlohmann::json& json);
-    static StatusMessageDTO parseStatusJsonToDto(const nlohmann::json& json);
+    static std::variant<DataMessageDTO, StatusMessageDTO> parseJsonRpcMessageToDto(
+        std::string_view message);
     static ModelConfigDTO parseModelConfigJsonToDto(const nlohmann::json& json);
 
    private:
-    static MetadataDTO parseMetadataJsonToDto(const nlohmann::json& metadata_json);
-
     static ReasonerSettingsDTO parseReasonerSettingsJsonToDto(
         const nlohmann::json& reasoner_settings_json);
 };
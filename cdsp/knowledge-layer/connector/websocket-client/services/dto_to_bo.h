@@ -17,8 +17,11 @@ class DtoToBo {
     explicit DtoToBo(std::shared_ptr<IFileHandler> file_handler = nullptr)
         : file_handler_(std::move(file_handler)) {}
 
-    static DataMessage convert(const DataMessageDTO &dto, RequestRegistry &registry) {
-        return DataMessageConverter::convert(dto, registry);
+    static DataMessage convert(
+        const DataMessageDTO &dto, RequestRegistry &registry,
+        const SignalCatalog *signal_catalog = nullptr,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+        return DataMessageConverter::convert(dto, registry, signal_catalog, resource);
     }
     static StatusMessage convert(const StatusMessageDTO &dto, RequestRegistry &registry) {
         return StatusMessageConverter::convert(dto, registry);
@@ -0,0 +1,362 @@
+#include "json_rpc_message_parser.h"
+
+#include <stdexcept>
+
+#include "globals.h"
+
+namespace {
+constexpr std::string_view ANY_KEY = "*";
+
+/**
+ * @brief Converts a scalar JSON value into a number, rejecting non-numeric values.
+ *
+ * @param value The JSON value to convert.
+ * @param field The name of the field, used in the error message.
+ * @return The numeric value.
+ * @throws std::invalid_argument if the value is not a number.
+ */
+template <typename T>
+T toNumber(const nlohmann::json& value, const std::string& field) {
+    if (!value.is_number()) {
+        throw std::invalid_argument("Expected a number for the " + field + " field, got: " +
+                                    value.dump());
+    }
+    return value.get<T>();
+}
+
+/**
+ * @brief Converts a scalar JSON value into a string, rejecting non-string values.
+ *
+ * @param value The JSON value to convert.
+ * @param field The name of the field, used in the error message.
+ * @return The string value.
+ * @throws std::invalid_argument if the value is not a string.
+ */
+std::string toString(nlohmann::json&& value, const std::string& field) {
+    if (!value.is_string()) {
+        throw std::invalid_argument("Expected a string for the " + field + " field, got: " +
+                                    value.dump());
+    }
+    return std::move(value.get_ref<std::string&>());
+}
+}  // namespace
+
+/**
+ * @brief Parses a JSON-RPC message in a single pass into a DataMessageDTO or a StatusMessageDTO.
+ *
+ * A message with a non-empty `result` is a data message, a message with an `error` or an empty
+ * `result` is a status message.
+ *
+ * @param message The raw JSON-RPC message, e.g. a view on the WebSocket receive buffer.
+ * @return A std::variant containing either a DataMessageDTO or a StatusMessageDTO.
+ * @throws std::invalid_argument If the message is not valid JSON, has an invalid JSON-RPC
+ * version or misses required fields.
+ * @throws std::runtime_error If the message is neither a data nor a status message.
+ */
+std::variant<DataMessageDTO, StatusMessageDTO> JsonRpcMessageParser::parse(
+    std::string_view message) {
+    JsonRpcMessageParser parser;
+    nlohmann::json::sax_parse(message.begin(), message.end(), &parser);
+    return parser.release();
+}
+
+bool JsonRpcMessageParser::null() { return onScalar(nlohmann::json()); }
+
+bool JsonRpcMessageParser::boolean(bool value) { return onScalar(nlohmann::json(value)); }
+
+bool JsonRpcMessageParser::number_integer(number_integer_t value) {
+    return onScalar(nlohmann::json(value));
+}
+
+bool JsonRpcMessageParser::number_unsigned(number_unsigned_t value) {
+    return onScalar(nlohmann::json(value));
+}
+
+bool JsonRpcMessageParser::number_float(number_float_t value, const string_t& /*raw*/) {
+    return onScalar(nlohmann::json(value));
+}
+
+bool JsonRpcMessageParser::string(string_t& value) {
+    return onScalar(nlohmann::json(std::move(value)));
+}
+
+bool JsonRpcMessageParser::binary(binary_t& value) {
+    return onScalar(nlohmann::json::binary(std::move(value)));
+}
+
+bool JsonRpcMessageParser::start_object(std::size_t /*elements*/) {
+    return onContainerStart(false);
+}
+
+bool JsonRpcMessageParser::key(string_t& value) {
+    current_key_ = std::move(value);
+    return true;
+}
+
+bool JsonRpcMessageParser::end_object() { return onContainerEnd(); }
+
+bool JsonRpcMessageParser::start_array(std::size_t /*elements*/) { return onContainerStart(true); }
+
+bool JsonRpcMessageParser::end_array() { return onContainerEnd(); }
+
+bool JsonRpcMessageParser::parse_error(std::size_t /*position*/, const std::string& /*last_token*/,
+                                       const nlohmann::detail::exception& ex) {
+    throw std::invalid_argument(ex.what());
+}
+
+/**
+ * @brief Returns the key of the current element within its enclosing container.
+ */
+std::string_view JsonRpcMessageParser::elementKey() const {
+    if (!container_is_array_.empty() && container_is_array_.back()) {
+        return ARRAY_ELEMENT;
+    }
+    return current_key_;
+}
+
+/**
+ * @brief Checks whether the current element is located at the given path.
+ *
+ * @param keys The keys from the root object to the element, `*` matches any key.
+ */
+bool JsonRpcMessageParser::isAt(std::initializer_list<std::string_view> keys) const {
+    if (keys.size() != path_.size() + 1) {
+        return false;
+    }
+    auto key = keys.begin();
+    for (const auto& segment : path_) {
+        if (*key != ANY_KEY && *key != segment) {
+            return false;
+        }
+        ++key;
+    }
+    return *key == ANY_KEY || *key == elementKey();
+}
+
+/**
+ * @brief Checks whether the container being closed is located at the given path.
+ *
+ * @param keys The keys from the root object to the container, `*` matches any key.
+ */
+bool JsonRpcMessageParser::isClosing(std::initializer_list<std::string_view> keys) const {
+    if (keys.size() != path_.size()) {
+        return false;
+    }
+    auto key = keys.begin();
+    for (const auto& segment : path_) {
+        if (*key != ANY_KEY && *key != segment) {
+            return false;
+        }
+        ++key;
+    }
+    return true;
+}
+
+/**
+ * @brief Adds a scalar to the free-form subtree currently being captured.
+ */
+bool JsonRpcMessageParser::captureValue(nlohmann::json&& value) {
+    auto* parent = capture_stack_.back();
+    if (parent->is_array()) {
+        parent->push_back(std::move(value));
+    } else {
+        (*parent)[current_key_] = std::move(value);
+    }
+    return true;
+}
+
+/**
+ * @brief Opens a nested container in the free-form subtree currently being captured.
+ */
+bool JsonRpcMessageParser::captureContainer(nlohmann::json&& container) {
+    auto* parent = capture_stack_.back();
+    if (parent->is_array()) {
+        parent->push_back(std::move(container));
+        capture_stack_.push_back(&parent->back());
+    } else {
+        auto& child = (*parent)[current_key_];
+        child = std::move(container);
+        capture_stack_.push_back(&child);
+    }
+    return true;
+}
+
+/**
+ * @brief Routes a scalar value to the DTO field located at the current path.
+ */
+bool JsonRpcMessageParser::onScalar(nlohmann::json&& value) {
+    if (!capture_stack_.empty()) {
+        return captureValue(std::move(value));
+    }
+    if (container_is_array_.empty()) {
+        throw std::invalid_argument("JSON-RPC message must be an object");
+    }
+    if (path_.size() == 1 && path_.front() == "result") {
+        result_empty_ = false;
+    }
+
+    if (path_.empty()) {
+        if (isAt({"jsonrpc"})) {
+            jsonrpc_ = value.is_string() ? value.get<std::string>() : value.dump();
+        } else if (isAt({"id"})) {
+            id_ = toNumber<int>(value, "id");
+        } else if (isAt({"result"})) {
+            has_result_ = true;
+            result_empty_ = value.is_null();
+        } else if (isAt({"error"})) {
+            has_error_ = true;
+        }
+    } else if (isAt({"result", "data"})) {
+        has_result_data_ = true;
+        data_ = std::move(value);
+    } else if (isAt({"error", "code"})) {
+        error_.code = toNumber<int>(value, "error code");
+    } else if (isAt({"error", "message"})) {
+        error_.message = toString(std::move(value), "error message");
+    } else if (isAt({"error", "data"})) {
+        error_.data = std::move(value);
+    } else if (current_node_metadata_ != nullptr) {
+        if (isAt({"result", "metadata", ANY_KEY, "timestamps", "received", "seconds"})) {
+            current_node_metadata_->received.seconds = toNumber<int64_t>(value, "seconds");
+            timestamp_has_seconds_ = true;
+        } else if (isAt({"result", "metadata", ANY_KEY, "timestamps", "received", "nanos"})) {
+            current_node_metadata_->received.nanos = toNumber<int64_t>(value, "nanos");
+        } else if (isAt({"result", "metadata", ANY_KEY, "timestamps", "generated", "seconds"})) {
+            current_node_metadata_->generated.seconds = toNumber<int64_t>(value, "seconds");
+            timestamp_has_seconds_ = true;
+        } else if (isAt({"result", "metadata", ANY_KEY, "timestamps", "generated", "nanos"})) {
+            current_node_metadata_->generated.nanos = toNumber<int64_t>(value, "nanos");
+        } else if (isAt({"result", "metadata", ANY_KEY, "confidence", "type"})) {
+            current_node_metadata_->confidence->type =
+                toString(std::move(value), "confidence type");
+            confidence_has_type_ = true;
+        } else if (isAt({"result", "metadata", ANY_KEY, "confidence", "value"})) {
+            current_node_metadata_->confidence->value = toNumber<int>(value, "confidence value");
+            confidence_has_value_ = true;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Handles the start of an object or array.
+ *
+ * Starts capturing `result.data` and `error.data`, and prepares the metadata entry of a node
+ * when its object is entered.
+ */
+bool JsonRpcMessageParser::onContainerStart(bool is_array) {
+    if (!capture_stack_.empty()) {
+        return captureContainer(is_array ? nlohmann::json::array() : nlohmann::json::object());
+    }
+    if (container_is_array_.empty()) {
+        if (is_array) {
+            throw std::invalid_argument("JSON-RPC message must be an object");
+        }
+        container_is_array_.push_back(false);
+        return true;
+    }
+    if (path_.size() == 1 && path_.front() == "result") {
+        result_empty_ = false;
+    }
+
+    const auto container = is_array ? nlohmann::json::array() : nlohmann::json::object();
+    if (isAt({"result", "data"})) {
+        has_result_data_ = true;
+        data_ = container;
+        capture_stack_.push_back(&data_);
+        return true;
+    }
+    if (isAt({"error", "data"})) {
+        error_.data = container;
+        capture_stack_.push_back(&error_.data);
+        return true;
+    }
+
+    if (isAt({"result"})) {
+        has_result_ = true;
+        result_empty_ = true;
+    } else if (isAt({"error"})) {
+        has_error_ = true;
+    } else if (!is_array && isAt({"result", "metadata"})) {
+        metadata_.emplace();
+    } else if (!is_array && metadata_ && isAt({"result", "metadata", ANY_KEY})) {
+        current_node_metadata_ = &metadata_->nodes[current_key_];
+    } else if (current_node_metadata_ != nullptr) {
+        if (isAt({"result", "metadata", ANY_KEY, "timestamps", "received"}) ||
+            isAt({"result", "metadata", ANY_KEY, "timestamps", "generated"})) {
+            timestamp_has_seconds_ = false;
+        } else if (isAt({"result", "metadata", ANY_KEY, "confidence"})) {
+            current_node_metadata_->confidence.emplace();
+            confidence_has_type_ = false;
+            confidence_has_value_ = false;
+        }
+    }
+
+    path_.emplace_back(elementKey());
+    container_is_array_.push_back(is_array);
+    return true;
+}
+
+/**
+ * @brief Handles the end of an object or array and validates completed metadata entries.
+ */
+bool JsonRpcMessageParser::onContainerEnd() {
+    if (!capture_stack_.empty()) {
+        capture_stack_.pop_back();
+        return true;
+    }
+
+    if (current_node_metadata_ != nullptr) {
+        if (isClosing({"result", "metadata", ANY_KEY, "timestamps", ANY_KEY}) &&
+            (path_.back() == "received" || path_.back() == "generated") &&
+            !timestamp_has_seconds_) {
+            throw std::invalid_argument("Missing required seconds field into " + path_.back() +
+                                        " timestamp in MetadataDTO");
+        }
+        if (isClosing({"result", "metadata", ANY_KEY, "confidence"}) &&
+            (!confidence_has_type_ || !confidence_has_value_)) {
+            throw std::invalid_argument("Missing required confidence fields in MetadataDTO");
+        }
+        if (isClosing({"result", "metadata", ANY_KEY})) {
+            current_node_metadata_ = nullptr;
+        }
+    }
+
+    if (!path_.empty()) {
+        path_.pop_back();
+    }
+    container_is_array_.pop_back();
+    return true;
+}
+
+/**
+ * @brief Validates the parsed fields and moves them into the resulting DTO.
+ */
+std::variant<DataMessageDTO, StatusMessageDTO> JsonRpcMessageParser::release() {
+    if (!jsonrpc_.has_value() || *jsonrpc_ != getJsonRpcVersion()) {
+        throw std::invalid_argument("Invalid JSON-RPC version");
+    }
+
+    if (has_result_ && !result_empty_) {
+        if (!id_.has_value()) {
+            throw std::invalid_argument("Missing required id field in DataMessageDTO");
+        }
+        if (!has_result_data_) {
+            throw std::invalid_argument("Missing required result data field in DataMessageDTO");
+        }
+        return DataMessageDTO{*id_, std::move(data_), std::move(metadata_)};
+    }
+
+    if (has_error_ || has_result_) {
+        if (!id_.has_value()) {
+            throw std::invalid_argument("Missing required id field in StatusMessageDTO");
+        }
+        StatusMessageDTO dto{*id_, std::nullopt};
+        if (has_error_) {
+            dto.error = std::move(error_);
+        }
+        return dto;
+    }
+
+    throw std::runtime_error("The incoming message is neither a data nor a status message");
+}
@@ -0,0 +1,82 @@
+#ifndef JSON_RPC_MESSAGE_PARSER_H
+#define JSON_RPC_MESSAGE_PARSER_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "data_message_dto.h"
+#include "status_message_dto.h"
+
+/**
+ * @brief Single-pass SAX parser for incoming JSON-RPC messages.
+ *
+ * Reads a JSON-RPC response straight into a DataMessageDTO or a StatusMessageDTO without building
+ * a DOM for the whole message. Only the free-form subtrees (`result.data` and `error.data`) are
+ * materialized as JSON values, and they are moved into the DTO. Metadata, identifiers and error
+ * fields are written directly into the DTO fields while parsing.
+ */
+class JsonRpcMessageParser : public nlohmann::json_sax<nlohmann::json> {
+   public:
+    static std::variant<DataMessageDTO, StatusMessageDTO> parse(std::string_view message);
+
+    bool null() override;
+    bool boolean(bool value) override;
+    bool number_integer(number_integer_t value) override;
+    bool number_unsigned(number_unsigned_t value) override;
+    bool number_float(number_float_t value, const string_t& raw) override;
+    bool string(string_t& value) override;
+    bool binary(binary_t& value) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& value) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& last_token,
+                     const nlohmann::detail::exception& ex) override;
+
+   private:
+    // Marker used as key for array elements in the path.
+    static constexpr std::string_view ARRAY_ELEMENT = "[]";
+
+    // Keys of the enclosing containers below the root object, and the container kinds.
+    std::vector<std::string> path_;
+    std::vector<bool> container_is_array_;
+    std::string current_key_;
+
+    // Open containers of the free-form subtree currently being captured.
+    std::vector<nlohmann::json*> capture_stack_;
+
+    std::optional<std::string> jsonrpc_;
+    std::optional<int> id_;
+    bool has_result_ = false;
+    bool result_empty_ = true;
+    bool has_result_data_ = false;
+    bool has_error_ = false;
+
+    nlohmann::json data_;
+    std::optional<MetadataDTO> metadata_;
+    StatusMessageErrorDTO error_{0, "", ""};
+
+    MetadataDTO::NodeMetadata* current_node_metadata_ = nullptr;
+    bool timestamp_has_seconds_ = false;
+    bool confidence_has_type_ = false;
+    bool confidence_has_value_ = false;
+
+    std::string_view elementKey() const;
+    bool isAt(std::initializer_list<std::string_view> keys) const;
+    bool isClosing(std::initializer_list<std::string_view> keys) const;
+    bool captureValue(nlohmann::json&& value);
+    bool captureContainer(nlohmann::json&& container);
+    bool onScalar(nlohmann::json&& value);
+    bool onContainerStart(bool is_array);
+    bool onContainerEnd();
+    std::variant<DataMessageDTO, StatusMessageDTO> release();
+};
+
+#endif  // JSON_RPC_MESSAGE_PARSER_H
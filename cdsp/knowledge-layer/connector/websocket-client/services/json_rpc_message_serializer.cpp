@@ -0,0 +1,344 @@
+#include "json_rpc_message_serializer.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "globals.h"
+
+namespace {
+/**
+ * @brief Appends an arithmetic value using std::to_chars (shortest round-trip for floats).
+ */
+template <typename T>
+void appendNumber(std::string& out, T value) {
+    std::array<char, 32> buffer{};
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    out.append(buffer.data(), result.ptr);
+}
+
+/**
+ * @brief Checks whether a later data item has the same name, so that its value wins like in a
+ * JSON object built by assignment. Data lists are short, a scan is cheaper than a set.
+ */
+bool isOverriddenLater(const std::vector<DataDTO>& data, std::size_t index) {
+    for (std::size_t later = index + 1; later < data.size(); ++later) {
+        if (data[later].name == data[index].name) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+/**
+ * @brief Serializes a GetMessageDTO into its JSON-RPC representation.
+ *
+ * @param dto The DTO to serialize.
+ * @param out The buffer the JSON text is appended to.
+ */
+void JsonRpcMessageSerializer::serialize(const GetMessageDTO& dto, std::string& out) {
+    appendHeader(out, "get", dto.id);
+    appendMember(out, "schema", dto.schema);
+    out += ',';
+    appendMember(out, "instance", dto.instance);
+    appendOptionalMember(out, "path", dto.path);
+    appendOptionalMember(out, "format", dto.format);
+    appendOptionalMember(out, "root", dto.root);
+    out += "}}";
+}
+
+/**
+ * @brief Serializes a SetMessageDTO, including its data and metadata, into its JSON-RPC
+ * representation.
+ *
+ * Data items with the same name are written once, with the value of the last one.
+ *
+ * @param dto The DTO to serialize.
+ * @param out The buffer the JSON text is appended to.
+ */
+void JsonRpcMessageSerializer::serialize(const SetMessageDTO& dto, std::string& out) {
+    appendHeader(out, "set", dto.id);
+    appendMember(out, "schema", dto.schema);
+    out += ',';
+    appendMember(out, "instance", dto.instance);
+    appendOptionalMember(out, "path", dto.path);
+
+    out += ",\"data\":{";
+    bool first = true;
+    for (std::size_t index = 0; index < dto.data.size(); ++index) {
+        if (isOverriddenLater(dto.data, index)) {
+            continue;
+        }
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        appendString(out, dto.data[index].name);
+        out += ':';
+        appendValue(out, dto.data[index].value);
+    }
+    out += "},\"metadata\":";
+    appendMetadata(out, dto.metadata);
+    out += "}}";
+}
+
+/**
+ * @brief Serializes a SubscribeMessageDTO into its JSON-RPC representation.
+ *
+ * @param dto The DTO to serialize.
+ * @param out The buffer the JSON text is appended to.
+ */
+void JsonRpcMessageSerializer::serialize(const SubscribeMessageDTO& dto, std::string& out) {
+    appendHeader(out, "subscribe", dto.id);
+    appendMember(out, "schema", dto.schema);
+    out += ',';
+    appendMember(out, "instance", dto.instance);
+    appendOptionalMember(out, "path", dto.path);
+    appendOptionalMember(out, "format", dto.format);
+    appendOptionalMember(out, "root", dto.root);
+    out += "}}";
+}
+
+/**
+ * @brief Serializes an UnsubscribeMessageDTO into its JSON-RPC representation.
+ *
+ * @param dto The DTO to serialize.
+ * @param out The buffer the JSON text is appended to.
+ */
+void JsonRpcMessageSerializer::serialize(const UnsubscribeMessageDTO& dto, std::string& out) {
+    appendHeader(out, "unsubscribe", dto.id);
+    appendMember(out, "schema", dto.schema);
+    out += ',';
+    appendMember(out, "instance", dto.instance);
+    appendOptionalMember(out, "path", dto.path);
+    out += "}}";
+}
+
+/**
+ * @brief Appends a JSON string literal, escaping quotes, backslashes and control characters.
+ *
+ * @param out The output buffer.
+ * @param value The raw string value.
+ */
+void JsonRpcMessageSerializer::appendString(std::string& out, std::string_view value) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    out += '"';
+    for (const char character : value) {
+        switch (character) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    out += "\\u00";
+                    out += HEX_DIGITS[(character >> 4) & 0x0F];
+                    out += HEX_DIGITS[character & 0x0F];
+                } else {
+                    out += character;
+                }
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief Appends an already existing JSON value (e.g. a data point value) by walking it.
+ *
+ * @param out The output buffer.
+ * @param value The JSON value to write.
+ */
+void JsonRpcMessageSerializer::appendValue(std::string& out, const nlohmann::json& value) {
+    switch (value.type()) {
+        case nlohmann::json::value_t::null:
+            out += "null";
+            break;
+        case nlohmann::json::value_t::boolean:
+            out += value.get<bool>() ? "true" : "false";
+            break;
+        case nlohmann::json::value_t::number_integer:
+            appendNumber(out, value.get<nlohmann::json::number_integer_t>());
+            break;
+        case nlohmann::json::value_t::number_unsigned:
+            appendNumber(out, value.get<nlohmann::json::number_unsigned_t>());
+            break;
+        case nlohmann::json::value_t::number_float: {
+            const auto number = value.get<double>();
+            if (!std::isfinite(number)) {
+                out += "null";  // Same as nlohmann::json::dump()
+                break;
+            }
+            const auto start = out.size();
+            appendNumber(out, number);
+            // Keep floats recognizable as such, like nlohmann::json::dump() does
+            if (out.find_first_of(".e", start) == std::string::npos) {
+                out += ".0";
+            }
+            break;
+        }
+        case nlohmann::json::value_t::string:
+            appendString(out, value.get_ref<const std::string&>());
+            break;
+        case nlohmann::json::value_t::array: {
+            out += '[';
+            bool first = true;
+            for (const auto& element : value) {
+                if (!first) {
+                    out += ',';
+                }
+                first = false;
+                appendValue(out, element);
+            }
+            out += ']';
+            break;
+        }
+        case nlohmann::json::value_t::object: {
+            out += '{';
+            bool first = true;
+            for (const auto& [key, element] : value.items()) {
+                if (!first) {
+                    out += ',';
+                }
+                first = false;
+                appendString(out, key);
+                out += ':';
+                appendValue(out, element);
+            }
+            out += '}';
+            break;
+        }
+        default:
+            out += value.dump();
+    }
+}
+
+/**
+ * @brief Appends the JSON-RPC envelope up to the opening of the params object.
+ */
+void JsonRpcMessageSerializer::appendHeader(std::string& out, std::string_view method, int id) {
+    out += "{\"jsonrpc\":";
+    appendString(out, getJsonRpcVersion());
+    out += ",\"method\":";
+    appendString(out, method);
+    out += ",\"id\":";
+    appendNumber(out, id);
+    out += ",\"params\":{";
+}
+
+/**
+ * @brief Appends a string member `"name":"value"` without a leading separator.
+ */
+void JsonRpcMessageSerializer::appendMember(std::string& out, std::string_view name,
+                                            std::string_view value) {
+    appendString(out, name);
+    out += ':';
+    appendString(out, value);
+}
+
+/**
+ * @brief Appends `,"name":"value"` if the optional value is set.
+ */
+void JsonRpcMessageSerializer::appendOptionalMember(std::string& out, std::string_view name,
+                                                    const std::optional<std::string>& value) {
+    if (value) {
+        out += ',';
+        appendMember(out, name, *value);
+    }
+}
+
+/**
+ * @brief Appends the metadata object, omitting unset timestamps like the `to_json` overload.
+ */
+void JsonRpcMessageSerializer::appendMetadata(std::string& out, const MetadataDTO& metadata) {
+    out += '{';
+    bool first_node = true;
+    for (const auto& [node_name, node] : metadata.nodes) {
+        const bool has_received = node.received.seconds != 0 || node.received.nanos != 0;
+        const bool has_generated = node.generated.seconds != 0 || node.generated.nanos != 0;
+        const bool has_origin = node.origin_type.has_value() && !node.origin_type->name.empty();
+        if (!has_received && !has_generated && !has_origin && !node.confidence) {
+            continue;
+        }
+
+        if (!first_node) {
+            out += ',';
+        }
+        first_node = false;
+        appendString(out, node_name);
+        out += ":{";
+
+        bool first_member = true;
+        const auto separate = [&out, &first_member]() {
+            if (!first_member) {
+                out += ',';
+            }
+            first_member = false;
+        };
+
+        if (has_received || has_generated) {
+            separate();
+            out += "\"timestamps\":{";
+            if (has_received) {
+                appendTimestamp(out, "received", node.received);
+            }
+            if (has_generated) {
+                if (has_received) {
+                    out += ',';
+                }
+                appendTimestamp(out, "generated", node.generated);
+            }
+            out += '}';
+        }
+        if (has_origin) {
+            separate();
+            out += "\"origin\":{\"type\":{";
+            appendMember(out, "name", node.origin_type->name);
+            out += ',';
+            appendMember(out, "uri", node.origin_type->uri.value_or(""));
+            out += "}}";
+        }
+        if (node.confidence) {
+            separate();
+            out += "\"confidence\":{";
+            appendMember(out, "type", node.confidence->type);
+            out += ",\"value\":";
+            appendNumber(out, node.confidence->value);
+            out += '}';
+        }
+        out += '}';
+    }
+    out += '}';
+}
+
+/**
+ * @brief Appends `"name":{"seconds":..,"nanos":..}`.
+ */
+void JsonRpcMessageSerializer::appendTimestamp(std::string& out, std::string_view name,
+                                               const MetadataDTO::Timestamp& timestamp) {
+    appendString(out, name);
+    out += ":{\"seconds\":";
+    appendNumber(out, timestamp.seconds);
+    out += ",\"nanos\":";
+    appendNumber(out, timestamp.nanos);
+    out += '}';
+}
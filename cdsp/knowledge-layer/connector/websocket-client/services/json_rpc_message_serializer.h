@@ -0,0 +1,42 @@
+#ifndef JSON_RPC_MESSAGE_SERIALIZER_H
+#define JSON_RPC_MESSAGE_SERIALIZER_H
+
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "get_message_dto.h"
+#include "metadata_dto.h"
+#include "set_message_dto.h"
+#include "subscribe_message_dto.h"
+#include "unsubscribe_message_dto.h"
+
+/**
+ * @brief Streaming serializer from outgoing DTOs to JSON-RPC wire format.
+ *
+ * Writes the JSON text of a message directly into a caller-provided buffer, without building an
+ * intermediate nlohmann::json tree. The output is equivalent to `json(dto).dump()` (member order
+ * aside), so it is accepted by the same servers.
+ */
+class JsonRpcMessageSerializer {
+   public:
+    static void serialize(const GetMessageDTO& dto, std::string& out);
+    static void serialize(const SetMessageDTO& dto, std::string& out);
+    static void serialize(const SubscribeMessageDTO& dto, std::string& out);
+    static void serialize(const UnsubscribeMessageDTO& dto, std::string& out);
+
+    static void appendString(std::string& out, std::string_view value);
+    static void appendValue(std::string& out, const nlohmann::json& value);
+
+   private:
+    static void appendHeader(std::string& out, std::string_view method, int id);
+    static void appendMember(std::string& out, std::string_view name, std::string_view value);
+    static void appendOptionalMember(std::string& out, std::string_view name,
+                                     const std::optional<std::string>& value);
+    static void appendMetadata(std::string& out, const MetadataDTO& metadata);
+    static void appendTimestamp(std::string& out, std::string_view name,
+                                const MetadataDTO::Timestamp& timestamp);
+};
+
+#endif  // JSON_RPC_MESSAGE_SERIALIZER_H
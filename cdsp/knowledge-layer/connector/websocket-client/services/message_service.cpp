@@ -1,11 +1,11 @@
 #include "message_service.h"
 
-#include <iostream>
-
 #include "bo_service.h"
 #include "bo_to_dto.h"
 #include "dto_service.h"
 #include "dto_to_bo.h"
+#include "json_rpc_message_serializer.h"
+#include "logger.h"
 #include "message_header.h"
 #include "unsubscribe_message_dto.h"
 
@@ -28,7 +28,7 @@ void MessageService::createAndQueueSubscribeMessage(const std::string &object_id
                                                     const SchemaType &schema_type,
                                                     const std::vector<std::string> &data_point_list,
                                                     RequestRegistry &registry,
-                                                    std::vector<json> &reply_messages_queue) {
+                                                    OutgoingMessageQueue &reply_messages_queue) {
     // Create a GetMessage to retrieve all data points for the schema type
     auto get_message = BoService::createGetMessage(object_id, schema_type, data_point_list);
     addMessageToQueue(get_message, registry, reply_messages_queue);
@@ -62,7 +62,7 @@ void MessageService::createAndQueueSubscribeMessage(const std::string &object_id
 void MessageService::createAndQueueUnsubscribeMessage(
     const std::string &object_id, const SchemaType &schema_type,
     const std::vector<std::string> &data_point_list, RequestRegistry &registry,
-    std::vector<json> &reply_messages_queue) {
+    OutgoingMessageQueue &reply_messages_queue) {
     // Create an UnsubscribeMessage to stop subscribing to data points for the
     // schema type
     std::vector<Node> nodes;
@@ -86,14 +86,14 @@ void MessageService::createAndQueueUnsubscribeMessage(
  * SetMessage.
  * @param registry A reference to the RequestRegistry used to track and manage
  * requests.
- * @param reply_messages_queue A reference to a vector where the generated JSON
+ * @param reply_messages_queue A reference to the queue where the serialized
  * messages (SetMessage and optional GetMessage) will be queued.
  * @param origin_system_name A string representing the name of the originating
  * system. This is used to identify the source of the messages.
  */
 void MessageService::createAndQueueSetMessage(const std::map<SchemaType, std::string> &object_ids,
                                               const json &json_body, RequestRegistry &registry,
-                                              std::vector<json> &reply_messages_queue,
+                                              OutgoingMessageQueue &reply_messages_queue,
                                               const std::string &origin_system_name) {
     // Create a SetMessage to set the data points for the schema type
     auto set_messages = BoService::createSetMessage(object_ids, json_body, origin_system_name);
@@ -114,46 +114,45 @@ void MessageService::createAndQueueSetMessage(const std::map<SchemaType, std::st
  * messages, converts and returns directly. For status messages logs
  * errors/success.
  *
- * @param message JSON-RPC formatted string from WebSocket server.
+ * @param message JSON-RPC formatted message from WebSocket server. It is only read during the
+ * call, so it can be a view on the connection's receive buffer.
  * @param registry RequestRegistry for tracking requests and DTO conversion.
+ * @param signal_catalog Catalog used to tag the nodes of data messages with their signal ID.
+ * @param resource Memory resource for the scratch data of the conversion, e.g. the message arena.
  * @return DataMessage if available from data response,
  *         std::nullopt for status-only messages or errors.
  */
 std::optional<DataMessage> MessageService::getDataOrProcessStatusFromMessage(
-    const std::string &message, RequestRegistry &registry) {
-    const auto parsed_message = MessageService::displayAndParseMessage(message);
+    std::string_view message, RequestRegistry &registry, const SignalCatalog *signal_catalog,
+    std::pmr::memory_resource *resource) {
+    auto parsed_message = MessageService::displayAndParseMessage(message);
 
     if (std::holds_alternative<StatusMessageDTO>(parsed_message)) {
-        StatusMessageDTO status_message_dto = std::get<StatusMessageDTO>(parsed_message);
+        const auto &status_message_dto = std::get<StatusMessageDTO>(parsed_message);
         try {
             StatusMessage status_message = DtoToBo::convert(status_message_dto, registry);
 
-            std::cout << Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true)
-                      << " Message received (Request ID:" << status_message.getIdentifier()
-                      << "):\n";
-
-            auto error = status_message.getError();
+            const auto &error = status_message.getError();
             if (error.has_value()) {
-                std::cout << "  Error during processing: \n";
-                std::cout << "    - Code: " << error->getCode() << "\n";
-                std::cout << "    - Message: " << error->getMessage() << "\n";
-                if (error->getData()) {
-                    std::cout << "    - Data: " << *error->getData() << "\n";
-                }
+                LOG_WARN("Message received (Request ID:"
+                         << status_message.getIdentifier() << "): Error during processing"
+                         << " - Code: " << error->getCode() << " - Message: "
+                         << error->getMessage()
+                         << (error->getData() ? " - Data: " + error->getData()->dump() : ""));
             } else {
                 // Successful status message
-                std::cout << " Processed successfully!\n";
+                LOG_INFO("Message received (Request ID:" << status_message.getIdentifier()
+                                                         << "): Processed successfully!");
             }
         } catch (const std::exception &e) {
-            std::cerr << "Error parsing status message: " << e.what() << "\n";
+            LOG_ERROR("Error parsing status message: " << e.what());
         }
     } else {
-        DataMessageDTO data_message_dto = std::get<DataMessageDTO>(parsed_message);
+        const auto &data_message_dto = std::get<DataMessageDTO>(parsed_message);
         try {
-            return DtoToBo::convert(data_message_dto, registry);
+            return DtoToBo::convert(data_message_dto, registry, signal_catalog, resource);
         } catch (const std::exception &e) {
-            std::cerr << "Error parsing and transforming data message to RDF triple: " << e.what()
-                      << "\n";
+            LOG_ERROR("Error parsing and transforming data message to RDF triple: " << e.what());
         }
     }
     return std::nullopt;
@@ -165,23 +164,23 @@ std::optional<DataMessage> MessageService::getDataOrProcessStatusFromMessage(
  * This function takes a variant message which can be of type GetMessage,
  * SetMessage, SubscribeMessage, or UnsubscribeMessage and processes it
  * accordingly. It converts the message to its corresponding Data Transfer
- * Object (DTO) and adds it to the reply messages queue. Additionally, it
- * registers the request information in the provided RequestRegistry.
+ * Object (DTO), serializes it once into a pooled buffer and adds it to the
+ * reply messages queue. Additionally, it registers the request information in
+ * the provided RequestRegistry.
  *
  * @param message A variant containing the message to be processed. It can
  * be one of the following types: GetMessage, SetMessage, SubscribeMessage,
  *                or UnsubscribeMessage.
  * @param registry A reference to the RequestRegistry used to track requests
  *                 and assign unique IDs to the DTOs.
- * @param reply_messages_queue A reference to a vector where the converted
- *                            JSON DTOs will be pushed for further
- *                            processing.
+ * @param reply_messages_queue A reference to the queue where the serialized
+ *                            DTOs will be pushed for sending.
  * @throws std::runtime_error If the message type is unknown and cannot be
  *                            processed.
  */
 void MessageService::addMessageToQueue(
     const std::variant<GetMessage, SetMessage, SubscribeMessage, UnsubscribeMessage> &message,
-    RequestRegistry &registry, std::vector<json> &reply_messages_queue) {
+    RequestRegistry &registry, OutgoingMessageQueue &reply_messages_queue) {
     std::visit(
         [&reply_messages_queue, &registry](const auto &specific_message) {
             auto dto = BoToDto::convert(specific_message);
@@ -206,8 +205,12 @@ void MessageService::addMessageToQueue(
                 request_info.instance = actual_dto.instance;
                 request_info.path = actual_dto.path;
 
-                actual_dto.id = registry.addRequest(request_info);
-                reply_messages_queue.push_back(json(actual_dto));
+                actual_dto.id = registry.addRequest(std::move(request_info));
+
+                // Serialize once, straight into a pooled buffer that is kept until sent
+                auto buffer = reply_messages_queue.acquireBuffer();
+                JsonRpcMessageSerializer::serialize(actual_dto, *buffer);
+                reply_messages_queue.push(std::move(buffer));
             }
         },
         message);
@@ -217,51 +220,30 @@ void MessageService::addMessageToQueue(
  * @brief Parses and displays a JSON-RPC message, returning either a
  * DataMessageDTO or a StatusMessageDTO.
  *
- * This function attempts to parse the provided JSON string into a JSON object
- * and checks for the presence of a valid JSON-RPC version. Depending on the
- * content of the message, it either parses and returns a DataMessageDTO or a
- * StatusMessageDTO. If the message cannot be parsed or is invalid, an exception
- * is thrown.
+ * The message is parsed in a single pass straight into the DTO, without
+ * building an intermediate JSON document. The raw message is logged as
+ * received instead of being serialized again.
  *
- * @param message The JSON string representing the message to be parsed.
+ * @param message The JSON-RPC message to be parsed.
  * @return A std::variant containing either a DataMessageDTO or a
  * StatusMessageDTO.
- * @throws std::invalid_argument If the JSON-RPC version is invalid.
- * @throws std::runtime_error If the message cannot be parsed or is of an
- * unknown type.
+ * @throws std::runtime_error If the message cannot be parsed, has an invalid
+ * JSON-RPC version or is of an unknown type.
  */
 std::variant<DataMessageDTO, StatusMessageDTO> MessageService::displayAndParseMessage(
-    const std::string &message) {
+    std::string_view message) {
     try {
-        // Parse the input JSON string into a JSON object
-        json json_message = json::parse(message);
-        if (!json_message.contains("jsonrpc") || json_message["jsonrpc"] != getJsonRpcVersion()) {
-            throw std::invalid_argument("Invalid JSON-RPC version");
-        }
-
-        if (json_message.contains("result") && !json_message["result"].empty()) {
-            // Parse and return a DataMessage
-            std::cout << "(" << Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true)
-                      << ") Websocket-Server: Data message received correctly\n"
-                      << "Message Content: " << json_message.dump() << "\n";
-            return (DtoService::parseDataJsonToDto(json_message));
-        }
-
-        if (json_message.contains("error") ||
-            (json_message.contains("result") && json_message["result"].empty())) {
-            std::cout << "(" << Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true)
-                      << ") Websocket-Server: Status message received correctly\n"
-                      << "Message Content: " << json_message.dump() << "\n";
-            return DtoService::parseStatusJsonToDto(json_message);
-        }
+        auto parsed_message = DtoService::parseJsonRpcMessageToDto(message);
 
-        // Log and return an ErrorMessage for unknown message types
-        throw std::runtime_error("The incoming message cannot be parsed: " + json_message.dump());
+        const char *message_kind =
+            std::holds_alternative<DataMessageDTO>(parsed_message) ? "Data" : "Status";
+        LOG_INFO("Websocket-Server: " << message_kind << " message received correctly");
+        LOG_PAYLOAD(LogLevel::INFO, "Message Content", message);
+        return parsed_message;
 
     } catch (const std::exception &e) {
         // Log and return an ErrorMessage for JSON parsing errors
-        std::cerr << "(" << Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true)
-                  << ") Websocket-Server: Error parsing JSON message: " << e.what() << "\n";
+        LOG_ERROR("Websocket-Server: Error parsing JSON message: " << e.what());
         throw std::runtime_error("Error parsing JSON message: " + std::string(e.what()));
     }
 }
@@ -1,9 +1,11 @@
 #ifndef MESSAGE_UTILS_H
 #define MESSAGE_UTILS_H
 
+#include <memory_resource>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -11,8 +13,10 @@
 #include "data_message_dto.h"
 #include "data_types.h"
 #include "get_message.h"
+#include "outgoing_message_queue.h"
 #include "request_registry.h"
 #include "set_message.h"
+#include "signal_catalog.h"
 #include "status_message_dto.h"
 #include "subscribe_message.h"
 #include "unsubscribe_message.h"
@@ -25,28 +29,30 @@ class MessageService {
                                                const SchemaType &schema_type,
                                                const std::vector<std::string> &data_point_list,
                                                RequestRegistry &registry,
-                                               std::vector<json> &reply_messages_queue);
+                                               OutgoingMessageQueue &reply_messages_queue);
 
     static void createAndQueueUnsubscribeMessage(const std::string &object_id,
                                                  const SchemaType &schema_type,
                                                  const std::vector<std::string> &data_point_list,
                                                  RequestRegistry &registry,
-                                                 std::vector<json> &reply_messages_queue);
+                                                 OutgoingMessageQueue &reply_messages_queue);
 
     static void createAndQueueSetMessage(const std::map<SchemaType, std::string> &object_id,
                                          const json &json_body, RequestRegistry &registry,
-                                         std::vector<json> &reply_messages_queue,
+                                         OutgoingMessageQueue &reply_messages_queue,
                                          const std::string &origin_system_name);
 
-    static std::optional<DataMessage> getDataOrProcessStatusFromMessage(const std::string &message,
-                                                                        RequestRegistry &registry);
+    static std::optional<DataMessage> getDataOrProcessStatusFromMessage(
+        std::string_view message, RequestRegistry &registry,
+        const SignalCatalog *signal_catalog = nullptr,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
    private:
     static void addMessageToQueue(
         const std::variant<GetMessage, SetMessage, SubscribeMessage, UnsubscribeMessage> &message,
-        RequestRegistry &registry, std::vector<json> &reply_messages_queue);
+        RequestRegistry &registry, OutgoingMessageQueue &reply_messages_queue);
 
     static std::variant<DataMessageDTO, StatusMessageDTO> displayAndParseMessage(
-        const std::string &message);
+        std::string_view message);
 };
 #endif  // MESSAGE_UTILS_H
\ No newline at end of file
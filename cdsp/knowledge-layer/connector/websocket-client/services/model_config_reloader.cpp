@@ -0,0 +1,261 @@
+#include "model_config_reloader.h"
+
+#include <algorithm>
+#include <csignal>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include "artifact_loader.h"
+#include "helper.h"
+#include "logger.h"
+#include "system_configuration_service.h"
+
+/**
+ * @brief Reads the reload settings from the environment.
+ *
+ * MODEL_CONFIG_RELOAD_ON_SIGNAL enables the reload on SIGHUP (default true) and
+ * MODEL_CONFIG_WATCH_SECONDS sets the interval of the file watch (default 0, disabled).
+ *
+ * @return The reload settings.
+ * @throws std::invalid_argument if a variable has an invalid value.
+ */
+ModelConfigReloadSettings ModelConfigReloadSettings::fromEnvironment() {
+    ModelConfigReloadSettings settings;
+    settings.reload_on_signal =
+        Helper::getBoolEnvVariable("MODEL_CONFIG_RELOAD_ON_SIGNAL", settings.reload_on_signal);
+
+    settings.watch_interval = std::chrono::seconds(Helper::getUnsignedEnvVariable(
+        "MODEL_CONFIG_WATCH_SECONDS", settings.watch_interval.count()));
+    return settings;
+}
+
+/**
+ * @brief Constructs a reloader for the model configuration in use.
+ *
+ * @param config_file The path of the model configuration file.
+ * @param model_config The configuration in use.
+ * @param reasoner_service The reasoner service the rules, ontologies and shapes are loaded into.
+ * @param apply The callback that swaps in a reloaded configuration.
+ * @param settings The triggers of the reload.
+ * @param loader Reads the configuration file, `SystemConfigurationService::loadModelConfig` if
+ * not provided.
+ */
+ModelConfigReloader::ModelConfigReloader(std::string config_file, ModelConfigSnapshot model_config,
+                                         ReasonerService& reasoner_service, ApplyCallback apply,
+                                         ModelConfigReloadSettings settings, ConfigLoader loader)
+    : config_file_(std::move(config_file)),
+      reasoner_service_(reasoner_service),
+      apply_(std::move(apply)),
+      settings_(settings),
+      loader_(loader ? std::move(loader) : SystemConfigurationService::loadModelConfig),
+      model_config_(std::move(model_config)),
+      signals_(io_context_),
+      watch_timer_(io_context_) {
+    if (!model_config_) {
+        throw std::invalid_argument("The model configuration to reload must be provided.");
+    }
+}
+
+ModelConfigReloader::~ModelConfigReloader() { stop(); }
+
+/**
+ * @brief Starts listening for SIGHUP and watching the model directory, as configured.
+ */
+void ModelConfigReloader::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    if (settings_.reload_on_signal) {
+        signals_.add(SIGHUP);
+        waitForSignal();
+    }
+    if (settings_.watch_interval.count() > 0) {
+        last_write_time_ = getLastWriteTime();
+        scheduleWatch();
+    }
+    work_guard_.emplace(io_context_.get_executor());
+    thread_ = std::thread([this] { io_context_.run(); });
+}
+
+/**
+ * @brief Stops the reload thread. A running reload is completed first.
+ */
+void ModelConfigReloader::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    work_guard_.reset();
+    io_context_.stop();
+    thread_.join();
+}
+
+/**
+ * @brief Requests a reload on the reload thread. The call returns immediately.
+ */
+void ModelConfigReloader::requestReload() {
+    boost::asio::post(io_context_, [this] { reload(); });
+}
+
+/**
+ * @brief Reloads the model configuration and applies the differences.
+ *
+ * The added rules, ontologies and validation shapes are loaded into the reasoner first, and only
+ * then the ones that are no longer in the configuration are removed, so the reasoner always holds
+ * a complete model. This happens before the new snapshot is handed to the apply callback. If the
+ * reasoner cannot be updated, nothing is removed and the new configuration is not applied; the
+ * next reload applies the remaining differences. A change of the triple assembler queries only
+ * needs the new snapshot, which reads them for every message.
+ *
+ * @return true if a new configuration was applied.
+ */
+bool ModelConfigReloader::reload() {
+    const std::lock_guard<std::mutex> reload_lock(reload_mutex_);
+    const auto start = std::chrono::steady_clock::now();
+    const ModelConfigSnapshot previous = getModelConfig();
+
+    ModelConfigSnapshot current;
+    try {
+        current = std::make_shared<const ModelConfig>(loader_(config_file_));
+        SystemConfigurationService::validateOutputQueries(*current);
+    } catch (const std::exception& e) {
+        LOG_ERROR("The model configuration could not be reloaded: " << e.what());
+        const std::lock_guard<std::mutex> lock(mutex_);
+        ++statistics_.failed;
+        return false;
+    }
+
+    const ModelConfigDiff diff = ModelConfigDiff::compute(*previous, *current);
+    if (diff.empty()) {
+        LOG_INFO("The model configuration has not changed");
+        const std::lock_guard<std::mutex> lock(mutex_);
+        ++statistics_.unchanged;
+        return false;
+    }
+    if (!diff.restart_required.empty()) {
+        LOG_WARN("The model configuration is not reloaded, a restart is required to apply: "
+                 << diff);
+        const std::lock_guard<std::mutex> lock(mutex_);
+        ++statistics_.rejected;
+        return false;
+    }
+
+    if (diff.hasReasonerChanges()) {
+        const ArtifactLoadStatistics load_statistics =
+            ArtifactLoader(reasoner_service_)
+                .addRules(diff.added_rules)
+                .addData(diff.added_ontologies)
+                .addData(diff.added_validation_shapes)
+                .removeRules(diff.removed_rules)
+                .removeData(diff.removed_ontologies)
+                .removeData(diff.removed_validation_shapes)
+                .load();
+        if (load_statistics.failed > 0) {
+            LOG_ERROR("The model configuration is not reloaded, "
+                      << load_statistics.failed << " rules, ontologies or validation shapes "
+                      << "could not be updated in the reasoner");
+            const std::lock_guard<std::mutex> lock(mutex_);
+            ++statistics_.failed;
+            return false;
+        }
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        model_config_ = current;
+        ++statistics_.applied;
+    }
+    apply_(current, diff);
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    LOG_INFO("Model configuration reloaded in " << elapsed.count() << " ms: " << diff);
+    return true;
+}
+
+/**
+ * @brief Retrieves the configuration in use.
+ *
+ * @return The snapshot of the last applied configuration.
+ */
+ModelConfigSnapshot ModelConfigReloader::getModelConfig() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return model_config_;
+}
+
+/**
+ * @brief Retrieves the reload counters.
+ *
+ * @return A copy of the counters.
+ */
+ModelConfigReloadStatistics ModelConfigReloader::getStatistics() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+/**
+ * @brief Waits for the next SIGHUP and reloads.
+ */
+void ModelConfigReloader::waitForSignal() {
+    signals_.async_wait([this](const boost::system::error_code& error_code, int) {
+        if (error_code) {
+            return;
+        }
+        LOG_INFO("SIGHUP received, reloading the model configuration");
+        reload();
+        waitForSignal();
+    });
+}
+
+/**
+ * @brief Checks the model directory for changed files after the watch interval and reloads if a
+ * file is newer than at the last check.
+ */
+void ModelConfigReloader::scheduleWatch() {
+    watch_timer_.expires_after(settings_.watch_interval);
+    watch_timer_.async_wait([this](const boost::system::error_code& error_code) {
+        if (error_code) {
+            return;
+        }
+        const auto last_write_time = getLastWriteTime();
+        if (last_write_time != last_write_time_) {
+            last_write_time_ = last_write_time;
+            LOG_INFO("The model directory has changed, reloading the model configuration");
+            reload();
+        }
+        scheduleWatch();
+    });
+}
+
+/**
+ * @brief Finds the newest modification time of the files in the directory of the model
+ * configuration. The output directory of the configuration in use is skipped.
+ *
+ * @return The newest modification time, the minimum time if the directory cannot be read.
+ */
+std::filesystem::file_time_type ModelConfigReloader::getLastWriteTime() const {
+    namespace fs = std::filesystem;
+    std::error_code error_code;
+    const fs::path model_directory = fs::path(config_file_).parent_path();
+    fs::path output_directory =
+        fs::weakly_canonical(fs::path(getModelConfig()->getOutput()), error_code);
+    if (!output_directory.has_filename()) {
+        output_directory = output_directory.parent_path();
+    }
+
+    fs::file_time_type last_write_time = fs::file_time_type::min();
+    const fs::recursive_directory_iterator end;
+    fs::recursive_directory_iterator entry(model_directory, error_code);
+    for (; !error_code && entry != end; entry.increment(error_code)) {
+        std::error_code entry_error_code;
+        if (entry->is_directory(entry_error_code)) {
+            if (fs::weakly_canonical(entry->path(), entry_error_code) == output_directory) {
+                entry.disable_recursion_pending();
+            }
+        } else if (entry->is_regular_file(entry_error_code)) {
+            last_write_time =
+                std::max(last_write_time, entry->last_write_time(entry_error_code));
+        }
+    }
+    return last_write_time;
+}
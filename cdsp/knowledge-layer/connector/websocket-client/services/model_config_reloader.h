@@ -0,0 +1,105 @@
+#ifndef MODEL_CONFIG_RELOADER_H
+#define MODEL_CONFIG_RELOADER_H
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "model_config.h"
+#include "model_config_diff.h"
+#include "reasoner_service.h"
+
+/**
+ * @brief Settings of the ModelConfigReloader.
+ */
+struct ModelConfigReloadSettings {
+    // Reload when the process receives SIGHUP
+    bool reload_on_signal = true;
+    // Interval of checking the model directory for changed files, 0 disables the file watch
+    std::chrono::seconds watch_interval{0};
+
+    static ModelConfigReloadSettings fromEnvironment();
+};
+
+/**
+ * @brief Counters of the ModelConfigReloader.
+ */
+struct ModelConfigReloadStatistics {
+    std::uint64_t applied = 0;
+    // Reloads without any difference to the configuration in use
+    std::uint64_t unchanged = 0;
+    // Reloads skipped because a changed setting requires a restart
+    std::uint64_t rejected = 0;
+    std::uint64_t failed = 0;
+};
+
+/**
+ * @brief Reloads the model configuration while the client keeps processing messages.
+ *
+ * A reload is triggered by SIGHUP, by a change of a file in the model directory or by
+ * `requestReload()`. It runs on a thread of its own: the configuration is read again, compared
+ * with the configuration in use, and the added and removed rules, ontologies and validation
+ * shapes are applied to the reasoner. Only then is the new snapshot handed to the apply callback,
+ * which swaps it in on the message path. Messages are processed with the previous snapshot
+ * until the swap.
+ *
+ * A configuration that cannot be loaded, or that changes a setting only applied at startup
+ * (e.g. the subscribed inputs), is not applied and the previous configuration stays in use.
+ */
+class ModelConfigReloader {
+   public:
+    using ConfigLoader = std::function<ModelConfig(const std::string&)>;
+    // Called on the reload thread with the new snapshot after the reasoner was updated
+    using ApplyCallback = std::function<void(ModelConfigSnapshot, const ModelConfigDiff&)>;
+
+    ModelConfigReloader(std::string config_file, ModelConfigSnapshot model_config,
+                        ReasonerService& reasoner_service, ApplyCallback apply,
+                        ModelConfigReloadSettings settings = ModelConfigReloadSettings(),
+                        ConfigLoader loader = nullptr);
+    ~ModelConfigReloader();
+
+    ModelConfigReloader(const ModelConfigReloader&) = delete;
+    ModelConfigReloader& operator=(const ModelConfigReloader&) = delete;
+
+    void start();
+    void stop();
+    void requestReload();
+    bool reload();
+
+    [[nodiscard]] ModelConfigSnapshot getModelConfig() const;
+    [[nodiscard]] ModelConfigReloadStatistics getStatistics() const;
+
+   private:
+    const std::string config_file_;
+    ReasonerService& reasoner_service_;
+    const ApplyCallback apply_;
+    const ModelConfigReloadSettings settings_;
+    const ConfigLoader loader_;
+
+    // Serializes the reloads
+    std::mutex reload_mutex_;
+    // Guards the snapshot and the statistics
+    mutable std::mutex mutex_;
+    ModelConfigSnapshot model_config_;
+    ModelConfigReloadStatistics statistics_;
+
+    boost::asio::io_context io_context_;
+    boost::asio::signal_set signals_;
+    boost::asio::steady_timer watch_timer_;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>
+        work_guard_;
+    std::thread thread_;
+    std::filesystem::file_time_type last_write_time_;
+
+    void waitForSignal();
+    void scheduleWatch();
+    std::filesystem::file_time_type getLastWriteTime() const;
+};
+
+#endif  // MODEL_CONFIG_RELOADER_H
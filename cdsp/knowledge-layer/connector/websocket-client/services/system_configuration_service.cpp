@@ -1,13 +1,37 @@
 #include "system_configuration_service.h"
 
 #include <iostream>
+#include <limits>
 #include <nlohmann/json.hpp>
+#include <stdexcept>
 
 #include "dto_service.h"
 #include "dto_to_bo.h"
 #include "file_handler_impl.h"
 #include "helper.h"
 #include "model_config_dto.h"
+#include "output_query_scheduler.h"
+
+namespace {
+/**
+ * @brief Loads the permessage-deflate settings of the WebSocket connection from the environment.
+ *
+ * @return The compression settings. Compression stays disabled unless
+ * `WEBSOCKET_DEFLATE_ENABLED` is set to `true` or `1`.
+ */
+WSCompressionSettings loadCompressionSettings() {
+    WSCompressionSettings settings;
+    settings.enabled = Helper::getBoolEnvVariable("WEBSOCKET_DEFLATE_ENABLED", settings.enabled);
+    settings.max_window_bits = static_cast<int>(Helper::getUnsignedEnvVariable(
+        "WEBSOCKET_DEFLATE_WINDOW_BITS", settings.max_window_bits, 9, 15));
+    settings.compression_level = static_cast<int>(Helper::getUnsignedEnvVariable(
+        "WEBSOCKET_DEFLATE_LEVEL", settings.compression_level, 0, 9));
+    settings.min_message_size = Helper::getUnsignedEnvVariable(
+        "WEBSOCKET_DEFLATE_MIN_SIZE", settings.min_message_size, 0,
+        std::numeric_limits<int>::max());
+    return settings;
+}
+}  // namespace
 
 SystemConfig SystemConfigurationService::loadSystemConfig(
     const std::optional<std::string> ws_server_host,
@@ -25,6 +49,7 @@ SystemConfig SystemConfigurationService::loadSystemConfig(
         Helper::getEnvVariable("PORT_WEBSOCKET_SERVER", ws_server_port);
     system_config.websocket_server.target =
         Helper::getEnvVariable("TARGET_WEBSOCKET_SERVER", ws_server_target);
+    system_config.websocket_server.compression = loadCompressionSettings();
     system_config.reasoner_server.host =
         Helper::getEnvVariable("HOST_REASONER_SERVER", reasoner_server_host);
     system_config.reasoner_server.port =
@@ -55,10 +80,30 @@ ModelConfig SystemConfigurationService::loadModelConfig(const std::string& confi
         std::cout << " - ModelConfigDTO parsed successfully\n";
         DtoToBo dto_to_bo(file_handler);
         const auto model_config = dto_to_bo.convert(model_config_dto);
+        validateOutputQueries(model_config);
         std::cout << " - Model configuration loaded successfully\n\n";
         return model_config;
 
     } catch (const std::exception& e) {
         throw std::runtime_error(" - Error loading model configuration: " + std::string(e.what()));
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Checks the comments of the reasoning output queries that configure how they run, e.g.
+ * `#SCHEDULE(...)`. They are otherwise only read once a query is scheduled, on the message path.
+ *
+ * @param model_config The model configuration with the output queries.
+ * @throws std::invalid_argument if the comment of a query is malformed.
+ */
+void SystemConfigurationService::validateOutputQueries(const ModelConfig& model_config) {
+    const OutputQuerySchedulerSettings defaults;
+    for (const auto& output_query : model_config.getReasoningOutputQueries()) {
+        try {
+            static_cast<void>(defaults.forQuery(output_query.query));
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Invalid output query '" + output_query.query +
+                                        "': " + e.what());
+        }
+    }
+}
@@ -19,6 +19,7 @@ class SystemConfigurationService {
         const std::optional<std::string> reasoner_server_data_store_name,
         const std::optional<std::string>& reasoner_server_origin_system);
     static ModelConfig loadModelConfig(const std::string& config_file);
+    static void validateOutputQueries(const ModelConfig& model_config);
 };
 
 #endif  // SYSTEM_CONFIGURATION_SERVICE_H
\ No newline at end of file
@@ -196,9 +196,11 @@ TEST_F(BoServiceIntegrationTest, CreateSetMessage) {
         for (const auto &[key, value] : vehicle_data.items()) {
             ASSERT_EQ(set_messages[i].getNodes()[index].getName(), key)
                 << "Node name mismatch at index " << i << ", node " << index;
-            ASSERT_EQ(set_messages[i].getNodes()[index].getValue().value(), value.dump())
-                << "Node value mismatch at index " << i
-                << ", SetMessage value: " << set_messages[i].getNodes()[index].getValue().value()
+            ASSERT_EQ(set_messages[i].getNodes()[index].getValue(),
+                      NodeValue(value.get<std::string>()))
+                << "Node value mismatch at index " << i << ", SetMessage value: "
+                << NodeValueFormatter::toString(
+                       set_messages[i].getNodes()[index].getValue().value())
                 << ", JSON: " << value << "\n";
             ASSERT_TRUE(set_messages[i]
                             .getNodes()[index]
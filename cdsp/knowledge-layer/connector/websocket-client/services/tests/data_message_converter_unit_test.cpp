@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "data_message_converter.h"
+
+class DataMessageConverterUnitTest : public ::testing::Test {
+   protected:
+    RequestRegistry registry_;
+
+    static std::vector<std::string> getNames(const std::vector<Node>& nodes) {
+        std::vector<std::string> names;
+        for (const auto& node : nodes) {
+            names.push_back(node.getName());
+        }
+        return names;
+    }
+};
+
+// Test that nested objects and arrays are flattened into node names and values
+TEST_F(DataMessageConverterUnitTest, FlattenNestedData) {
+    DataMessageDTO dto;
+    dto.id = registry_.addRequest({RequestInfo::SUBSCRIBE, "Vehicle", "VIN123", std::nullopt});
+    dto.data = nlohmann::json::parse(
+        R"({"Speed": 42, "Cabin": {"Door": [{"IsOpen": true}, {"IsOpen": false}]},
+            "Gears": [1, 2], "Row": {"1": "left"}})");
+
+    const auto nodes = DataMessageConverter::convert(dto, registry_).getNodes();
+
+    const std::vector<std::string> expected = {
+        "Vehicle.Cabin.Door[0].IsOpen", "Vehicle.Cabin.Door[1].IsOpen", "Vehicle.Gears[0]",
+        "Vehicle.Gears[1]",             "Vehicle.Row[1]",               "Vehicle.Speed"};
+    EXPECT_EQ(getNames(nodes), expected);
+    EXPECT_EQ(nodes[0].getValue(), NodeValue(true));
+    EXPECT_EQ(nodes[3].getValue(), NodeValue(std::int64_t{2}));
+    EXPECT_EQ(nodes[4].getValue(), NodeValue(std::string("left")));
+    EXPECT_EQ(nodes[5].getValue(), NodeValue(std::int64_t{42}));
+}
+
+// Test that values keep their JSON type and full precision
+TEST_F(DataMessageConverterUnitTest, KeepTypedValues) {
+    DataMessageDTO dto;
+    dto.id = registry_.addRequest({RequestInfo::SUBSCRIBE, "Vehicle", "VIN123", std::nullopt});
+    dto.data = nlohmann::json::parse(
+        R"({"Latitude": 48.137154123456, "Odometer": 18446744073709551615, "Speed": -3})");
+
+    const auto nodes = DataMessageConverter::convert(dto, registry_).getNodes();
+
+    ASSERT_EQ(nodes.size(), 3u);
+    EXPECT_EQ(nodes[0].getValue(), NodeValue(48.137154123456));
+    EXPECT_EQ(nodes[1].getValue(), NodeValue(18446744073709551615.0));
+    EXPECT_EQ(nodes[2].getValue(), NodeValue(std::int64_t{-3}));
+
+    dto.data = nlohmann::json::parse(R"({"Speed": null})");
+    EXPECT_THROW(DataMessageConverter::convert(dto, registry_), std::runtime_error);
+}
+
+// Test that metadata is attached relative to the requested path, with array indices ignored
+// and the empty path as fallback
+TEST_F(DataMessageConverterUnitTest, AttachMetadataRelativeToPath) {
+    DataMessageDTO dto;
+    dto.id = registry_.addRequest({RequestInfo::GET, "Vehicle", "VIN123", "Vehicle.Cabin"});
+    dto.data = nlohmann::json::parse(R"({"Temperature": 21.5, "Seats": [1, 2]})");
+
+    MetadataDTO metadata;
+    metadata.nodes["Temperature"].received = {1700000000, 0};
+    metadata.nodes["Seats"].received = {1700000100, 0};
+    metadata.nodes[""].received = {1600000000, 0};
+    dto.metadata = metadata;
+
+    const auto nodes = DataMessageConverter::convert(dto, registry_).getNodes();
+
+    ASSERT_EQ(nodes.size(), 3u);
+    EXPECT_EQ(nodes[0].getName(), "Vehicle.Vehicle.Cabin.Seats[0]");
+    const auto seconds = [](const Node& node) {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                   node.getMetadata().getReceived().time_since_epoch())
+            .count();
+    };
+    EXPECT_EQ(seconds(nodes[0]), 1700000100);
+    EXPECT_EQ(seconds(nodes[1]), 1700000100);
+    EXPECT_EQ(seconds(nodes[2]), 1700000000);
+
+    // GET requests are removed once answered
+    EXPECT_EQ(registry_.getRequest(dto.id), nullptr);
+}
+
+// Test that nodes are tagged with the ID of their signal in the catalog
+TEST_F(DataMessageConverterUnitTest, TagNodesWithSignalIds) {
+    SignalCatalog catalog;
+    const SignalId speed_id = catalog.addSignal("Vehicle.Speed");
+
+    DataMessageDTO dto;
+    dto.id = registry_.addRequest({RequestInfo::SUBSCRIBE, "Vehicle", "VIN123", std::nullopt});
+    dto.data = nlohmann::json::parse(R"({"Speed": 42, "Gears": [1]})");
+
+    const auto nodes = DataMessageConverter::convert(dto, registry_, &catalog).getNodes();
+
+    ASSERT_EQ(nodes.size(), 2u);
+    EXPECT_EQ(nodes[0].getSignalId(), SignalCatalog::UNKNOWN_SIGNAL);
+    EXPECT_EQ(nodes[1].getSignalId(), speed_id);
+}
@@ -345,12 +345,22 @@ TEST_F(DtoToModelConfigIntegrationTest, ConvertModelConfigDtoToBo) {
     TripleAssemblerHelper bo_queries_config = b_obj.getQueriesTripleAssemblerHelper();
     for (const auto &[expected_bo_schema, expected_bo_query_pair] :
          expected_bo_triple_assembler_helper_queries) {
-        EXPECT_EQ(bo_queries_config.getQueries()[expected_bo_schema].data_property,
+        EXPECT_EQ(bo_queries_config.getQueries().at(expected_bo_schema).data_property,
                   expected_bo_query_pair.data_property);
 
-        EXPECT_EQ(bo_queries_config.getQueries()[expected_bo_schema].object_property,
+        EXPECT_EQ(bo_queries_config.getQueries().at(expected_bo_schema).object_property,
                   expected_bo_query_pair.object_property);
     }
+
+    // Per-schema lookups
+    for (const SchemaType &schema : SCHEMAS_IN_TEST) {
+        EXPECT_EQ(b_obj.getInputs(schema), expected_bo_inputs.at(schema));
+        EXPECT_EQ(b_obj.getQueryPair(schema).data_property,
+                  expected_bo_triple_assembler_helper_queries.at(schema).data_property);
+        EXPECT_EQ(b_obj.getQueryPair(schema).object_property,
+                  expected_bo_triple_assembler_helper_queries.at(schema).object_property);
+    }
+    EXPECT_EQ(b_obj.getReasoningOutputPath(), expected_bo_output + "/reasoning_output/");
     EXPECT_EQ(b_obj.getReasoningOutputQueries(), expected_bo_reasoning_output_queries);
 
     ReasonerSettings bo_reasoner_settings = b_obj.getReasonerSettings();
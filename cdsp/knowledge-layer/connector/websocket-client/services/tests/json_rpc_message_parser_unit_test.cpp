@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include "globals.h"
+#include "json_rpc_message_parser.h"
+
+class JsonRpcMessageParserUnitTest : public ::testing::Test {
+   protected:
+    static std::string buildMessage(const nlohmann::json& body) {
+        nlohmann::json message = body;
+        message["jsonrpc"] = getJsonRpcVersion();
+        return message.dump();
+    }
+};
+
+// Test that a data message is parsed into a DataMessageDTO including its metadata
+TEST_F(JsonRpcMessageParserUnitTest, ParseDataMessageWithMetadata) {
+    const nlohmann::json data = {{"Vehicle", {{"Speed", 42.5}, {"Gears", {1, 2, 3}}}}};
+    const std::string message = buildMessage(
+        {{"id", 7},
+         {"result",
+          {{"data", data},
+           {"metadata",
+            {{"Vehicle.Speed",
+              {{"timestamps",
+                {{"received", {{"seconds", 1700000000}, {"nanos", 123}}},
+                 {"generated", {{"seconds", 1699999999}}}}},
+               {"confidence", {{"type", "deductive"}, {"value", 90}}}}}}}}}});
+
+    const auto parsed = JsonRpcMessageParser::parse(message);
+
+    ASSERT_TRUE(std::holds_alternative<DataMessageDTO>(parsed));
+    const auto& dto = std::get<DataMessageDTO>(parsed);
+    EXPECT_EQ(dto.id, 7);
+    EXPECT_EQ(dto.data, data);
+    ASSERT_TRUE(dto.metadata.has_value());
+    const auto& node = dto.metadata->nodes.at("Vehicle.Speed");
+    EXPECT_EQ(node.received.seconds, 1700000000);
+    EXPECT_EQ(node.received.nanos, 123);
+    EXPECT_EQ(node.generated.seconds, 1699999999);
+    EXPECT_EQ(node.generated.nanos, 0);
+    ASSERT_TRUE(node.confidence.has_value());
+    EXPECT_EQ(node.confidence->type, "deductive");
+    EXPECT_EQ(node.confidence->value, 90);
+}
+
+// Test that error responses and empty results are parsed into StatusMessageDTOs
+TEST_F(JsonRpcMessageParserUnitTest, ParseStatusMessages) {
+    const auto error = JsonRpcMessageParser::parse(buildMessage(
+        {{"id", 3}, {"error", {{"code", 404}, {"message", "Not found"}, {"data", {{"a", 1}}}}}}));
+    ASSERT_TRUE(std::holds_alternative<StatusMessageDTO>(error));
+    const auto& error_dto = std::get<StatusMessageDTO>(error);
+    EXPECT_EQ(error_dto.id, 3);
+    ASSERT_TRUE(error_dto.error.has_value());
+    EXPECT_EQ(error_dto.error->code, 404);
+    EXPECT_EQ(error_dto.error->message, "Not found");
+    EXPECT_EQ(error_dto.error->data, nlohmann::json({{"a", 1}}));
+
+    const auto success =
+        JsonRpcMessageParser::parse(buildMessage({{"id", 4}, {"result", nlohmann::json::object()}}));
+    ASSERT_TRUE(std::holds_alternative<StatusMessageDTO>(success));
+    EXPECT_EQ(std::get<StatusMessageDTO>(success).id, 4);
+    EXPECT_FALSE(std::get<StatusMessageDTO>(success).error.has_value());
+}
+
+// Test that invalid messages are rejected
+TEST_F(JsonRpcMessageParserUnitTest, RejectInvalidMessages) {
+    EXPECT_THROW(JsonRpcMessageParser::parse(R"({"jsonrpc":"1.0","id":1,"result":{"data":{}}})"),
+                 std::invalid_argument);
+    EXPECT_THROW(JsonRpcMessageParser::parse(buildMessage({{"result", {{"data", {{"a", 1}}}}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(JsonRpcMessageParser::parse(buildMessage({{"id", 1}, {"result", {{"x", 1}}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(JsonRpcMessageParser::parse(buildMessage(
+                     {{"id", 1},
+                      {"result",
+                       {{"data", {{"a", 1}}},
+                        {"metadata", {{"a", {{"timestamps", {{"received", {{"nanos", 1}}}}}}}}}}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(JsonRpcMessageParser::parse(R"({"jsonrpc":"2.0","id":1,"result":)"),
+                 std::invalid_argument);
+    EXPECT_THROW(JsonRpcMessageParser::parse(buildMessage({{"id", 1}})), std::runtime_error);
+}
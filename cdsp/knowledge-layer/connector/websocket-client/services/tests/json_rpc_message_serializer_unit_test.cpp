@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "json_rpc_message_serializer.h"
+
+class JsonRpcMessageSerializerUnitTest : public ::testing::Test {
+   protected:
+    template <typename DTO>
+    static nlohmann::json serializeAndParse(const DTO& dto) {
+        std::string out;
+        JsonRpcMessageSerializer::serialize(dto, out);
+        return nlohmann::json::parse(out);
+    }
+};
+
+// Test that request messages serialize to the same JSON as their to_json overloads
+TEST_F(JsonRpcMessageSerializerUnitTest, SerializeRequestMessagesLikeToJson) {
+    const GetMessageDTO get_dto{1, "Vehicle", "VIN123", "Vehicle.Speed", "flat", std::nullopt};
+    EXPECT_EQ(serializeAndParse(get_dto), nlohmann::json(get_dto));
+
+    const SubscribeMessageDTO subscribe_dto{2, "Vehicle", "VIN123", std::nullopt, "leaf", "root"};
+    EXPECT_EQ(serializeAndParse(subscribe_dto), nlohmann::json(subscribe_dto));
+
+    const UnsubscribeMessageDTO unsubscribe_dto{3, "Vehicle", "VIN\"123\"", "Vehicle.Speed"};
+    EXPECT_EQ(serializeAndParse(unsubscribe_dto), nlohmann::json(unsubscribe_dto));
+}
+
+// Test that set messages serialize their data and metadata like their to_json overload
+TEST_F(JsonRpcMessageSerializerUnitTest, SerializeSetMessageLikeToJson) {
+    SetMessageDTO dto;
+    dto.id = 4;
+    dto.schema = "Vehicle";
+    dto.instance = "VIN123";
+    dto.data = {{"Vehicle.Speed", 42.0},
+                {"Vehicle.Gear", -2},
+                {"Vehicle.Name", "line\nbreak \"quoted\""},
+                {"Vehicle.Flags", nlohmann::json::array({true, nullptr, 1.5e300})},
+                {"Vehicle.Nested", {{"a", {{"b", 1u}}}}}};
+    MetadataDTO::NodeMetadata node_metadata;
+    node_metadata.generated = {1700000000, 5};
+    node_metadata.origin_type = MetadataDTO::OriginType{"SemanticReasoner", std::nullopt};
+    node_metadata.confidence = MetadataDTO::Confidence{"deductive", 100};
+    dto.metadata.nodes["Vehicle.Speed"] = node_metadata;
+    dto.metadata.nodes["Vehicle.Empty"] = MetadataDTO::NodeMetadata{};
+
+    EXPECT_EQ(serializeAndParse(dto), nlohmann::json(dto));
+}
+
+// Test that data items with the same name are written once, with the last value
+TEST_F(JsonRpcMessageSerializerUnitTest, SerializeSetMessageKeepsLastDuplicateData) {
+    SetMessageDTO dto;
+    dto.id = 5;
+    dto.schema = "Vehicle";
+    dto.instance = "VIN123";
+    dto.data = {{"Vehicle.Speed", 10}, {"Vehicle.Gear", 3}, {"Vehicle.Speed", 20}};
+
+    std::string out;
+    JsonRpcMessageSerializer::serialize(dto, out);
+
+    const auto first = out.find("\"Vehicle.Speed\"");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_EQ(out.find("\"Vehicle.Speed\"", first + 1), std::string::npos);
+    EXPECT_EQ(nlohmann::json::parse(out)["params"]["data"]["Vehicle.Speed"], 20);
+    EXPECT_EQ(nlohmann::json::parse(out), nlohmann::json(dto));
+}
+
+// Test that scalar values are written like nlohmann::json::dump()
+TEST_F(JsonRpcMessageSerializerUnitTest, AppendValueMatchesDump) {
+    for (const auto& value : {nlohmann::json(1.0), nlohmann::json(0.1), nlohmann::json(-7),
+                              nlohmann::json("\x01tab\t"), nlohmann::json(false)}) {
+        std::string out;
+        JsonRpcMessageSerializer::appendValue(out, value);
+        EXPECT_EQ(out, value.dump());
+    }
+}
@@ -0,0 +1,269 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "artifact_loader.h"
+#include "mock_reasoner_adapter.h"
+#include "mock_reasoner_service.h"
+#include "model_config.h"
+#include "model_config_diff.h"
+#include "model_config_reloader.h"
+
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Return;
+using ::testing::StrEq;
+
+class ModelConfigReloaderUnitTest : public ::testing::Test {
+   protected:
+    std::shared_ptr<MockReasonerAdapter> mock_adapter_;
+    std::shared_ptr<MockReasonerService> mock_reasoner_service_;
+
+    void SetUp() override {
+        setenv("VEHICLE_OBJECT_ID", "VIN123", 0);
+        mock_adapter_ = std::make_shared<MockReasonerAdapter>();
+        EXPECT_CALL(*mock_adapter_, initialize()).Times(1);
+        mock_reasoner_service_ = std::make_shared<MockReasonerService>(mock_adapter_);
+    }
+
+    // Builds a configuration that differs in the given rules, inputs and queries
+    static ModelConfig createModelConfig(const std::vector<std::string>& rules,
+                                         const std::vector<std::string>& inputs = {"Speed"},
+                                         const std::string& output_query = "SELECT ?s",
+                                         const std::string& data_property_query = "data_property") {
+        std::vector<std::pair<RuleLanguageType, std::string>> reasoner_rules;
+        for (const auto& rule : rules) {
+            reasoner_rules.emplace_back(RuleLanguageType::DATALOG, rule);
+        }
+        return ModelConfig(
+            {{SchemaType::VEHICLE, SchemaInputList{inputs}}},
+            {{ReasonerSyntaxType::TURTLE, "ontology"}}, "output/", reasoner_rules,
+            {{ReasonerSyntaxType::TURTLE, "shapes"}},
+            TripleAssemblerHelper({{SchemaType::VEHICLE,
+                                    {{QueryLanguageType::SPARQL, data_property_query},
+                                     {QueryLanguageType::SPARQL, "object_property"}}}}),
+            {{QueryLanguageType::SPARQL, output_query}},
+            ReasonerSettings(InferenceEngineType::RDFOX, ReasonerSyntaxType::TURTLE,
+                             {SchemaType::VEHICLE}, true));
+    }
+
+    // Creates a reloader that loads `next` and records the applied snapshots
+    std::unique_ptr<ModelConfigReloader> createReloader(
+        const ModelConfig& next, std::vector<ModelConfigSnapshot>& applied,
+        ModelConfigReloadSettings settings = ModelConfigReloadSettings()) {
+        return std::make_unique<ModelConfigReloader>(
+            "model_config.json", std::make_shared<const ModelConfig>(createModelConfig({"r1"})),
+            *mock_reasoner_service_,
+            [&applied](ModelConfigSnapshot model_config, const ModelConfigDiff&) {
+                applied.push_back(std::move(model_config));
+            },
+            settings, [next](const std::string&) { return next; });
+    }
+};
+
+// Test that the diff lists the added and removed artifacts and the changed queries
+TEST_F(ModelConfigReloaderUnitTest, DiffListsChangedArtifactsAndQueries) {
+    const ModelConfigDiff diff = ModelConfigDiff::compute(
+        createModelConfig({"r1", "r2"}), createModelConfig({"r2", "r3"}, {"Speed"}, "SELECT ?o"));
+
+    ASSERT_EQ(diff.added_rules.size(), 1u);
+    EXPECT_EQ(diff.added_rules[0].second, "r3");
+    ASSERT_EQ(diff.removed_rules.size(), 1u);
+    EXPECT_EQ(diff.removed_rules[0].second, "r1");
+    EXPECT_TRUE(diff.added_ontologies.empty());
+    EXPECT_TRUE(diff.added_validation_shapes.empty());
+    EXPECT_TRUE(diff.output_queries_changed);
+    EXPECT_FALSE(diff.triple_assembler_queries_changed);
+    EXPECT_FALSE(diff.signal_catalog_changed);
+    EXPECT_TRUE(diff.restart_required.empty());
+    EXPECT_TRUE(diff.hasReasonerChanges());
+
+    EXPECT_TRUE(
+        ModelConfigDiff::compute(createModelConfig({"r1"}), createModelConfig({"r1"})).empty());
+}
+
+// Test that changed inputs are reported as requiring a restart
+TEST_F(ModelConfigReloaderUnitTest, DiffRequiresRestartForChangedInputs) {
+    const ModelConfigDiff diff = ModelConfigDiff::compute(createModelConfig({"r1"}),
+                                                          createModelConfig({"r1"}, {"Gear"}));
+    EXPECT_EQ(diff.restart_required, std::vector<std::string>{"inputs"});
+    EXPECT_TRUE(diff.signal_catalog_changed);
+}
+
+// Test that a reload loads the new rules before it removes the old ones and swaps the snapshot
+TEST_F(ModelConfigReloaderUnitTest, ReloadAppliesReasonerChangesAndSwapsSnapshot) {
+    std::vector<ModelConfigSnapshot> applied;
+    auto reloader = createReloader(createModelConfig({"r2"}), applied);
+
+    const ::testing::InSequence sequence;
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(HasSubstr(ArtifactLoader::FINGERPRINT_GRAPH), _, _))
+        .WillOnce(Return("?fingerprint\n"));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("r2"), RuleLanguageType::DATALOG))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(_, ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, deleteRules(StrEq("r1"), RuleLanguageType::DATALOG))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, deleteData(_, ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+    // Restores the statements r2 shares with r1
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("r2"), RuleLanguageType::DATALOG))
+        .WillOnce(Return(true));
+
+    EXPECT_TRUE(reloader->reload());
+    ASSERT_EQ(applied.size(), 1u);
+    EXPECT_EQ(applied[0], reloader->getModelConfig());
+    EXPECT_EQ(applied[0]->getReasonerRules()[0].second, "r2");
+    EXPECT_EQ(reloader->getStatistics().applied, 1u);
+}
+
+// Test that a configuration requiring a restart is not applied
+TEST_F(ModelConfigReloaderUnitTest, ReloadRejectsChangesRequiringRestart) {
+    std::vector<ModelConfigSnapshot> applied;
+    auto reloader = createReloader(createModelConfig({"r2"}, {"Gear"}), applied);
+    const ModelConfigSnapshot previous = reloader->getModelConfig();
+
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(_, _)).Times(0);
+    EXPECT_CALL(*mock_reasoner_service_, deleteRules(_, _)).Times(0);
+
+    EXPECT_FALSE(reloader->reload());
+    EXPECT_TRUE(applied.empty());
+    EXPECT_EQ(reloader->getModelConfig(), previous);
+    EXPECT_EQ(reloader->getStatistics().rejected, 1u);
+}
+
+// Test that the configuration in use is kept when the reasoner cannot be updated
+TEST_F(ModelConfigReloaderUnitTest, ReloadKeepsConfigurationWhenReasonerUpdateFails) {
+    std::vector<ModelConfigSnapshot> applied;
+    auto reloader = createReloader(createModelConfig({"r1", "r2"}), applied);
+
+    EXPECT_CALL(*mock_reasoner_service_, queryData(_, _, _)).WillOnce(Return("?fingerprint\n"));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("r2"), _)).WillOnce(Return(false));
+
+    EXPECT_FALSE(reloader->reload());
+    EXPECT_TRUE(applied.empty());
+    EXPECT_EQ(reloader->getStatistics().failed, 1u);
+}
+
+// Test that the old rules stay in the reasoner when the new ones cannot be loaded
+TEST_F(ModelConfigReloaderUnitTest, ReloadKeepsRemovedRulesWhenLoadingFails) {
+    std::vector<ModelConfigSnapshot> applied;
+    auto reloader = createReloader(createModelConfig({"r2"}), applied);
+
+    EXPECT_CALL(*mock_reasoner_service_, queryData(_, _, _)).WillOnce(Return("?fingerprint\n"));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("r2"), _)).WillOnce(Return(false));
+    EXPECT_CALL(*mock_reasoner_service_, deleteRules(_, _)).Times(0);
+
+    EXPECT_FALSE(reloader->reload());
+    EXPECT_TRUE(applied.empty());
+    EXPECT_EQ(reloader->getModelConfig()->getReasonerRules()[0].second, "r1");
+    EXPECT_EQ(reloader->getStatistics().failed, 1u);
+}
+
+// Test that a change of the triple assembler queries is applied without touching the reasoner
+TEST_F(ModelConfigReloaderUnitTest, ReloadAppliesChangedTripleAssemblerQueries) {
+    std::vector<ModelConfigSnapshot> applied;
+    auto reloader = createReloader(
+        createModelConfig({"r1"}, {"Speed"}, "SELECT ?s", "new_data_property"), applied);
+
+    EXPECT_CALL(*mock_reasoner_service_, queryData(_, _, _)).Times(0);
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(_, _)).Times(0);
+
+    EXPECT_TRUE(reloader->reload());
+    ASSERT_EQ(applied.size(), 1u);
+    EXPECT_EQ(applied[0]->getQueryPair(SchemaType::VEHICLE).data_property.second,
+              "new_data_property");
+}
+
+// Test that an unchanged or unreadable configuration is not applied
+TEST_F(ModelConfigReloaderUnitTest, ReloadSkipsUnchangedAndInvalidConfiguration) {
+    std::vector<ModelConfigSnapshot> applied;
+    auto reloader = createReloader(createModelConfig({"r1"}), applied);
+    EXPECT_FALSE(reloader->reload());
+
+    ModelConfigReloader failing_reloader(
+        "model_config.json", reloader->getModelConfig(), *mock_reasoner_service_,
+        [&applied](ModelConfigSnapshot model_config, const ModelConfigDiff&) {
+            applied.push_back(std::move(model_config));
+        },
+        ModelConfigReloadSettings(),
+        [](const std::string&) -> ModelConfig { throw std::runtime_error("Invalid JSON"); });
+    EXPECT_FALSE(failing_reloader.reload());
+
+    EXPECT_TRUE(applied.empty());
+    EXPECT_EQ(reloader->getStatistics().unchanged, 1u);
+    EXPECT_EQ(failing_reloader.getStatistics().failed, 1u);
+}
+
+// Test that a configuration with a malformed schedule comment in an output query is not applied
+TEST_F(ModelConfigReloaderUnitTest, ReloadRejectsMalformedOutputQuerySchedule) {
+    std::vector<ModelConfigSnapshot> applied;
+    auto reloader = createReloader(
+        createModelConfig({"r1"}, {"Speed"}, "SELECT ?s #SCHEDULE(interval_ms=5)"), applied);
+
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(_, _)).Times(0);
+
+    EXPECT_FALSE(reloader->reload());
+    EXPECT_TRUE(applied.empty());
+    EXPECT_EQ(reloader->getStatistics().failed, 1u);
+}
+
+// Test that a requested reload runs on the reload thread
+TEST_F(ModelConfigReloaderUnitTest, RequestedReloadRunsOnReloadThread) {
+    std::promise<std::thread::id> reload_thread;
+    ModelConfigReloadSettings settings;
+    settings.reload_on_signal = false;
+    ModelConfigReloader reloader(
+        "model_config.json", std::make_shared<const ModelConfig>(createModelConfig({"r1"})),
+        *mock_reasoner_service_,
+        [&reload_thread](ModelConfigSnapshot, const ModelConfigDiff&) {
+            reload_thread.set_value(std::this_thread::get_id());
+        },
+        settings, [](const std::string&) { return createModelConfig({"r1"}, {"Speed"}, "ASK"); });
+
+    reloader.start();
+    reloader.requestReload();
+    auto future = reload_thread.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+    reloader.stop();
+}
+
+// Test that a changed file in the model directory triggers a reload
+TEST_F(ModelConfigReloaderUnitTest, WatchReloadsOnChangedModelFile) {
+    const std::filesystem::path model_directory =
+        std::filesystem::path(TEST_OUTPUT_DIR) / "model_config_reloader_unit_test";
+    std::filesystem::remove_all(model_directory);
+    std::filesystem::create_directories(model_directory / "rules");
+    const std::filesystem::path rule_file = model_directory / "rules" / "rule.dlog";
+    std::ofstream(rule_file) << "r1";
+
+    std::promise<void> reloaded;
+    ModelConfigReloadSettings settings;
+    settings.reload_on_signal = false;
+    settings.watch_interval = std::chrono::seconds(1);
+    ModelConfigReloader reloader(
+        (model_directory / "model_config.json").string(),
+        std::make_shared<const ModelConfig>(createModelConfig({"r1"})), *mock_reasoner_service_,
+        [&reloaded](ModelConfigSnapshot, const ModelConfigDiff&) { reloaded.set_value(); },
+        settings, [](const std::string&) { return createModelConfig({"r1"}, {"Speed"}, "ASK"); });
+    reloader.start();
+
+    std::filesystem::last_write_time(
+        rule_file, std::filesystem::last_write_time(rule_file) + std::chrono::seconds(10));
+    EXPECT_EQ(reloaded.get_future().wait_for(std::chrono::seconds(5)),
+              std::future_status::ready);
+    reloader.stop();
+    std::filesystem::remove_all(model_directory);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "converter_helper.h"
+#include "node_value.h"
+
+// Test that values are formatted with the shortest representation that reads back the same
+TEST(NodeValueUnitTest, FormatShortestRoundTrip) {
+    EXPECT_EQ(NodeValueFormatter::toString(true), "true");
+    EXPECT_EQ(NodeValueFormatter::toString(std::int64_t{-42}), "-42");
+    EXPECT_EQ(NodeValueFormatter::toString(98.6), "98.6");
+    EXPECT_EQ(NodeValueFormatter::toString(48.137154123456), "48.137154123456");
+    EXPECT_EQ(NodeValueFormatter::toString(std::string("left")), "left");
+    EXPECT_EQ(NodeValueFormatter::formatDouble(std::numeric_limits<double>::infinity()), "INF");
+    EXPECT_EQ(NodeValueFormatter::formatDouble(std::numeric_limits<double>::quiet_NaN()), "NaN");
+}
+
+// Test that the datatype of the literal chooses the lexical form of the value
+TEST(NodeValueUnitTest, FormatLiteralByDatatype) {
+    EXPECT_EQ(NodeValueFormatter::toLiteral(75.0, "xsd:int"), "75");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(75.5, "xsd:int"), "75.5");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(1e21, "xsd:double"), "1e+21");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(1e21, "xsd:decimal"), "1000000000000000000000");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(std::int64_t{75}, "float"), "75");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(true, "xsd:int"), "1");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(std::int64_t{0}, "xsd:boolean"), "false");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(std::string("98.60"), "xsd:float"), "98.60");
+    EXPECT_EQ(NodeValueFormatter::toLiteral(0.1, "xsd:string"), "0.1");
+}
+
+// Test that values are read as numbers only when they are numeric
+TEST(NodeValueUnitTest, ReadAsDouble) {
+    EXPECT_EQ(NodeValueFormatter::toDouble(std::int64_t{3}), 3.0);
+    EXPECT_EQ(NodeValueFormatter::toDouble(std::string("40.5")), 40.5);
+    EXPECT_EQ(NodeValueFormatter::toDouble(std::string("40.5 N")), std::nullopt);
+    EXPECT_EQ(NodeValueFormatter::toDouble(std::string("")), std::nullopt);
+    EXPECT_EQ(NodeValueFormatter::toDouble(true), std::nullopt);
+}
+
+// Test that JSON values convert to node values and back without changing their type
+TEST(NodeValueUnitTest, ConvertJson) {
+    const auto json = nlohmann::json::parse(R"([true, -7, 0.1, "on", 18446744073709551615])");
+
+    EXPECT_EQ(ConverterHelper::toNodeValue(json[0]), NodeValue(true));
+    EXPECT_EQ(ConverterHelper::toNodeValue(json[1]), NodeValue(std::int64_t{-7}));
+    EXPECT_EQ(ConverterHelper::toNodeValue(json[2]), NodeValue(0.1));
+    EXPECT_EQ(ConverterHelper::toNodeValue(json[3]), NodeValue(std::string("on")));
+    EXPECT_EQ(ConverterHelper::toNodeValue(json[4]), NodeValue(18446744073709551615.0));
+    EXPECT_THROW(ConverterHelper::toNodeValue(nlohmann::json::object()), std::runtime_error);
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(ConverterHelper::toJson(ConverterHelper::toNodeValue(json[i])), json[i]);
+    }
+}
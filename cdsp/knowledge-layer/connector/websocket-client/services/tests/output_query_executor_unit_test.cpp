@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "output_query_executor.h"
+
+using namespace std::chrono_literals;
+
+// Test that the tasks run concurrently, but never more of them than the limit
+TEST(OutputQueryExecutorUnitTest, RunsTasksUpToConcurrencyLimit) {
+    OutputQueryExecutor executor(3);
+    EXPECT_EQ(executor.getConcurrency(), 3u);
+
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    std::vector<int> results(9, 0);
+    std::vector<OutputQueryExecutor::Task> tasks;
+    for (std::size_t index = 0; index < results.size(); ++index) {
+        tasks.emplace_back([&, index]() {
+            const int now_running = ++running;
+            int expected = max_running.load();
+            while (now_running > expected &&
+                   !max_running.compare_exchange_weak(expected, now_running)) {
+            }
+            std::this_thread::sleep_for(20ms);
+            results[index] = static_cast<int>(index) * 2;
+            --running;
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    executor.runAll(tasks);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    for (std::size_t index = 0; index < results.size(); ++index) {
+        EXPECT_EQ(results[index], static_cast<int>(index) * 2);
+    }
+    EXPECT_LE(max_running.load(), 3);
+    EXPECT_GT(max_running.load(), 1);
+    EXPECT_LT(elapsed, 9 * 20ms);
+
+    // The executor can be reused
+    executor.runAll(tasks);
+    executor.runAll({});
+}
+
+// Test that a concurrency of 1 runs the tasks in order on the calling thread
+TEST(OutputQueryExecutorUnitTest, SequentialWithoutConcurrency) {
+    OutputQueryExecutor executor(0);
+    EXPECT_EQ(executor.getConcurrency(), 1u);
+
+    std::vector<std::size_t> order;
+    std::vector<OutputQueryExecutor::Task> tasks;
+    for (std::size_t index = 0; index < 4; ++index) {
+        tasks.emplace_back([&order, index]() {
+            EXPECT_EQ(order.size(), index);
+            order.push_back(index);
+        });
+    }
+    executor.runAll(tasks);
+    EXPECT_EQ(order.size(), 4u);
+}
+
+// Test that the exception of a task is rethrown once all tasks have completed
+TEST(OutputQueryExecutorUnitTest, RethrowsTaskExceptionAfterAllTasks) {
+    OutputQueryExecutor executor(2);
+
+    std::atomic<int> completed{0};
+    std::vector<OutputQueryExecutor::Task> tasks = {
+        []() { throw std::runtime_error("query failed"); },
+        [&completed]() {
+            std::this_thread::sleep_for(10ms);
+            ++completed;
+        },
+        [&completed]() { ++completed; },
+    };
+    EXPECT_THROW(executor.runAll(tasks), std::runtime_error);
+    EXPECT_EQ(completed.load(), 2);
+}
+
+// Test that a worker that only starts after runAll() has returned does not touch its tasks
+TEST(OutputQueryExecutorUnitTest, LateWorkerDoesNotTouchCompletedTasks) {
+    auto workers = std::make_shared<boost::asio::thread_pool>(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    boost::asio::post(*workers, [released]() { released.wait(); });
+
+    OutputQueryExecutor executor(2, workers);
+    std::atomic<int> runs{0};
+    {
+        // The pool is blocked, so the calling thread runs all tasks
+        auto tasks = std::make_unique<std::vector<OutputQueryExecutor::Task>>();
+        for (int index = 0; index < 3; ++index) {
+            tasks->emplace_back([&runs]() { ++runs; });
+        }
+        executor.runAll(*tasks);
+        EXPECT_EQ(runs.load(), 3);
+    }
+
+    // The helper posted by runAll() starts now, after its task list is gone
+    release.set_value();
+    workers->join();
+    EXPECT_EQ(runs.load(), 3);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+#include "output_query_scheduler.h"
+
+using namespace std::chrono_literals;
+
+class OutputQuerySchedulerUnitTest : public ::testing::Test {
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+   protected:
+    const OutputQueryScheduler::Clock::time_point start_ = OutputQueryScheduler::Clock::now();
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+
+    static OutputQuerySchedulerSettings makeSettings(std::chrono::milliseconds min_interval,
+                                                     std::chrono::milliseconds debounce,
+                                                     std::chrono::milliseconds max_delay) {
+        OutputQuerySchedulerSettings settings;
+        settings.min_interval = min_interval;
+        settings.debounce = debounce;
+        settings.max_delay = max_delay;
+        return settings;
+    }
+};
+
+// Test that a burst of data runs each query once, after the current batch by default
+TEST_F(OutputQuerySchedulerUnitTest, BurstIsCoalescedIntoOneRun) {
+    OutputQueryScheduler scheduler;
+    EXPECT_FALSE(scheduler.nextDueTime().has_value());
+
+    for (int message = 0; message < 100; ++message) {
+        scheduler.notifyDataArrived("q1", start_);
+        scheduler.notifyDataArrived("q2", start_);
+    }
+    EXPECT_EQ(scheduler.nextDueTime(), start_);
+
+    const auto due_queries = scheduler.takeDueQueries(start_ + 5ms);
+    EXPECT_EQ(due_queries.size(), 2u);
+    EXPECT_EQ(due_queries.count("q1"), 1u);
+    EXPECT_TRUE(scheduler.takeDueQueries(start_ + 10ms).empty());
+    EXPECT_FALSE(scheduler.nextDueTime().has_value());
+
+    const auto statistics = scheduler.getStatistics();
+    EXPECT_EQ(statistics.notifications, 200u);
+    EXPECT_EQ(statistics.coalesced, 198u);
+    EXPECT_EQ(statistics.runs, 2u);
+    EXPECT_EQ(statistics.total_lag, 10ms);
+    EXPECT_EQ(statistics.max_lag, 5ms);
+}
+
+// Test that the debounce waits for the end of a burst, but not longer than the maximum delay
+TEST_F(OutputQuerySchedulerUnitTest, DebounceRunsOnTrailingEdgeWithinMaxDelay) {
+    OutputQueryScheduler scheduler(makeSettings(0ms, 100ms, 250ms));
+
+    scheduler.notifyDataArrived("q", start_);
+    scheduler.notifyDataArrived("q", start_ + 50ms);
+    EXPECT_EQ(scheduler.nextDueTime(), start_ + 150ms);
+    EXPECT_TRUE(scheduler.takeDueQueries(start_ + 149ms).empty());
+    EXPECT_EQ(scheduler.takeDueQueries(start_ + 150ms).size(), 1u);
+
+    // Data that keeps arriving delays the query up to the maximum delay
+    const auto burst_start = start_ + 1s;
+    for (auto offset = 0ms; offset <= 400ms; offset += 50ms) {
+        scheduler.notifyDataArrived("q", burst_start + offset);
+    }
+    EXPECT_EQ(scheduler.nextDueTime(), burst_start + 250ms);
+    EXPECT_EQ(scheduler.getStatistics().max_lag, 150ms);
+}
+
+// Test that a query does not run more often than its minimum interval
+TEST_F(OutputQuerySchedulerUnitTest, MinimumIntervalLimitsRuns) {
+    OutputQueryScheduler scheduler(makeSettings(200ms, 0ms, 1000ms));
+
+    scheduler.notifyDataArrived("q", start_);
+    EXPECT_EQ(scheduler.takeDueQueries(start_).size(), 1u);
+
+    scheduler.notifyDataArrived("q", start_ + 10ms);
+    EXPECT_EQ(scheduler.nextDueTime(), start_ + 200ms);
+    EXPECT_TRUE(scheduler.takeDueQueries(start_ + 100ms).empty());
+    EXPECT_EQ(scheduler.takeDueQueries(start_ + 200ms).size(), 1u);
+
+    scheduler.clear();
+    EXPECT_FALSE(scheduler.nextDueTime().has_value());
+}
+
+// Test that a query overrides the default settings with its schedule comment
+TEST_F(OutputQuerySchedulerUnitTest, QueryScheduleCommentOverridesDefaults) {
+    const OutputQuerySchedulerSettings defaults = makeSettings(10ms, 20ms, 30ms);
+    const auto settings = defaults.forQuery(
+        "SELECT * WHERE { ?s ?p ?o } #SCHEDULE(min_interval_ms=500, debounce_ms = 0)");
+    EXPECT_EQ(settings.min_interval, 500ms);
+    EXPECT_EQ(settings.debounce, 0ms);
+    EXPECT_EQ(settings.max_delay, 30ms);
+    EXPECT_EQ(defaults.forQuery("SELECT * WHERE { ?s ?p ?o }").min_interval, 10ms);
+
+    EXPECT_THROW(defaults.forQuery("#SCHEDULE(interval_ms=5)"), std::invalid_argument);
+    EXPECT_THROW(defaults.forQuery("#SCHEDULE(debounce_ms=-5)"), std::invalid_argument);
+    EXPECT_THROW(defaults.forQuery("#SCHEDULE(debounce_ms=5\n)"), std::invalid_argument);
+
+    OutputQueryScheduler scheduler(defaults);
+    EXPECT_THROW(scheduler.notifyDataArrived("#SCHEDULE(max_delay_ms)", start_),
+                 std::invalid_argument);
+    EXPECT_FALSE(scheduler.nextDueTime().has_value());
+}
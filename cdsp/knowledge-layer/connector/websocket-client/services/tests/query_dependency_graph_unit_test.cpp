@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "query_dependency_graph.h"
+#include "signal_catalog.h"
+
+class QueryDependencyGraphUnitTest : public ::testing::Test {
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+   protected:
+    SignalCatalog catalog_;
+    SignalId angle_ = 0;
+    SignalId speed_ = 0;
+    SignalId latitude_ = 0;
+    SignalId voltage_ = 0;
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+
+    void SetUp() override {
+        const std::string shapes = R"(
+@prefix sh: <http://www.w3.org/ns/shacl#> .
+@prefix car: <http://example.ontology.com/car#> .
+@prefix val: <http://example.ontology.com/validation#> .
+
+val:VehicleShape a sh:NodeShape ;
+    sh:name "Vehicle" ;
+    sh:property [ sh:name "Speed" ; sh:path car:speed ] ;
+    sh:property [ sh:name "Latitude" ; sh:path <http://example.ontology.com/car#latitude> ] ;
+    sh:property [ sh:name "NominalVoltage" ; sh:path car:nominalVoltage ] ;
+    sh:property [ sh:name "SteeringWheel" ; sh:node val:SteeringWheelShape ] .
+
+val:SteeringWheelShape a sh:NodeShape ;
+    sh:name "SteeringWheel" ;
+    sh:property [ sh:name "Angle" ; sh:path car:angle ] .
+)";
+        catalog_.addSignalsFromShapes(shapes, {"Vehicle"});
+        angle_ = catalog_.find("Vehicle.SteeringWheel.Angle");
+        speed_ = catalog_.find("Vehicle.Speed");
+        latitude_ = catalog_.find("Vehicle.Latitude");
+        voltage_ = catalog_.find("Vehicle.NominalVoltage");
+    }
+};
+
+// Test that the input signals of a query are found through the rules that derive its terms
+TEST_F(QueryDependencyGraphUnitTest, FollowsRulesToSignalPredicates) {
+    const std::string rules = R"(
+@prefix car: <http://example.ontology.com/car#> .
+@prefix sosa: <http://www.w3.org/ns/sosa/> .
+
+# A large angle change, angle > 180
+car:LargeAngleChange[?lac],
+car:hasAngleDiff[?lac, ?diff] :-
+    sosa:observedProperty[?obs, car:angle],
+    sosa:hasSimpleResult[?obs, ?angle],
+    FILTER(?angle > 180.5).
+
+car:HighSpeed[?obs] :-
+    sosa:observedProperty[?obs, car:speed],
+    sosa:hasSimpleResult[?obs, ?speed],
+    FILTER(?speed >= 10).
+
+car:Segment[?lac], car:hasHighSpeed[?lac, ?obs] :-
+    car:LargeAngleChange[?lac], car:HighSpeed[?obs], BIND("car:latitude" AS ?label).
+
+car:FixPoint[?loc] :- car:latitude[?loc, ?lat].
+)";
+    const std::vector<ReasoningOutputQuery> queries = {
+        {QueryLanguageType::SPARQL,
+         "PREFIX car: <http://example.ontology.com/car#>\n"
+         "SELECT ?diff WHERE { ?s a car:Segment ; car:hasAngleDiff ?diff . "
+         "FILTER(?diff <= 4) } # car:nominalVoltage"},
+        {QueryLanguageType::SPARQL,
+         "SELECT ?lat WHERE { ?p <http://example.ontology.com/car#latitude> ?lat }"},
+        {QueryLanguageType::SPARQL, "SELECT ?s ?p ?o WHERE { ?s ?p ?o }"},
+    };
+
+    const QueryDependencyGraph graph({{RuleLanguageType::DATALOG, rules}}, queries, catalog_);
+    ASSERT_EQ(graph.size(), 3u);
+
+    // The segment is derived from the angle and speed rules; literals and comments do not count
+    EXPECT_EQ(graph.getInputSignals(0), (std::vector<SignalId>{speed_, angle_}));
+    EXPECT_TRUE(graph.dependsOn(0, angle_));
+    EXPECT_TRUE(graph.dependsOn(0, speed_));
+    EXPECT_FALSE(graph.dependsOn(0, latitude_));
+    EXPECT_FALSE(graph.dependsOn(0, voltage_));
+    EXPECT_FALSE(graph.dependsOnAllSignals(0));
+
+    EXPECT_EQ(graph.getInputSignals(1), (std::vector<SignalId>{latitude_}));
+    EXPECT_FALSE(graph.dependsOn(1, speed_));
+
+    // Signals outside of the catalog are inputs of every query
+    EXPECT_TRUE(graph.dependsOn(1, SignalCatalog::UNKNOWN_SIGNAL));
+}
+
+// Test that comments and literals in rule bodies and queries are skipped, even with a `.` or `,`
+TEST_F(QueryDependencyGraphUnitTest, SkipsCommentsAndLiteralsInRuleBodies) {
+    const std::string rules = R"(
+@prefix car: <http://example.ontology.com/car#> .
+@prefix sosa: <http://www.w3.org/ns/sosa/> .
+
+# car:Tagged[?obs] :- car:nominalVoltage[?obs, ?v] .
+car:Labeled[?obs] :-
+    sosa:observedProperty[?obs, car:angle],  # Not car:nominalVoltage, see car:latitude.
+    BIND("car:nominalVoltage[?obs, ?v]. car:Tagged[?x] :- car:latitude[?x, ?y], " AS ?label),
+    BIND('car:latitude. \' car:nominalVoltage, ' AS ?other) .
+car:Tagged[?obs] :- car:Labeled[?obs], sosa:hasSimpleResult[?obs, ?v], car:speed[?obs, ?v] .
+)";
+    const std::vector<ReasoningOutputQuery> queries = {
+        {QueryLanguageType::SPARQL,
+         "PREFIX car: <http://example.ontology.com/car#>\n"
+         "# SELECT ?o WHERE { ?o car:latitude ?v }\n"
+         "SELECT ?o WHERE { ?o a car:Tagged . FILTER(?o != \"car:nominalVoltage, ?p. ?s ?p\") }"},
+    };
+
+    const QueryDependencyGraph graph({{RuleLanguageType::DATALOG, rules}}, queries, catalog_);
+    EXPECT_EQ(graph.getInputSignals(0), (std::vector<SignalId>{speed_, angle_}));
+}
+
+// Test that a query that reaches no signal predicate depends on all signals
+TEST_F(QueryDependencyGraphUnitTest, GenericQueryDependsOnAllSignals) {
+    const std::vector<ReasoningOutputQuery> queries = {
+        {QueryLanguageType::SPARQL, "SELECT ?s ?p ?o WHERE { ?s ?p ?o }"}};
+
+    const QueryDependencyGraph graph({}, queries, catalog_);
+    EXPECT_TRUE(graph.dependsOnAllSignals(0));
+    EXPECT_TRUE(graph.getInputSignals(0).empty());
+    EXPECT_TRUE(graph.dependsOn(0, voltage_));
+    EXPECT_TRUE(graph.dependsOn(1, voltage_));
+    EXPECT_THROW(static_cast<void>(graph.getInputSignals(1)), std::out_of_range);
+
+    const QueryDependencyGraph empty_graph;
+    EXPECT_EQ(empty_graph.size(), 0u);
+    EXPECT_TRUE(empty_graph.dependsOn(0, angle_));
+}
+
+// Test that a signal no shape maps to a predicate is an input of every query
+TEST_F(QueryDependencyGraphUnitTest, UnmappedSignalIsInputOfEveryQuery) {
+    const SignalId gear = catalog_.addSignal("Vehicle.Powertrain.Gear");
+    const std::vector<ReasoningOutputQuery> queries = {
+        {QueryLanguageType::SPARQL,
+         "SELECT ?v WHERE { ?s <http://example.ontology.com/car#speed> ?v }"}};
+
+    const QueryDependencyGraph graph({}, queries, catalog_);
+    EXPECT_FALSE(graph.dependsOnAllSignals(0));
+    EXPECT_TRUE(graph.dependsOn(0, speed_));
+    EXPECT_TRUE(graph.dependsOn(0, gear));
+    EXPECT_FALSE(graph.dependsOn(0, angle_));
+    EXPECT_EQ(graph.getInputSignals(0), (std::vector<SignalId>{speed_, gear}));
+}
+
+// Test that a variable predicate in a query or in a rule it reaches depends on all signals
+TEST_F(QueryDependencyGraphUnitTest, VariablePredicateDependsOnAllSignals) {
+    const std::string rules = R"(
+@prefix car: <http://example.ontology.com/car#> .
+
+car:Fast[?v] :- car:speed[?v, ?speed], FILTER(?speed > 100).
+car:Annotated[?s] :- [?s, ?p, ?o], car:speed[?s, ?v].
+)";
+    const std::vector<ReasoningOutputQuery> queries = {
+        {QueryLanguageType::SPARQL,
+         "PREFIX car: <http://example.ontology.com/car#>\n"
+         "SELECT ?v ?p ?o WHERE { ?v a car:Fast ; ?p ?o . FILTER(?o != ?v) }"},
+        {QueryLanguageType::SPARQL,
+         "PREFIX car: <http://example.ontology.com/car#>\n"
+         "SELECT ?s WHERE { ?s a car:Annotated }"},
+        {QueryLanguageType::SPARQL,
+         "PREFIX car: <http://example.ontology.com/car#>\n"
+         "SELECT ?s ?v ?a WHERE { ?s a car:Fast ; car:speed ?v . "
+         "OPTIONAL { [ car:angle ?a ] } FILTER(BOUND(?v)) } ORDER BY ?s ?v ?a"},
+    };
+
+    const QueryDependencyGraph graph({{RuleLanguageType::DATALOG, rules}}, queries, catalog_);
+    EXPECT_TRUE(graph.dependsOnAllSignals(0));
+    EXPECT_TRUE(graph.dependsOn(0, voltage_));
+    EXPECT_TRUE(graph.dependsOnAllSignals(1));
+    EXPECT_TRUE(graph.dependsOn(1, latitude_));
+
+    // Variables in the object position, in expressions and outside of the patterns do not count
+    EXPECT_EQ(graph.getInputSignals(2), (std::vector<SignalId>{speed_, angle_}));
+}
+
+// Test that a rule with a variable predicate in its head is followed from every query
+TEST_F(QueryDependencyGraphUnitTest, RuleWithVariableHeadIsFollowedFromEveryQuery) {
+    const std::string rules = R"(
+@prefix car: <http://example.ontology.com/car#> .
+
+[?s, ?p, ?o] :- [?s, car:alias, ?t], car:latitude[?t, ?o], BIND(car:speed AS ?p).
+)";
+    const std::vector<ReasoningOutputQuery> queries = {
+        {QueryLanguageType::SPARQL,
+         "SELECT ?v WHERE { ?s <http://example.ontology.com/car#speed> ?v }"}};
+
+    const QueryDependencyGraph graph({{RuleLanguageType::DATALOG, rules}}, queries, catalog_);
+    EXPECT_EQ(graph.getInputSignals(0), (std::vector<SignalId>{speed_, latitude_}));
+
+    const std::string copying_rules = "[?t, ?p, ?o] :- [?s, ?p, ?o], [?s, <urn:sameAs>, ?t] .";
+    const QueryDependencyGraph copying_graph({{RuleLanguageType::DATALOG, copying_rules}}, queries,
+                                             catalog_);
+    EXPECT_TRUE(copying_graph.dependsOnAllSignals(0));
+    EXPECT_TRUE(copying_graph.dependsOn(0, voltage_));
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+#include "request_registry.h"
+
+class RequestRegistryUnitTest : public ::testing::Test {
+   protected:
+    static RequestInfo makeRequest(RequestInfo::Type type, const std::string& path) {
+        return RequestInfo{type, "Vehicle", "VIN123", path};
+    }
+};
+
+// Test that requests can be found by identifier and by their metadata
+TEST_F(RequestRegistryUnitTest, FindRequestsByIdentifierAndMetadata) {
+    RequestRegistry registry;
+    const int subscribe_id = registry.addRequest(makeRequest(RequestInfo::SUBSCRIBE, "Speed"));
+    const int first_get_id = registry.addRequest(makeRequest(RequestInfo::GET, "Speed"));
+    const int second_get_id = registry.addRequest(makeRequest(RequestInfo::GET, "Speed"));
+
+    ASSERT_NE(registry.getRequest(subscribe_id), nullptr);
+    EXPECT_EQ(*registry.getRequest(subscribe_id), makeRequest(RequestInfo::SUBSCRIBE, "Speed"));
+    EXPECT_EQ(registry.findRequestId(makeRequest(RequestInfo::SUBSCRIBE, "Speed")), subscribe_id);
+    EXPECT_EQ(registry.findRequestId(makeRequest(RequestInfo::GET, "Speed")), first_get_id);
+    EXPECT_FALSE(registry.findRequestId(makeRequest(RequestInfo::SET, "Speed")).has_value());
+    EXPECT_FALSE(registry.findRequestId(RequestInfo{RequestInfo::GET, "Vehicle", "VIN123",
+                                                    std::nullopt})
+                     .has_value());
+
+    // The reverse index moves on to the remaining request with the same metadata
+    registry.removeRequest(first_get_id);
+    EXPECT_EQ(registry.getRequest(first_get_id), nullptr);
+    EXPECT_EQ(registry.findRequestId(makeRequest(RequestInfo::GET, "Speed")), second_get_id);
+    registry.removeRequest(second_get_id);
+    EXPECT_FALSE(registry.findRequestId(makeRequest(RequestInfo::GET, "Speed")).has_value());
+
+    EXPECT_EQ(registry.size(), 1u);
+    EXPECT_EQ(registry.getStatistics().added, 3u);
+    EXPECT_EQ(registry.getStatistics().removed, 2u);
+}
+
+// Test that unanswered GET/SET requests expire after the TTL while subscriptions stay
+TEST_F(RequestRegistryUnitTest, ExpireOrphanedRequests) {
+    RequestRegistry registry(std::chrono::seconds(10));
+    const int subscribe_id = registry.addRequest(makeRequest(RequestInfo::SUBSCRIBE, "Speed"));
+    const int get_id = registry.addRequest(makeRequest(RequestInfo::GET, "Speed"));
+    const int set_id = registry.addRequest(makeRequest(RequestInfo::SET, "Gear"));
+    registry.removeRequest(set_id);
+
+    EXPECT_EQ(registry.expireRequests(RequestRegistry::Clock::now()), 0u);
+    EXPECT_EQ(registry.expireRequests(RequestRegistry::Clock::now() + std::chrono::seconds(11)),
+              1u);
+
+    EXPECT_NE(registry.getRequest(subscribe_id), nullptr);
+    EXPECT_EQ(registry.getRequest(get_id), nullptr);
+    EXPECT_FALSE(registry.findRequestId(makeRequest(RequestInfo::GET, "Speed")).has_value());
+    EXPECT_EQ(registry.getStatistics().expired, 1u);
+}
+
+// Test that the oldest GET/SET requests are evicted when the registry is full
+TEST_F(RequestRegistryUnitTest, EvictOldestRequestsWhenFull) {
+    RequestRegistry registry(std::chrono::minutes(1), 3);
+    const int subscribe_id = registry.addRequest(makeRequest(RequestInfo::SUBSCRIBE, "Speed"));
+    const int first_get_id = registry.addRequest(makeRequest(RequestInfo::GET, "A"));
+    const int second_get_id = registry.addRequest(makeRequest(RequestInfo::GET, "B"));
+    const int third_get_id = registry.addRequest(makeRequest(RequestInfo::GET, "C"));
+
+    EXPECT_EQ(registry.size(), 3u);
+    EXPECT_EQ(registry.getRequest(first_get_id), nullptr);
+    EXPECT_NE(registry.getRequest(second_get_id), nullptr);
+    EXPECT_NE(registry.getRequest(third_get_id), nullptr);
+    EXPECT_NE(registry.getRequest(subscribe_id), nullptr);
+    EXPECT_EQ(registry.getStatistics().evicted, 1u);
+
+    // Subscriptions are never evicted
+    RequestRegistry subscriptions(std::chrono::minutes(1), 1);
+    subscriptions.addRequest(makeRequest(RequestInfo::SUBSCRIBE, "Speed"));
+    EXPECT_THROW(subscriptions.addRequest(makeRequest(RequestInfo::SUBSCRIBE, "Gear")),
+                 std::runtime_error);
+}
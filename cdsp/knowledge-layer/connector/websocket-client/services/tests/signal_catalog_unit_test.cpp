@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "signal_catalog.h"
+
+// Test that signals get dense IDs in insertion order and keep their path segments
+TEST(SignalCatalogUnitTest, InternsSignals) {
+    SignalCatalog catalog;
+
+    EXPECT_EQ(catalog.addSignal("Vehicle.Speed"), 0u);
+    EXPECT_EQ(catalog.addSignal("Vehicle.CurrentLocation.Latitude"), 1u);
+    EXPECT_EQ(catalog.addSignal("Vehicle.Speed"), 0u);
+    EXPECT_EQ(catalog.size(), 2u);
+
+    EXPECT_EQ(catalog.find("Vehicle.CurrentLocation.Latitude"), 1u);
+    EXPECT_EQ(catalog.find("Vehicle.Unknown"), SignalCatalog::UNKNOWN_SIGNAL);
+    EXPECT_EQ(catalog.getPath(1), "Vehicle.CurrentLocation.Latitude");
+    EXPECT_EQ(catalog.getSegments(1),
+              (std::vector<std::string>{"Vehicle", "CurrentLocation", "Latitude"}));
+    EXPECT_THROW(catalog.addSignal(""), std::invalid_argument);
+
+    // Copies index their own paths
+    SignalCatalog copy;
+    {
+        const SignalCatalog original = catalog;
+        copy = original;
+    }
+    EXPECT_EQ(copy.find("Vehicle.CurrentLocation.Latitude"), 1u);
+}
+
+// Test that the leaf properties of the SHACL node shapes below a root shape become signals
+TEST(SignalCatalogUnitTest, AddsSignalsFromShapes) {
+    const std::string shapes = R"(
+@prefix sh: <http://www.w3.org/ns/shacl#> .
+@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .
+@prefix car: <http://example.ontology.com/car#> .
+@prefix val: <http://www.w3.org/2001/XMLSchema#> .
+
+# The root shape
+val:VehicleShape a sh:NodeShape ;
+    sh:name "Vehicle" ;
+    sh:property [
+        sh:name "CurrentLocation" ;
+        sh:path car:hasSignal ;
+        sh:node val:CurrentLocationShape ;
+    ] ;
+    sh:property [ sh:name "Speed" ; sh:path car:speed ; sh:datatype xsd:float ] .
+
+val:CurrentLocationShape a sh:NodeShape ;
+    sh:name "CurrentLocation" ;
+    sh:property [ sh:name "Latitude" ; sh:datatype xsd:double ] , [
+        sh:name "Longitude" ; sh:datatype xsd:double ;
+    ] ;
+    sh:property [ sh:name "Self" ; sh:node val:CurrentLocationShape ] ;
+    sh:property [ sh:name "Altitude" ; sh:node <http://www.w3.org/2001/XMLSchema#AltitudeShape> ] .
+
+@prefix shacl: <http://www.w3.org/ns/shacl#> .
+
+# Shapes may use any prefix for SHACL, and literals may span lines
+<http://www.w3.org/2001/XMLSchema#AltitudeShape>
+    <http://www.w3.org/1999/02/22-rdf-syntax-ns#type> shacl:NodeShape ;
+    shacl:name "Altitude" ;
+    shacl:description """The altitude ;
+        sh:property [ sh:name "Ignored" ] ."""@en ;
+    shacl:property [ shacl:name "Value" ; shacl:path car:altitude ] ,
+        [ shacl:name "Accuracy" ; shacl:path ( car:hasAccuracy car:value ) ] .
+
+val:ObservationShape a sh:NodeShape ;
+    sh:name "Observation" ;
+    sh:property [ sh:name "Value" ; sh:datatype xsd:string ] .
+)";
+    SignalCatalog catalog;
+    catalog.addSignal("Vehicle.Speed");
+
+    EXPECT_EQ(catalog.addSignalsFromShapes(shapes, {"Vehicle"}), 4u);
+    EXPECT_EQ(catalog.size(), 5u);
+    EXPECT_EQ(catalog.find("Vehicle.Speed"), 0u);
+    EXPECT_NE(catalog.find("Vehicle.CurrentLocation.Latitude"), SignalCatalog::UNKNOWN_SIGNAL);
+    EXPECT_NE(catalog.find("Vehicle.CurrentLocation.Longitude"), SignalCatalog::UNKNOWN_SIGNAL);
+    EXPECT_EQ(catalog.find("Vehicle.CurrentLocation.Altitude.Ignored"),
+              SignalCatalog::UNKNOWN_SIGNAL);
+    EXPECT_EQ(catalog.find("Observation.Value"), SignalCatalog::UNKNOWN_SIGNAL);
+
+    // The sh:path of a leaf property is the predicate of its signal
+    EXPECT_EQ(catalog.getPredicate(0), "http://example.ontology.com/car#speed");
+    EXPECT_EQ(catalog.getPredicate(catalog.find("Vehicle.CurrentLocation.Latitude")), "");
+    EXPECT_EQ(catalog.getPredicate(catalog.find("Vehicle.CurrentLocation.Altitude.Value")),
+              "http://example.ontology.com/car#altitude");
+    // A property path is not a single predicate
+    EXPECT_EQ(catalog.getPredicate(catalog.find("Vehicle.CurrentLocation.Altitude.Accuracy")),
+              "");
+
+    // Documents that are not SHACL Turtle do not add signals
+    EXPECT_EQ(catalog.addSignalsFromShapes("<a> <b> \"c\" . [ ( ] ;", {"Vehicle"}), 0u);
+}
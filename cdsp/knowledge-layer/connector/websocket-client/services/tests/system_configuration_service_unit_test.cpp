@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "system_configuration_service.h"
+
+class SystemConfigurationServiceUnitTest : public ::testing::Test {
+   protected:
+    void TearDown() override {
+        unsetenv("WEBSOCKET_DEFLATE_ENABLED");
+        unsetenv("WEBSOCKET_DEFLATE_WINDOW_BITS");
+        unsetenv("WEBSOCKET_DEFLATE_LEVEL");
+        unsetenv("WEBSOCKET_DEFLATE_MIN_SIZE");
+    }
+
+    static WSCompressionSettings loadCompressionSettings() {
+        return SystemConfigurationService::loadSystemConfig("localhost", "8080", "", "localhost",
+                                                            "12110", "", "ds", "cdsp")
+            .websocket_server.compression;
+    }
+};
+
+// Test that compression is disabled with the default settings when no variable is set
+TEST_F(SystemConfigurationServiceUnitTest, CompressionDefaultsWithoutEnvironment) {
+    const WSCompressionSettings settings = loadCompressionSettings();
+
+    EXPECT_FALSE(settings.enabled);
+    EXPECT_EQ(settings.max_window_bits, 15);
+    EXPECT_EQ(settings.compression_level, 8);
+    EXPECT_EQ(settings.min_message_size, 0u);
+}
+
+// Test that the compression settings are read from the WEBSOCKET_DEFLATE_* variables
+TEST_F(SystemConfigurationServiceUnitTest, CompressionSettingsAreReadFromEnvironment) {
+    setenv("WEBSOCKET_DEFLATE_ENABLED", "TRUE", 1);
+    setenv("WEBSOCKET_DEFLATE_WINDOW_BITS", "9", 1);
+    setenv("WEBSOCKET_DEFLATE_LEVEL", "0", 1);
+    setenv("WEBSOCKET_DEFLATE_MIN_SIZE", "256", 1);
+
+    WSCompressionSettings settings = loadCompressionSettings();
+    EXPECT_TRUE(settings.enabled);
+    EXPECT_EQ(settings.max_window_bits, 9);
+    EXPECT_EQ(settings.compression_level, 0);
+    EXPECT_EQ(settings.min_message_size, 256u);
+
+    setenv("WEBSOCKET_DEFLATE_ENABLED", "1", 1);
+    EXPECT_TRUE(loadCompressionSettings().enabled);
+    setenv("WEBSOCKET_DEFLATE_ENABLED", " false ", 1);
+    EXPECT_FALSE(loadCompressionSettings().enabled);
+    setenv("WEBSOCKET_DEFLATE_ENABLED", "yes", 1);
+    EXPECT_THROW(loadCompressionSettings(), std::invalid_argument);
+    unsetenv("WEBSOCKET_DEFLATE_ENABLED");
+}
+
+// Test that values that are no integers or out of their range are rejected
+TEST_F(SystemConfigurationServiceUnitTest, InvalidCompressionSettingsThrow) {
+    setenv("WEBSOCKET_DEFLATE_WINDOW_BITS", "16", 1);
+    EXPECT_THROW(loadCompressionSettings(), std::invalid_argument);
+    setenv("WEBSOCKET_DEFLATE_WINDOW_BITS", "8", 1);
+    EXPECT_THROW(loadCompressionSettings(), std::invalid_argument);
+    setenv("WEBSOCKET_DEFLATE_WINDOW_BITS", "12bits", 1);
+    EXPECT_THROW(loadCompressionSettings(), std::invalid_argument);
+    unsetenv("WEBSOCKET_DEFLATE_WINDOW_BITS");
+
+    setenv("WEBSOCKET_DEFLATE_LEVEL", "-1", 1);
+    EXPECT_THROW(loadCompressionSettings(), std::invalid_argument);
+    unsetenv("WEBSOCKET_DEFLATE_LEVEL");
+
+    setenv("WEBSOCKET_DEFLATE_MIN_SIZE", "big", 1);
+    EXPECT_THROW(loadCompressionSettings(), std::invalid_argument);
+    setenv("WEBSOCKET_DEFLATE_MIN_SIZE", "99999999999999999999", 1);
+    EXPECT_THROW(loadCompressionSettings(), std::invalid_argument);
+}
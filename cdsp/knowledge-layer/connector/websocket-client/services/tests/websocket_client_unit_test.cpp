@@ -0,0 +1,317 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mock_i_output_sink.h"
+#include "mock_reasoner_adapter.h"
+#include "mock_reasoner_service.h"
+#include "model_config.h"
+#include "model_config_diff.h"
+#include "websocket_client.h"
+#include "websocket_interface.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::HasSubstr;
+using ::testing::NiceMock;
+using ::testing::Return;
+using namespace std::chrono_literals;
+
+/**
+ * @brief A WebSocket server in memory. It completes the operations of the client on its IO
+ * context, answers every request with a success status and sends the queued data notifications
+ * for the subscription once the requests are answered.
+ */
+class FakeWebSocketConnection : public WebSocketClientInterface {
+   public:
+    void attach(const std::shared_ptr<WebSocketClient>& client) { client_ = client; }
+
+    void addNotification(nlohmann::json data) { notifications_.push_back(std::move(data)); }
+
+    void asyncResolve(const std::string&, const std::string&) override {
+        post([](WebSocketClient& client) { client.onConnect({}, {}); });
+    }
+
+    void asyncConnect() override {}
+
+    void asyncHandshake() override {
+        post([](WebSocketClient& client) { client.handshake({}); });
+    }
+
+    void asyncWrite(std::shared_ptr<const std::string> message) override {
+        EXPECT_FALSE(write_pending_) << "Two writes are pending at the same time";
+        write_pending_ = true;
+        const auto json_message = nlohmann::json::parse(*message);
+        written_.push_back(json_message);
+        if (json_message.value("method", "") == "subscribe") {
+            subscription_id_ = json_message["id"].get<int>();
+        }
+        replies_.push_back({{"jsonrpc", "2.0"},
+                            {"id", json_message["id"]},
+                            {"result", nlohmann::json::object()}});
+
+        const std::size_t size = message->size();
+        post([this, size](WebSocketClient& client) {
+            write_pending_ = false;
+            client.onSendMessage({}, size);
+        });
+        deliverNext();
+    }
+
+    void asyncRead() override {
+        EXPECT_FALSE(read_pending_) << "Two reads are pending at the same time";
+        read_pending_ = true;
+        deliverNext();
+    }
+
+    std::string_view getReceivedMessage() override { return received_; }
+
+    void consumeBuffer(std::size_t) override { received_.clear(); }
+
+    // Messages the client wrote, in order
+    std::vector<nlohmann::json> getWrittenMessages(const std::string& method) const {
+        std::vector<nlohmann::json> messages;
+        for (const auto& message : written_) {
+            if (message.value("method", "") == method) {
+                messages.push_back(message);
+            }
+        }
+        return messages;
+    }
+
+   private:
+    std::weak_ptr<WebSocketClient> client_;
+    std::deque<nlohmann::json> replies_;
+    std::deque<nlohmann::json> notifications_;
+    std::vector<nlohmann::json> written_;
+    std::string received_;
+    std::optional<int> subscription_id_;
+    bool read_pending_ = false;
+    bool read_scheduled_ = false;
+    bool write_pending_ = false;
+
+    template <typename Handler>
+    void post(Handler handler) {
+        auto client = client_.lock();
+        boost::asio::post(client->getIoContext(),
+                          [client, handler = std::move(handler)]() { handler(*client); });
+    }
+
+    // Completes a pending read with the next reply or notification, if there is one
+    void deliverNext() {
+        if (!read_pending_ || read_scheduled_) {
+            return;
+        }
+        nlohmann::json message;
+        if (!replies_.empty()) {
+            message = std::move(replies_.front());
+            replies_.pop_front();
+        } else if (subscription_id_ && !notifications_.empty()) {
+            message = {{"jsonrpc", "2.0"},
+                       {"id", *subscription_id_},
+                       {"result", {{"data", std::move(notifications_.front())}}}};
+            notifications_.pop_front();
+        } else {
+            // The server is idle, the read stays pending
+            return;
+        }
+        read_scheduled_ = true;
+        post([this, message = message.dump()](WebSocketClient& client) {
+            read_pending_ = false;
+            read_scheduled_ = false;
+            received_ = message;
+            client.onReceiveMessage({}, received_.size());
+        });
+    }
+};
+
+class WebSocketClientUnitTest : public ::testing::Test {
+   protected:
+    const std::string VIN = "VIN123";
+
+    std::shared_ptr<NiceMock<MockReasonerAdapter>> mock_adapter_;
+    std::shared_ptr<NiceMock<MockReasonerService>> mock_reasoner_service_;
+    std::shared_ptr<NiceMock<MockIOutputSink>> mock_output_sink_;
+    std::shared_ptr<FakeWebSocketConnection> connection_;
+
+    void SetUp() override {
+        setenv("VEHICLE_OBJECT_ID", VIN.c_str(), 1);
+        mock_adapter_ = std::make_shared<NiceMock<MockReasonerAdapter>>();
+        mock_reasoner_service_ = std::make_shared<NiceMock<MockReasonerService>>(mock_adapter_);
+        mock_output_sink_ = std::make_shared<NiceMock<MockIOutputSink>>();
+        connection_ = std::make_shared<FakeWebSocketConnection>();
+
+        // The triple assembler finds no terms for the signals, so no triples are generated
+        ON_CALL(*mock_reasoner_service_, checkDataStore()).WillByDefault(Return(true));
+        ON_CALL(*mock_reasoner_service_, loadData(_, _)).WillByDefault(Return(true));
+        EXPECT_CALL(*mock_reasoner_service_, queryData(_, _, _))
+            .Times(AnyNumber())
+            .WillRepeatedly(Return(""));
+    }
+
+    static ModelConfigSnapshot createModelConfig(const std::vector<std::string>& output_queries) {
+        std::vector<ReasoningOutputQuery> queries;
+        for (const auto& query : output_queries) {
+            queries.push_back({QueryLanguageType::SPARQL, query});
+        }
+        return std::make_shared<const ModelConfig>(
+            std::map<SchemaType, SchemaInputList>{
+                {SchemaType::VEHICLE, SchemaInputList{{"Speed"}}}},
+            std::vector<std::pair<ReasonerSyntaxType, std::string>>{}, "output/",
+            std::vector<std::pair<RuleLanguageType, std::string>>{
+                {RuleLanguageType::DATALOG, "rule"}},
+            std::vector<std::pair<ReasonerSyntaxType, std::string>>{
+                {ReasonerSyntaxType::TURTLE, "shapes"}},
+            TripleAssemblerHelper({{SchemaType::VEHICLE,
+                                    {{QueryLanguageType::SPARQL, "object_property"},
+                                     {QueryLanguageType::SPARQL, "data_property"}}}}),
+            queries,
+            ReasonerSettings(InferenceEngineType::RDFOX, ReasonerSyntaxType::TURTLE,
+                             {SchemaType::VEHICLE}, false));
+    }
+
+    std::shared_ptr<WebSocketClient> createClient(ModelConfigSnapshot model_config,
+                                                  OutputQuerySchedulerSettings settings) {
+        auto client = std::make_shared<WebSocketClient>(
+            SystemConfig(), std::move(model_config), mock_reasoner_service_, mock_output_sink_,
+            connection_, ReasoningResultCacheSettings(), settings);
+        connection_->attach(client);
+        return client;
+    }
+
+    static OutputQuerySchedulerSettings createSchedulerSettings(std::size_t max_concurrency) {
+        OutputQuerySchedulerSettings settings;
+        settings.debounce = 100ms;
+        settings.max_delay = 1000ms;
+        settings.max_concurrency = max_concurrency;
+        return settings;
+    }
+
+    static std::string createSpeedResult(int speed, const std::string& instance = "") {
+        nlohmann::json binding = {
+            {"Vehicle_Speed",
+             {{"type", "literal"},
+              {"value", std::to_string(speed)},
+              {"datatype", "http://www.w3.org/2001/XMLSchema#int"}}}};
+        nlohmann::json vars = {"Vehicle_Speed"};
+        if (!instance.empty()) {
+            binding["instance"] = {{"type", "literal"}, {"value", instance}};
+            vars.push_back("instance");
+        }
+        return nlohmann::json({{"head", {{"vars", vars}}},
+                               {"results", {{"bindings", nlohmann::json::array({binding})}}}})
+            .dump();
+    }
+
+    static nlohmann::json getSetValue(const nlohmann::json& set_message) {
+        return set_message["params"]["data"]["Speed"];
+    }
+};
+
+// Test that a burst of data messages runs the output query once after the debounce, and that the
+// result is written while the client waits for the next message
+TEST_F(WebSocketClientUnitTest, BurstOfDataMessagesRunsOutputQueryOnce) {
+    const std::string query = "SELECT ?Vehicle_Speed WHERE { ?s ?p ?Vehicle_Speed }";
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(query, QueryLanguageType::SPARQL, DataQueryAcceptType::SPARQL_JSON))
+        .WillOnce(Return(createSpeedResult(50)));
+
+    auto client = createClient(createModelConfig({query}), createSchedulerSettings(1));
+    for (int speed = 10; speed <= 30; speed += 10) {
+        connection_->addNotification({{"Speed", speed}});
+    }
+    client->run();
+
+    const auto set_messages = connection_->getWrittenMessages("set");
+    ASSERT_EQ(set_messages.size(), 1u);
+    EXPECT_EQ(set_messages[0]["params"]["instance"], VIN);
+    EXPECT_EQ(getSetValue(set_messages[0]), 50);
+
+    const auto statistics = client->getQuerySchedulerStatistics();
+    EXPECT_EQ(statistics.runs, 1u);
+    EXPECT_EQ(statistics.notifications, 3u);
+    EXPECT_EQ(statistics.coalesced, 2u);
+}
+
+// Test that due queries run concurrently and that their results are sent in the order of the
+// output queries, not in the order the reasoner answered
+TEST_F(WebSocketClientUnitTest, ConcurrentQueriesAreSentInConfigurationOrder) {
+    const std::string slow_query = "SELECT ?Vehicle_Speed WHERE { ?slow ?p ?Vehicle_Speed }";
+    const std::string fast_query = "SELECT ?Vehicle_Speed WHERE { ?fast ?p ?Vehicle_Speed }";
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    const auto answer = [&running, &max_running](int speed, std::chrono::milliseconds delay) {
+        return [&running, &max_running, speed, delay](const std::string&,
+                                                      const QueryLanguageType&,
+                                                      const DataQueryAcceptType&) {
+            const int now_running = ++running;
+            int expected = max_running.load();
+            while (now_running > expected &&
+                   !max_running.compare_exchange_weak(expected, now_running)) {
+            }
+            std::this_thread::sleep_for(delay);
+            --running;
+            return createSpeedResult(speed);
+        };
+    };
+    EXPECT_CALL(*mock_reasoner_service_, queryData(slow_query, _, _))
+        .WillOnce(answer(50, 100ms));
+    EXPECT_CALL(*mock_reasoner_service_, queryData(fast_query, _, _)).WillOnce(answer(30, 0ms));
+
+    auto client =
+        createClient(createModelConfig({slow_query, fast_query}), createSchedulerSettings(2));
+    connection_->addNotification({{"Speed", 10}});
+    client->run();
+
+    const auto set_messages = connection_->getWrittenMessages("set");
+    ASSERT_EQ(set_messages.size(), 2u);
+    EXPECT_EQ(getSetValue(set_messages[0]), 50);
+    EXPECT_EQ(getSetValue(set_messages[1]), 30);
+    EXPECT_EQ(max_running.load(), 2);
+}
+
+// Test that a fleet query runs for the instances with new data and is sent to each instance
+TEST_F(WebSocketClientUnitTest, FleetQueryResultIsSentPerInstance) {
+    const std::string query =
+        "SELECT ?instance ?Vehicle_Speed WHERE { ?s ?p ?Vehicle_Speed } #FLEET(?instance)";
+    EXPECT_CALL(*mock_reasoner_service_,
+                queryData(HasSubstr("VALUES ?instance { \"" + VIN + "\" }"), _, _))
+        .WillOnce(Return(createSpeedResult(50, VIN)));
+
+    auto client = createClient(createModelConfig({query}), createSchedulerSettings(1));
+    connection_->addNotification({{"Speed", 10}});
+    client->run();
+
+    const auto set_messages = connection_->getWrittenMessages("set");
+    ASSERT_EQ(set_messages.size(), 1u);
+    EXPECT_EQ(set_messages[0]["params"]["instance"], VIN);
+    EXPECT_EQ(getSetValue(set_messages[0]), 50);
+}
+
+// Test that a reloaded output query with a malformed schedule comment does not stop the client
+TEST_F(WebSocketClientUnitTest, ReloadWithMalformedScheduleKeepsClientRunning) {
+    const std::string query = "SELECT ?Vehicle_Speed WHERE { ?s ?p ?Vehicle_Speed }";
+    // The reload and the data may run the query once or twice, the unchanged result is sent once
+    EXPECT_CALL(*mock_reasoner_service_, queryData(query, _, DataQueryAcceptType::SPARQL_JSON))
+        .WillRepeatedly(Return(createSpeedResult(50)));
+
+    auto client = createClient(createModelConfig({"ASK { ?s ?p ?o }"}),
+                               createSchedulerSettings(1));
+    ModelConfigDiff diff;
+    diff.output_queries_changed = true;
+    client->updateModelConfig(createModelConfig({query, "ASK { ?s ?p ?o } #SCHEDULE(x=1)"}),
+                              diff);
+    connection_->addNotification({{"Speed", 10}});
+    EXPECT_NO_THROW(client->run());
+
+    ASSERT_EQ(connection_->getWrittenMessages("set").size(), 1u);
+}
@@ -2,6 +2,7 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <nlohmann/json.hpp>
@@ -9,7 +10,11 @@
 #include "data_types.h"
 #include "globals.h"
 #include "helper.h"
+#include "json_writer.h"
+#include "logger.h"
 #include "model_config.h"
+#include "model_config_reloader.h"
+#include "output_writer.h"
 #include "reasoner_factory.h"
 #include "reasoner_service.h"
 #include "system_configuration_service.h"
@@ -108,6 +113,22 @@ void displayEnvVariables() {
               << Helper::getEnvVariable("TARGET_WEBSOCKET_SERVER", DEFAULT_TARGET_WEB_SOCKET_SERVER)
               << "\n";
 
+    std::cout << std::left << std::setw(35) << "WEBSOCKET_DEFLATE_ENABLED" << std::setw(65)
+              << "Offer permessage-deflate compression (true/false)" << std::setw(40)
+              << Helper::getEnvVariable("WEBSOCKET_DEFLATE_ENABLED", "false") << "\n";
+
+    std::cout << std::left << std::setw(35) << "WEBSOCKET_DEFLATE_WINDOW_BITS" << std::setw(65)
+              << "Compression window bits (9-15)" << std::setw(40)
+              << Helper::getEnvVariable("WEBSOCKET_DEFLATE_WINDOW_BITS", "15") << "\n";
+
+    std::cout << std::left << std::setw(35) << "WEBSOCKET_DEFLATE_LEVEL" << std::setw(65)
+              << "Compression level (0-9)" << std::setw(40)
+              << Helper::getEnvVariable("WEBSOCKET_DEFLATE_LEVEL", "8") << "\n";
+
+    std::cout << std::left << std::setw(35) << "WEBSOCKET_DEFLATE_MIN_SIZE" << std::setw(65)
+              << "Minimum message size in bytes to compress" << std::setw(40)
+              << Helper::getEnvVariable("WEBSOCKET_DEFLATE_MIN_SIZE", "0") << "\n";
+
     std::cout << std::left << std::setw(35) << "HOST_REASONER_SERVER" << std::setw(65)
               << "IP address of the reasoner server" << std::setw(40)
               << Helper::getEnvVariable("HOST_REASONER_SERVER", DEFAULT_REASONER_SERVER) << "\n";
@@ -133,6 +154,115 @@ void displayEnvVariables() {
               << Helper::getEnvVariable("REASONER_ORIGIN_SYSTEM_NAME",
                                         DEFAULT_REASONER_ORIGIN_SYSTEM_NAME)
               << "\n";
+
+    std::cout << std::left << std::setw(35) << "LOG_LEVEL" << std::setw(65)
+              << "Minimum log level (trace, debug, info, warn, error, off)" << std::setw(40)
+              << Helper::getEnvVariable("LOG_LEVEL", "info") << "\n";
+
+    std::cout << std::left << std::setw(35) << "LOG_FILE" << std::setw(65)
+              << "Log file path, logs go to the console when not set" << std::setw(40)
+              << Helper::getEnvVariable("LOG_FILE", "") << "\n";
+
+    std::cout << std::left << std::setw(35) << "LOG_FILE_MAX_SIZE" << std::setw(65)
+              << "Size in bytes at which the log file is rotated" << std::setw(40)
+              << Helper::getEnvVariable("LOG_FILE_MAX_SIZE", "10485760") << "\n";
+
+    std::cout << std::left << std::setw(35) << "LOG_FILE_MAX_FILES" << std::setw(65)
+              << "Number of rotated log files to keep" << std::setw(40)
+              << Helper::getEnvVariable("LOG_FILE_MAX_FILES", "5") << "\n";
+
+    std::cout << std::left << std::setw(35) << "LOG_PAYLOAD_SAMPLE_RATE" << std::setw(65)
+              << "Log only every n-th message payload" << std::setw(40)
+              << Helper::getEnvVariable("LOG_PAYLOAD_SAMPLE_RATE", "1") << "\n";
+
+    std::cout << std::left << std::setw(35) << "LOG_PAYLOAD_MAX_PER_SECOND" << std::setw(65)
+              << "Maximum message payloads logged per second (0 = unlimited)" << std::setw(40)
+              << Helper::getEnvVariable("LOG_PAYLOAD_MAX_PER_SECOND", "10") << "\n";
+
+    std::cout << std::left << std::setw(35) << "LOG_PAYLOAD_MAX_BYTES" << std::setw(65)
+              << "Logged message payloads are truncated to this size (0 = never)"
+              << std::setw(40) << Helper::getEnvVariable("LOG_PAYLOAD_MAX_BYTES", "4096") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_QUEUE_CAPACITY" << std::setw(65)
+              << "Maximum number of output records waiting to be written" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_QUEUE_CAPACITY", "1024") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_FSYNC" << std::setw(65)
+              << "When output files are synced to disk (never, batch, always)" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_FSYNC", "never") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_FILE_MAX_SIZE" << std::setw(65)
+              << "Size in bytes at which output files are rotated (0 = never)" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_FILE_MAX_SIZE", "67108864") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_FILE_MAX_AGE" << std::setw(65)
+              << "Age in seconds at which output files are rotated (0 = never)" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_FILE_MAX_AGE", "3600") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_TRIPLES_ENABLED" << std::setw(65)
+              << "Write the generated triples to the output files" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_TRIPLES_ENABLED", "true") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_TRIPLES_SAMPLE_RATE" << std::setw(65)
+              << "Write only every n-th generated triples output" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_TRIPLES_SAMPLE_RATE", "1") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_REASONING_ENABLED" << std::setw(65)
+              << "Write the reasoning query results to the output files" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_REASONING_ENABLED", "true") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_REASONING_SAMPLE_RATE" << std::setw(65)
+              << "Write only every n-th reasoning query result" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_REASONING_SAMPLE_RATE", "1") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_TRIPLES_ARCHIVE" << std::setw(65)
+              << "Write the triples as N-Triples to a compressed archive" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_TRIPLES_ARCHIVE", "false") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_REASONING_ARCHIVE" << std::setw(65)
+              << "Write the reasoning query results to a compressed archive" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_REASONING_ARCHIVE", "false") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_ARCHIVE_BLOCK_SECONDS" << std::setw(65)
+              << "Duration in seconds of the time blocks of the archives" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_ARCHIVE_BLOCK_SECONDS", "60") << "\n";
+
+    std::cout << std::left << std::setw(35) << "MODEL_CONFIG_RELOAD_ON_SIGNAL" << std::setw(65)
+              << "Reload the model configuration on SIGHUP" << std::setw(40)
+              << Helper::getEnvVariable("MODEL_CONFIG_RELOAD_ON_SIGNAL", "true") << "\n";
+
+    std::cout << std::left << std::setw(35) << "MODEL_CONFIG_WATCH_SECONDS" << std::setw(65)
+              << "Interval to check the model files for changes (0 = off)" << std::setw(40)
+              << Helper::getEnvVariable("MODEL_CONFIG_WATCH_SECONDS", "0") << "\n";
+
+    std::cout << std::left << std::setw(35) << "REASONING_RESULT_DIFF" << std::setw(65)
+              << "Send only the changed rows of the reasoning results" << std::setw(40)
+              << Helper::getEnvVariable("REASONING_RESULT_DIFF", "true") << "\n";
+
+    std::cout << std::left << std::setw(35) << "REASONING_RESULT_REFRESH_SECONDS" << std::setw(65)
+              << "Interval to send the full reasoning results (0 = off)" << std::setw(40)
+              << Helper::getEnvVariable("REASONING_RESULT_REFRESH_SECONDS", "0") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_QUERY_MIN_INTERVAL_MS" << std::setw(65)
+              << "Minimum time between two runs of an output query" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_QUERY_MIN_INTERVAL_MS", "0") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_QUERY_DEBOUNCE_MS" << std::setw(65)
+              << "Time without new data before the output queries run" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_QUERY_DEBOUNCE_MS", "0") << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_QUERY_MAX_DELAY_MS" << std::setw(65)
+              << "Longest delay of the output queries by the debounce (0 = none)"
+              << std::setw(40) << Helper::getEnvVariable("OUTPUT_QUERY_MAX_DELAY_MS", "1000")
+              << "\n";
+
+    std::cout << std::left << std::setw(35) << "OUTPUT_QUERY_CONCURRENCY" << std::setw(65)
+              << "Most output queries that run at the same time" << std::setw(40)
+              << Helper::getEnvVariable("OUTPUT_QUERY_CONCURRENCY", "4") << "\n";
+
+    std::cout << std::left << std::setw(35) << "QUERY_RESULT_CACHE_SIZE" << std::setw(65)
+              << "Most query results cached until new data arrives (0 disables)" << std::setw(40)
+              << Helper::getEnvVariable("QUERY_RESULT_CACHE_SIZE", "64") << "\n";
 }
 
 void displayHelpXOptions() {
@@ -148,6 +278,18 @@ void displayHelpXOptions() {
               << ": reset the reasoner datastore." << reset << "\n";
 }
 
+/**
+ * @brief Prints how long a startup phase took and returns the start time of the next phase.
+ */
+std::chrono::steady_clock::time_point printStartupPhase(
+    const std::string& phase, const std::chrono::steady_clock::time_point& start) {
+    const auto now = std::chrono::steady_clock::now();
+    std::cout << "** Startup phase '" << phase << "' took "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count()
+              << " ms **" << std::endl;
+    return now;
+}
+
 int main(int argc, char* argv[]) {
     // Print the banner
     printBanner();
@@ -187,6 +329,17 @@ int main(int argc, char* argv[]) {
     }
 
     try {
+        const auto startup_start = std::chrono::steady_clock::now();
+        auto phase_start = startup_start;
+
+        // Initialize the asynchronous logger used on the message path
+        Logger::getInstance().configure(LoggerSettings::fromEnvironment());
+
+        // Initialize the asynchronous writer of the output files
+        auto output_writer =
+            std::make_shared<AsyncOutputWriter>(OutputWriterSettings::fromEnvironment(
+                {TripleAssembler::OUTPUT_STREAM_NAME, JSONWriter::OUTPUT_STREAM_NAME}));
+
         // Initialize System Configuration
         SystemConfig system_config = SystemConfigurationService::loadSystemConfig(
             DEFAULT_HOST_WEB_SOCKET_SERVER, DEFAULT_PORT_WEB_SOCKET_SERVER,
@@ -195,28 +348,76 @@ int main(int argc, char* argv[]) {
             DEFAULT_REASONER_ORIGIN_SYSTEM_NAME);
 
         // Initialize Model Configuration
-        std::shared_ptr<ModelConfig> model_config = std::make_shared<ModelConfig>(
+        ModelConfigSnapshot model_config = std::make_shared<const ModelConfig>(
             SystemConfigurationService::loadModelConfig(MODEL_CONFIGURATION_FILE));
+        phase_start = printStartupPhase("configuration", phase_start);
 
         // Initialize Reasoner Service
         std::shared_ptr<ReasonerService> reasoner_service = ReasonerFactory::initReasoner(
             model_config->getReasonerSettings().getInferenceEngine(), system_config.reasoner_server,
             model_config->getReasonerRules(), model_config->getOntologies(),
-            RESET_REASONER_DATASTORE);
+            RESET_REASONER_DATASTORE, QueryResultCacheSettings::fromEnvironment());
+        phase_start = printStartupPhase("reasoner", phase_start);
 
         // Create the WebSocketClient
         std::cout << std::endl << "** Starting Websocket Client **" << std::endl;
-        auto client =
-            std::make_shared<WebSocketClient>(system_config, model_config, reasoner_service);
+        auto client = std::make_shared<WebSocketClient>(
+            system_config, model_config, reasoner_service, output_writer, nullptr,
+            ReasoningResultCacheSettings::fromEnvironment(),
+            OutputQuerySchedulerSettings::fromEnvironment());
+        printStartupPhase("client", phase_start);
+        printStartupPhase("total", startup_start);
+
+        // Reload the model configuration on SIGHUP or file changes while messages are processed
+        ModelConfigReloader model_config_reloader(
+            MODEL_CONFIGURATION_FILE, model_config, *reasoner_service,
+            [client](ModelConfigSnapshot reloaded_config, const ModelConfigDiff& diff) {
+                client->updateModelConfig(std::move(reloaded_config), diff);
+            },
+            ModelConfigReloadSettings::fromEnvironment());
+        model_config_reloader.start();
 
         // Initialize the RealWebSocketConnection with the WebSocketClient
         client->initializeConnection();
 
         // Run the WebSocket client
         client->run();
-
+        model_config_reloader.stop();
+
+        const ReasoningResultCacheStatistics result_statistics =
+            client->getResultCacheStatistics();
+        LOG_INFO("Reasoning results: " << result_statistics.rows_sent << " rows sent, "
+                                       << result_statistics.rows_suppressed
+                                       << " unchanged rows and "
+                                       << result_statistics.sends_suppressed
+                                       << " unchanged results suppressed");
+
+        const OutputQuerySchedulerStatistics scheduler_statistics =
+            client->getQuerySchedulerStatistics();
+        const auto average_lag =
+            scheduler_statistics.runs == 0
+                ? 0
+                : scheduler_statistics.total_lag.count() /
+                      static_cast<std::int64_t>(scheduler_statistics.runs);
+        LOG_INFO("Output queries: " << scheduler_statistics.runs << " runs, "
+                                    << scheduler_statistics.coalesced
+                                    << " data notifications coalesced, lag " << average_lag
+                                    << " ms on average and "
+                                    << scheduler_statistics.max_lag.count() << " ms at most");
+
+        const QueryResultCacheStatistics query_cache_statistics =
+            reasoner_service->getQueryCacheStatistics();
+        LOG_INFO("Query result cache: " << query_cache_statistics.hits << " hits, "
+                                        << query_cache_statistics.misses << " misses, "
+                                        << query_cache_statistics.evictions << " evictions and "
+                                        << query_cache_statistics.invalidations
+                                        << " datastore changes");
+
+        output_writer->shutdown();
+        Logger::getInstance().shutdown();
         return EXIT_SUCCESS;
     } catch (const std::exception& e) {
+        Logger::getInstance().shutdown();
         std::cerr << "Error: " << e.what() << std::endl;
         return EXIT_FAILURE;
     }
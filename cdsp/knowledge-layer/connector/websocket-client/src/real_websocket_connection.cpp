@@ -2,6 +2,13 @@
 
 #include <iostream>
 
+#include "logger.h"
+
+namespace {
+// Number of messages (read + written) between two traffic metric reports.
+constexpr std::uint64_t TRAFFIC_METRICS_LOG_INTERVAL = 100;
+}  // namespace
+
 RealWebSocketConnection::RealWebSocketConnection(net::io_context& io_context,
                                                  std::weak_ptr<WebSocketClient> client)
     : resolver_(io_context), ws_(io_context), client_(std::move(client)) {}
@@ -22,63 +29,133 @@ void RealWebSocketConnection::onResolve(beast::error_code ec, tcp::resolver::res
 void RealWebSocketConnection::asyncConnect() {
     if (auto client = client_.lock()) {
         auto shared_client = client;  // Ensure shared_ptr is captured
-        net::async_connect(ws_.next_layer(), resolve_results_,
-                           [shared_client](boost::system::error_code ec,
-                                           const boost::asio::ip::tcp::endpoint& endpoint) {
-                               if (shared_client) {
-                                   shared_client->onConnect(ec, endpoint);
-                               } else {
-                                   std::cerr << "WebSocketClient instance no longer exists.\n";
-                               }
-                           });
+        ws_.next_layer().async_connect(
+            resolve_results_, [shared_client](boost::system::error_code ec,
+                                              const boost::asio::ip::tcp::endpoint& endpoint) {
+                if (shared_client) {
+                    shared_client->onConnect(ec, endpoint);
+                } else {
+                    LOG_ERROR("WebSocketClient instance no longer exists.");
+                }
+            });
     } else {
-        std::cerr << "Failed to lock WebSocketClient. Client may have been destroyed.\n";
+        LOG_ERROR("Failed to lock WebSocketClient. Client may have been destroyed.");
     }
 }
 
+/**
+ * @brief Applies the permessage-deflate settings to the WebSocket stream.
+ *
+ * Must be called before the handshake, since the extension is negotiated there. The same window
+ * size is offered for both directions. If the server declines the extension, messages are
+ * exchanged uncompressed.
+ *
+ * @param settings The compression settings from the system configuration.
+ */
+void RealWebSocketConnection::configureCompression(const WSCompressionSettings& settings) {
+    compression_enabled_ = settings.enabled;
+    if (!settings.enabled) {
+        return;
+    }
+
+    beast::websocket::permessage_deflate options;
+    options.client_enable = true;
+    options.client_max_window_bits = settings.max_window_bits;
+    options.server_max_window_bits = settings.max_window_bits;
+    options.compLevel = settings.compression_level;
+    options.msg_size_threshold = settings.min_message_size;
+    ws_.set_option(options);
+
+    std::cout << " - WebSocket permessage-deflate offered (window bits: "
+              << settings.max_window_bits << ", level: " << settings.compression_level
+              << ", min size: " << settings.min_message_size << " bytes)\n";
+}
+
 void RealWebSocketConnection::asyncHandshake() {
     if (auto client = client_.lock()) {
         auto shared_client = client;  // Ensure shared_ptr is captured
+        configureCompression(client->getInitConfig().websocket_server.compression);
         ws_.async_handshake(
             client->getInitConfig().websocket_server.host,
             "/" + client->getInitConfig().websocket_server.target,
             [shared_client](boost::system::error_code ec) { shared_client->handshake(ec); });
     } else {
-        std::cerr << "Failed to lock WebSocketClient. Client may have been destroyed.\n";
+        LOG_ERROR("Failed to lock WebSocketClient. Client may have been destroyed.");
     }
 }
 
-void RealWebSocketConnection::asyncWrite(const json& message) {
+void RealWebSocketConnection::asyncWrite(std::shared_ptr<const std::string> message) {
     if (auto client = client_.lock()) {
         auto shared_client = client;  // Ensure shared_ptr is captured
-        ws_.async_write(
-            net::buffer(message.dump()),
-            [shared_client](boost::system::error_code ec, std::size_t bytes_transferred) {
-                shared_client->onSendMessage(ec, bytes_transferred);
-            });
+        const auto wire_start = ws_.next_layer().rate_policy().writtenBytes();
+        // The handler owns the message, so the buffer stays alive until the write completes
+        ws_.async_write(net::buffer(*message),
+                        [this, shared_client, message, wire_start](boost::system::error_code ec,
+                                                                   std::size_t bytes_transferred) {
+                            if (!ec) {
+                                metrics_.messages_written++;
+                                metrics_.payload_bytes_written += bytes_transferred;
+                                metrics_.wire_bytes_written +=
+                                    ws_.next_layer().rate_policy().writtenBytes() - wire_start;
+                                logTrafficMetrics();
+                            }
+                            shared_client->onSendMessage(ec, bytes_transferred);
+                        });
     } else {
-        std::cerr << "Failed to lock WebSocketClient. Client may have been destroyed.\n";
+        LOG_ERROR("Failed to lock WebSocketClient. Client may have been destroyed.");
     }
 }
 
 void RealWebSocketConnection::asyncRead() {
     if (auto client = client_.lock()) {
         auto shared_client = client;  // Ensure shared_ptr is captured
-        ws_.async_read(buffer_,
-                       [shared_client](boost::beast::error_code ec, std::size_t bytes_transferred) {
-                           shared_client->onReceiveMessage(ec, bytes_transferred);
-                       });
+        const auto wire_start = ws_.next_layer().rate_policy().readBytes();
+        ws_.async_read(buffer_, [this, shared_client, wire_start](boost::beast::error_code ec,
+                                                                  std::size_t bytes_transferred) {
+            if (!ec) {
+                metrics_.messages_read++;
+                metrics_.payload_bytes_read += bytes_transferred;
+                metrics_.wire_bytes_read += ws_.next_layer().rate_policy().readBytes() - wire_start;
+                logTrafficMetrics();
+            }
+            shared_client->onReceiveMessage(ec, bytes_transferred);
+        });
     } else {
-        std::cerr << "Failed to lock WebSocketClient. Client may have been destroyed.\n";
+        LOG_ERROR("Failed to lock WebSocketClient. Client may have been destroyed.");
     }
 }
 
 void RealWebSocketConnection::Fail(beast::error_code ec, const char* what) {
-    std::cerr << what << ": " << ec.message() << "\n";
+    LOG_ERROR(what << ": " << ec.message());
 }
 
-std::string RealWebSocketConnection::getReceivedMessage() {
-    return boost::beast::buffers_to_string(buffer_.data());
+std::string_view RealWebSocketConnection::getReceivedMessage() {
+    const auto data = buffer_.data();
+    return {static_cast<const char*>(data.data()), data.size()};
 }
 
-void RealWebSocketConnection::consumeBuffer(std::size_t bytes) { buffer_.consume(bytes); }
\ No newline at end of file
+void RealWebSocketConnection::consumeBuffer(std::size_t bytes) { buffer_.consume(bytes); }
+
+/**
+ * @brief Returns a snapshot of the traffic counters of this connection.
+ *
+ * @return The accumulated message and byte counters.
+ */
+WebSocketTrafficMetrics RealWebSocketConnection::getTrafficMetrics() const { return metrics_; }
+
+/**
+ * @brief Periodically reports the compression ratio while compression is enabled.
+ */
+void RealWebSocketConnection::logTrafficMetrics() const {
+    const auto messages = metrics_.messages_read + metrics_.messages_written;
+    if (!compression_enabled_ || messages % TRAFFIC_METRICS_LOG_INTERVAL != 0) {
+        return;
+    }
+
+    LOG_INFO("WebSocket traffic: sent "
+             << metrics_.messages_written << " msgs (" << metrics_.payload_bytes_written << " -> "
+             << metrics_.wire_bytes_written << " bytes, ratio "
+             << metrics_.writeCompressionRatio() << "), received " << metrics_.messages_read
+             << " msgs (" << metrics_.wire_bytes_read << " -> " << metrics_.payload_bytes_read
+             << " bytes, ratio " << metrics_.readCompressionRatio() << ")");
+}
@@ -5,8 +5,11 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/system/error_code.hpp>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <string_view>
 
 #include "websocket_client.h"
 #include "websocket_interface.h"
@@ -16,27 +19,93 @@ namespace net = boost::asio;
 using tcp = net::ip::tcp;
 using json = nlohmann::json;
 
+/**
+ * @brief Traffic counters of a WebSocket connection.
+ *
+ * Payload bytes are the uncompressed message sizes seen by the application, wire bytes are what
+ * actually crossed the TCP socket (frame headers included).
+ */
+struct WebSocketTrafficMetrics {
+    std::uint64_t messages_written = 0;
+    std::uint64_t messages_read = 0;
+    std::uint64_t payload_bytes_written = 0;
+    std::uint64_t payload_bytes_read = 0;
+    std::uint64_t wire_bytes_written = 0;
+    std::uint64_t wire_bytes_read = 0;
+
+    /**
+     * @brief Ratio of wire bytes to payload bytes for outgoing messages (1.0 means no gain).
+     */
+    double writeCompressionRatio() const {
+        return payload_bytes_written == 0
+                   ? 1.0
+                   : static_cast<double>(wire_bytes_written) / payload_bytes_written;
+    }
+
+    /**
+     * @brief Ratio of wire bytes to payload bytes for incoming messages (1.0 means no gain).
+     */
+    double readCompressionRatio() const {
+        return payload_bytes_read == 0
+                   ? 1.0
+                   : static_cast<double>(wire_bytes_read) / payload_bytes_read;
+    }
+};
+
+/**
+ * @brief Beast rate policy that never limits the stream but counts the bytes transferred.
+ */
+class ByteCountingRatePolicy {
+   public:
+    std::uint64_t readBytes() const noexcept { return read_bytes_; }
+    std::uint64_t writtenBytes() const noexcept { return written_bytes_; }
+
+   private:
+    friend class beast::rate_policy_access;
+
+    std::uint64_t read_bytes_ = 0;
+    std::uint64_t written_bytes_ = 0;
+
+    std::size_t available_read_bytes() const noexcept {
+        return (std::numeric_limits<std::size_t>::max)();
+    }
+    std::size_t available_write_bytes() const noexcept {
+        return (std::numeric_limits<std::size_t>::max)();
+    }
+    void transfer_read_bytes(std::size_t bytes) noexcept { read_bytes_ += bytes; }
+    void transfer_write_bytes(std::size_t bytes) noexcept { written_bytes_ += bytes; }
+    void on_timer() const noexcept {}
+};
+
 class RealWebSocketConnection : public WebSocketClientInterface {
    public:
+    using CountingTcpStream = beast::basic_stream<tcp, net::any_io_executor, ByteCountingRatePolicy>;
+
     RealWebSocketConnection(net::io_context& io_context, std::weak_ptr<WebSocketClient> client);
 
     void asyncResolve(const std::string& host, const std::string& port) override;
     void asyncConnect() override;
     void asyncHandshake() override;
-    void asyncWrite(const json& message) override;
+    void asyncWrite(std::shared_ptr<const std::string> message) override;
     void asyncRead() override;
 
-    std::string getReceivedMessage() override;
+    std::string_view getReceivedMessage() override;
     void consumeBuffer(std::size_t bytes) override;
 
+    WebSocketTrafficMetrics getTrafficMetrics() const;
+
    private:
     tcp::resolver resolver_;
     tcp::resolver::results_type resolve_results_;
-    beast::websocket::stream<tcp::socket> ws_;
+    beast::websocket::stream<CountingTcpStream> ws_;
     std::weak_ptr<WebSocketClient> client_;
     beast::flat_buffer buffer_;
+    WebSocketTrafficMetrics metrics_;
+    bool compression_enabled_ = false;
 
     void onResolve(beast::error_code ec, tcp::resolver::results_type results);
+    void configureCompression(const WSCompressionSettings& settings);
+    void logTrafficMetrics() const;
     void Fail(beast::error_code ec, const char* what);
 };
 
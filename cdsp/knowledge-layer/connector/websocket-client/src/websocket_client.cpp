@@ -1,8 +1,11 @@
 #include "websocket_client.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "fleet_query.h"
 #include "helper.h"
+#include "logger.h"
 #include "real_websocket_connection.h"
 
 namespace {
@@ -13,7 +16,20 @@ namespace {
  * @param what Description of the operation that failed.
  */
 void Fail(const boost::system::error_code& ec, const std::string& what) {
-    std::cerr << what << ": " << ec.message() << "\n";
+    LOG_ERROR(what << ": " << ec.message());
+}
+
+/**
+ * @brief Appends the grouped rows of a filtered result to a batch of rows.
+ */
+void appendRows(json& rows, json result) {
+    if (result.is_array()) {
+        for (auto& group : result) {
+            rows.push_back(std::move(group));
+        }
+    } else if (!result.empty()) {
+        rows.push_back(std::move(result));
+    }
 }
 }  // namespace
 
@@ -27,20 +43,34 @@ void Fail(const boost::system::error_code& ec, const std::string& what) {
  *
  * @param system_config The initialization configuration containing settings for the
  * WebSocketClient.
+ * @param output_sink The output sink writing the generated triples and query results to files.
  * @param connection A shared pointer to a WebSocketClientInterface, representing the connection to
  * be used.
+ * @param result_cache_settings The settings of the cache that suppresses unchanged reasoning
+ * results.
+ * @param query_scheduler_settings The default settings of the scheduler that decides when the
+ * output queries run, and how many of them run at the same time.
  */
-WebSocketClient::WebSocketClient(SystemConfig system_config,
-                                 std::shared_ptr<ModelConfig> model_config,
+WebSocketClient::WebSocketClient(SystemConfig system_config, ModelConfigSnapshot model_config,
                                  std::shared_ptr<ReasonerService> reasoner_service,
-                                 std::shared_ptr<WebSocketClientInterface> connection)
+                                 std::shared_ptr<IOutputSink> output_sink,
+                                 std::shared_ptr<WebSocketClientInterface> connection,
+                                 ReasoningResultCacheSettings result_cache_settings,
+                                 OutputQuerySchedulerSettings query_scheduler_settings)
     : system_config_(std::move(system_config)),
       reasoner_service_(std::move(reasoner_service)),
+      output_sink_(std::move(output_sink)),
       model_config_(std::move(model_config)),
       connection_(std::move(connection)),
-      triple_assembler_(model_config_, *reasoner_service_, file_handler_, triple_writer_),
       request_registry_(std::make_shared<RequestRegistry>()),
-      reasoner_query_service_(std::make_shared<ReasoningQueryService>(reasoner_service_)) {
+      message_arena_pool_(std::make_shared<MessageArenaPool>()),
+      triple_assembler_(model_config_, *reasoner_service_, *output_sink_, triple_writer_),
+      result_cache_(result_cache_settings),
+      query_scheduler_(query_scheduler_settings),
+      query_executor_(query_scheduler_settings.max_concurrency),
+      query_timer_(io_context_),
+      reasoner_query_service_(
+          std::make_shared<ReasoningQueryService>(reasoner_service_, output_sink_)) {
     triple_assembler_.initialize();
 }
 
@@ -71,6 +101,45 @@ void WebSocketClient::run() {
     io_context_.run();
 }
 
+/**
+ * @brief Swaps in a reloaded model configuration. Can be called from any thread.
+ *
+ * The swap is posted to the IO context, so it happens between two messages: a message is always
+ * processed with a single configuration snapshot and message processing does not pause.
+ *
+ * @param model_config The reloaded model configuration.
+ * @param diff The differences to the configuration in use.
+ */
+void WebSocketClient::updateModelConfig(ModelConfigSnapshot model_config,
+                                        const ModelConfigDiff& diff) {
+    const bool output_changed = diff.output_queries_changed || diff.output_settings_changed;
+    net::post(io_context_, [self = shared_from_this(), model_config = std::move(model_config),
+                            signal_catalog_changed = diff.signal_catalog_changed,
+                            output_changed]() mutable {
+        self->triple_assembler_.updateModelConfig(model_config, signal_catalog_changed);
+        self->model_config_ = std::move(model_config);
+        // Results of changed output queries or settings are sent in full again, right away
+        if (output_changed) {
+            self->result_cache_.clear();
+            self->fleet_instances_.clear();
+            self->query_scheduler_.clear();
+            for (const auto& query : self->model_config_->getReasoningOutputQueries()) {
+                try {
+                    self->query_scheduler_.notifyDataArrived(query.query);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("Error scheduling reasoning query: " << e.what());
+                }
+            }
+            self->scheduleOutputQueries();
+        }
+    });
+}
+
+/**
+ * @brief Provides access to the IO context the callbacks of the connection have to run on.
+ */
+net::io_context& WebSocketClient::getIoContext() { return io_context_; }
+
 /**
  * @brief Provides access to the client's configuration.
  *
@@ -78,6 +147,26 @@ void WebSocketClient::run() {
  */
 const SystemConfig& WebSocketClient::getInitConfig() const { return system_config_; }
 
+/**
+ * @brief Retrieves the counters of the reasoning results that were sent or suppressed because
+ * they had not changed. Can be called from any thread.
+ *
+ * @return A copy of the counters.
+ */
+ReasoningResultCacheStatistics WebSocketClient::getResultCacheStatistics() const {
+    return result_cache_.getStatistics();
+}
+
+/**
+ * @brief Retrieves the counters of the output query runs and their lag behind the data. Can be
+ * called from any thread.
+ *
+ * @return A copy of the counters.
+ */
+OutputQuerySchedulerStatistics WebSocketClient::getQuerySchedulerStatistics() const {
+    return query_scheduler_.getStatistics();
+}
+
 // Callbacks for connection lifecycle and message handling
 void WebSocketClient::onConnect(boost::system::error_code error_code,
                                 const boost::asio::ip::tcp::endpoint& endpoint) {
@@ -109,12 +198,10 @@ void WebSocketClient::handshake(boost::system::error_code error_code) {
     for (const SchemaType& schema_type :
          model_config_->getReasonerSettings().getSupportedSchemaCollections()) {
         // Start subscribing to supported schemas
-        const auto object_id = model_config_->getObjectId().at(schema_type);
-        auto data_point_list = model_config_->getInputs().at(schema_type);
-
-        MessageService::createAndQueueSubscribeMessage(object_id, schema_type,
-                                                       data_point_list.subscribe,
-                                                       *request_registry_, reply_messages_queue_);
+        MessageService::createAndQueueSubscribeMessage(
+            model_config_->getObjectId(schema_type), schema_type,
+            model_config_->getInputs(schema_type).subscribe, *request_registry_,
+            reply_messages_queue_);
     }
 
     std::cout << " - Handshake succeeded!\n\n";
@@ -123,88 +210,294 @@ void WebSocketClient::handshake(boost::system::error_code error_code) {
 }
 
 /**
- * @brief Sends a JSON message to the WebSocket server.
+ * @brief Sends a serialized message to the WebSocket server.
  *
- * @param message The JSON message to be sent.
+ * @param message The serialized message to be sent.
  */
-void WebSocketClient::sendMessage(const json& message) { connection_->asyncWrite(message); }
+void WebSocketClient::sendMessage(std::shared_ptr<const std::string> message) {
+    write_pending_ = true;
+    connection_->asyncWrite(std::move(message));
+}
 
 void WebSocketClient::onSendMessage(boost::system::error_code error_code,
                                     std::size_t bytes_transferred) {
+    write_pending_ = false;
     if (error_code) {
         Fail(error_code, "write");
         return;
     }
-    std::cout << "Message sent! " << bytes_transferred << " bytes transferred\n\n";
-    connection_->asyncRead();
+    LOG_DEBUG("Message sent! " << bytes_transferred << " bytes transferred");
+    // Results of scheduled queries may have been queued while a read was pending
+    if (read_pending_ && !reply_messages_queue_.empty()) {
+        writeReplyMessagesOnQueue();
+    } else {
+        readNextMessage();
+    }
 }
 
 void WebSocketClient::onReceiveMessage(boost::beast::error_code error_code,
                                        std::size_t bytes_transferred) {
+    read_pending_ = false;
     if (error_code) {
         Fail(error_code, "read");
         return;
     }
 
-    const auto received_message = std::make_shared<std::string>(connection_->getReceivedMessage());
+    // The scratch data of the message is allocated from an arena that is released all at once
+    // when the message has been processed
+    auto arena = message_arena_pool_->acquire();
+
+    // Parse the message straight from the receive buffer before it is released for the next read
+    std::optional<DataMessage> data_message;
+    try {
+        data_message = MessageService::getDataOrProcessStatusFromMessage(
+            connection_->getReceivedMessage(), *request_registry_,
+            &model_config_->getSignalCatalog(), arena.resource());
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error processing received message: " << e.what());
+    }
     connection_->consumeBuffer(bytes_transferred);  // Clear the buffer for the next message
-    processMessage(received_message);
+    processMessage(data_message, arena.resource());
+}
+
+/**
+ * @brief Marks a vehicle instance as recently seen. Once MAX_KNOWN_INSTANCES are known, the least
+ * recently seen one is forgotten, so fleet queries without new data no longer run for it.
+ *
+ * @param instance The instance of a data message.
+ */
+void WebSocketClient::rememberInstance(const std::string& instance) {
+    const auto known = known_instance_positions_.find(instance);
+    if (known != known_instance_positions_.end()) {
+        known_instances_.splice(known_instances_.end(), known_instances_, known->second);
+        return;
+    }
+    if (known_instances_.size() >= MAX_KNOWN_INSTANCES) {
+        known_instance_positions_.erase(known_instances_.front());
+        known_instances_.pop_front();
+    }
+    known_instance_positions_.emplace(instance,
+                                      known_instances_.insert(known_instances_.end(), instance));
 }
 
 /**
  * @brief Processes an incoming WebSocket message.
  *
- * This method handles an incoming message by adding it to the response message queue,
- * extracting the highest priority message, and attempting to transform it into a reasoning triple
- * if it contains valid data. If there are reply messages queued, it writes them to the queue;
- * otherwise, it initiates an asynchronous read operation on the connection.
+ * This method transforms the data message extracted from an incoming message into reasoning
+ * triples and makes the reasoning output queries that depend on one of its signals pending; they
+ * run once the query scheduler says so (see runOutputQueries). If there are reply messages
+ * queued, it writes them to the queue; otherwise, it initiates an asynchronous read operation on
+ * the connection.
  *
- * @param message A shared pointer to the incoming message string to be processed.
+ * @param data_message The data message of the incoming message, or std::nullopt if it was a status
+ * message or could not be parsed.
+ * @param resource The memory arena of the message, used for the scratch data of the triples.
  */
-void WebSocketClient::processMessage(const std::shared_ptr<const std::string>& message) {
-    response_messages_queue_.push_back(message);
-    auto prio_message = *response_messages_queue_.front();
-    response_messages_queue_.erase(response_messages_queue_.begin());
-
-    // Attempt to extract a data message from the priority message
-    // or process the status message and log any errors if present
-    const auto data_message =
-        MessageService::getDataOrProcessStatusFromMessage(prio_message, *request_registry_);
-
+void WebSocketClient::processMessage(const std::optional<DataMessage>& data_message,
+                                     std::pmr::memory_resource* resource) {
     // Process the data message if it is valid
     if (data_message.has_value()) {
         // If the message is a regular data message, process it as a triple and
         // handle the reasoning queries
-        triple_assembler_.transformMessageToTriple(data_message.value());
+        triple_assembler_.transformMessageToTriple(data_message.value(), resource);
 
-        // Process reasoning query
-        for (const auto& reasoning_output_query : model_config_->getReasoningOutputQueries()) {
+        // The output queries of a burst of messages are coalesced into one run. Only the queries
+        // with an input signal in the message can have a new result.
+        const auto now = OutputQueryScheduler::Clock::now();
+        const auto& queries = model_config_->getReasoningOutputQueries();
+        const QueryDependencyGraph& dependencies = model_config_->getQueryDependencies();
+        const std::string& instance = data_message->getHeader().getInstance();
+        rememberInstance(instance);
+        for (std::size_t index = 0; index < queries.size(); ++index) {
+            const auto& nodes = data_message->getNodes();
+            const bool affected = std::any_of(nodes.begin(), nodes.end(), [&](const Node& node) {
+                return dependencies.dependsOn(index, node.getSignalId());
+            });
+            if (!affected) {
+                continue;
+            }
             try {
-                json result = reasoner_query_service_->processReasoningQuery(
-                    reasoning_output_query,
-                    model_config_->getReasonerSettings().isIsAiReasonerInferenceResults(),
-                    model_config_->getOutput() + "/reasoning_output/");
-
-                if (!result.empty()) {
-                    auto data_point_list = model_config_->getInputs();
-
-                    MessageService::createAndQueueSetMessage(
-                        model_config_->getObjectId(), result, *request_registry_,
-                        reply_messages_queue_, system_config_.reasoner_server.origin_system_name);
+                query_scheduler_.notifyDataArrived(queries[index].query, now);
+                // Fleet queries run for the vehicles with new data
+                if (FleetQuery::findInstanceVariable(queries[index].query)) {
+                    fleet_instances_[queries[index].query].insert(instance);
                 }
             } catch (const std::exception& e) {
-                std::cerr << "Error processing reasoning query: " << e.what() << std::endl;
+                LOG_ERROR("Error scheduling reasoning query: " << e.what());
             }
         }
+        scheduleOutputQueries();
     }
 
+    // A pending write continues with the next read when it completes
+    if (write_pending_) {
+        return;
+    }
     if (!reply_messages_queue_.empty()) {
         writeReplyMessagesOnQueue();
     } else {
-        connection_->asyncRead();
+        readNextMessage();
     }
 }
 
+/**
+ * @brief Sets the query timer to the time the next pending output query is due.
+ *
+ * The timer is only moved forward in time if it would otherwise fire too late.
+ */
+void WebSocketClient::scheduleOutputQueries() {
+    const std::optional<OutputQueryScheduler::Clock::time_point> due_time =
+        query_scheduler_.nextDueTime();
+    if (!due_time || (query_timer_expiry_ && *query_timer_expiry_ <= *due_time)) {
+        return;
+    }
+
+    query_timer_expiry_ = *due_time;
+    query_timer_.expires_at(*due_time);
+    query_timer_.async_wait([self = shared_from_this()](const boost::system::error_code& ec) {
+        // A cancelled wait was replaced by an earlier one
+        if (ec == net::error::operation_aborted) {
+            return;
+        }
+        self->query_timer_expiry_.reset();
+        self->runOutputQueries();
+    });
+}
+
+/**
+ * @brief Runs the output queries that are due and queues the new and changed rows of their
+ * results as SET messages.
+ *
+ * The due queries run concurrently, up to the concurrency limit of the scheduler settings. Their
+ * results are merged in the order of the output queries in the model configuration and queued
+ * together, so the SET messages do not depend on the order in which the reasoner answered.
+ *
+ * A fleet query (see FleetQuery) runs once for all vehicle instances with new data since its
+ * previous run, or for all instances seen so far if it runs without new data. Its result is split
+ * into the SET messages of each instance.
+ */
+void WebSocketClient::runOutputQueries() {
+    const std::unordered_set<std::string> due_queries = query_scheduler_.takeDueQueries();
+    if (!due_queries.empty()) {
+        const ModelConfig& model_config = *model_config_;
+        std::vector<QueryRun> runs;
+        for (const auto& reasoning_output_query : model_config.getReasoningOutputQueries()) {
+            if (due_queries.count(reasoning_output_query.query) == 0) {
+                continue;
+            }
+            QueryRun& run = runs.emplace_back();
+            run.query = &reasoning_output_query;
+            try {
+                run.is_fleet_query =
+                    FleetQuery::findInstanceVariable(reasoning_output_query.query).has_value();
+            } catch (const std::exception& e) {
+                LOG_ERROR("Error processing reasoning query: " << e.what());
+                runs.pop_back();
+                continue;
+            }
+            if (run.is_fleet_query) {
+                auto pending = fleet_instances_.find(reasoning_output_query.query);
+                if (pending != fleet_instances_.end()) {
+                    run.instances.assign(pending->second.begin(), pending->second.end());
+                    fleet_instances_.erase(pending);
+                } else {
+                    run.instances.assign(known_instances_.begin(), known_instances_.end());
+                    std::sort(run.instances.begin(), run.instances.end());
+                }
+            }
+        }
+
+        // Each query writes its result to its own slot, its scratch data goes to its own arena
+        std::vector<OutputQueryExecutor::Task> tasks;
+        tasks.reserve(runs.size());
+        for (QueryRun& run : runs) {
+            tasks.emplace_back([this, &model_config, &run]() {
+                const bool is_ai_reasoner_inference_results =
+                    model_config.getReasonerSettings().isIsAiReasonerInferenceResults();
+                try {
+                    auto arena = message_arena_pool_->acquire();
+                    if (run.is_fleet_query) {
+                        run.fleet_results = reasoner_query_service_->processFleetReasoningQuery(
+                            *run.query, run.instances, is_ai_reasoner_inference_results,
+                            model_config.getReasoningOutputPath(), arena.resource());
+                    } else {
+                        run.result = reasoner_query_service_->processReasoningQuery(
+                            *run.query, is_ai_reasoner_inference_results,
+                            model_config.getReasoningOutputPath(), arena.resource());
+                    }
+                } catch (const std::exception& e) {
+                    LOG_ERROR("Error processing reasoning query: " << e.what());
+                }
+            });
+        }
+        query_executor_.runAll(tasks);
+
+        // Only the rows that changed since the previous result of a query are sent. The rows of
+        // a fleet query are kept per instance; rows without an instance go to the configured
+        // object IDs.
+        json changed_rows = json::array();
+        std::map<std::string, json> changed_instance_rows;
+        for (const QueryRun& run : runs) {
+            if (run.result) {
+                appendRows(changed_rows, result_cache_.filter(run.query->query, *run.result));
+            }
+            for (const auto& [instance, result] : run.fleet_results) {
+                json& rows = instance.empty() ? changed_rows : changed_instance_rows[instance];
+                if (rows.is_null()) {
+                    rows = json::array();
+                }
+                appendRows(rows, result_cache_.filter(run.query->query + '\n' + instance, result));
+            }
+        }
+        queueSetMessages(model_config.getObjectId(), changed_rows);
+        for (const auto& [instance, rows] : changed_instance_rows) {
+            std::map<SchemaType, std::string> object_ids = model_config.getObjectId();
+            for (auto& [schema, object_id] : object_ids) {
+                object_id = instance;
+            }
+            queueSetMessages(object_ids, rows);
+        }
+    }
+    scheduleOutputQueries();
+
+    // The results are written while the connection waits for the next message; a pending write
+    // continues with them when it completes
+    if (!write_pending_ && read_pending_ && !reply_messages_queue_.empty()) {
+        writeReplyMessagesOnQueue();
+    }
+}
+
+/**
+ * @brief Queues the rows of reasoning results as SET messages.
+ *
+ * @param object_ids The object ID of each schema, e.g. the vehicle instance.
+ * @param rows The grouped rows of the results.
+ */
+void WebSocketClient::queueSetMessages(const std::map<SchemaType, std::string>& object_ids,
+                                       const json& rows) {
+    if (rows.empty()) {
+        return;
+    }
+    try {
+        MessageService::createAndQueueSetMessage(object_ids, rows, *request_registry_,
+                                                 reply_messages_queue_,
+                                                 system_config_.reasoner_server.origin_system_name);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error queueing reasoning results: " << e.what());
+    }
+}
+
+/**
+ * @brief Starts reading the next message unless a read is already pending.
+ */
+void WebSocketClient::readNextMessage() {
+    if (read_pending_) {
+        return;
+    }
+    read_pending_ = true;
+    connection_->asyncRead();
+}
+
 /**
  * @brief Sends messages queued in the reply_messages_queue_.
  *
@@ -212,13 +505,10 @@ void WebSocketClient::processMessage(const std::shared_ptr<const std::string>& m
  */
 void WebSocketClient::writeReplyMessagesOnQueue() {
     if (reply_messages_queue_.empty()) {
-        std::cerr << "No messages to send." << std::endl;
+        LOG_WARN("No messages to send.");
         return;
     }
-    json reply_message = reply_messages_queue_.front();
-    reply_messages_queue_.erase(reply_messages_queue_.begin());
-    std::cout << Helper::getFormattedTimestampNow("%Y-%m-%dT%H:%M:%S", true, true)
-              << " Sending queue message:\n"
-              << reply_message.dump() << std::endl;
-    sendMessage(reply_message);
+    auto reply_message = reply_messages_queue_.pop();
+    LOG_PAYLOAD(LogLevel::INFO, "Sending queue message", *reply_message);
+    sendMessage(std::move(reply_message));
 }
@@ -3,17 +3,28 @@
 
 #include <boost/asio.hpp>
 #include <boost/beast/core.hpp>
+#include <list>
+#include <map>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "data_types.h"
-#include "file_handler_impl.h"
+#include "i_output_sink.h"
+#include "message_arena_pool.h"
 #include "message_service.h"
 #include "model_config.h"
+#include "model_config_diff.h"
+#include "output_query_executor.h"
+#include "output_query_scheduler.h"
+#include "outgoing_message_queue.h"
 #include "reasoner_service.h"
 #include "reasoning_query_service.h"
+#include "reasoning_result_cache.h"
 #include "request_registry.h"
 #include "triple_assembler.h"
 #include "triple_writer.h"
@@ -26,34 +37,74 @@ using json = nlohmann::json;
 
 class WebSocketClient : public std::enable_shared_from_this<WebSocketClient> {
    public:
-    WebSocketClient(SystemConfig system_config, std::shared_ptr<ModelConfig> model_config,
+    WebSocketClient(SystemConfig system_config, ModelConfigSnapshot model_config,
                     std::shared_ptr<ReasonerService> reasoner_service,
-                    std::shared_ptr<WebSocketClientInterface> connection = nullptr);
+                    std::shared_ptr<IOutputSink> output_sink,
+                    std::shared_ptr<WebSocketClientInterface> connection = nullptr,
+                    ReasoningResultCacheSettings result_cache_settings =
+                        ReasoningResultCacheSettings(),
+                    OutputQuerySchedulerSettings query_scheduler_settings =
+                        OutputQuerySchedulerSettings());
 
     void initializeConnection();
     void run();
-    void sendMessage(const json& message);
+    void updateModelConfig(ModelConfigSnapshot model_config, const ModelConfigDiff& diff);
+    void sendMessage(std::shared_ptr<const std::string> message);
+    net::io_context& getIoContext();
     const SystemConfig& getInitConfig() const;
+    ReasoningResultCacheStatistics getResultCacheStatistics() const;
+    OutputQuerySchedulerStatistics getQuerySchedulerStatistics() const;
     void onConnect(boost::system::error_code ec, const boost::asio::ip::tcp::endpoint& endpoint);
     void handshake(boost::system::error_code ec);
     void onSendMessage(boost::system::error_code ec, std::size_t bytes_transferred);
     void onReceiveMessage(beast::error_code ec, std::size_t bytes_transferred);
 
+    // Most vehicle instances remembered for runs of fleet queries without new data
+    static constexpr std::size_t MAX_KNOWN_INSTANCES = 4096;
+
    private:
+    // An output query of a scheduler run, with the slot of its result
+    struct QueryRun {
+        const ReasoningOutputQuery* query = nullptr;
+        bool is_fleet_query = false;
+        std::vector<std::string> instances;
+        std::optional<json> result;
+        std::map<std::string, json> fleet_results;
+    };
+
     SystemConfig system_config_;
     net::io_context io_context_;
     std::shared_ptr<WebSocketClientInterface> connection_;
-    std::shared_ptr<ModelConfig> model_config_;
+    ModelConfigSnapshot model_config_;
     std::shared_ptr<ReasonerService> reasoner_service_;
+    std::shared_ptr<IOutputSink> output_sink_;
     std::shared_ptr<ReasoningQueryService> reasoner_query_service_;
     std::shared_ptr<RequestRegistry> request_registry_;
+    std::shared_ptr<MessageArenaPool> message_arena_pool_;
     TripleWriter triple_writer_;
     TripleAssembler triple_assembler_;
-    FileHandlerImpl file_handler_;
-    std::vector<json> reply_messages_queue_;
-    std::vector<std::shared_ptr<const std::string>> response_messages_queue_;
+    ReasoningResultCache result_cache_;
+    OutputQueryScheduler query_scheduler_;
+    OutputQueryExecutor query_executor_;
+    net::steady_timer query_timer_;
+    std::optional<OutputQueryScheduler::Clock::time_point> query_timer_expiry_;
+    // Vehicle instances with new data since the previous run of each fleet query, by query
+    std::unordered_map<std::string, std::set<std::string>> fleet_instances_;
+    // Vehicle instances seen so far, least recently seen first, for runs of fleet queries without
+    // new data. At most MAX_KNOWN_INSTANCES are kept.
+    std::list<std::string> known_instances_;
+    std::unordered_map<std::string, std::list<std::string>::iterator> known_instance_positions_;
+    OutgoingMessageQueue reply_messages_queue_;
+    bool read_pending_ = false;
+    bool write_pending_ = false;
 
-    void processMessage(const std::shared_ptr<const std::string>& message);
+    void rememberInstance(const std::string& instance);
+    void processMessage(const std::optional<DataMessage>& data_message,
+                        std::pmr::memory_resource* resource);
+    void scheduleOutputQueries();
+    void runOutputQueries();
+    void queueSetMessages(const std::map<SchemaType, std::string>& object_ids, const json& rows);
+    void readNextMessage();
     void writeReplyMessagesOnQueue();
 };
 
@@ -2,8 +2,10 @@
 #define WEBSOCKET_INTERFACE_H
 
 #include <boost/asio.hpp>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
 
 using json = nlohmann::json;
 
@@ -30,11 +32,12 @@ class WebSocketClientInterface {
     virtual void asyncHandshake() = 0;
 
     /**
-     * @brief Send a JSON message asynchronously.
+     * @brief Send a serialized message asynchronously.
      *
-     * @param message The JSON message to send.
+     * @param message The serialized message to send. The connection keeps a reference to it until
+     * the write completes.
      */
-    virtual void asyncWrite(const json& message) = 0;
+    virtual void asyncWrite(std::shared_ptr<const std::string> message) = 0;
 
     /**
      * @brief Start asynchronously reading messages.
@@ -44,9 +47,9 @@ class WebSocketClientInterface {
     /**
      * @brief Retrieve the most recent message received from the WebSocket.
      *
-     * @return The received message as a string.
+     * @return A view on the received message. It is valid until the buffer is consumed.
      */
-    virtual std::string getReceivedMessage() = 0;
+    virtual std::string_view getReceivedMessage() = 0;
 
     /**
      * @brief Consume (clear) a portion of the WebSocket's buffer after reading.
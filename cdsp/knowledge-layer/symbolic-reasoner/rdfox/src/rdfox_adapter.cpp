@@ -91,6 +91,27 @@ bool RDFoxAdapter::loadData(const std::string& data, const std::string& content_
         .sendRequest();
 };
 
+/**
+ * Deletes data or rules from the RDFox datastore.
+ *
+ * This method sends a PATCH request with the `delete-content` operation, which removes the facts
+ * and rules of the given content from the datastore.
+ *
+ * @param data The data or rules to be deleted, in the same format they were loaded with.
+ * @param content_type The content type of the data to be deleted. Default is "text/turtle".
+ * @return true if the data is successfully deleted; false otherwise.
+ */
+bool RDFoxAdapter::deleteData(const std::string& data, const std::string& content_type) {
+    std::string target = "/datastores/" + data_store_ + "/content?operation=delete-content";
+
+    return createRequestBuilder()
+        ->setMethod(http::verb::patch)
+        .setTarget(target)
+        .setContentType(content_type)
+        .setBody(data)
+        .sendRequest();
+}
+
 /**
  * Queries data from the RDFox datastore.
  *
@@ -23,6 +23,8 @@ class RDFoxAdapter : public IReasonerAdapter {
 
     virtual void initialize();
     virtual bool loadData(const std::string& data, const std::string& content_type = "text/turtle");
+    virtual bool deleteData(const std::string& data,
+                            const std::string& content_type = "text/turtle");
     virtual std::string queryData(
         const std::string& query,
         const QueryLanguageType& query_language_type = QueryLanguageType::SPARQL,
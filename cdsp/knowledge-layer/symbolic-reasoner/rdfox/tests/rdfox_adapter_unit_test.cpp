@@ -138,6 +138,40 @@ TEST_F(RDFoxAdapterTest, LoadDataSuccess) {
         ttl_data, reasonerSyntaxTypeToContentType(content_type)));
 }
 
+/**
+ * @brief Unit test for RDFoxAdapter to verify the behavior when deleting data
+ * from a datastore.
+ */
+TEST_F(RDFoxAdapterTest, DeleteDataSuccess) {
+    const std::string target = "/datastores/" + DATASTORE + "/content?operation=delete-content";
+    const std::string ttl_data = "@prefix : <http://example.org/> . :test a :Entity .";
+    const ReasonerSyntaxType content_type = ReasonerSyntaxType::TURTLE;
+
+    // Create a mock RequestBuilder
+    MockRequestBuilder *mock_request_builder_ptr = mock_request_builder_.get();
+
+    // Mock createRequestBuilder to return the shared_ptr to MockRequestBuilder
+    EXPECT_CALL(*mock_rdfox_adapter_, createRequestBuilder())
+        .WillOnce(testing::Return(::testing::ByMove(std::move(mock_request_builder_))));
+
+    // Set up expectations for MockRequestBuilder
+    EXPECT_CALL(*mock_request_builder_ptr, setMethod(http::verb::patch))
+        .WillOnce(testing::ReturnRef(*mock_request_builder_ptr));
+    EXPECT_CALL(*mock_request_builder_ptr, setTarget(target))
+        .WillOnce(testing::ReturnRef(*mock_request_builder_ptr));
+    EXPECT_CALL(*mock_request_builder_ptr,
+                setContentType(reasonerSyntaxTypeToContentType(content_type)))
+        .WillOnce(testing::ReturnRef(*mock_request_builder_ptr));
+    EXPECT_CALL(*mock_request_builder_ptr, setBody(ttl_data))
+        .WillOnce(testing::ReturnRef(*mock_request_builder_ptr));
+    EXPECT_CALL(*mock_request_builder_ptr, sendRequest(nullptr, nullptr))
+        .WillOnce(testing::Return(true));
+
+    // Expect the data to be deleted successfully
+    EXPECT_TRUE(mock_rdfox_adapter_->RDFoxAdapter::deleteData(
+        ttl_data, reasonerSyntaxTypeToContentType(content_type)));
+}
+
 /**
  * @brief Unit test for RDFoxAdapter to verify successful data querying.
  */
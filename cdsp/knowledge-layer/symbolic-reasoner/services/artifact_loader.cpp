@@ -0,0 +1,328 @@
+#include "artifact_loader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "helper.h"
+
+namespace {
+// Builds the TriG document of the fingerprint triples
+std::string buildFingerprintTrig(const std::vector<std::string>& fingerprints) {
+    std::string trig = std::string("<") + ArtifactLoader::FINGERPRINT_GRAPH + "> {\n";
+    for (const auto& fingerprint : fingerprints) {
+        trig.append("<urn:cdsp:artifact:")
+            .append(fingerprint)
+            .append("> <")
+            .append(ArtifactLoader::FINGERPRINT_PREDICATE)
+            .append("> \"")
+            .append(fingerprint)
+            .append("\" .\n");
+    }
+    trig.append("}\n");
+    return trig;
+}
+}  // namespace
+
+/**
+ * @brief Constructs a loader for the given reasoner service.
+ *
+ * @param reasoner_service The reasoner service to load the artifacts into.
+ * @param max_parallel_loads The maximum number of artifacts loaded at the same time.
+ */
+ArtifactLoader::ArtifactLoader(ReasonerService& reasoner_service, std::size_t max_parallel_loads)
+    : reasoner_service_(reasoner_service),
+      max_parallel_loads_(std::max<std::size_t>(1, max_parallel_loads)) {}
+
+/**
+ * @brief Adds rules to the artifacts to load. The rules are referenced, not copied, and must
+ * outlive the call to `load()`.
+ *
+ * @param rules Pairs of rule language and rules.
+ * @return The loader, for chaining.
+ */
+ArtifactLoader& ArtifactLoader::addRules(
+    const std::vector<std::pair<RuleLanguageType, std::string>>& rules) {
+    for (const auto& [language, content] : rules) {
+        artifacts_.push_back(
+            {fingerprint(ruleLanguageTypeToContentType(language), content),
+             [this, &content, language = language] {
+                 return reasoner_service_.loadRules(content, language);
+             }});
+    }
+    return *this;
+}
+
+/**
+ * @brief Adds data, e.g. ontologies or validation shapes, to the artifacts to load. The data is
+ * referenced, not copied, and must outlive the call to `load()`.
+ *
+ * @param data Pairs of syntax type and data.
+ * @return The loader, for chaining.
+ */
+ArtifactLoader& ArtifactLoader::addData(
+    const std::vector<std::pair<ReasonerSyntaxType, std::string>>& data) {
+    for (const auto& [syntax, content] : data) {
+        artifacts_.push_back({fingerprint(reasonerSyntaxTypeToContentType(syntax), content),
+                              [this, &content, syntax = syntax] {
+                                  return reasoner_service_.loadData(content, syntax);
+                              }});
+    }
+    return *this;
+}
+
+/**
+ * @brief Adds rules to remove from the datastore, e.g. the previous version of changed rules.
+ * The rules are referenced, not copied, and must outlive the call to `load()`.
+ *
+ * @param rules Pairs of rule language and rules, as they were loaded.
+ * @return The loader, for chaining.
+ */
+ArtifactLoader& ArtifactLoader::removeRules(
+    const std::vector<std::pair<RuleLanguageType, std::string>>& rules) {
+    for (const auto& [language, content] : rules) {
+        removals_.push_back(
+            {fingerprint(ruleLanguageTypeToContentType(language), content),
+             [this, &content, language = language] {
+                 return reasoner_service_.deleteRules(content, language);
+             }});
+    }
+    return *this;
+}
+
+/**
+ * @brief Adds data to remove from the datastore, e.g. the previous version of changed ontologies.
+ * The data is referenced, not copied, and must outlive the call to `load()`.
+ *
+ * @param data Pairs of syntax type and data, as they were loaded.
+ * @return The loader, for chaining.
+ */
+ArtifactLoader& ArtifactLoader::removeData(
+    const std::vector<std::pair<ReasonerSyntaxType, std::string>>& data) {
+    for (const auto& [syntax, content] : data) {
+        removals_.push_back({fingerprint(reasonerSyntaxTypeToContentType(syntax), content),
+                             [this, &content, syntax = syntax] {
+                                 return reasoner_service_.deleteData(content, syntax);
+                             }});
+    }
+    return *this;
+}
+
+/**
+ * @brief Loads the artifacts that the datastore does not hold yet, then removes the artifacts to
+ * remove and updates the stored fingerprints.
+ *
+ * The previous versions of changed artifacts stay in the datastore until the new versions are
+ * loaded. If an artifact fails to load, nothing is removed. A removal also deletes the statements
+ * that the removed artifact shares with an added one, e.g. with the new version of a changed
+ * ontology, so the added artifacts are loaded again after a removal.
+ *
+ * Only the fingerprints of successfully loaded artifacts are stored, failed artifacts are loaded
+ * again on the next start. The fingerprints of removed artifacts are deleted.
+ *
+ * @return The number of loaded, unchanged, removed and failed artifacts and the time it took.
+ */
+ArtifactLoadStatistics ArtifactLoader::load() {
+    const auto start = std::chrono::steady_clock::now();
+    ArtifactLoadStatistics statistics;
+
+    std::set<std::string> known_fingerprints = queryFingerprints();
+
+    std::vector<const Artifact*> pending;
+    for (const Artifact& artifact : artifacts_) {
+        // Also skips duplicates within the added artifacts
+        if (known_fingerprints.insert(artifact.fingerprint).second) {
+            pending.push_back(&artifact);
+        } else {
+            ++statistics.unchanged;
+        }
+    }
+
+    const std::vector<char> results = applyInParallel(pending);
+    std::vector<std::string> loaded_fingerprints;
+    for (std::size_t index = 0; index < pending.size(); ++index) {
+        if (results[index]) {
+            loaded_fingerprints.push_back(pending[index]->fingerprint);
+        }
+    }
+    statistics.loaded = loaded_fingerprints.size();
+    statistics.failed += pending.size() - loaded_fingerprints.size();
+
+    if (!loaded_fingerprints.empty() && !storeFingerprints(loaded_fingerprints)) {
+        std::cerr << " - Failed to store the artifact fingerprints, the artifacts will be loaded "
+                     "again on the next start."
+                  << std::endl;
+    }
+
+    if (!removals_.empty() && statistics.failed == 0) {
+        statistics.removed = remove();
+        statistics.failed += removals_.size() - statistics.removed;
+        if (statistics.removed > 0) {
+            statistics.failed += reloadArtifacts();
+        }
+    }
+
+    statistics.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return statistics;
+}
+
+/**
+ * @brief Computes the fingerprint of an artifact: a 64-bit FNV-1a hash of the content type and
+ * content, followed by the content size.
+ *
+ * @param content_type The content type the artifact is loaded with.
+ * @param content The content of the artifact.
+ * @return The fingerprint, e.g. `cbf29ce484222325-1024`.
+ */
+std::string ArtifactLoader::fingerprint(const std::string& content_type,
+                                        const std::string& content) {
+    std::uint64_t hash = Helper::hashFnv1a(content_type);
+    hash = Helper::hashFnv1a("\n", hash);
+    hash = Helper::hashFnv1a(content, hash);
+
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << "-"
+           << content.size();
+    return stream.str();
+}
+
+/**
+ * @brief Removes the artifacts to remove and deletes their fingerprints.
+ *
+ * @return The number of removed artifacts.
+ */
+std::size_t ArtifactLoader::remove() const {
+    std::vector<const Artifact*> removals;
+    for (const Artifact& removal : removals_) {
+        removals.push_back(&removal);
+    }
+    const std::vector<char> results = applyInParallel(removals);
+    std::vector<std::string> removed_fingerprints;
+    for (std::size_t index = 0; index < removals.size(); ++index) {
+        if (results[index]) {
+            removed_fingerprints.push_back(removals[index]->fingerprint);
+        }
+    }
+
+    if (!removed_fingerprints.empty() && !deleteFingerprints(removed_fingerprints)) {
+        std::cerr << " - Failed to delete the fingerprints of the removed artifacts." << std::endl;
+    }
+    return removed_fingerprints.size();
+}
+
+/**
+ * @brief Loads all added artifacts again, to restore the statements a removal has deleted.
+ *
+ * The fingerprints of the artifacts that fail to load are deleted, so they are loaded again on
+ * the next start.
+ *
+ * @return The number of artifacts that failed to load.
+ */
+std::size_t ArtifactLoader::reloadArtifacts() const {
+    std::vector<const Artifact*> artifacts;
+    for (const Artifact& artifact : artifacts_) {
+        artifacts.push_back(&artifact);
+    }
+    const std::vector<char> results = applyInParallel(artifacts);
+    std::vector<std::string> failed_fingerprints;
+    for (std::size_t index = 0; index < artifacts.size(); ++index) {
+        if (!results[index]) {
+            failed_fingerprints.push_back(artifacts[index]->fingerprint);
+        }
+    }
+
+    if (!failed_fingerprints.empty() && !deleteFingerprints(failed_fingerprints)) {
+        std::cerr << " - Failed to delete the fingerprints of the artifacts that failed to load."
+                  << std::endl;
+    }
+    return failed_fingerprints.size();
+}
+
+/**
+ * @brief Queries the fingerprints of the artifacts the datastore holds.
+ *
+ * @return The stored fingerprints, empty if there are none or the query fails.
+ */
+std::set<std::string> ArtifactLoader::queryFingerprints() const {
+    const std::string query = std::string("SELECT ?fingerprint WHERE { GRAPH <") +
+                              FINGERPRINT_GRAPH + "> { ?artifact <" + FINGERPRINT_PREDICATE +
+                              "> ?fingerprint } }";
+    const std::string response = reasoner_service_.queryData(query, QueryLanguageType::SPARQL,
+                                                             DataQueryAcceptType::TEXT_TSV);
+
+    std::set<std::string> fingerprints;
+    std::istringstream lines(response);
+    std::string line;
+    // Skip the header line
+    std::getline(lines, line);
+    while (std::getline(lines, line)) {
+        line = Helper::trimTrailingNewlines(line);
+        if (line.size() >= 2 && line.front() == '"') {
+            fingerprints.insert(line.substr(1, line.find('"', 1) - 1));
+        }
+    }
+    return fingerprints;
+}
+
+/**
+ * @brief Stores fingerprints in the fingerprint graph of the datastore.
+ *
+ * @param fingerprints The fingerprints of the loaded artifacts.
+ * @return true if the fingerprints were stored.
+ */
+bool ArtifactLoader::storeFingerprints(const std::vector<std::string>& fingerprints) const {
+    return reasoner_service_.loadData(buildFingerprintTrig(fingerprints),
+                                      ReasonerSyntaxType::TRIG);
+}
+
+/**
+ * @brief Deletes fingerprints from the fingerprint graph of the datastore.
+ *
+ * @param fingerprints The fingerprints of the removed artifacts.
+ * @return true if the fingerprints were deleted.
+ */
+bool ArtifactLoader::deleteFingerprints(const std::vector<std::string>& fingerprints) const {
+    return reasoner_service_.deleteData(buildFingerprintTrig(fingerprints),
+                                        ReasonerSyntaxType::TRIG);
+}
+
+/**
+ * @brief Loads or removes artifacts on up to `max_parallel_loads_` threads.
+ *
+ * @param artifacts The artifacts to load or remove.
+ * @return Whether each artifact was applied, in the order of the artifacts.
+ */
+std::vector<char> ArtifactLoader::applyInParallel(
+    const std::vector<const Artifact*>& artifacts) const {
+    std::vector<char> results(artifacts.size(), 0);
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&artifacts, &results, &next] {
+        for (std::size_t index = next++; index < artifacts.size(); index = next++) {
+            try {
+                results[index] = artifacts[index]->apply() ? 1 : 0;
+            } catch (const std::exception& e) {
+                std::cerr << " - Failed to apply an artifact: " << e.what() << std::endl;
+            }
+        }
+    };
+
+    const std::size_t thread_count = std::min(max_parallel_loads_, artifacts.size());
+    if (thread_count <= 1) {
+        worker();
+        return results;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
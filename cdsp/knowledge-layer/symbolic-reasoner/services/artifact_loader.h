@@ -0,0 +1,81 @@
+#ifndef ARTIFACT_LOADER_H
+#define ARTIFACT_LOADER_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data_types.h"
+#include "reasoner_service.h"
+
+/**
+ * @brief Result of loading a set of artifacts into the reasoner.
+ */
+struct ArtifactLoadStatistics {
+    std::size_t loaded = 0;
+    // Artifacts skipped because the datastore already holds them
+    std::size_t unchanged = 0;
+    std::size_t removed = 0;
+    std::size_t failed = 0;
+    std::chrono::milliseconds duration{0};
+};
+
+/**
+ * @brief Loads rules, ontologies and validation shapes into the reasoner, skipping the artifacts
+ * the datastore already holds.
+ *
+ * Each artifact is identified by a fingerprint of its content type and content. The fingerprints
+ * of the loaded artifacts are stored as triples in a named graph of the datastore
+ * (`<urn:cdsp:artifacts>`), so that a restart only loads new or changed artifacts. Artifacts
+ * that need loading are independent of each other and are sent in parallel.
+ *
+ * At startup the content of changed artifacts is added, the previous version is not removed.
+ * Resetting the datastore (`-X reset_ds`) drops the fingerprints and loads everything again. A
+ * reload of the model configuration knows the previous version and removes it explicitly with
+ * `removeRules()` and `removeData()`, after the new version is loaded.
+ */
+class ArtifactLoader {
+   public:
+    static constexpr std::size_t DEFAULT_PARALLEL_LOADS = 4;
+    static constexpr char FINGERPRINT_GRAPH[] = "urn:cdsp:artifacts";
+    static constexpr char FINGERPRINT_PREDICATE[] = "urn:cdsp:fingerprint";
+
+    explicit ArtifactLoader(ReasonerService& reasoner_service,
+                            std::size_t max_parallel_loads = DEFAULT_PARALLEL_LOADS);
+
+    ArtifactLoader& addRules(const std::vector<std::pair<RuleLanguageType, std::string>>& rules);
+    ArtifactLoader& addData(const std::vector<std::pair<ReasonerSyntaxType, std::string>>& data);
+    ArtifactLoader& removeRules(
+        const std::vector<std::pair<RuleLanguageType, std::string>>& rules);
+    ArtifactLoader& removeData(
+        const std::vector<std::pair<ReasonerSyntaxType, std::string>>& data);
+
+    ArtifactLoadStatistics load();
+
+    static std::string fingerprint(const std::string& content_type, const std::string& content);
+
+   private:
+    struct Artifact {
+        std::string fingerprint;
+        // Loads or removes the artifact
+        std::function<bool()> apply;
+    };
+
+    ReasonerService& reasoner_service_;
+    const std::size_t max_parallel_loads_;
+    std::vector<Artifact> artifacts_;
+    std::vector<Artifact> removals_;
+
+    std::set<std::string> queryFingerprints() const;
+    bool storeFingerprints(const std::vector<std::string>& fingerprints) const;
+    bool deleteFingerprints(const std::vector<std::string>& fingerprints) const;
+    std::size_t remove() const;
+    std::size_t reloadArtifacts() const;
+    std::vector<char> applyInParallel(const std::vector<const Artifact*>& artifacts) const;
+};
+
+#endif  // ARTIFACT_LOADER_H
@@ -0,0 +1,214 @@
+#include "query_result_cache.h"
+
+#include <array>
+#include <cctype>
+#include <string_view>
+
+#include "helper.h"
+
+namespace {
+// Functions whose result differs between two runs of a query on the same data
+constexpr std::array<std::string_view, 5> NON_DETERMINISTIC_FUNCTIONS = {"NOW", "RAND", "UUID",
+                                                                         "STRUUID", "BNODE"};
+// Keywords of the clauses that read named graphs
+constexpr std::array<std::string_view, 2> GRAPH_KEYWORDS = {"GRAPH", "FROM"};
+
+bool isNameCharacter(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+}  // namespace
+
+/**
+ * @brief Reads the cache settings from the environment.
+ *
+ * QUERY_RESULT_CACHE_SIZE sets the most query results kept (default 64, 0 disables the cache).
+ *
+ * @return The cache settings.
+ * @throws std::invalid_argument if the variable has an invalid value.
+ */
+QueryResultCacheSettings QueryResultCacheSettings::fromEnvironment() {
+    QueryResultCacheSettings settings;
+    settings.max_entries =
+        Helper::getUnsignedEnvVariable("QUERY_RESULT_CACHE_SIZE", settings.max_entries);
+    return settings;
+}
+
+QueryResultCache::QueryResultCache(QueryResultCacheSettings settings) : settings_(settings) {}
+
+/**
+ * @brief Retrieves the current version of the datastore. A query result stored with it is valid
+ * until the next invalidate().
+ */
+std::uint64_t QueryResultCache::getVersion() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+/**
+ * @brief Marks a change of the datastore, which outdates all cached results.
+ */
+void QueryResultCache::invalidate() {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    version_++;
+    statistics_.invalidations++;
+    entries_.clear();
+    recently_used_.clear();
+}
+
+/**
+ * @brief Marks a change of a named graph, which outdates the cached results of the queries that
+ * may read the graph. The other results stay cached.
+ *
+ * @param graph The IRI of the graph.
+ */
+void QueryResultCache::invalidateGraph(const std::string& graph) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    version_++;
+    for (auto entry = entries_.begin(); entry != entries_.end();) {
+        const std::string& key = entry->first;
+        if (readsGraph(key.substr(key.find('\n') + 1), graph)) {
+            recently_used_.erase(entry->second.position);
+            entry = entries_.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+}
+
+/**
+ * @brief Looks up the result of a query on the current data.
+ *
+ * @param query The query.
+ * @param query_language_type The language of the query.
+ * @param accept_type The format of the result.
+ * @return The cached result, or std::nullopt if the query has to be sent to the reasoner.
+ */
+std::optional<std::string> QueryResultCache::lookup(const std::string& query,
+                                                    const QueryLanguageType& query_language_type,
+                                                    const DataQueryAcceptType& accept_type) {
+    if (settings_.max_entries == 0) {
+        return std::nullopt;
+    }
+    const bool cacheable = isCacheable(query);
+    const std::string key = makeKey(query, query_language_type, accept_type);
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (!cacheable) {
+        statistics_.uncacheable++;
+        return std::nullopt;
+    }
+    const auto entry = entries_.find(key);
+    if (entry == entries_.end()) {
+        statistics_.misses++;
+        return std::nullopt;
+    }
+    statistics_.hits++;
+    recently_used_.splice(recently_used_.begin(), recently_used_, entry->second.position);
+    return entry->second.result;
+}
+
+/**
+ * @brief Stores the result of a query.
+ *
+ * If the cache is full, the least recently used result is evicted.
+ *
+ * @param query The query.
+ * @param query_language_type The language of the query.
+ * @param accept_type The format of the result.
+ * @param version The version of the datastore read before the query was sent. The result is
+ * dropped if the datastore has changed since, as it may not reflect the change.
+ * @param result The result returned by the reasoner.
+ */
+void QueryResultCache::store(const std::string& query, const QueryLanguageType& query_language_type,
+                             const DataQueryAcceptType& accept_type, std::uint64_t version,
+                             const std::string& result) {
+    if (settings_.max_entries == 0 || !isCacheable(query)) {
+        return;
+    }
+    std::string key = makeKey(query, query_language_type, accept_type);
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (version != version_) {
+        return;
+    }
+    const auto entry = entries_.find(key);
+    if (entry != entries_.end()) {
+        entry->second.result = result;
+        recently_used_.splice(recently_used_.begin(), recently_used_, entry->second.position);
+        return;
+    }
+    if (entries_.size() >= settings_.max_entries) {
+        entries_.erase(recently_used_.back());
+        recently_used_.pop_back();
+        statistics_.evictions++;
+    }
+    recently_used_.push_front(key);
+    entries_.emplace(std::move(key), Entry{result, recently_used_.begin()});
+}
+
+/**
+ * @brief Retrieves a copy of the counters.
+ */
+QueryResultCacheStatistics QueryResultCache::getStatistics() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+/**
+ * @brief Checks whether the result of a query only depends on the data in the datastore.
+ *
+ * @param query The query.
+ * @return false if the query calls a function like NOW() or RAND().
+ */
+bool QueryResultCache::isCacheable(const std::string& query) {
+    const std::string upper_query = Helper::toUppercase(query);
+    for (const std::string_view function : NON_DETERMINISTIC_FUNCTIONS) {
+        for (std::size_t position = upper_query.find(function); position != std::string::npos;
+             position = upper_query.find(function, position + 1)) {
+            if (position > 0 && isNameCharacter(upper_query[position - 1])) {
+                continue;
+            }
+            std::size_t next = position + function.size();
+            while (next < upper_query.size() &&
+                   std::isspace(static_cast<unsigned char>(upper_query[next])) != 0) {
+                next++;
+            }
+            if (next < upper_query.size() && upper_query[next] == '(') {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether a query may read a named graph: it names the graph or uses the GRAPH or
+ * FROM keyword, e.g. `GRAPH ?g { ... }`.
+ *
+ * @param query The query.
+ * @param graph The IRI of the graph.
+ */
+bool QueryResultCache::readsGraph(const std::string& query, const std::string& graph) {
+    if (query.find(graph) != std::string::npos) {
+        return true;
+    }
+    const std::string upper_query = Helper::toUppercase(query);
+    for (const std::string_view keyword : GRAPH_KEYWORDS) {
+        for (std::size_t position = upper_query.find(keyword); position != std::string::npos;
+             position = upper_query.find(keyword, position + 1)) {
+            const std::size_t end = position + keyword.size();
+            if ((position == 0 || !isNameCharacter(upper_query[position - 1])) &&
+                (end == upper_query.size() || !isNameCharacter(upper_query[end]))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::string QueryResultCache::makeKey(const std::string& query,
+                                      const QueryLanguageType& query_language_type,
+                                      const DataQueryAcceptType& accept_type) {
+    return std::to_string(static_cast<int>(query_language_type)) + ' ' +
+           std::to_string(static_cast<int>(accept_type)) + '\n' + query;
+}
@@ -0,0 +1,96 @@
+#ifndef QUERY_RESULT_CACHE_H
+#define QUERY_RESULT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "data_types.h"
+
+/**
+ * @brief Settings of the QueryResultCache.
+ */
+struct QueryResultCacheSettings {
+    // Most query results kept, 0 disables the cache
+    std::size_t max_entries = 64;
+
+    static QueryResultCacheSettings fromEnvironment();
+};
+
+/**
+ * @brief Counters of the QueryResultCache.
+ */
+struct QueryResultCacheStatistics {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    // Queries that are never cached, e.g. because they use NOW()
+    std::uint64_t uncacheable = 0;
+    // Changes of the datastore, each one outdates all cached results
+    std::uint64_t invalidations = 0;
+    // Results dropped to make room for a new one
+    std::uint64_t evictions = 0;
+};
+
+/**
+ * @brief Remembers query results until the datastore changes.
+ *
+ * Every change of the datastore made through the ReasonerService drops the cached results it
+ * outdates, so repeating a query without new data in between does not reach the reasoner. The
+ * change also increments a local version counter, which keeps results of queries that were
+ * already running from being stored. Changes made by other clients of the datastore are not
+ * seen; the cache assumes the connector is its only writer.
+ *
+ * A change of a single named graph, e.g. the watermarks of the output queries, only outdates the
+ * results of queries that name the graph or read named graphs through GRAPH or FROM.
+ *
+ * Queries whose result depends on more than the data, i.e. that use NOW(), RAND(), UUID(),
+ * STRUUID() or BNODE(), are never cached. When the cache is full, the least recently used result
+ * makes room for a new one.
+ */
+class QueryResultCache {
+   public:
+    explicit QueryResultCache(QueryResultCacheSettings settings = QueryResultCacheSettings());
+
+    [[nodiscard]] std::uint64_t getVersion() const;
+    void invalidate();
+    void invalidateGraph(const std::string& graph);
+
+    [[nodiscard]] std::optional<std::string> lookup(const std::string& query,
+                                                    const QueryLanguageType& query_language_type,
+                                                    const DataQueryAcceptType& accept_type);
+    void store(const std::string& query, const QueryLanguageType& query_language_type,
+               const DataQueryAcceptType& accept_type, std::uint64_t version,
+               const std::string& result);
+
+    [[nodiscard]] QueryResultCacheStatistics getStatistics() const;
+
+    static bool isCacheable(const std::string& query);
+
+   private:
+    struct Entry {
+        std::string result;
+        // Position of the key in recently_used_
+        std::list<std::string>::iterator position;
+    };
+
+    const QueryResultCacheSettings settings_;
+
+    // Guards all members below, queries may run concurrently
+    mutable std::mutex mutex_;
+    std::uint64_t version_ = 0;
+    std::unordered_map<std::string, Entry> entries_;
+    // Keys of the entries, the most recently used first
+    std::list<std::string> recently_used_;
+    QueryResultCacheStatistics statistics_;
+
+    static bool readsGraph(const std::string& query, const std::string& graph);
+    static std::string makeKey(const std::string& query,
+                               const QueryLanguageType& query_language_type,
+                               const DataQueryAcceptType& accept_type);
+};
+
+#endif  // QUERY_RESULT_CACHE_H
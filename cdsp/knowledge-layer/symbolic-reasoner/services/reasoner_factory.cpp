@@ -1,17 +1,36 @@
 #include "reasoner_factory.h"
 
+#include <chrono>
 #include <iostream>
 
+#include "artifact_loader.h"
+
+namespace {
+/**
+ * @brief Prints the result of loading a set of artifacts, one line per startup phase.
+ */
+void printLoadStatistics(const std::string& artifacts, const ArtifactLoadStatistics& statistics) {
+    std::cout << " - Loaded " << statistics.loaded << " " << artifacts << " ("
+              << statistics.unchanged << " unchanged) in " << statistics.duration.count() << " ms"
+              << std::endl;
+}
+}  // namespace
+
 /**
  * Initializes a ReasonerService based on the specified inference engine, server data,
  * reasoner rules, and ontologies.
  *
+ * Rules and ontologies the data store already holds from a previous start are not loaded again,
+ * see ArtifactLoader. The time of each startup phase is printed.
+ *
  * @param inference_engine The type of inference engine to be used.
  * @param server_data The server data required for initializing the reasoner.
  * @param reasoner_rules A vector of pairs containing rule language types and their corresponding
  * rules.
  * @param ontologies A vector of pairs containing reasoner syntax types and their corresponding
  * ontologies.
+ * @param reset_datastore Whether to delete the data store before it is initialized.
+ * @param query_cache_settings The settings of the cache of query results.
  * @return A shared pointer to the initialized ReasonerService.
  * @throws std::invalid_argument If the specified inference engine is unsupported.
  * @throws std::runtime_error If the reasoner service fails to initialize due to a missing data
@@ -21,7 +40,7 @@ std::shared_ptr<ReasonerService> ReasonerFactory::initReasoner(
     const InferenceEngineType& inference_engine, const ReasonerServerData& server_data,
     const std::vector<std::pair<RuleLanguageType, std::string>>& reasoner_rules,
     const std::vector<std::pair<ReasonerSyntaxType, std::string>>& ontologies,
-    const bool reset_datastore) {
+    const bool reset_datastore, QueryResultCacheSettings query_cache_settings) {
     std::shared_ptr<IReasonerAdapter> reasoner_adapter;
 
     if (inference_engine == InferenceEngineType::RDFOX) {
@@ -32,12 +51,17 @@ std::shared_ptr<ReasonerService> ReasonerFactory::initReasoner(
 
     std::shared_ptr<ReasonerService> reasoner_service;
 
-    reasoner_service = std::make_shared<ReasonerService>(reasoner_adapter, reset_datastore);
+    const auto start = std::chrono::steady_clock::now();
+    reasoner_service = std::make_shared<ReasonerService>(reasoner_adapter, reset_datastore,
+                                                         query_cache_settings);
 
     if (!reasoner_service->checkDataStore()) {
         throw std::runtime_error(
             "Failed to initialize the reasoner service. Data store not found.");
     }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << " - Data store ready in " << elapsed.count() << " ms" << std::endl;
 
     loadRules(reasoner_service, reasoner_rules);
     loadOntologies(reasoner_service, ontologies);
@@ -49,8 +73,8 @@ std::shared_ptr<ReasonerService> ReasonerFactory::initReasoner(
  *
  * This function attempts to load a collection of rules into the provided
  * ReasonerService. Each rule is represented as a pair consisting of a
- * RuleLanguageType and a string. The function counts and outputs the number
- * of successfully loaded rules.
+ * RuleLanguageType and a string. Rules the data store already holds are skipped, the others are
+ * loaded in parallel. The function outputs the number of loaded and unchanged rules.
  *
  * @param reasoner_service A shared pointer to the ReasonerService where the
  *                         rules will be loaded. Must be initialized.
@@ -61,12 +85,12 @@ void ReasonerFactory::loadRules(
     const std::shared_ptr<ReasonerService>& reasoner_service,
     const std::vector<std::pair<RuleLanguageType, std::string>>& rules) {
     std::cout << " - Loading rules into the reasoner service..." << std::endl;
-    for (const auto& rule : rules) {
-        if (!reasoner_service->loadRules(rule.second, rule.first)) {
-            throw std::runtime_error("Failed to load rules into the reasoner service.");
-        }
+    const ArtifactLoadStatistics statistics =
+        ArtifactLoader(*reasoner_service).addRules(rules).load();
+    if (statistics.failed > 0) {
+        throw std::runtime_error("Failed to load rules into the reasoner service.");
     }
-    std::cout << " - Successfully loaded rules!" << std::endl;
+    printLoadStatistics("rules", statistics);
 }
 
 /**
@@ -74,8 +98,9 @@ void ReasonerFactory::loadRules(
  *
  * This function attempts to load a collection of ontologies into the provided
  * ReasonerService. Each ontology is represented as a pair consisting of a
- * ReasonerSyntaxType and a string. The function counts and outputs the number
- * of successfully loaded ontologies.
+ * ReasonerSyntaxType and a string. Ontologies the data store already holds are skipped, the
+ * others are loaded in parallel. The function outputs the number of loaded and unchanged
+ * ontologies.
  *
  * @param reasoner_service A shared pointer to the ReasonerService where the
  *                        ontologies will be loaded. Must be initialized.
@@ -86,10 +111,10 @@ void ReasonerFactory::loadOntologies(
     const std::shared_ptr<ReasonerService>& reasoner_service,
     const std::vector<std::pair<ReasonerSyntaxType, std::string>>& ontologies) {
     std::cout << " - Loading ontologies into the reasoner service..." << std::endl;
-    for (const auto& ontology : ontologies) {
-        if (!reasoner_service->loadData(ontology.second, ontology.first)) {
-            throw std::runtime_error("Failed to load ontologies into the reasoner service.");
-        }
+    const ArtifactLoadStatistics statistics =
+        ArtifactLoader(*reasoner_service).addData(ontologies).load();
+    if (statistics.failed > 0) {
+        throw std::runtime_error("Failed to load ontologies into the reasoner service.");
     }
-    std::cout << " - Successfully loaded ontologies!" << std::endl;
+    printLoadStatistics("ontologies", statistics);
 }
\ No newline at end of file
@@ -14,7 +14,8 @@ class ReasonerFactory {
         const InferenceEngineType& inference_engine, const ReasonerServerData& server_data,
         const std::vector<std::pair<RuleLanguageType, std::string>>& reasoner_rules,
         const std::vector<std::pair<ReasonerSyntaxType, std::string>>& ontologies,
-        const bool reset_datastore);
+        const bool reset_datastore,
+        QueryResultCacheSettings query_cache_settings = QueryResultCacheSettings());
 
    protected:
     static void loadRules(const std::shared_ptr<ReasonerService>& reasoner_service,
@@ -1,16 +1,22 @@
 #ifndef REASONER_SERVICE_H
 #define REASONER_SERVICE_H
 
+#include <cstdint>
 #include <iostream>
+#include <optional>
+#include <string>
 
 #include "data_types.h"
 #include "i_reasoner_adapter.h"
 #include "memory"
+#include "query_result_cache.h"
 
 class ReasonerService {
    public:
-    explicit ReasonerService(std::shared_ptr<IReasonerAdapter> adapter, const bool reset_datastore)
-        : adapter_(std::move(adapter)) {
+    explicit ReasonerService(
+        std::shared_ptr<IReasonerAdapter> adapter, const bool reset_datastore,
+        QueryResultCacheSettings query_cache_settings = QueryResultCacheSettings())
+        : adapter_(std::move(adapter)), query_cache_(query_cache_settings) {
         if (reset_datastore) {
             std::cout << "Deleting the datastore...\n";
             deleteDataStore();
@@ -23,24 +29,99 @@ class ReasonerService {
 
     virtual bool loadData(const std::string& data, const ReasonerSyntaxType& content_type) {
         const std::string content_type_str = reasonerSyntaxTypeToContentType(content_type);
+        const DataStoreChange change(query_cache_);
         return adapter_->loadData(data, content_type_str);
     }
 
     virtual bool loadRules(const std::string& rules, const RuleLanguageType& content_type) {
         const std::string content_type_str = ruleLanguageTypeToContentType(content_type);
+        const DataStoreChange change(query_cache_);
         return adapter_->loadData(rules, content_type_str);
     }
 
+    virtual bool deleteData(const std::string& data, const ReasonerSyntaxType& content_type) {
+        const std::string content_type_str = reasonerSyntaxTypeToContentType(content_type);
+        const DataStoreChange change(query_cache_);
+        return adapter_->deleteData(data, content_type_str);
+    }
+
+    virtual bool deleteRules(const std::string& rules, const RuleLanguageType& content_type) {
+        const std::string content_type_str = ruleLanguageTypeToContentType(content_type);
+        const DataStoreChange change(query_cache_);
+        return adapter_->deleteData(rules, content_type_str);
+    }
+
+    // Changes a named graph that only the connector reads, e.g. the query watermarks. The cached
+    // results of queries that do not read named graphs stay valid.
+    virtual bool loadGraphData(const std::string& graph, const std::string& data,
+                               const ReasonerSyntaxType& content_type) {
+        const std::string content_type_str = reasonerSyntaxTypeToContentType(content_type);
+        const DataStoreChange change(query_cache_, graph);
+        return adapter_->loadData(data, content_type_str);
+    }
+
+    virtual bool deleteGraphData(const std::string& graph, const std::string& data,
+                                 const ReasonerSyntaxType& content_type) {
+        const std::string content_type_str = reasonerSyntaxTypeToContentType(content_type);
+        const DataStoreChange change(query_cache_, graph);
+        return adapter_->deleteData(data, content_type_str);
+    }
+
     virtual std::string queryData(
         const std::string& query, const QueryLanguageType& query_language_type,
         const DataQueryAcceptType& accept_type = DataQueryAcceptType::TEXT_TSV) {
-        return adapter_->queryData(query, query_language_type, accept_type);
+        // Results are served from the cache while the datastore has not changed
+        const std::uint64_t version = query_cache_.getVersion();
+        if (auto result = query_cache_.lookup(query, query_language_type, accept_type)) {
+            return *result;
+        }
+        std::string result = adapter_->queryData(query, query_language_type, accept_type);
+        if (!result.empty()) {
+            query_cache_.store(query, query_language_type, accept_type, version, result);
+        }
+        return result;
     }
 
-    virtual bool deleteDataStore() { return adapter_->deleteDataStore(); }
+    virtual bool deleteDataStore() {
+        const DataStoreChange change(query_cache_);
+        return adapter_->deleteDataStore();
+    }
+
+    std::uint64_t getDataStoreVersion() const { return query_cache_.getVersion(); }
+
+    QueryResultCacheStatistics getQueryCacheStatistics() const {
+        return query_cache_.getStatistics();
+    }
 
    private:
+    /**
+     * @brief Outdates the cached query results once a change of the datastore has completed,
+     * also if it failed, as a failed request may have changed part of the data. A change of a
+     * single named graph only outdates the results of the queries that may read it.
+     */
+    class DataStoreChange {
+       public:
+        explicit DataStoreChange(QueryResultCache& cache,
+                                 std::optional<std::string> graph = std::nullopt)
+            : cache_(cache), graph_(std::move(graph)) {}
+        ~DataStoreChange() {
+            if (graph_) {
+                cache_.invalidateGraph(*graph_);
+            } else {
+                cache_.invalidate();
+            }
+        }
+
+        DataStoreChange(const DataStoreChange&) = delete;
+        DataStoreChange& operator=(const DataStoreChange&) = delete;
+
+       private:
+        QueryResultCache& cache_;
+        std::optional<std::string> graph_;
+    };
+
     std::shared_ptr<IReasonerAdapter> adapter_;
+    QueryResultCache query_cache_;
 };
 
 #endif  // REASONER_SERVICE_H
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "artifact_loader.h"
+#include "data_types.h"
+#include "mock_reasoner_adapter.h"
+#include "mock_reasoner_service.h"
+
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Not;
+using ::testing::Return;
+using ::testing::StrEq;
+
+class ArtifactLoaderUnitTest : public ::testing::Test {
+   protected:
+    std::shared_ptr<MockReasonerAdapter> mock_adapter_;
+    std::shared_ptr<MockReasonerService> mock_reasoner_service_;
+
+    const std::vector<std::pair<RuleLanguageType, std::string>> rules_ = {
+        {RuleLanguageType::DATALOG, "rule_1"}, {RuleLanguageType::DATALOG, "rule_2"}};
+    const std::vector<std::pair<ReasonerSyntaxType, std::string>> ontologies_ = {
+        {ReasonerSyntaxType::TURTLE, "ontology_1"}};
+
+    void SetUp() override {
+        mock_adapter_ = std::make_shared<MockReasonerAdapter>();
+        EXPECT_CALL(*mock_adapter_, initialize()).Times(1);
+        mock_reasoner_service_ = std::make_shared<MockReasonerService>(mock_adapter_);
+    }
+
+    // Makes the fingerprint query return the given fingerprints
+    void expectStoredFingerprints(const std::vector<std::string>& fingerprints) {
+        std::string response = "?fingerprint\n";
+        for (const auto& fingerprint : fingerprints) {
+            response += "\"" + fingerprint + "\"\n";
+        }
+        EXPECT_CALL(*mock_reasoner_service_,
+                    queryData(HasSubstr(ArtifactLoader::FINGERPRINT_GRAPH), _, _))
+            .WillOnce(Return(response));
+    }
+};
+
+// Test that fingerprints depend on the content and the content type
+TEST_F(ArtifactLoaderUnitTest, FingerprintDependsOnContentAndType) {
+    const std::string fingerprint = ArtifactLoader::fingerprint("text/turtle", "content");
+    EXPECT_EQ(fingerprint, ArtifactLoader::fingerprint("text/turtle", "content"));
+    EXPECT_NE(fingerprint, ArtifactLoader::fingerprint("text/turtle", "contents"));
+    EXPECT_NE(fingerprint, ArtifactLoader::fingerprint("application/trig", "content"));
+    EXPECT_EQ(fingerprint.substr(fingerprint.size() - 2), "-7");
+}
+
+// Test that all artifacts are loaded into an empty datastore and their fingerprints are stored
+TEST_F(ArtifactLoaderUnitTest, LoadsAllArtifactsIntoEmptyDatastore) {
+    expectStoredFingerprints({});
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_1"), RuleLanguageType::DATALOG))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_2"), RuleLanguageType::DATALOG))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(StrEq("ontology_1"), ReasonerSyntaxType::TURTLE))
+        .WillOnce(Return(true));
+
+    const std::string rule_fingerprint =
+        ArtifactLoader::fingerprint("application/x.datalog", "rule_1");
+    EXPECT_CALL(*mock_reasoner_service_,
+                loadData(HasSubstr("\"" + rule_fingerprint + "\""), ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+
+    const auto statistics =
+        ArtifactLoader(*mock_reasoner_service_).addRules(rules_).addData(ontologies_).load();
+    EXPECT_EQ(statistics.loaded, 3u);
+    EXPECT_EQ(statistics.unchanged, 0u);
+    EXPECT_EQ(statistics.failed, 0u);
+}
+
+// Test that only the artifacts without a stored fingerprint are loaded
+TEST_F(ArtifactLoaderUnitTest, SkipsUnchangedArtifacts) {
+    expectStoredFingerprints({ArtifactLoader::fingerprint("application/x.datalog", "rule_1"),
+                              ArtifactLoader::fingerprint("text/turtle", "ontology_1")});
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_1"), _)).Times(0);
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_2"), _)).WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(StrEq("ontology_1"), _)).Times(0);
+    EXPECT_CALL(*mock_reasoner_service_, loadData(_, ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+
+    const auto statistics =
+        ArtifactLoader(*mock_reasoner_service_).addRules(rules_).addData(ontologies_).load();
+    EXPECT_EQ(statistics.loaded, 1u);
+    EXPECT_EQ(statistics.unchanged, 2u);
+}
+
+// Test that the fingerprints of failed artifacts are not stored
+TEST_F(ArtifactLoaderUnitTest, DoesNotStoreFingerprintsOfFailedArtifacts) {
+    expectStoredFingerprints({});
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_1"), _)).WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_2"), _)).WillOnce(Return(false));
+
+    const std::string failed_fingerprint =
+        ArtifactLoader::fingerprint("application/x.datalog", "rule_2");
+    EXPECT_CALL(*mock_reasoner_service_,
+                loadData(Not(HasSubstr(failed_fingerprint)), ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+
+    const auto statistics = ArtifactLoader(*mock_reasoner_service_).addRules(rules_).load();
+    EXPECT_EQ(statistics.loaded, 1u);
+    EXPECT_EQ(statistics.failed, 1u);
+}
+
+// Test that many artifacts are loaded on several threads
+TEST_F(ArtifactLoaderUnitTest, LoadsArtifactsInParallel) {
+    std::vector<std::pair<ReasonerSyntaxType, std::string>> shapes;
+    for (int i = 0; i < 16; ++i) {
+        shapes.emplace_back(ReasonerSyntaxType::TURTLE, "shape_" + std::to_string(i));
+    }
+    expectStoredFingerprints({});
+    EXPECT_CALL(*mock_reasoner_service_, loadData(HasSubstr("shape_"), ReasonerSyntaxType::TURTLE))
+        .Times(16)
+        .WillRepeatedly(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(_, ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+
+    const auto statistics = ArtifactLoader(*mock_reasoner_service_, 4).addData(shapes).load();
+    EXPECT_EQ(statistics.loaded, 16u);
+}
+
+// Test that removed artifacts are deleted from the datastore together with their fingerprints,
+// after the added artifacts are loaded, which are loaded again to restore shared statements
+TEST_F(ArtifactLoaderUnitTest, RemovesArtifactsAndTheirFingerprints) {
+    const std::vector<std::pair<RuleLanguageType, std::string>> removed_rules = {
+        {RuleLanguageType::DATALOG, "old_rule"}};
+    const std::string removed_fingerprint =
+        ArtifactLoader::fingerprint("application/x.datalog", "old_rule");
+    expectStoredFingerprints({removed_fingerprint});
+    ::testing::Sequence rule_1_sequence;
+    ::testing::Sequence rule_2_sequence;
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_1"), _))
+        .InSequence(rule_1_sequence)
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_2"), _))
+        .InSequence(rule_2_sequence)
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(_, ReasonerSyntaxType::TRIG))
+        .InSequence(rule_1_sequence, rule_2_sequence)
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_,
+                deleteRules(StrEq("old_rule"), RuleLanguageType::DATALOG))
+        .InSequence(rule_1_sequence, rule_2_sequence)
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_,
+                deleteData(HasSubstr("\"" + removed_fingerprint + "\""), ReasonerSyntaxType::TRIG))
+        .InSequence(rule_1_sequence, rule_2_sequence)
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_1"), _))
+        .InSequence(rule_1_sequence)
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_2"), _))
+        .InSequence(rule_2_sequence)
+        .WillOnce(Return(true));
+
+    const auto statistics =
+        ArtifactLoader(*mock_reasoner_service_).removeRules(removed_rules).addRules(rules_).load();
+    EXPECT_EQ(statistics.removed, 1u);
+    EXPECT_EQ(statistics.loaded, 2u);
+    EXPECT_EQ(statistics.failed, 0u);
+}
+
+// Test that nothing is removed when an added artifact fails to load
+TEST_F(ArtifactLoaderUnitTest, KeepsRemovedArtifactsWhenLoadingFails) {
+    const std::vector<std::pair<RuleLanguageType, std::string>> removed_rules = {
+        {RuleLanguageType::DATALOG, "old_rule"}};
+    expectStoredFingerprints({ArtifactLoader::fingerprint("application/x.datalog", "old_rule")});
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_1"), _)).WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, loadRules(StrEq("rule_2"), _)).WillOnce(Return(false));
+    EXPECT_CALL(*mock_reasoner_service_, loadData(_, ReasonerSyntaxType::TRIG))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_reasoner_service_, deleteRules(_, _)).Times(0);
+    EXPECT_CALL(*mock_reasoner_service_, deleteData(_, _)).Times(0);
+
+    const auto statistics =
+        ArtifactLoader(*mock_reasoner_service_).removeRules(removed_rules).addRules(rules_).load();
+    EXPECT_EQ(statistics.loaded, 1u);
+    EXPECT_EQ(statistics.removed, 0u);
+    EXPECT_EQ(statistics.failed, 1u);
+}
@@ -0,0 +1,167 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "data_types.h"
+#include "mock_reasoner_adapter.h"
+#include "reasoner_service.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::Throw;
+
+class ReasonerServiceUnitTest : public ::testing::Test {
+   protected:
+    std::shared_ptr<MockReasonerAdapter> mock_adapter_;
+
+    const std::string query_ = "SELECT ?s WHERE { ?s ?p ?o }";
+
+    void SetUp() override {
+        mock_adapter_ = std::make_shared<MockReasonerAdapter>();
+        EXPECT_CALL(*mock_adapter_, initialize()).Times(1);
+    }
+
+    ReasonerService makeService(std::size_t max_entries) {
+        QueryResultCacheSettings settings;
+        settings.max_entries = max_entries;
+        return ReasonerService(mock_adapter_, false, settings);
+    }
+};
+
+// Test that a repeated query is answered from the cache until the datastore changes
+TEST_F(ReasonerServiceUnitTest, QueryResultIsCachedUntilDataStoreChanges) {
+    EXPECT_CALL(*mock_adapter_, queryData(query_, QueryLanguageType::SPARQL, _))
+        .Times(2)
+        .WillOnce(Return("?s\n<a>\n"))
+        .WillOnce(Return("?s\n<a>\n<b>\n"));
+    EXPECT_CALL(*mock_adapter_, loadData(_, _)).WillOnce(Return(true));
+    ReasonerService service = makeService(8);
+
+    EXPECT_EQ(service.queryData(query_, QueryLanguageType::SPARQL), "?s\n<a>\n");
+    EXPECT_EQ(service.queryData(query_, QueryLanguageType::SPARQL), "?s\n<a>\n");
+    const auto version = service.getDataStoreVersion();
+
+    EXPECT_TRUE(service.loadData("<b> <p> <o> .", ReasonerSyntaxType::TURTLE));
+    EXPECT_EQ(service.getDataStoreVersion(), version + 1);
+    EXPECT_EQ(service.queryData(query_, QueryLanguageType::SPARQL), "?s\n<a>\n<b>\n");
+    EXPECT_EQ(service.queryData(query_, QueryLanguageType::SPARQL), "?s\n<a>\n<b>\n");
+
+    const auto statistics = service.getQueryCacheStatistics();
+    EXPECT_EQ(statistics.hits, 2u);
+    EXPECT_EQ(statistics.misses, 2u);
+    EXPECT_EQ(statistics.invalidations, 1u);
+}
+
+// Test that a failed change of the datastore also outdates the cached results
+TEST_F(ReasonerServiceUnitTest, FailedChangeInvalidatesCache) {
+    EXPECT_CALL(*mock_adapter_, queryData(query_, QueryLanguageType::SPARQL, _))
+        .Times(2)
+        .WillRepeatedly(Return("?s\n<a>\n"));
+    EXPECT_CALL(*mock_adapter_, deleteData(_, _))
+        .WillOnce(Throw(std::runtime_error("Connection lost")));
+    ReasonerService service = makeService(8);
+
+    service.queryData(query_, QueryLanguageType::SPARQL);
+    EXPECT_THROW(service.deleteData("<a> <p> <o> .", ReasonerSyntaxType::TURTLE),
+                 std::runtime_error);
+    service.queryData(query_, QueryLanguageType::SPARQL);
+}
+
+// Test that a change of a named graph only outdates the results of queries that may read it
+TEST_F(ReasonerServiceUnitTest, GraphChangeKeepsResultsOfOtherQueries) {
+    const std::string graph_query = "SELECT ?s WHERE { GRAPH ?g { ?s ?p ?o } }";
+    const std::string named_query = "SELECT ?s WHERE { ?s <urn:cdsp:watermark> ?o }";
+    EXPECT_CALL(*mock_adapter_, queryData(query_, _, _)).WillOnce(Return("?s\n<a>\n"));
+    EXPECT_CALL(*mock_adapter_, queryData(graph_query, _, _))
+        .Times(2)
+        .WillRepeatedly(Return("?s\n"));
+    EXPECT_CALL(*mock_adapter_, queryData(named_query, _, _))
+        .Times(2)
+        .WillRepeatedly(Return("?s\n"));
+    EXPECT_CALL(*mock_adapter_, loadData(_, _)).WillOnce(Return(true));
+    EXPECT_CALL(*mock_adapter_, deleteData(_, _)).WillOnce(Return(true));
+    ReasonerService service = makeService(8);
+
+    service.queryData(query_, QueryLanguageType::SPARQL);
+    service.queryData(graph_query, QueryLanguageType::SPARQL);
+    service.queryData(named_query, QueryLanguageType::SPARQL);
+    EXPECT_TRUE(service.deleteGraphData("urn:cdsp:watermark", "", ReasonerSyntaxType::TRIG));
+    EXPECT_TRUE(service.loadGraphData("urn:cdsp:watermark", "", ReasonerSyntaxType::TRIG));
+
+    EXPECT_EQ(service.queryData(query_, QueryLanguageType::SPARQL), "?s\n<a>\n");
+    service.queryData(graph_query, QueryLanguageType::SPARQL);
+    service.queryData(named_query, QueryLanguageType::SPARQL);
+
+    const auto statistics = service.getQueryCacheStatistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.invalidations, 0u);
+}
+
+// Test that the result of a query that overlaps a change of the datastore is not cached
+TEST_F(ReasonerServiceUnitTest, ResultReadDuringChangeIsNotCached) {
+    ReasonerService service = makeService(8);
+    EXPECT_CALL(*mock_adapter_, loadData(_, _)).WillOnce(Return(true));
+    EXPECT_CALL(*mock_adapter_, queryData(query_, QueryLanguageType::SPARQL, _))
+        .Times(2)
+        .WillOnce(Invoke([&service](const auto&, const auto&, const auto&) {
+            service.loadData("<b> <p> <o> .", ReasonerSyntaxType::TURTLE);
+            return std::string("?s\n<a>\n");
+        }))
+        .WillOnce(Return("?s\n<a>\n<b>\n"));
+
+    EXPECT_EQ(service.queryData(query_, QueryLanguageType::SPARQL), "?s\n<a>\n");
+    EXPECT_EQ(service.queryData(query_, QueryLanguageType::SPARQL), "?s\n<a>\n<b>\n");
+    EXPECT_EQ(service.getQueryCacheStatistics().hits, 0u);
+}
+
+// Test that a full cache only evicts the least recently used result
+TEST_F(ReasonerServiceUnitTest, FullCacheEvictsLeastRecentlyUsedResult) {
+    const std::string first_query = "SELECT ?a WHERE { ?a ?p ?o }";
+    const std::string second_query = "SELECT ?b WHERE { ?b ?p ?o }";
+    const std::string third_query = "SELECT ?c WHERE { ?c ?p ?o }";
+    EXPECT_CALL(*mock_adapter_, queryData(first_query, _, _)).WillOnce(Return("?a\n"));
+    EXPECT_CALL(*mock_adapter_, queryData(second_query, _, _))
+        .Times(2)
+        .WillRepeatedly(Return("?b\n"));
+    EXPECT_CALL(*mock_adapter_, queryData(third_query, _, _)).WillOnce(Return("?c\n"));
+    ReasonerService service = makeService(2);
+
+    service.queryData(first_query, QueryLanguageType::SPARQL);
+    service.queryData(second_query, QueryLanguageType::SPARQL);
+    // The first result is used again, so the second one is evicted for the third
+    service.queryData(first_query, QueryLanguageType::SPARQL);
+    service.queryData(third_query, QueryLanguageType::SPARQL);
+
+    EXPECT_EQ(service.queryData(first_query, QueryLanguageType::SPARQL), "?a\n");
+    EXPECT_EQ(service.queryData(third_query, QueryLanguageType::SPARQL), "?c\n");
+    EXPECT_EQ(service.queryData(second_query, QueryLanguageType::SPARQL), "?b\n");
+
+    const auto statistics = service.getQueryCacheStatistics();
+    EXPECT_EQ(statistics.hits, 3u);
+    EXPECT_EQ(statistics.misses, 4u);
+    EXPECT_EQ(statistics.evictions, 2u);
+}
+
+// Test that queries using functions like NOW() and a cache size of 0 always reach the reasoner
+TEST_F(ReasonerServiceUnitTest, UncacheableQueriesAreNotCached) {
+    const std::string now_query = "SELECT ?t WHERE { BIND(now () AS ?t) }";
+    EXPECT_CALL(*mock_adapter_, queryData(now_query, _, _)).Times(2).WillRepeatedly(Return("?t\n"));
+    EXPECT_CALL(*mock_adapter_, queryData(query_, _, _)).Times(2).WillRepeatedly(Return("?s\n"));
+
+    ReasonerService service = makeService(8);
+    service.queryData(now_query, QueryLanguageType::SPARQL);
+    service.queryData(now_query, QueryLanguageType::SPARQL);
+    EXPECT_EQ(service.getQueryCacheStatistics().uncacheable, 2u);
+
+    EXPECT_TRUE(QueryResultCache::isCacheable("SELECT ?known WHERE { ?known ?p ?o }"));
+    EXPECT_FALSE(QueryResultCache::isCacheable("SELECT (RAND() AS ?r) WHERE {}"));
+
+    EXPECT_CALL(*mock_adapter_, initialize()).Times(1);
+    ReasonerService disabled_service = makeService(0);
+    disabled_service.queryData(query_, QueryLanguageType::SPARQL);
+    disabled_service.queryData(query_, QueryLanguageType::SPARQL);
+}
@@ -19,6 +19,18 @@ class MockReasonerService : public ReasonerService {
                 (const std::string& query, const QueryLanguageType& query_language_type,
                  const DataQueryAcceptType& accept_type),
                 (override));
+    MOCK_METHOD(bool, deleteData, (const std::string& data, const ReasonerSyntaxType& content_type),
+                (override));
+    MOCK_METHOD(bool, deleteRules, (const std::string& rules, const RuleLanguageType& content_type),
+                (override));
+    MOCK_METHOD(bool, loadGraphData,
+                (const std::string& graph, const std::string& data,
+                 const ReasonerSyntaxType& content_type),
+                (override));
+    MOCK_METHOD(bool, deleteGraphData,
+                (const std::string& graph, const std::string& data,
+                 const ReasonerSyntaxType& content_type),
+                (override));
     MOCK_METHOD(bool, deleteDataStore, (), (override));
 };
 